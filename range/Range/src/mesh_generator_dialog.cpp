@@ -47,6 +47,19 @@ MeshGeneratorDialog::MeshGeneratorDialog(uint modelID, QWidget *parent) :
     this->keepResultsCheck->setChecked(this->meshInput.getKeepResults());
     this->keepResultsCheck->setEnabled(rModel.getNVariables() > 0);
 
+    QHBoxLayout *reorderLayout = new QHBoxLayout;
+    mainLayout->addLayout(reorderLayout);
+
+    QLabel *reorderLabel = new QLabel(tr("Reorder nodes and elements:"));
+    reorderLayout->addWidget(reorderLabel);
+
+    this->reorderComboBox = new QComboBox;
+    this->reorderComboBox->addItem(tr("None"),QVariant(int(R_MESH_REORDER_NONE)));
+    this->reorderComboBox->addItem(tr("Reverse Cuthill-McKee"),QVariant(int(R_MESH_REORDER_RCM)));
+    this->reorderComboBox->addItem(tr("Morton curve"),QVariant(int(R_MESH_REORDER_MORTON)));
+    this->reorderComboBox->setCurrentIndex(this->reorderComboBox->findData(QVariant(int(this->meshInput.getReorderType()))));
+    reorderLayout->addWidget(this->reorderComboBox);
+
     this->qualityMeshGroupBox = new QGroupBox(tr("Quality mesh"));
     mainLayout->addWidget(this->qualityMeshGroupBox);
     this->qualityMeshGroupBox->setCheckable(true);
@@ -137,6 +150,7 @@ MeshGeneratorDialog::MeshGeneratorDialog(uint modelID, QWidget *parent) :
     QObject::connect(this->meshSizeFunctionMaxValueEdit,&ValueLineEdit::valueChanged,this,&MeshGeneratorDialog::onVolumeConstraintValueChanged);
     QObject::connect(this->reconstructCheck,&QCheckBox::stateChanged,this,&MeshGeneratorDialog::onReconstructStateChanged);
     QObject::connect(this->keepResultsCheck,&QCheckBox::stateChanged,this,&MeshGeneratorDialog::onKeepResultsStateChanged);
+    this->connect(this->reorderComboBox,SIGNAL(currentIndexChanged(int)),SLOT(onReorderCurrentIndexChanged(int)));
     QObject::connect(this->tetgenParamsGroupBox,&QGroupBox::clicked,this,&MeshGeneratorDialog::onTetgenParamsGroupBoxClicked);
 
     QObject::connect(cancelButton,&QPushButton::clicked,this,&MeshGeneratorDialog::reject);
@@ -184,6 +198,7 @@ void MeshGeneratorDialog::updateMeshInput(void)
     this->meshInput.setVolumeConstraint(this->volumeConstraintEdit->getValue());
     this->meshInput.setReconstruct(this->reconstructCheck->isChecked());
     this->meshInput.setKeepResults(this->keepResultsCheck->isChecked());
+    this->meshInput.setReorderType(RMeshReorderType(this->reorderComboBox->currentData().toInt()));
 
     if (this->meshSizeFunctionMaxValueEdit->getValue() > this->meshSizeFunctionMaxValueEdit->getMaximum())
     {
@@ -244,6 +259,11 @@ void MeshGeneratorDialog::onKeepResultsStateChanged(int)
     this->updateMeshInput();
 }
 
+void MeshGeneratorDialog::onReorderCurrentIndexChanged(int)
+{
+    this->updateMeshInput();
+}
+
 void MeshGeneratorDialog::onTetgenParamsGroupBoxClicked(bool)
 {
     this->updateMeshInput();
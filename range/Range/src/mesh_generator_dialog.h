@@ -46,6 +46,8 @@ class MeshGeneratorDialog : public QDialog
         QCheckBox *reconstructCheck;
         //! Keep results check box.
         QCheckBox *keepResultsCheck;
+        //! Reorder type combo box.
+        QComboBox *reorderComboBox;
         //! TetGen parameters group box.
         QGroupBox *tetgenParamsGroupBox;
         //! TetGen parameters line edit.
@@ -89,6 +91,9 @@ class MeshGeneratorDialog : public QDialog
         //! Keep results checkbox state changed.
         void onKeepResultsStateChanged(int);
 
+        //! Reorder type combo box index changed.
+        void onReorderCurrentIndexChanged(int);
+
         //! Tetgen parameters group box clicked.
         void onTetgenParamsGroupBoxClicked(bool);
     
@@ -142,6 +142,7 @@ void Model::insertModel(const Model &model, bool mergeNearNodes, double toleranc
         }
         this->RResults::addElement();
     }
+    this->invalidateMeshTopology();
     for (uint i=0;i<model.getNPoints();i++)
     {
         this->points.push_back(model.points[i]);
@@ -3205,6 +3206,7 @@ QMap<uint, uint> Model::splitNodes(const QSet<uint> &nodeIDs, const QSet<uint> &
             }
         }
     }
+    this->invalidateMeshTopology();
 
     return newNodeMap;
 } /* Model::splitNodes */
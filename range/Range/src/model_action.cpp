@@ -737,6 +737,7 @@ void ModelAction::swapSurfaceElementNormal(const ModelActionInput &modelActionIn
         RElement &rElement = rModel.getElement(elementIDs[i]);
         rElement.swapNormal();
     }
+    rModel.invalidateMeshTopology();
 
     RLogger::unindent();
 
@@ -778,6 +779,7 @@ void ModelAction::swapSurfaceNormals(const ModelActionInput &modelActionInput)
             rElement.swapNormal();
         }
     }
+    rModel.invalidateMeshTopology();
     RLogger::unindent();
 
     Session::getInstance().setModelChanged(modelActionInput.getModelID());
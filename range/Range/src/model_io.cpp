@@ -116,7 +116,8 @@ void ModelIO::update(Model &rModel, const QString &fileName)
     {
         RModel tmpModel;
 
-        tmpModel.read(fileName);
+        // Only variables which are accessed will be loaded.
+        tmpModel.read(fileName,true);
 
         rModel.update(tmpModel);
 
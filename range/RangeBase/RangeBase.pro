@@ -13,6 +13,7 @@ SOURCES += \
     src/rbl_arguments_parser.cpp \
     src/rbl_book.cpp \
     src/rbl_bvector.cpp \
+    src/rbl_compiled_value_table.cpp \
     src/rbl_error.cpp \
     src/rbl_gl_light.cpp \
     src/rbl_imatrix.cpp \
@@ -42,8 +43,10 @@ HEADERS += \
     include/rbl_arguments_parser.h \
     include/rbl_book.h \
     include/rbl_bvector.h \
+    include/rbl_compiled_value_table.h \
     include/rbl_distance_vector.h \
     include/rbl_error.h \
+    include/rbl_fixed_matrix.h \
     include/rbl_gl_light.h \
     include/rbl_imatrix.h \
     include/rbl_ivector.h \
@@ -0,0 +1,134 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_compiled_value_table.h                               *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Compiled value table class declaration              *
+ *********************************************************************/
+
+#ifndef RBL_COMPILED_VALUE_TABLE_H
+#define RBL_COMPILED_VALUE_TABLE_H
+
+#include <vector>
+#include <algorithm>
+
+#include "rbl_value_table.h"
+
+//! Read-only value table compiled for fast lookup.
+//! Keys and values of the table are stored in flat sorted arrays.
+//! Interval is found by branch-free binary search or, if keys are uniformly
+//! spaced, estimated from the key and corrected by checking neighbouring
+//! keys. Interval selection (key equal to table key belongs to the interval
+//! on its left) and interpolation formula are the same as in
+//! RValueTable::get, so returned values are bit-identical.
+class RCompiledValueTable
+{
+
+    protected:
+
+        //! Keys.
+        std::vector<double> keys;
+        //! Values.
+        std::vector<double> values;
+        //! Keys are uniformly spaced.
+        bool uniform;
+        //! Inverse key spacing (only for uniformly spaced keys).
+        double invStep;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RCompiledValueTable *pCompiledValueTable = nullptr);
+
+    public:
+
+        //! Constructor.
+        RCompiledValueTable();
+
+        //! Constructor from value table.
+        explicit RCompiledValueTable(const RValueTable &valueTable);
+
+        //! Copy constructor.
+        RCompiledValueTable(const RCompiledValueTable &compiledValueTable);
+
+        //! Destructor.
+        ~RCompiledValueTable();
+
+        //! Assignment operator.
+        RCompiledValueTable &operator =(const RCompiledValueTable &compiledValueTable);
+
+        //! Compile given value table.
+        void compile(const RValueTable &valueTable);
+
+        //! Return number of values in the table.
+        inline unsigned int size(void) const
+        {
+            return (unsigned int)this->keys.size();
+        }
+
+        //! Return true if table has only one distinct value.
+        bool isConstant(void) const;
+
+        //! Return true if keys are uniformly spaced.
+        inline bool isUniform(void) const
+        {
+            return this->uniform;
+        }
+
+        //! Return value for a given key.
+        inline double get(double key) const
+        {
+            std::size_t n = this->keys.size();
+            if (n < 2)
+            {
+                return (n == 0) ? 0.0 : this->values[0];
+            }
+
+            const double *k = this->keys.data();
+            const double *v = this->values.data();
+
+            if (!(key > k[0]))
+            {
+                return v[0];
+            }
+            if (key > k[n-1])
+            {
+                return v[n-1];
+            }
+
+            // Find interval i such that k[i] < key <= k[i+1].
+            std::size_t i;
+            if (this->uniform)
+            {
+                i = std::min(std::size_t((key - k[0]) * this->invStep),n-2);
+                // Estimate may be off by one due to rounding.
+                while (i > 0 && !(k[i] < key))
+                {
+                    i--;
+                }
+                while (i < n-2 && k[i+1] < key)
+                {
+                    i++;
+                }
+            }
+            else
+            {
+                const double *base = k;
+                std::size_t len = n-1;
+                while (len > 1)
+                {
+                    std::size_t half = len / 2;
+                    base += (base[half] < key) ? half : 0;
+                    len -= half;
+                }
+                i = std::size_t(base - k);
+            }
+
+            return ((key - k[i]) / (k[i+1] - k[i])) * (v[i+1] - v[i]) + v[i];
+        }
+
+};
+
+#endif // RBL_COMPILED_VALUE_TABLE_H
@@ -0,0 +1,170 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_fixed_matrix.h                                       *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Fixed size real matrix class declaration            *
+ *********************************************************************/
+
+#ifndef RBL_FIXED_MATRIX_H
+#define RBL_FIXED_MATRIX_H
+
+#include <cmath>
+
+#include "rbl_error.h"
+
+//! Fixed size real matrix.
+//! Values are stored contiguously (row by row) so that object can be
+//! allocated on stack and loops with compile-time bounds can be unrolled.
+template <unsigned int N, unsigned int M>
+class RFixedMatrix
+{
+
+    protected:
+
+        //! Matrix values.
+        double values[N*M];
+
+    public:
+
+        //! Return number of rows.
+        static constexpr unsigned int getNRows(void)
+        {
+            return N;
+        }
+
+        //! Return number of columns.
+        static constexpr unsigned int getNColumns(void)
+        {
+            return M;
+        }
+
+        //! Fill matrix with given value.
+        inline void fill(double value)
+        {
+            for (unsigned int i=0;i<N*M;i++)
+            {
+                this->values[i] = value;
+            }
+        }
+
+        //! Return pointer to given row.
+        inline double *operator [](unsigned int row)
+        {
+            return &this->values[row*M];
+        }
+
+        //! Return const pointer to given row.
+        inline const double *operator [](unsigned int row) const
+        {
+            return &this->values[row*M];
+        }
+
+        //! Return matrix determinant.
+        //! Only matrices up to size 3x3 are supported.
+        double getDeterminant(void) const
+        {
+            static_assert(N == M && N >= 1 && N <= 3,"Determinant is implemented only for square matrices up to 3x3.");
+
+            const RFixedMatrix &A = (*this);
+
+            if (N == 1)
+            {
+                return A[0][0];
+            }
+            if (N == 2)
+            {
+                return A[0][0]*A[1][1] - A[0][1]*A[1][0];
+            }
+            return   A[0][0]*(A[1][1]*A[2][2] - A[1][2]*A[2][1])
+                   - A[0][1]*(A[1][0]*A[2][2] - A[1][2]*A[2][0])
+                   + A[0][2]*(A[1][0]*A[2][1] - A[1][1]*A[2][0]);
+        }
+
+        //! Invert matrix.
+        //! Only matrices up to size 3x3 are supported.
+        void invert(void)
+        {
+            double det = this->getDeterminant();
+
+            if (det == 0.0)
+            {
+                throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Can not invert matrix. Singular matrix.");
+            }
+
+            RFixedMatrix &A = (*this);
+
+            if (N == 1)
+            {
+                A[0][0] = 1.0 / det;
+            }
+            else if (N == 2)
+            {
+                double a00 = A[0][0];
+                A[0][0] =  A[1][1] / det;
+                A[0][1] = -A[0][1] / det;
+                A[1][0] = -A[1][0] / det;
+                A[1][1] =  a00 / det;
+            }
+            else
+            {
+                RFixedMatrix B(A);
+
+                A[0][0] = (B[1][1]*B[2][2] - B[1][2]*B[2][1]) / det;
+                A[0][1] = (B[0][2]*B[2][1] - B[0][1]*B[2][2]) / det;
+                A[0][2] = (B[0][1]*B[1][2] - B[0][2]*B[1][1]) / det;
+                A[1][0] = (B[1][2]*B[2][0] - B[1][0]*B[2][2]) / det;
+                A[1][1] = (B[0][0]*B[2][2] - B[0][2]*B[2][0]) / det;
+                A[1][2] = (B[0][2]*B[1][0] - B[0][0]*B[1][2]) / det;
+                A[2][0] = (B[1][0]*B[2][1] - B[1][1]*B[2][0]) / det;
+                A[2][1] = (B[0][1]*B[2][0] - B[0][0]*B[2][1]) / det;
+                A[2][2] = (B[0][0]*B[1][1] - B[0][1]*B[1][0]) / det;
+            }
+        }
+
+};
+
+//! Fixed size real vector.
+template <unsigned int N>
+class RFixedVector
+{
+
+    protected:
+
+        //! Vector values.
+        double values[N];
+
+    public:
+
+        //! Return vector size.
+        static constexpr unsigned int size(void)
+        {
+            return N;
+        }
+
+        //! Fill vector with given value.
+        inline void fill(double value)
+        {
+            for (unsigned int i=0;i<N;i++)
+            {
+                this->values[i] = value;
+            }
+        }
+
+        //! Return reference to element at given position.
+        inline double &operator [](unsigned int n)
+        {
+            return this->values[n];
+        }
+
+        //! Return const reference to element at given position.
+        inline const double &operator [](unsigned int n) const
+        {
+            return this->values[n];
+        }
+
+};
+
+#endif // RBL_FIXED_MATRIX_H
@@ -192,6 +192,13 @@ class RLogger
         //! Convenience function to decrease indent.
         static void unindent ( bool printTime = true );
 
+        //! Return whether logging is muted in calling thread.
+        static bool getThreadMuted ( void );
+
+        //! Mute/unmute logging in calling thread.
+        //! Messages, indentation and progress printed from muted thread are dropped.
+        static void setThreadMuted ( bool muted );
+
 };
 
 #endif /* RBL_LOGGER_H */
@@ -116,6 +116,8 @@ class RValueTable
         //! Not equal operator.
         bool operator != ( const RValueTable &valueTable ) const;
 
+        friend class RCompiledValueTable;
+
 };
 
 #endif /* RBL_VALUE_TABLE_H */
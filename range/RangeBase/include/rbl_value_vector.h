@@ -71,6 +71,10 @@ class RValueVector
         //! If valueBook[i] == RConstants::eod then value will be removed.
         void remove(const std::vector<uint> &valueBook);
 
+        //! Renumber values.
+        //! Value at position i is moved to position valueBook[i] (valueBook has to be a permutation).
+        void renumber(const std::vector<uint> &valueBook);
+
         //! Fill values with given value.
         void fill ( double value );
 
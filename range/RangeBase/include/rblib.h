@@ -16,8 +16,10 @@
 #include "rbl_arguments_parser.h"
 #include "rbl_book.h"
 #include "rbl_bvector.h"
+#include "rbl_compiled_value_table.h"
 #include "rbl_distance_vector.h"
 #include "rbl_error.h"
+#include "rbl_fixed_matrix.h"
 #include "rbl_gl_light.h"
 #include "rbl_imatrix.h"
 #include "rbl_ivector.h"
@@ -0,0 +1,105 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rbl_compiled_value_table.cpp                             *
+ *  GROUP:  RBL                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Compiled value table class definition               *
+ *********************************************************************/
+
+#include <cmath>
+
+#include "rbl_compiled_value_table.h"
+
+void RCompiledValueTable::_init(const RCompiledValueTable *pCompiledValueTable)
+{
+    if (pCompiledValueTable)
+    {
+        this->keys = pCompiledValueTable->keys;
+        this->values = pCompiledValueTable->values;
+        this->uniform = pCompiledValueTable->uniform;
+        this->invStep = pCompiledValueTable->invStep;
+    }
+}
+
+RCompiledValueTable::RCompiledValueTable()
+    : uniform(false)
+    , invStep(0.0)
+{
+    this->_init();
+}
+
+RCompiledValueTable::RCompiledValueTable(const RValueTable &valueTable)
+    : uniform(false)
+    , invStep(0.0)
+{
+    this->_init();
+    this->compile(valueTable);
+}
+
+RCompiledValueTable::RCompiledValueTable(const RCompiledValueTable &compiledValueTable)
+{
+    this->_init(&compiledValueTable);
+}
+
+RCompiledValueTable::~RCompiledValueTable()
+{
+
+}
+
+RCompiledValueTable &RCompiledValueTable::operator =(const RCompiledValueTable &compiledValueTable)
+{
+    this->_init(&compiledValueTable);
+    return (*this);
+}
+
+void RCompiledValueTable::compile(const RValueTable &valueTable)
+{
+    this->keys.clear();
+    this->values.clear();
+    this->uniform = false;
+    this->invStep = 0.0;
+
+    this->keys.reserve(valueTable.size());
+    this->values.reserve(valueTable.size());
+
+    for (std::map<double,double>::const_iterator iter = valueTable.table.begin(); iter != valueTable.table.end(); ++iter)
+    {
+        this->keys.push_back(iter->first);
+        this->values.push_back(iter->second);
+    }
+
+    std::size_t n = this->keys.size();
+    if (n < 2)
+    {
+        return;
+    }
+
+    double step = (this->keys[n-1] - this->keys[0]) / double(n-1);
+    this->uniform = true;
+    for (std::size_t i=0;i<n-1;i++)
+    {
+        if (std::fabs((this->keys[i+1] - this->keys[i]) - step) > 1.0e-12 * std::fabs(step))
+        {
+            this->uniform = false;
+            break;
+        }
+    }
+    if (this->uniform)
+    {
+        this->invStep = 1.0 / step;
+    }
+}
+
+bool RCompiledValueTable::isConstant(void) const
+{
+    for (std::size_t i=1;i<this->values.size();i++)
+    {
+        if (this->values[i] != this->values[0])
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -18,6 +18,9 @@
 #include "rbl_locker.h"
 #include "rbl_error.h"
 
+//! Logging is muted in this thread.
+static thread_local bool threadMuted = false;
+
 
 void RLogger::_init (const RLogger *pLogger)
 {
@@ -276,6 +279,11 @@ void RLogger::print (const RMessage &message)
     QString fullMessage;
     bool printToStderr = false;
 
+    if (threadMuted)
+    {
+        return;
+    }
+
     if (!(messageType & this->getLevel()))
     {
         // Message is out of the log level, so it will be dropped.
@@ -499,6 +507,10 @@ void RLogger::timestamp(const QString prefix)
 
 void RLogger::indent (void)
 {
+    if (threadMuted)
+    {
+        return;
+    }
     RLogger::getInstance().timerStack.push_front(QTime());
     RLogger::getInstance().timerStack.first().start();
     RLogger::info("{\n");
@@ -508,6 +520,10 @@ void RLogger::indent (void)
 
 void RLogger::unindent (bool printTime)
 {
+    if (threadMuted)
+    {
+        return;
+    }
     RLogger::getInstance().decreaseIndent();
     int elapsed = qRound(double(RLogger::getInstance().timerStack.first().elapsed())/1000.0);
     if (printTime)
@@ -520,3 +536,15 @@ void RLogger::unindent (bool printTime)
     }
     RLogger::getInstance().timerStack.pop_front();
 } /* RLogger::unindent */
+
+
+bool RLogger::getThreadMuted (void)
+{
+    return threadMuted;
+} /* RLogger::getThreadMuted */
+
+
+void RLogger::setThreadMuted (bool muted)
+{
+    threadMuted = muted;
+} /* RLogger::setThreadMuted */
@@ -111,6 +111,10 @@ void RProgress::setProgressFinalizeHandler (RProgressFinalizeHandler progressFin
 void RProgress::initialize (const QString &message,
                             bool           pulseType)
 {
+    if (RLogger::getThreadMuted())
+    {
+        return;
+    }
     this->pulseType = pulseType;
     this->lastFraction = 0.0;
     this->print(0.0);
@@ -130,6 +134,10 @@ void RProgress::initialize (const QString &message,
 
 void RProgress::finalize (const QString &message)
 {
+    if (RLogger::getThreadMuted())
+    {
+        return;
+    }
     this->print(1.0);
     if (this->printToLog)
     {
@@ -147,6 +155,10 @@ void RProgress::finalize (const QString &message)
 
 void RProgress::print (double fraction)
 {
+    if (RLogger::getThreadMuted())
+    {
+        return;
+    }
     if (this->printToLog)
     {
         bool addNewLine = RLogger::getInstance().getAddNewLine();
@@ -13,7 +13,7 @@ TEMPLATE = lib
 DEFINES += RANGEMODEL_LIBRARY
 
 DEFINES += "FILE_MAJOR_VERSION=1"
-DEFINES += "FILE_MINOR_VERSION=0"
+DEFINES += "FILE_MINOR_VERSION=5"
 DEFINES += "FILE_RELEASE_VERSION=0"
 
 INCLUDEPATH += include
@@ -23,6 +23,7 @@ SOURCES += \
     src/rml_condition.cpp \
     src/rml_condition_component.cpp \
     src/rml_cut.cpp \
+    src/rml_edge_collapse.cpp \
     src/rml_eigen_value_solver_conf.cpp \
     src/rml_element.cpp \
     src/rml_element_group.cpp \
@@ -35,6 +36,7 @@ SOURCES += \
     src/rml_file_header.cpp \
     src/rml_file_io.cpp \
     src/rml_file_manager.cpp \
+    src/rml_geometry_packet.cpp \
     src/rml_gl_display_properties.cpp \
     src/rml_initial_condition.cpp \
     src/rml_interpolated_element.cpp \
@@ -49,6 +51,7 @@ SOURCES += \
     src/rml_mesh_generator.cpp \
     src/rml_mesh_input.cpp \
     src/rml_mesh_setup.cpp \
+    src/rml_mesh_topology.cpp \
     src/rml_modal_setup.cpp \
     src/rml_model.cpp \
     src/rml_model_data.cpp \
@@ -58,6 +61,7 @@ SOURCES += \
     src/rml_monitoring_point.cpp \
     src/rml_monitoring_point_manager.cpp \
     src/rml_node.cpp \
+    src/rml_node_element_incidence.cpp \
     src/rml_patch.cpp \
     src/rml_patch_book.cpp \
     src/rml_patch_input.cpp \
@@ -77,11 +81,14 @@ SOURCES += \
     src/rml_surface.cpp \
     src/rml_tetgen.cpp \
     src/rml_tetrahedron.cpp \
+    src/rml_text_formatter.cpp \
+    src/rml_text_parser.cpp \
     src/rml_time_solver.cpp \
     src/rml_triangle.cpp \
     src/rml_triangulate.cpp \
     src/rml_variable.cpp \
     src/rml_variable_data.cpp \
+    src/rml_variable_loader.cpp \
     src/rml_vector_field.cpp \
     src/rml_view_factor_matrix.cpp \
     src/rml_view_factor_matrix_header.cpp \
@@ -93,6 +100,7 @@ HEADERS += \
     include/rml_condition.h \
     include/rml_condition_component.h \
     include/rml_cut.h \
+    include/rml_edge_collapse.h \
     include/rml_eigen_value_solver_conf.h \
     include/rml_element.h \
     include/rml_element_group.h \
@@ -105,6 +113,7 @@ HEADERS += \
     include/rml_file_header.h \
     include/rml_file_io.h \
     include/rml_file_manager.h \
+    include/rml_geometry_packet.h \
     include/rml_gl_display_properties.h \
     include/rml_initial_condition.h \
     include/rml_interpolated_element.h \
@@ -119,6 +128,7 @@ HEADERS += \
     include/rml_mesh_generator.h \
     include/rml_mesh_input.h \
     include/rml_mesh_setup.h \
+    include/rml_mesh_topology.h \
     include/rml_modal_setup.h \
     include/rml_model.h \
     include/rml_model_data.h \
@@ -128,6 +138,7 @@ HEADERS += \
     include/rml_monitoring_point.h \
     include/rml_monitoring_point_manager.h \
     include/rml_node.h \
+    include/rml_node_element_incidence.h \
     include/rml_patch.h \
     include/rml_patch_book.h \
     include/rml_patch_input.h \
@@ -149,11 +160,14 @@ HEADERS += \
     include/rml_surface.h \
     include/rml_tetgen.h \
     include/rml_tetrahedron.h \
+    include/rml_text_formatter.h \
+    include/rml_text_parser.h \
     include/rml_time_solver.h \
     include/rml_triangle.h \
     include/rml_triangulate.h \
     include/rml_variable.h \
     include/rml_variable_data.h \
+    include/rml_variable_loader.h \
     include/rml_vector_field.h \
     include/rml_view_factor_matrix.h \
     include/rml_view_factor_matrix_header.h \
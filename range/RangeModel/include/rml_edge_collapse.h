@@ -0,0 +1,144 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_edge_collapse.h                                      *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Edge collapse class declaration                     *
+ *********************************************************************/
+
+#ifndef RML_EDGE_COLLAPSE_H
+#define RML_EDGE_COLLAPSE_H
+
+#include <vector>
+#include <queue>
+#include <functional>
+
+#include <rblib.h>
+
+#include "rml_element.h"
+#include "rml_node.h"
+
+typedef struct _REdgeCollapseItem
+{
+    //! Collapse cost (shortest edge length).
+    double cost;
+    //! Element ID.
+    uint elementID;
+    //! Element version at the time item was queued.
+    uint version;
+
+    bool operator >(const _REdgeCollapseItem &item) const
+    {
+        return (this->cost > item.cost);
+    }
+} REdgeCollapseItem;
+
+//! Edge collapse engine.
+//! Works on copy of nodes and elements. Candidate elements which violate
+//! any of the set limits are queued by their shortest edge length and the
+//! shortest edge is collapsed (nodes are merged into their mid point).
+//! Node to element adjacency is updated locally after each collapse and
+//! only affected elements are re-queued, therefore whole mesh is processed
+//! in a single pass.
+class REdgeCollapse
+{
+
+    protected:
+
+        //! Working copy of nodes.
+        std::vector<RNode> nodes;
+        //! Working copy of elements.
+        std::vector<RElement> elements;
+        //! Node to element adjacency.
+        std::vector<RUVector> nodeElements;
+        //! Elements which may trigger collapse.
+        RBVector candidateBook;
+        //! Elements which were collapsed (contain duplicate nodes).
+        RBVector collapsedBook;
+        //! Merged (no longer used) nodes.
+        RBVector mergedBook;
+        //! Element versions (incremented whenever element changes).
+        RUVector elementVersions;
+        //! Edge length limit.
+        double edgeLengthLimit;
+        //! Element area limit.
+        double elementAreaLimit;
+        //! Edge (aspect) ratio limit.
+        double edgeRatioLimit;
+        //! Allow downgrade of collapsed elements.
+        bool allowDowngrade;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const REdgeCollapse *pEdgeCollapse = nullptr);
+
+    public:
+
+        //! Constructor.
+        REdgeCollapse(const std::vector<RNode> &nodes,
+                      const std::vector<RElement> &elements,
+                      bool allowDowngrade);
+
+        //! Copy constructor.
+        REdgeCollapse(const REdgeCollapse &edgeCollapse);
+
+        //! Destructor.
+        ~REdgeCollapse();
+
+        //! Assignment operator.
+        REdgeCollapse &operator =(const REdgeCollapse &edgeCollapse);
+
+        //! Set elements which may trigger collapse.
+        void setCandidates(const RBVector &candidateBook);
+
+        //! Set edge length limit (edges shorter than limit are collapsed).
+        void setEdgeLengthLimit(double edgeLengthLimit);
+
+        //! Set element area limit (elements with smaller area are collapsed).
+        void setElementAreaLimit(double elementAreaLimit);
+
+        //! Set edge (aspect) ratio limit (elements with larger ratio are collapsed).
+        void setEdgeRatioLimit(double edgeRatioLimit);
+
+        //! Collapse edges.
+        //! Return number of performed collapses.
+        uint collapse(void);
+
+        //! Return working copy of nodes.
+        const std::vector<RNode> &getNodes(void) const;
+
+        //! Return working copy of elements.
+        const std::vector<RElement> &getElements(void) const;
+
+        //! Return book of collapsed elements.
+        const RBVector &getCollapsedBook(void) const;
+
+        //! Return book of merged nodes.
+        const RBVector &getMergedBook(void) const;
+
+        //! Find shortest and longest distance between element nodes.
+        //! Return false if element has less than two distinct nodes.
+        static bool findEdgeLengths(const RElement &rElement,
+                                    const std::vector<RNode> &nodes,
+                                    double &lMin,
+                                    double &lMax,
+                                    uint &node1,
+                                    uint &node2);
+
+    protected:
+
+        //! Return true if element violates any of the limits.
+        bool findCollapseEdge(uint elementID, double &cost, uint &node1, uint &node2) const;
+
+        //! Queue element if it violates any of the limits.
+        void queueElement(uint elementID, std::priority_queue<REdgeCollapseItem,std::vector<REdgeCollapseItem>,std::greater<REdgeCollapseItem> > &queue) const;
+
+        //! Merge node2 into node1.
+        void mergeNodes(uint node1, uint node2);
+
+};
+
+#endif // RML_EDGE_COLLAPSE_H
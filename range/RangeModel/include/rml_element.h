@@ -235,6 +235,12 @@ class RElement
                              RRMatrix &J,
                              RRMatrix &Rt ) const;
 
+        //! Calculate inverse jacobian matrix and jacobian determinant of volume element.
+        //! No memory is allocated.
+        double findJacobian( const std::vector <RNode> &nodes,
+                             unsigned int iPoint,
+                             RFixedMatrix<3,3> &J ) const;
+
         //! Find out on which side and where is given vector intersecting the element.
         unsigned int findIntersectedSide( const std::vector <RNode> &nodes,
                                           const RR3Vector &position,
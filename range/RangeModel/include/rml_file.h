@@ -38,6 +38,8 @@ class RFile : public QFile
         Type type;
         //! File version.
         RVersion fileVersion;
+        //! Binary data blocks are compressed.
+        bool compressed;
 
         //! Text stream.
         QTextStream textStream;
@@ -71,6 +73,12 @@ class RFile : public QFile
         //! Return const reference file version.
         void setVersion(const RVersion &fileVersion);
 
+        //! Return true if binary data blocks are compressed.
+        bool getCompressed(void) const;
+
+        //! Set whether binary data blocks are compressed.
+        void setCompressed(bool compressed);
+
         //! Return reference to text stream.
         QTextStream &getTextStream(void);
 
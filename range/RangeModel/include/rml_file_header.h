@@ -21,6 +21,9 @@ typedef enum _RFileType
     R_FILE_TYPE_VIEW_FACTOR_MATRIX,
     R_FILE_TYPE_DISPLAY_PROPERTIES,
     R_FILE_TYPE_LINK,
+    R_FILE_TYPE_MODEL_RESULTS,
+    R_FILE_TYPE_TIME_SOLVER,
+    R_FILE_TYPE_SOLVER_CHECKPOINT,
     R_FILE_N_TYPES
 } RFileType;
 
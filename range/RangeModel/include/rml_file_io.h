@@ -49,6 +49,7 @@
 #include "rml_surface.h"
 #include "rml_volume.h"
 #include "rml_variable.h"
+#include "rml_variable_loader.h"
 #include "rml_vector_field.h"
 #include "rml_view_factor_matrix_header.h"
 #include "rml_view_factor_row.h"
@@ -65,6 +66,16 @@ class RFileIO
         //! Write new line character.
         static void writeNewLineAscii(RSaveFile &outFile);
 
+        // Raw data block
+
+        //! Read block of raw data with single read.
+        //! If file is compressed, large blocks are decompressed in parallel.
+        static void readBinaryBlock(RFile &inFile, void *data, qint64 nBytes, qint64 elementSize = 1);
+        //! Write block of raw data with single write.
+        //! If file is compressed, large blocks are compressed in parallel.
+        //! Element size is used to group bytes of same significance.
+        static void writeBinaryBlock(RSaveFile &outFile, const void *data, qint64 nBytes, qint64 elementSize = 1);
+
         // bool
 
         //! Read boolean value.
@@ -343,6 +354,21 @@ class RFileIO
         static void writeAscii(RSaveFile &outFile, const RVariable &variable, bool addNewLine = true);
         //! Write RVariable.
         static void writeBinary(RSaveFile &outFile, const RVariable &variable);
+        //! Read RVariable without values.
+        //! Value vectors are left empty and can be read later from given location.
+        static void readBinary(RFile &inFile, RVariable &variable, const RVariableLocation &location);
+        //! Read RVariable values from given location.
+        static void readBinaryValues(RFile &inFile, RVariable &variable, const RVariableLocation &location);
+        //! Write RVariable and return its location.
+        static void writeBinary(RSaveFile &outFile, const RVariable &variable, RVariableLocation &location);
+
+        // RVariableLocation
+
+        //! Read table of RVariableLocation.
+        static void readBinary(RFile &inFile, std::vector<RVariableLocation> &locations);
+        //! Write table of RVariableLocation.
+        //! Table is never compressed so that it can be rewritten in place.
+        static void writeBinary(RSaveFile &outFile, const std::vector<RVariableLocation> &locations);
 
         // RBoundaryConditionType
 
@@ -487,6 +513,15 @@ class RFileIO
         //! Write RNode.
         static void writeBinary(RSaveFile &outFile, const RNode &node);
 
+        // std::vector<RNode>
+
+        //! Read vector of RNode (number of nodes followed by coordinate block).
+        static void readBinary(RFile &inFile, std::vector<RNode> &nodes);
+        //! Write vector of RNode (number of nodes followed by one node per line).
+        static void writeAscii(RSaveFile &outFile, const std::vector<RNode> &nodes);
+        //! Write vector of RNode (number of nodes followed by coordinate block).
+        static void writeBinary(RSaveFile &outFile, const std::vector<RNode> &nodes);
+
         // RElementType
 
         //! Read RElementType.
@@ -509,6 +544,17 @@ class RFileIO
         //! Write RElement.
         static void writeBinary(RSaveFile &outFile, const RElement &element);
 
+        // std::vector<RElement>
+
+        //! Read vector of RElement.
+        //! Since version 1.1.0 elements are stored as type table followed by
+        //! type, offset and node ID blocks, older versions store each element separately.
+        static void readBinary(RFile &inFile, std::vector<RElement> &elements);
+        //! Write vector of RElement (number of elements followed by one element per line).
+        static void writeAscii(RSaveFile &outFile, const std::vector<RElement> &elements);
+        //! Write vector of RElement as type, offset and node ID blocks.
+        static void writeBinary(RSaveFile &outFile, const std::vector<RElement> &elements);
+
         // REntityGroupVariableDisplayType
 
         //! Read REntityGroupVariableDisplayType.
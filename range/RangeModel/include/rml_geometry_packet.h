@@ -0,0 +1,136 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_geometry_packet.h                                    *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Geometry packet classes declaration                 *
+ *********************************************************************/
+
+#ifndef RML_GEOMETRY_PACKET_H
+#define RML_GEOMETRY_PACKET_H
+
+#include <rblib.h>
+
+#include "rml_node.h"
+#include "rml_triangle.h"
+
+//! Number of primitives tested together (vector lanes).
+#define R_GEOMETRY_PACKET_SIZE 8
+
+//! Vectorize loop over packet lanes.
+//! Without OpenMP 4.0 support the loop is left to the compiler (scalar fallback).
+#if defined(_OPENMP) && _OPENMP >= 201307
+#  define R_GEOMETRY_PACKET_SIMD _Pragma("omp simd")
+#else
+#  define R_GEOMETRY_PACKET_SIMD
+#endif
+
+//! Packet of triangles prepared for line intersection tests.
+//! Triangles are stored as first node and two edge vectors in lane-major
+//! arrays so that one line is tested against all triangles in a single
+//! vectorized loop (Moller-Trumbore). Unused lanes never intersect.
+class RTrianglePacket
+{
+
+    protected:
+
+        //! Number of triangles in the packet.
+        uint nTriangles;
+        //! First node.
+        double p[3][R_GEOMETRY_PACKET_SIZE];
+        //! Edge from first to second node.
+        double e1[3][R_GEOMETRY_PACKET_SIZE];
+        //! Edge from first to third node.
+        double e2[3][R_GEOMETRY_PACKET_SIZE];
+        //! Length of edge cross product (twice the area).
+        double a[R_GEOMETRY_PACKET_SIZE];
+
+    public:
+
+        //! Constructor.
+        RTrianglePacket();
+
+        //! Return number of triangles in the packet.
+        inline uint size(void) const
+        {
+            return this->nTriangles;
+        }
+
+        //! Return true if no more triangles can be added.
+        inline bool isFull(void) const
+        {
+            return (this->nTriangles == R_GEOMETRY_PACKET_SIZE);
+        }
+
+        //! Remove all triangles.
+        void clear(void);
+
+        //! Add triangle to the packet.
+        void add(const RTriangle &triangle);
+
+        //! Find intersections of line with all triangles in the packet.
+        //! Return bit mask of intersected triangles, line parameter of each intersection is stored in u.
+        uint findLineIntersections(const RR3Vector &position,
+                                   const RR3Vector &direction,
+                                   double u[R_GEOMETRY_PACKET_SIZE]) const;
+
+        //! Find intersections of lines sharing start position with given triangle.
+        //! Return bit mask of intersecting lines, line parameter of each intersection is stored in u.
+        static uint findLineIntersections(const RTriangle &triangle,
+                                          const RR3Vector &position,
+                                          const double directions[3][R_GEOMETRY_PACKET_SIZE],
+                                          uint nLines,
+                                          double u[R_GEOMETRY_PACKET_SIZE]);
+
+};
+
+//! Packet of linear tetrahedra prepared for point location.
+//! For every tetrahedron first node and inverse of edge matrix are stored
+//! so that barycentric coordinates of one point are evaluated for all
+//! tetrahedra in a single vectorized loop.
+class RTetrahedronPacket
+{
+
+    protected:
+
+        //! Number of tetrahedra in the packet.
+        uint nTetrahedra;
+        //! Mask of non-degenerated tetrahedra.
+        uint validMask;
+        //! First node.
+        double p[3][R_GEOMETRY_PACKET_SIZE];
+        //! Inverse of edge matrix (3x3 row major).
+        double invE[9][R_GEOMETRY_PACKET_SIZE];
+
+    public:
+
+        //! Constructor.
+        RTetrahedronPacket();
+
+        //! Return number of tetrahedra in the packet.
+        inline uint size(void) const
+        {
+            return this->nTetrahedra;
+        }
+
+        //! Return true if no more tetrahedra can be added.
+        inline bool isFull(void) const
+        {
+            return (this->nTetrahedra == R_GEOMETRY_PACKET_SIZE);
+        }
+
+        //! Remove all tetrahedra.
+        void clear(void);
+
+        //! Add tetrahedron to the packet.
+        void add(const RNode &node1, const RNode &node2, const RNode &node3, const RNode &node4);
+
+        //! Return bit mask of tetrahedra containing given point.
+        //! Barycentric coordinates are allowed to be negative down to -tolerance.
+        uint findInside(const RR3Vector &point, double tolerance) const;
+
+};
+
+#endif // RML_GEOMETRY_PACKET_H
@@ -45,6 +45,14 @@ class RMatrixSolverConf
         // FOLOWING MEMBERS ARE NOT SAVED TO FILE
         //! Output file name.
         QString outputFileName;
+        //! Number of domains used by domain decomposition preconditioner.
+        unsigned int nDomains;
+        //! Apply matrix without assembling it where supported.
+        bool matrixFree;
+        //! Use block preconditioner for saddle point matrix systems where supported.
+        bool saddlePointPreconditioner;
+        //! Deflate conjugate gradient solver with vectors recycled from previous solves.
+        bool deflation;
 
     private:
 
@@ -101,6 +109,37 @@ class RMatrixSolverConf
         //! Set output file name.
         void setOutputFileName ( const QString &outputFileName );
 
+        //! Return number of domains.
+        unsigned int getNDomains ( void ) const;
+
+        //! Set number of domains.
+        //! If more than one domain is set additive Schwarz preconditioner replaces
+        //! none and Jacobi preconditioners, block Jacobi is kept.
+        //! Domains are processed by threads of single process, distributed
+        //! memory (MPI) execution is not implemented.
+        void setNDomains ( unsigned int nDomains );
+
+        //! Return true if matrix should be applied without assembling it.
+        bool getMatrixFree ( void ) const;
+
+        //! Set whether matrix should be applied without assembling it.
+        //! Solvers which do not support matrix-free operator ignore this setting.
+        void setMatrixFree ( bool matrixFree );
+
+        //! Return true if saddle point matrix systems should use block preconditioner.
+        bool getSaddlePointPreconditioner ( void ) const;
+
+        //! Set whether saddle point matrix systems should use block preconditioner.
+        //! If not set Jacobi preconditioner is used instead.
+        void setSaddlePointPreconditioner ( bool saddlePointPreconditioner );
+
+        //! Return true if conjugate gradient solver should be deflated.
+        bool getDeflation ( void ) const;
+
+        //! Set whether conjugate gradient solver should be deflated with vectors recycled from previous solves.
+        //! Deflation is applied only to solvers which provide it and whose matrix is symmetric positive definite.
+        void setDeflation ( bool deflation );
+
         //! Allow RFileIO to access private members.
         friend class RFileIO;
 
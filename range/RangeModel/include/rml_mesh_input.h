@@ -15,6 +15,17 @@
 
 #include <rblib.h>
 
+//! Mesh reordering types.
+typedef enum _RMeshReorderType
+{
+    //! Keep node and element numbering.
+    R_MESH_REORDER_NONE = 0,
+    //! Reverse Cuthill-McKee ordering of node graph.
+    R_MESH_REORDER_RCM,
+    //! Morton (Z-order) space filling curve ordering of node coordinates.
+    R_MESH_REORDER_MORTON
+} RMeshReorderType;
+
 class RMeshInput
 {
 
@@ -44,6 +55,8 @@ class RMeshInput
         bool surfaceIntegrityCheck;
         //! Keep results after mesh generation is done.
         bool keepResults;
+        //! Reorder nodes and elements after mesh generation is done (none by default).
+        RMeshReorderType reorderType;
 
         //! Use provided TetGen mesh input line directly.
         bool useTetGenInputParams;
@@ -141,6 +154,12 @@ class RMeshInput
         //! Set whether results should be kept.
         void setKeepResults(bool keepResults);
 
+        //! Return reorder type applied to generated mesh.
+        RMeshReorderType getReorderType(void) const;
+
+        //! Set reorder type applied to generated mesh.
+        void setReorderType(RMeshReorderType reorderType);
+
         //! Return whether to use TetGen input parameters directly.
         bool getUseTetGenInputParams(void) const;
 
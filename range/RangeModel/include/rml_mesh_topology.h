@@ -0,0 +1,135 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_mesh_topology.h                                      *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Mesh topology class declaration                     *
+ *********************************************************************/
+
+#ifndef RML_MESH_TOPOLOGY_H
+#define RML_MESH_TOPOLOGY_H
+
+#include <vector>
+
+#include <rblib.h>
+
+#include "rml_element.h"
+
+//! Maximum number of nodes on element side.
+#define R_MESH_TOPOLOGY_MAX_SIDE_NODES 4
+
+//! Mesh topology.
+//! Holds node to element incidence and element side adjacency.
+//! Sides are edges of surface elements and faces of volume elements.
+//! Each side is shared by all elements (of the same group type) which
+//! contain the same set of side nodes, therefore boundary sides have
+//! exactly one element and non-manifold sides have more than two.
+class RMeshTopology
+{
+
+    protected:
+
+        //! Indicates whether topology was built.
+        bool built;
+        //! Number of nodes.
+        uint nNodes;
+        //! Number of elements.
+        uint nElements;
+        //! Offsets to node element arrays (size = nNodes + 1).
+        std::vector<uint> nodeElementOffsets;
+        //! Elements incident with nodes (ascending element IDs).
+        std::vector<uint> nodeElements;
+        //! Offsets to element side arrays (size = nElements + 1).
+        std::vector<uint> elementSideOffsets;
+        //! Side IDs in order of local element sides.
+        std::vector<uint> elementSides;
+        //! Offsets to side element arrays (size = nSides + 1).
+        std::vector<uint> sideElementOffsets;
+        //! Elements sharing sides.
+        std::vector<uint> sideElements;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RMeshTopology *pMeshTopology = nullptr);
+
+    public:
+
+        //! Constructor.
+        RMeshTopology();
+
+        //! Copy constructor.
+        RMeshTopology(const RMeshTopology &meshTopology);
+
+        //! Destructor.
+        ~RMeshTopology();
+
+        //! Assignment operator.
+        RMeshTopology &operator =(const RMeshTopology &meshTopology);
+
+        //! Build topology from element connectivity.
+        void build(const std::vector<RElement> &elements, uint nNodes);
+
+        //! Clear topology.
+        void clear(void);
+
+        //! Return true if topology was built for given number of nodes and elements.
+        bool isValid(uint nNodes, uint nElements) const;
+
+        //! Return number of elements incident with given node.
+        uint getNNodeElements(uint nodeID) const;
+
+        //! Return ID of element incident with given node.
+        uint getNodeElementID(uint nodeID, uint position) const;
+
+        //! Return number of sides.
+        uint getNSides(void) const;
+
+        //! Return number of sides of given element.
+        uint getNElementSides(uint elementID) const;
+
+        //! Return side ID for given element local side.
+        uint getElementSideID(uint elementID, uint localSide) const;
+
+        //! Return number of elements sharing given side.
+        uint getNSideElements(uint sideID) const;
+
+        //! Return ID of element sharing given side.
+        uint getSideElementID(uint sideID, uint position) const;
+
+        //! Return true if side has only one element.
+        bool isBoundarySide(uint sideID) const;
+
+        //! Return true if side is shared by at most two elements.
+        bool isManifoldSide(uint sideID) const;
+
+        //! Return true if any of element sides is a boundary side.
+        bool hasBoundarySide(uint elementID) const;
+
+        //! Find elements which share a side with given element.
+        RUVector findNeighbors(uint elementID) const;
+
+        //! Find number of boundary sides.
+        uint findNBoundarySides(void) const;
+
+        //! Find number of non-manifold sides.
+        uint findNNonManifoldSides(void) const;
+
+        //! Return true if elements marked in element book form closed surface or volume.
+        //! Each side of marked elements must be shared by at least two elements
+        //! and all of them must be marked.
+        bool isClosed(const RBVector &elementBook) const;
+
+        //! Return number of sides for given element type.
+        static uint getNSides(RElementType elementType);
+
+        //! Return side node positions for given element type and local side.
+        //! Return number of side nodes.
+        //! Wedge and hexahedron nodes follow bottom face then top face ordering.
+        static uint getSideNodePositions(RElementType elementType, uint localSide, uint nodePositions[R_MESH_TOPOLOGY_MAX_SIDE_NODES]);
+
+};
+
+#endif // RML_MESH_TOPOLOGY_H
@@ -17,13 +17,16 @@
 
 #include "rml_cut.h"
 #include "rml_element.h"
+#include "rml_file.h"
 #include "rml_interpolated_entity.h"
 #include "rml_iso.h"
 #include "rml_line.h"
+#include "rml_mesh_topology.h"
 #include "rml_node.h"
 #include "rml_patch_book.h"
 #include "rml_patch_input.h"
 #include "rml_point.h"
+#include "rml_save_file.h"
 #include "rml_surface.h"
 #include "rml_volume.h"
 #include "rml_results.h"
@@ -94,8 +97,12 @@ class RModel : public RProblem, public RResults
         std::vector<RUVector> surfaceNeigs;
         //! Volume neighbors.
         std::vector<RUVector> volumeNeigs;
+        //! Mesh topology (built on demand).
+        mutable RMeshTopology meshTopology;
         //! Display properties.
         RModelData modelData;
+        //! Compress data blocks in binary files.
+        bool binaryCompression;
 
     public:
 
@@ -126,12 +133,28 @@ class RModel : public RProblem, public RResults
         void update ( const RModel &rModel );
 
         //! Read mesh from the file.
-        void read ( const QString &fileName );
+        //! If lazyVariables is true variable values are read from the file
+        //! only when variable is first accessed.
+        void read ( const QString &fileName, bool lazyVariables = false );
 
         //! Write mesh to the file.
         //! Return actual filename to which the model was saved.
         QString write ( const QString &fileName, bool writeLinkFile = true ) const;
 
+        //! Write only results (time solver, problem setup and variables) to the file.
+        //! Mesh and remaining setup are referenced from the base record file.
+        //! Return actual filename to which the model was saved.
+        QString writeResults ( const QString &fileName, const QString &baseFileName ) const;
+
+        //! Return record filename to which the model would be saved.
+        QString getRecordFileName ( const QString &fileName ) const;
+
+        //! Return true if data blocks in binary files are compressed.
+        bool getBinaryCompression ( void ) const;
+
+        //! Set whether data blocks in binary files are compressed.
+        void setBinaryCompression ( bool binaryCompression );
+
         //! Export model to MSH (old range) model.
         void exportTo ( RModelMsh &modelMsh ) const;
 
@@ -257,6 +280,19 @@ class RModel : public RProblem, public RResults
         //! Purge unused nodes.
         uint purgeUnusedNodes();
 
+        //! Renumber nodes.
+        //! Node at position i is moved to position nodeBook[i] (nodeBook has to be a permutation).
+        void renumberNodes(const std::vector<uint> &nodeBook);
+
+        //! Find node book (old to new node ID) ordering nodes by reverse Cuthill-McKee algorithm.
+        std::vector<uint> findNodeBookRCM(void) const;
+
+        //! Find node book (old to new node ID) ordering nodes along Morton (Z-order) curve.
+        std::vector<uint> findNodeBookMorton(void) const;
+
+        //! Return maximum difference between node IDs of one element.
+        uint findNodeBandwidth(void) const;
+
         /*************************************************************
          * Element interface                                         *
          *************************************************************/
@@ -322,6 +358,14 @@ class RModel : public RProblem, public RResults
         std::vector<uint> findElementPositionsByNodeId
                                         ( uint nodeID ) const;
 
+        //! Return position of first (or last if findLast is true) element of given group type containing given node.
+        //! Element volumes (barycentric weights) are stored in volumes.
+        //! If no such element exists RConstants::eod is returned.
+        uint findElementContainingNode(const RNode &node,
+                                       REntityGroupTypeMask entityGroup,
+                                       RRVector &volumes,
+                                       bool findLast = false) const;
+
         //! Find line element size statistics.
         RStatistics findLineElementSizeStatistics() const;
 
@@ -334,6 +378,16 @@ class RModel : public RProblem, public RResults
         //! Purge unused elements.
         uint purgeUnusedElements();
 
+        //! Renumber elements.
+        //! Element at position i is moved to position elementBook[i] (elementBook has to be a permutation).
+        void renumberElements(const std::vector<uint> &elementBook);
+
+        //! Find element book (old to new element ID) ordering elements by their lowest node ID.
+        std::vector<uint> findElementBookByNodes(void) const;
+
+        //! Reorder nodes and elements to reduce matrix bandwidth and improve memory locality.
+        void reorder(RMeshReorderType reorderType);
+
         /*************************************************************
          * Interpolated element interface                            *
          *************************************************************/
@@ -814,6 +868,16 @@ class RModel : public RProblem, public RResults
         //! Check mesh consistency.
         RModelProblemTypeMask checkMesh(bool printOutput = true) const;
 
+        //! Return mesh topology.
+        //! Topology is built on first request and kept until element connectivity changes.
+        //! Must not be called for the first time from within parallel region.
+        const RMeshTopology & getMeshTopology ( void ) const;
+
+        //! Invalidate mesh topology.
+        //! Has to be called after element connectivity is modified through
+        //! non-const element accessors (getElement, getElementPtr, getElements).
+        void invalidateMeshTopology ( void );
+
         //! Return book vector of edge nodes.
         QVector<bool> findEdgeNodes( void ) const;
 
@@ -973,15 +1037,30 @@ class RModel : public RProblem, public RResults
         static void writeLink ( const QString &linkFileName,
                                 const QString &targetFileName );
 
+        //! Return time solver file name shared by all records of given model file.
+        static QString getTimeSolverFileName ( const QString &fileName );
+
+        //! Read time solver file.
+        static void readTimeSolver ( const QString &fileName,
+                                     RTimeSolver &timeSolver );
+
+        //! Write time solver file.
+        static void writeTimeSolver ( const QString &fileName,
+                                      const RTimeSolver &timeSolver );
+
     protected:
 
+        //! Read record file following links and base records.
+        void readRecord ( const QString &fileName, bool lazyVariables );
+
         //! Read from the ASCII file.
         //! If file is a link target filename is returned.
         QString readAscii ( const QString &fileName );
 
         //! Read from the binary file.
         //! If file is a link target filename is returned.
-        QString readBinary ( const QString &fileName );
+        //! If lazyVariables is true variable values are loaded on first access.
+        QString readBinary ( const QString &fileName, bool lazyVariables );
 
         //! Write to the ASCII file.
         void writeAscii ( const QString &fileName ) const;
@@ -989,6 +1068,36 @@ class RModel : public RProblem, public RResults
         //! Write to the binary file.
         void writeBinary ( const QString &fileName ) const;
 
+        //! Write results to the ASCII file.
+        void writeResultsAscii ( const QString &fileName, const QString &baseFileName ) const;
+
+        //! Write results to the binary file.
+        void writeResultsBinary ( const QString &fileName, const QString &baseFileName ) const;
+
+        //! Check that results read from results file match mesh read from base file.
+        void checkResultsSize ( const QString &fileName, const QString &baseFileName, uint nResultsNodes, uint nResultsElements ) const;
+
+        //! Read binary data block compression flag and set it to file.
+        void readBinaryCompression ( RFile &modelFile );
+
+        //! Write binary data block compression flag and set it to file.
+        void writeBinaryCompression ( RSaveFile &modelFile ) const;
+
+        //! Read binary table of contents (variable locations).
+        void readBinaryTableOfContents ( RFile &modelFile, std::vector<RVariableLocation> &variableLocations );
+
+        //! Write binary table of contents at given offset.
+        void writeBinaryTableOfContents ( RSaveFile &modelFile, qint64 tocOffset, const std::vector<RVariableLocation> &variableLocations ) const;
+
+        //! Read variables from binary file.
+        //! If lazyVariables is true and variable locations are known only
+        //! variable descriptions are read and values are loaded on first access.
+        void readBinaryVariables ( RFile &modelFile,
+                                   const QString &fileName,
+                                   uint nVariables,
+                                   const std::vector<RVariableLocation> &variableLocations,
+                                   bool lazyVariables );
+
     protected:
 
         //! Find surface neighbors book.
@@ -997,9 +1106,21 @@ class RModel : public RProblem, public RResults
         //! Find volume neighbors book.
         std::vector<RUVector> findVolumeNeighbors() const;
 
+        //! Find neighbors book for elements of given group type.
+        std::vector<RUVector> findNeighbors(REntityGroupType elementGroupType) const;
+
         //! Find volume elements neighbor position.
         uint findVolumeNeighborPosition(uint elementID, uint neighborID) const;
 
+        //! Breadth-first traversal of node graph from given start node.
+        //! Nodes of the last level are returned in lastLevel, return value is number of levels.
+        static uint findNodeGraphLastLevel(const std::vector<uint> &graphOffsets,
+                                           const std::vector<uint> &graph,
+                                           uint startNode,
+                                           uint stamp,
+                                           std::vector<uint> &levelStamp,
+                                           std::vector<uint> &lastLevel);
+
         //! Internal function to mark surfaces neighbors with the same mark as given surface.
         void markSurfaceNeighbors(uint                         elementID,
                                   double                       angle,
@@ -18,6 +18,7 @@
 
 #include "rml_node.h"
 #include "rml_element.h"
+#include "rml_text_parser.h"
 
 //! Raw triangulated surface class.
 class RModelRaw
@@ -123,6 +124,9 @@ class RModelRaw
 
     protected:
 
+        //! Read from text parser.
+        void readTextParser(RTextParser &textParser, double tolerance);
+
         //! Compute element normal.
         //! If possible true is returned otherwise false.
         bool getNormal ( unsigned int  elementID,
@@ -0,0 +1,119 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_node_element_incidence.h                             *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Node-element incidence class declaration            *
+ *********************************************************************/
+
+#ifndef RML_NODE_ELEMENT_INCIDENCE_H
+#define RML_NODE_ELEMENT_INCIDENCE_H
+
+#include <vector>
+
+#include <rblib.h>
+
+class RModel;
+
+//! Node to element incidence (compressed row storage).
+//! For every node list of incident elements is stored together with
+//! inverse node to element center distance weights which are used to
+//! convert element values to node values.
+//! Incident elements are stored in order volumes, surfaces, lines and
+//! points (same order in which element groups were traversed by original
+//! conversion functions) so that results are identical.
+class RNodeElementIncidence
+{
+
+    protected:
+
+        //! Number of nodes.
+        uint nNodes;
+        //! Number of elements.
+        uint nElements;
+        //! Offsets to incident element arrays (size = nNodes + 1).
+        std::vector<uint> nodeOffsets;
+        //! Incident element IDs.
+        std::vector<uint> elementIDs;
+        //! Incident element weights.
+        //! Weight is equal to zero if element does not contribute to node value.
+        std::vector<double> elementWeights;
+        //! Elements which receive values in node to element conversion.
+        std::vector<uint> convertibleElements;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RNodeElementIncidence *pNodeElementIncidence = nullptr);
+
+    public:
+
+        //! Constructor.
+        RNodeElementIncidence();
+
+        //! Copy constructor.
+        RNodeElementIncidence(const RNodeElementIncidence &nodeElementIncidence);
+
+        //! Destructor.
+        ~RNodeElementIncidence();
+
+        //! Assignment operator.
+        RNodeElementIncidence &operator =(const RNodeElementIncidence &nodeElementIncidence);
+
+        //! Build incidence from given model.
+        void build(const RModel &rModel);
+
+        //! Clear incidence.
+        void clear(void);
+
+        //! Return true if incidence was built for model with given number of nodes and elements.
+        bool isValid(uint nNodes, uint nElements) const;
+
+        //! Return number of nodes.
+        uint getNNodes(void) const;
+
+        //! Return number of elements.
+        uint getNElements(void) const;
+
+        //! Return number of elements incident with given node.
+        uint getNIncidentElements(uint nodeID) const;
+
+        //! Return ID of incident element at given position.
+        uint getIncidentElementID(uint nodeID, uint position) const;
+
+        //! Convert element values to node values.
+        void convertElementToNode(const RRVector &elementValues,
+                                  const RBVector &setValues,
+                                  RRVector &nodeValues,
+                                  bool onlySetValues = false) const;
+
+        //! Convert several element value vectors sharing same set values to node values in one pass.
+        void convertElementToNode(const std::vector<const RRVector*> &elementValues,
+                                  const RBVector &setValues,
+                                  const std::vector<RRVector*> &nodeValues,
+                                  bool onlySetValues = false) const;
+
+        //! Convert node values to element values.
+        void convertNodeToElement(const RModel &rModel,
+                                  const RRVector &nodeValues,
+                                  RRVector &elementValues) const;
+
+        //! Convert several node value vectors to element values in one pass.
+        void convertNodeToElement(const RModel &rModel,
+                                  const std::vector<const RRVector*> &nodeValues,
+                                  const std::vector<RRVector*> &elementValues) const;
+
+    protected:
+
+        //! Append element to incidence arrays.
+        void appendElement(const RModel &rModel,
+                           uint elementID,
+                           bool weighted,
+                           bool centerDistance,
+                           std::vector<uint> &nodePositions);
+
+};
+
+#endif // RML_NODE_ELEMENT_INCIDENCE_H
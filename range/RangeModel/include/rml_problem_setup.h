@@ -14,6 +14,22 @@
 #include "rml_mesh_setup.h"
 #include "rml_modal_setup.h"
 #include "rml_radiation_setup.h"
+#include "rml_problem_type.h"
+
+#define R_WARM_START_TYPE_IS_VALID(_type) \
+( \
+    _type >= R_WARM_START_NONE && \
+    _type < R_WARM_START_N_TYPES \
+)
+
+//! Matrix solver initial guess (warm start) type.
+typedef enum _RWarmStartType
+{
+    R_WARM_START_NONE = 0,
+    R_WARM_START_PREVIOUS,
+    R_WARM_START_EXTRAPOLATE,
+    R_WARM_START_N_TYPES
+} RWarmStartType;
 
 class RProblemSetup
 {
@@ -28,6 +44,12 @@ class RProblemSetup
         RModalSetup modalSetup;
         //! Mesh setup.
         RMeshSetup meshSetup;
+        //! Problem types for which matrix solver starts from previous solution.
+        RProblemTypeMask warmStartMask;
+        //! Problem types for which initial guess is extrapolated from two previous solutions.
+        RProblemTypeMask warmStartExtrapolationMask;
+        //! Problem types solved by segregated method (fluid only).
+        RProblemTypeMask segregatedMask;
 
     private:
 
@@ -81,6 +103,19 @@ class RProblemSetup
         //! Set mesh setup.
         void setMeshSetup(const RMeshSetup &meshSetup);
 
+        //! Return matrix solver warm start type for given problem type.
+        RWarmStartType getWarmStart(RProblemType problemType) const;
+
+        //! Set matrix solver warm start type for given problem type.
+        void setWarmStart(RProblemType problemType, RWarmStartType warmStartType);
+
+        //! Return true if given problem type is solved by segregated method.
+        bool getSegregated(RProblemType problemType) const;
+
+        //! Set whether given problem type is solved by segregated method.
+        //! Velocity and pressure equations are then solved one after another instead of as one coupled system.
+        void setSegregated(RProblemType problemType, bool segregated);
+
         //! Allow RFileIO to access private members.
         friend class RFileIO;
 
@@ -13,8 +13,10 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 
 #include "rml_variable.h"
+#include "rml_variable_loader.h"
 
 //! Results class.
 class RResults
@@ -33,8 +35,13 @@ class RResults
         unsigned int nelements;
 //        //! Current computational time / frequency (modal analysis).
 //        double compTime;
-        //! Variables.
-        std::vector<RVariable> variables;
+        //! Variables (values may be loaded on demand).
+        mutable std::vector<RVariable> variables;
+        //! Loader of variable values which were not read yet.
+        mutable std::shared_ptr<RVariableLoader> variableLoader;
+        //! Loader positions of variables whose values were not loaded yet.
+        //! RConstants::eod = values are loaded.
+        mutable RUVector variableLoadBook;
 
     public:
 
@@ -108,6 +115,14 @@ class RResults
         //! Remove node from results at give position.
         virtual void removeNode ( unsigned int position );
 
+        //! Remove nodes from results at give positions.
+        //! If nodeBook[i] == RConstants::eod then node will be removed.
+        void removeNodes(const std::vector<uint>&nodeBook);
+
+        //! Renumber nodes in results.
+        //! Node at position i is moved to position nodeBook[i].
+        void renumberNodes(const std::vector<uint>&nodeBook);
+
         //! Return number of elements.
         unsigned int getNElements ( void ) const;
 
@@ -124,6 +139,30 @@ class RResults
         //! If elementBook[i] == RConstants::eod then element will be removed.
         void removeElements(const std::vector<uint>&elementBook);
 
+        //! Renumber elements in results.
+        //! Element at position i is moved to position elementBook[i].
+        void renumberElements(const std::vector<uint>&elementBook);
+
+        //! Set loader of variable values.
+        //! Values of all variables will be read on first access.
+        void setVariableLoader(const std::shared_ptr<RVariableLoader> &variableLoader);
+
+        //! Return true if values of variable at given position are loaded.
+        bool isVariableLoaded ( unsigned int position ) const;
+
+        //! Load values of all variables which were not loaded yet.
+        void loadVariables(void) const;
+
+        //! If variable values are loaded from given file load all of them and release the loader.
+        //! Has to be called before the file is rewritten.
+        void releaseVariableLoader(const QString &fileName) const;
+
+    protected:
+
+        //! Load values of variable at given position if not loaded yet.
+        //! If values cannot be read error is thrown and variable stays unloaded.
+        void loadVariable ( unsigned int position ) const;
+
 };
 
 #endif /* RML_RESULTS_H */
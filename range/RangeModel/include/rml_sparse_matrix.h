@@ -59,6 +59,9 @@ class RSparseMatrix
         //! Return value at given row index and column position.
         double getValue(unsigned int rowIndex, unsigned int columnPosition) const;
 
+        //! Return column index at given row index and column position.
+        unsigned int getColumnIndex(unsigned int rowIndex, unsigned int columnPosition) const;
+
         //! Return vector of position indexes for given row index.
         std::vector<unsigned int> getRowIndexes(unsigned int rowIndex) const;
 
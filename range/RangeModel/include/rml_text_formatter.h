@@ -0,0 +1,61 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_text_formatter.h                                     *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Text formatter class declaration                    *
+ *********************************************************************/
+
+#ifndef RML_TEXT_FORMATTER_H
+#define RML_TEXT_FORMATTER_H
+
+#include <functional>
+
+#include <QByteArray>
+
+#include <rblib.h>
+
+#include "rml_save_file.h"
+
+//! Fast text formatter.
+//! Values are formatted into memory buffers exactly as QTextStream with
+//! default settings would format them. Large blocks of items are split
+//! into chunks which are formatted in parallel and written in order.
+class RTextFormatter
+{
+
+    private:
+
+        //! Private constructor.
+        explicit RTextFormatter () {}
+
+    public:
+
+        //! Function formatting single item into buffer.
+        typedef std::function<void(qint64 itemID, QByteArray &buffer)> FormatFunction;
+
+        //! Append double value.
+        //! Same as QTextStream (6 significant digits, smart notation).
+        static void appendValue(QByteArray &buffer, double value);
+
+        //! Append int value.
+        static void appendValue(QByteArray &buffer, int value);
+
+        //! Append unsigned int value.
+        static void appendValue(QByteArray &buffer, unsigned int value);
+
+        //! Format given number of items in parallel and write them to file in order.
+        static void writeBlock(RSaveFile &outFile, qint64 nItems, const FormatFunction &formatItem);
+
+    protected:
+
+        //! Find 6 significant digits of positive finite value.
+        //! Digits are rounded half up from exact binary value.
+        //! Return decimal exponent of the first digit.
+        static int findDigits(double value, unsigned int &digits);
+
+};
+
+#endif // RML_TEXT_FORMATTER_H
@@ -0,0 +1,164 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_text_parser.h                                        *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Text parser class declaration                       *
+ *********************************************************************/
+
+#ifndef RML_TEXT_PARSER_H
+#define RML_TEXT_PARSER_H
+
+#include <vector>
+#include <chrono>
+
+#include <QString>
+#include <QByteArray>
+#include <QFile>
+
+#include <rblib.h>
+
+//! Fast text parser.
+//! Whole file is memory mapped (or read into memory if mapping is not
+//! possible) and parsed directly from the buffer. Numbers are parsed
+//! independently of the current locale. Large blocks of numbers and line
+//! ranges are split into chunks at whitespace/line boundaries and parsed
+//! in parallel.
+class RTextParser
+{
+
+    protected:
+
+        //! File.
+        QFile file;
+        //! Mapped file memory.
+        uchar *pMap;
+        //! Buffer used if file could not be mapped.
+        QByteArray buffer;
+        //! Pointer to data.
+        const char *pData;
+        //! Data size.
+        qint64 size;
+        //! Current position.
+        qint64 position;
+        //! Parsing start time.
+        std::chrono::steady_clock::time_point startTime;
+
+    private:
+
+        //! Copy constructor (not allowed).
+        RTextParser(const RTextParser &textParser);
+
+        //! Assignment operator (not allowed).
+        RTextParser & operator =(const RTextParser &textParser);
+
+    public:
+
+        //! Constructor (file).
+        explicit RTextParser(const QString &fileName);
+
+        //! Constructor (data in memory).
+        explicit RTextParser(const QByteArray &data);
+
+        //! Destructor.
+        ~RTextParser();
+
+        //! Return pointer to data.
+        const char *getData(void) const;
+
+        //! Return data size.
+        qint64 getSize(void) const;
+
+        //! Return current position.
+        qint64 getPosition(void) const;
+
+        //! Set current position.
+        void setPosition(qint64 position);
+
+        //! Return true if there is no other token.
+        bool atEnd(void);
+
+        //! Read next whitespace separated token.
+        //! Return false if end of data was reached.
+        bool readToken(QString &token);
+
+        //! Read rest of the current line (without line end).
+        //! Return false if end of data was reached.
+        bool readLine(QString &line);
+
+        //! Read string value (may be enclosed in double quotes).
+        void readValue(QString &sValue);
+
+        //! Read bool value.
+        void readValue(bool &bValue);
+
+        //! Read int value.
+        void readValue(int &iValue);
+
+        //! Read unsigned int value.
+        void readValue(unsigned int &uValue);
+
+        //! Read double value.
+        void readValue(double &dValue);
+
+        //! Read vector values (size is given by vector size).
+        void readValues(RRVector &rVector);
+
+        //! Read matrix values (size is given by matrix size).
+        void readValues(RRMatrix &rMatrix);
+
+        //! Read matrix values (size is given by matrix size).
+        void readValues(RIMatrix &iMatrix);
+
+        //! Read given number of double values.
+        void readValues(double *values, qint64 nValues);
+
+        //! Read given number of int values.
+        void readValues(int *values, qint64 nValues);
+
+        //! Find offsets of line beginnings.
+        //! Last offset is equal to data size.
+        void findLineOffsets(std::vector<qint64> &lineOffsets) const;
+
+        //! Split line range into chunks for parallel processing.
+        //! Return chunk boundaries (line indexes).
+        static std::vector<qint64> findChunks(qint64 nItems);
+
+        //! Split data range into chunks for parallel processing.
+        //! Chunk boundaries (data offsets) are placed on whitespace so that no token is split.
+        static std::vector<qint64> findTokenChunks(const char *pData, qint64 begin, qint64 end);
+
+        //! Print parsing throughput.
+        void printThroughput(void) const;
+
+        //! Return true if character is a whitespace.
+        static inline bool isSpace(char c)
+        {
+            return (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\v' || c == '\f');
+        }
+
+        //! Match (case insensitive) whitespace terminated token.
+        //! On success pointer is moved after matched token.
+        static bool matchToken(const char *&pBegin, const char *pEnd, const char *token);
+
+        //! Parse double value from given string.
+        //! On success pointer is moved after parsed value.
+        static bool parseDouble(const char *&pBegin, const char *pEnd, double &value);
+
+        //! Parse int value from given string.
+        //! On success pointer is moved after parsed value.
+        static bool parseInt(const char *&pBegin, const char *pEnd, int &value);
+
+    protected:
+
+        //! Skip whitespace.
+        void skipSpace(void);
+
+        //! Find end of block containing given number of tokens.
+        qint64 findTokensEnd(qint64 begin, qint64 nTokens) const;
+
+};
+
+#endif // RML_TEXT_PARSER_H
@@ -288,6 +288,10 @@ class RVariable
         //! If valueBook[i] == RConstants::eod then value will be removed.
         void removeValues(const std::vector<uint> &valueBook);
 
+        //! Renumber values in all vectors.
+        //! Value at position i is moved to position valueBook[i].
+        void renumberValues(const std::vector<uint> &valueBook);
+
         //! Return const reference to variable data.
         const RVariableData & getVariableData ( void ) const;
 
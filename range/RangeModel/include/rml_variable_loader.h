@@ -0,0 +1,95 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_variable_loader.h                                    *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Variable loader class declaration                   *
+ *********************************************************************/
+
+#ifndef RML_VARIABLE_LOADER_H
+#define RML_VARIABLE_LOADER_H
+
+#include <vector>
+#include <mutex>
+
+#include <QString>
+#include <QDateTime>
+
+#include <rblib.h>
+
+#include "rml_variable.h"
+
+//! Location of variable in binary file.
+typedef struct _RVariableLocation
+{
+    //! Offset of variable value vectors.
+    qint64 valuesOffset;
+    //! Offset of variable data (follows value vectors).
+    qint64 dataOffset;
+} RVariableLocation;
+
+//! Variable loader.
+//! Holds locations of variable values in binary record file so that
+//! values can be read on demand when variable is first accessed.
+//! Locations are valid only as long as the file is not rewritten, loading
+//! fails if file size or modification time has changed since construction.
+class RVariableLoader
+{
+
+    protected:
+
+        //! File name.
+        QString fileName;
+        //! File version.
+        RVersion fileVersion;
+        //! Binary data blocks are compressed.
+        bool compressed;
+        //! Variable locations.
+        std::vector<RVariableLocation> locations;
+        //! File size at construction.
+        qint64 fileSize;
+        //! File modification time at construction.
+        QDateTime fileLastModified;
+        //! Loading mutex.
+        std::mutex mutex;
+
+    private:
+
+        //! Copy constructor (not allowed).
+        RVariableLoader(const RVariableLoader &variableLoader);
+
+        //! Assignment operator (not allowed).
+        RVariableLoader & operator =(const RVariableLoader &variableLoader);
+
+    public:
+
+        //! Constructor.
+        RVariableLoader(const QString &fileName,
+                        const RVersion &fileVersion,
+                        bool compressed,
+                        const std::vector<RVariableLocation> &locations);
+
+        //! Return file name.
+        const QString &getFileName(void) const;
+
+        //! Return true if loader reads from given file.
+        bool isFile(const QString &fileName) const;
+
+        //! Return true if file was not modified since construction.
+        bool isFileUnchanged(void) const;
+
+        //! Return number of variables.
+        uint getNVariables(void) const;
+
+        //! Return reference to loading mutex.
+        std::mutex &getMutex(void);
+
+        //! Read values of variable at given position.
+        //! Values are read into value vectors already present in variable.
+        void load(uint position, RVariable &variable) const;
+
+};
+
+#endif // RML_VARIABLE_LOADER_H
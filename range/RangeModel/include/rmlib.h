@@ -15,6 +15,7 @@
 #include "rml_condition.h"
 #include "rml_condition_component.h"
 #include "rml_cut.h"
+#include "rml_edge_collapse.h"
 #include "rml_eigen_value_solver_conf.h"
 #include "rml_element.h"
 #include "rml_element_group.h"
@@ -26,6 +27,7 @@
 #include "rml_file_io.h"
 #include "rml_file.h"
 #include "rml_file_manager.h"
+#include "rml_geometry_packet.h"
 #include "rml_gl_display_properties.h"
 #include "rml_initial_condition.h"
 #include "rml_interpolated_element.h"
@@ -39,6 +41,7 @@
 #include "rml_mesh_generator.h"
 #include "rml_mesh_input.h"
 #include "rml_mesh_setup.h"
+#include "rml_mesh_topology.h"
 #include "rml_modal_setup.h"
 #include "rml_model_data.h"
 #include "rml_model.h"
@@ -48,6 +51,7 @@
 #include "rml_monitoring_point_manager.h"
 #include "rml_monitoring_point.h"
 #include "rml_node.h"
+#include "rml_node_element_incidence.h"
 #include "rml_patch.h"
 #include "rml_patch_book.h"
 #include "rml_patch_input.h"
@@ -67,11 +71,14 @@
 #include "rml_stream_line.h"
 #include "rml_surface.h"
 #include "rml_tetrahedron.h"
+#include "rml_text_formatter.h"
+#include "rml_text_parser.h"
 #include "rml_time_solver.h"
 #include "rml_triangle.h"
 #include "rml_triangulate.h"
 #include "rml_variable.h"
 #include "rml_variable_data.h"
+#include "rml_variable_loader.h"
 #include "rml_vector_field.h"
 #include "rml_view_factor_matrix.h"
 #include "rml_view_factor_matrix_header.h"
@@ -0,0 +1,302 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_edge_collapse.cpp                                    *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Edge collapse class definition                      *
+ *********************************************************************/
+
+#include <algorithm>
+
+#include "rml_edge_collapse.h"
+
+typedef std::priority_queue<REdgeCollapseItem,std::vector<REdgeCollapseItem>,std::greater<REdgeCollapseItem> > REdgeCollapseQueue;
+
+void REdgeCollapse::_init(const REdgeCollapse *pEdgeCollapse)
+{
+    if (pEdgeCollapse)
+    {
+        this->nodes = pEdgeCollapse->nodes;
+        this->elements = pEdgeCollapse->elements;
+        this->nodeElements = pEdgeCollapse->nodeElements;
+        this->candidateBook = pEdgeCollapse->candidateBook;
+        this->collapsedBook = pEdgeCollapse->collapsedBook;
+        this->mergedBook = pEdgeCollapse->mergedBook;
+        this->elementVersions = pEdgeCollapse->elementVersions;
+        this->edgeLengthLimit = pEdgeCollapse->edgeLengthLimit;
+        this->elementAreaLimit = pEdgeCollapse->elementAreaLimit;
+        this->edgeRatioLimit = pEdgeCollapse->edgeRatioLimit;
+        this->allowDowngrade = pEdgeCollapse->allowDowngrade;
+    }
+}
+
+REdgeCollapse::REdgeCollapse(const std::vector<RNode> &nodes, const std::vector<RElement> &elements, bool allowDowngrade)
+    : nodes(nodes)
+    , elements(elements)
+    , edgeLengthLimit(0.0)
+    , elementAreaLimit(0.0)
+    , edgeRatioLimit(0.0)
+    , allowDowngrade(allowDowngrade)
+{
+    this->_init();
+
+    this->candidateBook.resize(this->elements.size(),true);
+    this->collapsedBook.resize(this->elements.size(),false);
+    this->mergedBook.resize(this->nodes.size(),false);
+    this->elementVersions.resize(this->elements.size(),0);
+
+    this->nodeElements.resize(this->nodes.size());
+    for (uint i=0;i<this->elements.size();i++)
+    {
+        for (uint j=0;j<this->elements[i].size();j++)
+        {
+            RUVector &rNodeElements = this->nodeElements[this->elements[i].getNodeId(j)];
+            if (rNodeElements.empty() || rNodeElements.back() != i)
+            {
+                rNodeElements.push_back(i);
+            }
+        }
+    }
+}
+
+REdgeCollapse::REdgeCollapse(const REdgeCollapse &edgeCollapse)
+{
+    this->_init(&edgeCollapse);
+}
+
+REdgeCollapse::~REdgeCollapse()
+{
+
+}
+
+REdgeCollapse &REdgeCollapse::operator =(const REdgeCollapse &edgeCollapse)
+{
+    this->_init(&edgeCollapse);
+    return (*this);
+}
+
+void REdgeCollapse::setCandidates(const RBVector &candidateBook)
+{
+    R_ERROR_ASSERT(candidateBook.size() == this->elements.size());
+    this->candidateBook = candidateBook;
+}
+
+void REdgeCollapse::setEdgeLengthLimit(double edgeLengthLimit)
+{
+    this->edgeLengthLimit = edgeLengthLimit;
+}
+
+void REdgeCollapse::setElementAreaLimit(double elementAreaLimit)
+{
+    this->elementAreaLimit = elementAreaLimit;
+}
+
+void REdgeCollapse::setEdgeRatioLimit(double edgeRatioLimit)
+{
+    this->edgeRatioLimit = edgeRatioLimit;
+}
+
+uint REdgeCollapse::collapse(void)
+{
+    REdgeCollapseQueue queue;
+
+    for (uint i=0;i<this->elements.size();i++)
+    {
+        this->queueElement(i,queue);
+    }
+
+    uint nCollapsed = 0;
+
+    while (!queue.empty())
+    {
+        REdgeCollapseItem item = queue.top();
+        queue.pop();
+
+        // Skip items which were queued before element was changed.
+        if (this->collapsedBook[item.elementID] || item.version != this->elementVersions[item.elementID])
+        {
+            continue;
+        }
+
+        double cost = 0.0;
+        uint node1 = RConstants::eod;
+        uint node2 = RConstants::eod;
+        if (!this->findCollapseEdge(item.elementID,cost,node1,node2))
+        {
+            continue;
+        }
+
+        RProgressPrint(1.0);
+
+        this->mergeNodes(std::min(node1,node2),std::max(node1,node2));
+        nCollapsed++;
+
+        // Re-queue all elements which share the remaining node.
+        const RUVector &rNodeElements = this->nodeElements[std::min(node1,node2)];
+        for (uint i=0;i<rNodeElements.size();i++)
+        {
+            this->queueElement(rNodeElements[i],queue);
+        }
+    }
+
+    return nCollapsed;
+}
+
+const std::vector<RNode> &REdgeCollapse::getNodes(void) const
+{
+    return this->nodes;
+}
+
+const std::vector<RElement> &REdgeCollapse::getElements(void) const
+{
+    return this->elements;
+}
+
+const RBVector &REdgeCollapse::getCollapsedBook(void) const
+{
+    return this->collapsedBook;
+}
+
+const RBVector &REdgeCollapse::getMergedBook(void) const
+{
+    return this->mergedBook;
+}
+
+bool REdgeCollapse::findEdgeLengths(const RElement &rElement, const std::vector<RNode> &nodes, double &lMin, double &lMax, uint &node1, uint &node2)
+{
+    lMax = 0.0;
+    lMin = 0.0;
+    bool firstTime = true;
+    node1 = RConstants::eod;
+    node2 = RConstants::eod;
+    for (uint j=0;j<rElement.size();j++)
+    {
+        for (uint k=j+1;k<rElement.size();k++)
+        {
+            double distance = nodes[rElement.getNodeId(j)].getDistance(nodes[rElement.getNodeId(k)]);
+            if (firstTime)
+            {
+                lMax = lMin = distance;
+                node1 = rElement.getNodeId(j);
+                node2 = rElement.getNodeId(k);
+                firstTime = false;
+            }
+            else
+            {
+                lMax = std::max(lMax,distance);
+                if (lMin > distance)
+                {
+                    lMin = distance;
+                    node1 = rElement.getNodeId(j);
+                    node2 = rElement.getNodeId(k);
+                }
+            }
+        }
+    }
+
+    return !(node1 == RConstants::eod || node2 == RConstants::eod || node1 == node2);
+}
+
+bool REdgeCollapse::findCollapseEdge(uint elementID, double &cost, uint &node1, uint &node2) const
+{
+    if (!this->candidateBook[elementID] || this->collapsedBook[elementID])
+    {
+        return false;
+    }
+
+    const RElement &rElement = this->elements[elementID];
+
+    double lMin = 0.0;
+    double lMax = 0.0;
+    if (!REdgeCollapse::findEdgeLengths(rElement,this->nodes,lMin,lMax,node1,node2))
+    {
+        return false;
+    }
+
+    cost = lMin;
+
+    if (lMin < this->edgeLengthLimit)
+    {
+        return true;
+    }
+    if (this->elementAreaLimit > 0.0)
+    {
+        double area = 0.0;
+        if (rElement.findArea(this->nodes,area) && area < this->elementAreaLimit)
+        {
+            return true;
+        }
+    }
+    if (this->edgeRatioLimit > 0.0)
+    {
+        if (lMin <= RConstants::eps || (lMax/lMin) >= this->edgeRatioLimit)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void REdgeCollapse::queueElement(uint elementID, REdgeCollapseQueue &queue) const
+{
+    REdgeCollapseItem item;
+    uint node1 = RConstants::eod;
+    uint node2 = RConstants::eod;
+    if (this->findCollapseEdge(elementID,item.cost,node1,node2))
+    {
+        item.elementID = elementID;
+        item.version = this->elementVersions[elementID];
+        queue.push(item);
+    }
+}
+
+void REdgeCollapse::mergeNodes(uint node1, uint node2)
+{
+    R_ERROR_ASSERT(node1 != node2);
+
+    this->nodes[node1].set((this->nodes[node1].getX() + this->nodes[node2].getX())/2.0,
+                           (this->nodes[node1].getY() + this->nodes[node2].getY())/2.0,
+                           (this->nodes[node1].getZ() + this->nodes[node2].getZ())/2.0);
+    this->mergedBook[node2] = true;
+
+    RUVector &rNodeElements1 = this->nodeElements[node1];
+    RUVector &rNodeElements2 = this->nodeElements[node2];
+
+    for (uint i=0;i<rNodeElements2.size();i++)
+    {
+        uint elementID = rNodeElements2[i];
+        if (this->collapsedBook[elementID])
+        {
+            continue;
+        }
+        RElement &rElement = this->elements[elementID];
+        rElement.mergeNodes(node1,node2,this->allowDowngrade);
+        if (!this->allowDowngrade && rElement.hasDuplicateNodes())
+        {
+            this->collapsedBook[elementID] = true;
+            continue;
+        }
+        rNodeElements1.push_back(elementID);
+    }
+    rNodeElements2.clear();
+    rNodeElements2.shrink_to_fit();
+
+    // Remove duplicate and collapsed elements and mark all remaining elements as changed.
+    std::sort(rNodeElements1.begin(),rNodeElements1.end());
+    rNodeElements1.erase(std::unique(rNodeElements1.begin(),rNodeElements1.end()),rNodeElements1.end());
+
+    uint nKept = 0;
+    for (uint i=0;i<rNodeElements1.size();i++)
+    {
+        uint elementID = rNodeElements1[i];
+        if (this->collapsedBook[elementID])
+        {
+            continue;
+        }
+        this->elementVersions[elementID]++;
+        rNodeElements1[nKept++] = elementID;
+    }
+    rNodeElements1.resize(nKept);
+}
@@ -14,6 +14,7 @@
 
 #include "rml_element.h"
 #include "rml_element_shape_function.h"
+#include "rml_geometry_packet.h"
 #include "rml_interpolated_element.h"
 #include "rml_triangle.h"
 #include "rml_tetrahedron.h"
@@ -668,12 +669,23 @@ bool RElement::findPickDistance(const std::vector<RNode> &nodes,
     else if (R_ELEMENT_TYPE_IS_SURFACE(this->type))
     {
         std::vector<RTriangle> triangles = this->triangulate(nodes);
+        RTrianglePacket trianglePacket;
+        double u[R_GEOMETRY_PACKET_SIZE];
         for (uint i=0;i<triangles.size();i++)
         {
-            RR3Vector x;
-            if (triangles[i].findLineIntersection(position,direction,x,distance))
+            trianglePacket.add(triangles[i]);
+            if (trianglePacket.isFull() || i+1 == triangles.size())
             {
-                return true;
+                uint hitMask = trianglePacket.findLineIntersections(position,direction,u);
+                for (uint l=0;l<trianglePacket.size();l++)
+                {
+                    if (hitMask & (1u << l))
+                    {
+                        distance = u[l];
+                        return true;
+                    }
+                }
+                trianglePacket.clear();
             }
         }
     }
@@ -1341,6 +1353,32 @@ double RElement::findJacobian(const std::vector<RNode> &nodes, unsigned int iPoi
 } /* RElement::findJacobian */
 
 
+double RElement::findJacobian(const std::vector<RNode> &nodes, unsigned int iPoint, RFixedMatrix<3,3> &J) const
+{
+    R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(this->getType()));
+
+    const RRMatrix &dN = RElement::getShapeFunction(this->getType(),iPoint).getDN();
+
+    J.fill(0.0);
+
+    for (unsigned int k=0;k<dN.getNRows();k++)
+    {
+        const RNode &node = nodes[this->getNodeId(k)];
+        for (unsigned int i=0;i<3;i++)
+        {
+            J[i][0] += dN[k][i]*node.getX();
+            J[i][1] += dN[k][i]*node.getY();
+            J[i][2] += dN[k][i]*node.getZ();
+        }
+    }
+
+    double detJ = J.getDeterminant();
+    J.invert();
+
+    return detJ;
+} /* RElement::findJacobian */
+
+
 unsigned int RElement::findIntersectedSide(const std::vector<RNode> &nodes,
                                            const RR3Vector &position,
                                            const RR3Vector &direction,
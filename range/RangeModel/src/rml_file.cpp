@@ -17,6 +17,7 @@ void RFile::_init(const RFile *pFile)
         this->fileName = pFile->fileName;
         this->type = pFile->type;
         this->fileVersion = pFile->fileVersion;
+        this->compressed = pFile->compressed;
 //        this->textStream = pFile->textStream;
     }
     if (this->type == RFile::ASCII)
@@ -30,6 +31,7 @@ RFile::RFile(const QString &fileName, RFile::Type type)
     , fileName(fileName)
     , type(type)
     , fileVersion(RVersion(0,0,0))
+    , compressed(false)
 {
     this->_init();
 }
@@ -61,6 +63,16 @@ void RFile::setVersion(const RVersion &fileVersion)
     this->fileVersion = fileVersion;
 }
 
+bool RFile::getCompressed(void) const
+{
+    return this->compressed;
+}
+
+void RFile::setCompressed(bool compressed)
+{
+    this->compressed = compressed;
+}
+
 QTextStream &RFile::getTextStream(void)
 {
     return this->textStream;
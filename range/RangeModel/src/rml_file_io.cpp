@@ -8,7 +8,16 @@
  *  DESCRIPTION: File IO operation functions definitions             *
  *********************************************************************/
 
+#include <cstring>
+#include <algorithm>
+#include <limits>
+
 #include "rml_file_io.h"
+#include "rml_text_formatter.h"
+
+
+// Arrays with fewer items are written value by value through text stream.
+static const unsigned int asciiBlockMinSize = 1024;
 
 
 void RFileIO::writeNewLineAscii(RSaveFile &outFile)
@@ -21,6 +30,228 @@ void RFileIO::writeNewLineAscii(RSaveFile &outFile)
 } /* RFileIO::writeNewLineAscii */
 
 
+/*********************************************************************
+ *  Raw data block                                                   *
+ *********************************************************************/
+
+
+// Compressed block is split into chunks of fixed size (rounded down to
+// whole elements) which are encoded independently:
+//   uint nChunks
+//   uint storedSize[nChunks]
+//   chunk data
+// Chunk data are stored as they are if storedSize is equal to chunk size,
+// otherwise they contain XOR-delta of consecutive elements with bytes of
+// same significance grouped together, compressed with qCompress().
+static const qint64 compressedChunkSize = 1024*1024;
+// Blocks smaller than this are never compressed.
+static const qint64 compressedBlockMinSize = 4096;
+// Fast compression level is used to keep write throughput high.
+static const int compressionLevel = 1;
+
+
+static void encodeChunk(const uchar *data, qint64 nBytes, qint64 elementSize, QByteArray &encoded)
+{
+    qint64 nElements = nBytes / elementSize;
+    qint64 nTailBytes = nBytes - nElements * elementSize;
+
+    QByteArray shuffled(int(nBytes),0);
+    uchar *pShuffled = (uchar*)shuffled.data();
+    for (qint64 b=0;b<elementSize;b++)
+    {
+        uchar previous = 0;
+        for (qint64 j=0;j<nElements;j++)
+        {
+            uchar current = data[j*elementSize+b];
+            pShuffled[b*nElements+j] = current ^ previous;
+            previous = current;
+        }
+    }
+    for (qint64 j=nBytes-nTailBytes;j<nBytes;j++)
+    {
+        pShuffled[j] = data[j];
+    }
+
+    encoded = qCompress(shuffled,compressionLevel);
+    if (qint64(encoded.size()) >= nBytes)
+    {
+        encoded = QByteArray((const char*)data,int(nBytes));
+    }
+}
+
+
+static bool decodeChunk(const uchar *encoded, qint64 nEncodedBytes, qint64 elementSize, uchar *data, qint64 nBytes)
+{
+    if (nEncodedBytes == nBytes)
+    {
+        std::memcpy(data,encoded,size_t(nBytes));
+        return true;
+    }
+
+    QByteArray shuffled = qUncompress(encoded,int(nEncodedBytes));
+    if (qint64(shuffled.size()) != nBytes)
+    {
+        return false;
+    }
+
+    qint64 nElements = nBytes / elementSize;
+    qint64 nTailBytes = nBytes - nElements * elementSize;
+
+    const uchar *pShuffled = (const uchar*)shuffled.constData();
+    for (qint64 b=0;b<elementSize;b++)
+    {
+        uchar previous = 0;
+        for (qint64 j=0;j<nElements;j++)
+        {
+            previous ^= pShuffled[b*nElements+j];
+            data[j*elementSize+b] = previous;
+        }
+    }
+    for (qint64 j=nBytes-nTailBytes;j<nBytes;j++)
+    {
+        data[j] = pShuffled[j];
+    }
+    return true;
+}
+
+
+void RFileIO::readBinaryBlock(RFile &inFile, void *data, qint64 nBytes, qint64 elementSize)
+{
+    if (nBytes == 0)
+    {
+        return;
+    }
+    if (!inFile.getCompressed() || nBytes < compressedBlockMinSize)
+    {
+        if (inFile.read((char*)data,nBytes) != nBytes || inFile.error() != RFile::NoError)
+        {
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read data block.");
+        }
+        return;
+    }
+
+    qint64 chunkSize = std::max(compressedChunkSize / elementSize,qint64(1)) * elementSize;
+    qint64 nChunks = (nBytes + chunkSize - 1) / chunkSize;
+
+    if (chunkSize > qint64(std::numeric_limits<int>::max()))
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Compressed data block element is too large (%lld bytes).",(long long)elementSize);
+    }
+
+    unsigned int nStoredChunks = 0;
+    RFileIO::readBinary(inFile,nStoredChunks);
+    if (qint64(nStoredChunks) != nChunks)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Invalid number of compressed chunks (%u != %lld).",nStoredChunks,(long long)nChunks);
+    }
+
+    std::vector<unsigned int> storedSizes(nChunks);
+    if (inFile.read((char*)storedSizes.data(),nChunks*qint64(sizeof(unsigned int))) != nChunks*qint64(sizeof(unsigned int)))
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read compressed chunk sizes.");
+    }
+
+    std::vector<qint64> offsets(nChunks+1,0);
+    for (qint64 i=0;i<nChunks;i++)
+    {
+        if (qint64(storedSizes[i]) > qint64(std::numeric_limits<int>::max()))
+        {
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Invalid compressed chunk size (chunk %lld).",(long long)i);
+        }
+        offsets[i+1] = offsets[i] + qint64(storedSizes[i]);
+    }
+
+    // Encoded data are held in std::vector, QByteArray is limited to 2 GB.
+    std::vector<char> encoded(size_t(offsets[nChunks]),0);
+    if (inFile.read(encoded.data(),offsets[nChunks]) != offsets[nChunks] || inFile.error() != RFile::NoError)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read compressed data block.");
+    }
+
+    const uchar *pEncoded = (const uchar*)encoded.data();
+    uchar *pData = (uchar*)data;
+    std::vector<char> decoded(nChunks,0);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        qint64 chunkBegin = i * chunkSize;
+        decoded[i] = decodeChunk(pEncoded + offsets[i],qint64(storedSizes[i]),elementSize,pData + chunkBegin,std::min(chunkSize,nBytes - chunkBegin));
+    }
+
+    for (qint64 i=0;i<nChunks;i++)
+    {
+        if (!decoded[i])
+        {
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to decompress data block (chunk %lld).",(long long)i);
+        }
+    }
+} /* RFileIO::readBinaryBlock */
+
+
+void RFileIO::writeBinaryBlock(RSaveFile &outFile, const void *data, qint64 nBytes, qint64 elementSize)
+{
+    if (nBytes == 0)
+    {
+        return;
+    }
+    if (!outFile.getCompressed() || nBytes < compressedBlockMinSize)
+    {
+        if (outFile.write((const char*)data,nBytes) != nBytes || outFile.error() != RFile::NoError)
+        {
+            throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write data block.");
+        }
+        return;
+    }
+
+    qint64 chunkSize = std::max(compressedChunkSize / elementSize,qint64(1)) * elementSize;
+    qint64 nChunks = (nBytes + chunkSize - 1) / chunkSize;
+
+    // Every chunk is encoded into its own QByteArray which is limited to 2 GB.
+    if (chunkSize > qint64(std::numeric_limits<int>::max()))
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Compressed data block element is too large (%lld bytes).",(long long)elementSize);
+    }
+    if (nChunks > qint64(std::numeric_limits<unsigned int>::max()))
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Compressed data block is too large (%lld bytes).",(long long)nBytes);
+    }
+
+    const uchar *pData = (const uchar*)data;
+    std::vector<QByteArray> encoded(nChunks);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        qint64 chunkBegin = i * chunkSize;
+        encodeChunk(pData + chunkBegin,std::min(chunkSize,nBytes - chunkBegin),elementSize,encoded[i]);
+    }
+
+    std::vector<unsigned int> storedSizes(nChunks);
+    qint64 nStoredBytes = 0;
+    for (qint64 i=0;i<nChunks;i++)
+    {
+        storedSizes[i] = (unsigned int)encoded[i].size();
+        nStoredBytes += qint64(storedSizes[i]);
+    }
+
+    RFileIO::writeBinary(outFile,(unsigned int)nChunks);
+    if (outFile.write((const char*)storedSizes.data(),nChunks*qint64(sizeof(unsigned int))) != nChunks*qint64(sizeof(unsigned int)))
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write compressed chunk sizes.");
+    }
+    for (qint64 i=0;i<nChunks;i++)
+    {
+        if (outFile.write(encoded[i].constData(),encoded[i].size()) != encoded[i].size() || outFile.error() != RFile::NoError)
+        {
+            throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write compressed data block.");
+        }
+    }
+
+    RLogger::trace("Compressed data block %lld -> %lld bytes\n",(long long)nBytes,(long long)nStoredBytes);
+} /* RFileIO::writeBinaryBlock */
+
+
 /*********************************************************************
  *  bool                                                             *
  *********************************************************************/
@@ -516,12 +747,26 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RIVector &iVector, bool write
             RFileIO::writeAscii(outFile,' ',false);
         }
     }
-    for (unsigned int i=0;i<nr;i++)
+    if (nr >= asciiBlockMinSize)
     {
-        RFileIO::writeAscii(outFile,iVector[i], false);
-        if (i+1 < nr)
+        RTextFormatter::writeBlock(outFile,nr,[&](qint64 i, QByteArray &buffer)
         {
-            RFileIO::writeAscii(outFile,' ', false);
+            RTextFormatter::appendValue(buffer,iVector[i]);
+            if (i+1 < nr)
+            {
+                buffer.append(' ');
+            }
+        });
+    }
+    else
+    {
+        for (unsigned int i=0;i<nr;i++)
+        {
+            RFileIO::writeAscii(outFile,iVector[i], false);
+            if (i+1 < nr)
+            {
+                RFileIO::writeAscii(outFile,' ', false);
+            }
         }
     }
     if (addNewLine)
@@ -583,10 +828,7 @@ void RFileIO::readBinary(RFile &inFile, RUVector &uVector, bool readSize)
     {
         nr = uVector.getNRows();
     }
-    for (unsigned int i=0;i<nr;i++)
-    {
-        RFileIO::readBinary(inFile,uVector[i]);
-    }
+    RFileIO::readBinaryBlock(inFile,uVector.data(),qint64(nr)*qint64(sizeof(unsigned int)),sizeof(unsigned int));
 } /* RFileIO::readBinary */
 
 
@@ -605,12 +847,26 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RUVector &uVector, bool write
             RFileIO::writeAscii(outFile,' ',false);
         }
     }
-    for (unsigned int i=0;i<nr;i++)
+    if (nr >= asciiBlockMinSize)
+    {
+        RTextFormatter::writeBlock(outFile,nr,[&](qint64 i, QByteArray &buffer)
+        {
+            RTextFormatter::appendValue(buffer,uVector[i]);
+            if (i+1 < nr)
+            {
+                buffer.append(' ');
+            }
+        });
+    }
+    else
     {
-        RFileIO::writeAscii(outFile,uVector[i], false);
-        if (i+1 < nr)
+        for (unsigned int i=0;i<nr;i++)
         {
-            RFileIO::writeAscii(outFile,' ', false);
+            RFileIO::writeAscii(outFile,uVector[i], false);
+            if (i+1 < nr)
+            {
+                RFileIO::writeAscii(outFile,' ', false);
+            }
         }
     }
     if (addNewLine)
@@ -627,10 +883,7 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RUVector &uVector, bool writ
     {
         RFileIO::writeBinary(outFile,nr);
     }
-    for (unsigned int i=0;i<nr;i++)
-    {
-        RFileIO::writeBinary(outFile,uVector[i]);
-    }
+    RFileIO::writeBinaryBlock(outFile,uVector.data(),qint64(nr)*qint64(sizeof(unsigned int)),sizeof(unsigned int));
 } /* RFileIO::writeBinary */
 
 
@@ -672,10 +925,7 @@ void RFileIO::readBinary(RFile &inFile, RRVector &rVector, bool readSize)
     {
         nr = rVector.getNRows();
     }
-    for (unsigned int i=0;i<nr;i++)
-    {
-        RFileIO::readBinary(inFile,rVector[i]);
-    }
+    RFileIO::readBinaryBlock(inFile,rVector.data(),qint64(nr)*qint64(sizeof(double)),sizeof(double));
 } /* RFileIO::readBinary */
 
 
@@ -690,12 +940,26 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RRVector &rVector, bool write
             RFileIO::writeAscii(outFile,' ',false);
         }
     }
-    for (unsigned int i=0;i<nr;i++)
+    if (nr >= asciiBlockMinSize)
+    {
+        RTextFormatter::writeBlock(outFile,nr,[&](qint64 i, QByteArray &buffer)
+        {
+            RTextFormatter::appendValue(buffer,rVector[i]);
+            if (i+1 < nr)
+            {
+                buffer.append(' ');
+            }
+        });
+    }
+    else
     {
-        RFileIO::writeAscii(outFile,rVector[i], false);
-        if (i+1 < nr)
+        for (unsigned int i=0;i<nr;i++)
         {
-            RFileIO::writeAscii(outFile,' ', false);
+            RFileIO::writeAscii(outFile,rVector[i], false);
+            if (i+1 < nr)
+            {
+                RFileIO::writeAscii(outFile,' ', false);
+            }
         }
     }
     if (addNewLine)
@@ -712,10 +976,7 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RRVector &rVector, bool writ
     {
         RFileIO::writeBinary(outFile,nr);
     }
-    for (unsigned int i=0;i<nr;i++)
-    {
-        RFileIO::writeBinary(outFile,rVector[i]);
-    }
+    RFileIO::writeBinaryBlock(outFile,rVector.data(),qint64(nr)*qint64(sizeof(double)),sizeof(double));
 } /* RFileIO::writeBinary */
 
 
@@ -1039,10 +1300,7 @@ void RFileIO::readBinary(RFile &inFile, RValueVector &valueVector)
     valueVector.setUnits(units);
     valueVector.resize(n);
 
-    for (unsigned int i=0;i<n;i++)
-    {
-        RFileIO::readBinary(inFile,valueVector[i]);
-    }
+    RFileIO::readBinaryBlock(inFile,valueVector.getDataVector().data(),qint64(n)*qint64(sizeof(double)),sizeof(double));
 } /* RFileIO::readBinary */
 
 
@@ -1066,12 +1324,30 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RValueVector &valueVector, bo
         RFileIO::writeAscii(outFile,' ',false);
     }
 
-    for (unsigned int i=0;i<n;i++)
+    if (n >= asciiBlockMinSize)
     {
-        RFileIO::writeAscii(outFile,valueVector[i],addNewLine);
-        if (!addNewLine && i+1<n)
+        RTextFormatter::writeBlock(outFile,n,[&](qint64 i, QByteArray &buffer)
         {
-            RFileIO::writeAscii(outFile,' ',false);
+            RTextFormatter::appendValue(buffer,valueVector[i]);
+            if (addNewLine)
+            {
+                buffer.append(RConstants::endl);
+            }
+            else if (i+1 < n)
+            {
+                buffer.append(' ');
+            }
+        });
+    }
+    else
+    {
+        for (unsigned int i=0;i<n;i++)
+        {
+            RFileIO::writeAscii(outFile,valueVector[i],addNewLine);
+            if (!addNewLine && i+1<n)
+            {
+                RFileIO::writeAscii(outFile,' ',false);
+            }
         }
     }
 } /* RFileIO::writeAscii */
@@ -1085,10 +1361,7 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RValueVector &valueVector)
     RFileIO::writeBinary(outFile,valueVector.getUnits());
     RFileIO::writeBinary(outFile,n);
 
-    for (unsigned int i=0;i<n;i++)
-    {
-        RFileIO::writeBinary(outFile,valueVector[i]);
-    }
+    RFileIO::writeBinaryBlock(outFile,valueVector.getDataVector().data(),qint64(n)*qint64(sizeof(double)),sizeof(double));
 } /* RFileIO::writeBinary */
 
 
@@ -1777,20 +2050,99 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RVariable &variable, bool add
 
 
 void RFileIO::writeBinary(RSaveFile &outFile, const RVariable &variable)
+{
+    RVariableLocation location;
+    RFileIO::writeBinary(outFile,variable,location);
+} /* RFileIO::writeBinary */
+
+
+void RFileIO::readBinary(RFile &inFile, RVariable &variable, const RVariableLocation &location)
+{
+    RFileIO::readBinary(inFile,variable.type);
+    RFileIO::readBinary(inFile,variable.applyType);
+    RFileIO::readBinary(inFile,variable.name);
+    RFileIO::readBinary(inFile,variable.units);
+    unsigned int nValues = 0;
+    RFileIO::readBinary(inFile,nValues);
+    variable.values.clear();
+    variable.values.resize(nValues);
+    if (!inFile.seek(location.dataOffset))
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to seek to variable data.");
+    }
+    RFileIO::readBinary(inFile,variable.variableData);
+} /* RFileIO::readBinary */
+
+
+void RFileIO::readBinaryValues(RFile &inFile, RVariable &variable, const RVariableLocation &location)
+{
+    if (!inFile.seek(location.valuesOffset))
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to seek to variable values.");
+    }
+    for (unsigned int i=0;i<variable.values.size();i++)
+    {
+        RFileIO::readBinary(inFile,variable.values[i]);
+    }
+    if (inFile.pos() != location.dataOffset)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Variable values do not match table of contents.");
+    }
+} /* RFileIO::readBinaryValues */
+
+
+void RFileIO::writeBinary(RSaveFile &outFile, const RVariable &variable, RVariableLocation &location)
 {
     RFileIO::writeBinary(outFile,variable.type);
     RFileIO::writeBinary(outFile,variable.applyType);
     RFileIO::writeBinary(outFile,variable.name);
     RFileIO::writeBinary(outFile,variable.units);
     RFileIO::writeBinary(outFile,(unsigned int)variable.values.size());
+    location.valuesOffset = outFile.pos();
     for (unsigned int i=0;i<variable.values.size();i++)
     {
         RFileIO::writeBinary(outFile,variable.values[i]);
     }
+    location.dataOffset = outFile.pos();
     RFileIO::writeBinary(outFile,variable.variableData);
 } /* RFileIO::writeBinary */
 
 
+/*********************************************************************
+ *  RVariableLocation                                                *
+ *********************************************************************/
+
+
+void RFileIO::readBinary(RFile &inFile, std::vector<RVariableLocation> &locations)
+{
+    unsigned int nLocations = 0;
+    RFileIO::readBinary(inFile,nLocations);
+    locations.resize(nLocations);
+    for (unsigned int i=0;i<nLocations;i++)
+    {
+        if (inFile.read((char*)&locations[i].valuesOffset,sizeof(qint64)) != qint64(sizeof(qint64))
+            || inFile.read((char*)&locations[i].dataOffset,sizeof(qint64)) != qint64(sizeof(qint64)))
+        {
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read variable location.");
+        }
+    }
+} /* RFileIO::readBinary */
+
+
+void RFileIO::writeBinary(RSaveFile &outFile, const std::vector<RVariableLocation> &locations)
+{
+    RFileIO::writeBinary(outFile,(unsigned int)locations.size());
+    for (unsigned int i=0;i<locations.size();i++)
+    {
+        if (outFile.write((const char*)&locations[i].valuesOffset,sizeof(qint64)) != qint64(sizeof(qint64))
+            || outFile.write((const char*)&locations[i].dataOffset,sizeof(qint64)) != qint64(sizeof(qint64)))
+        {
+            throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write variable location.");
+        }
+    }
+} /* RFileIO::writeBinary */
+
+
 /*********************************************************************
  *  RBoundaryConditionType                                           *
  *********************************************************************/
@@ -2460,6 +2812,63 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RNode &node)
 }
 
 
+/*********************************************************************
+ *  std::vector<RNode>                                               *
+ *********************************************************************/
+
+
+void RFileIO::readBinary(RFile &inFile, std::vector<RNode> &nodes)
+{
+    // Layout of node coordinate block is same as when nodes are written one by one.
+    unsigned int nNodes = 0;
+    RFileIO::readBinary(inFile,nNodes);
+
+    RRVector coordinates(3*nNodes);
+    RFileIO::readBinaryBlock(inFile,coordinates.data(),qint64(coordinates.size())*qint64(sizeof(double)),3*sizeof(double));
+
+    nodes.resize(nNodes);
+    for (unsigned int i=0;i<nNodes;i++)
+    {
+        nodes[i].x = coordinates[3*i];
+        nodes[i].y = coordinates[3*i+1];
+        nodes[i].z = coordinates[3*i+2];
+    }
+}
+
+
+void RFileIO::writeAscii(RSaveFile &outFile, const std::vector<RNode> &nodes)
+{
+    unsigned int nNodes = (unsigned int)nodes.size();
+    RFileIO::writeAscii(outFile,nNodes);
+
+    RTextFormatter::writeBlock(outFile,nNodes,[&](qint64 i, QByteArray &buffer)
+    {
+        RTextFormatter::appendValue(buffer,nodes[i].x);
+        buffer.append(' ');
+        RTextFormatter::appendValue(buffer,nodes[i].y);
+        buffer.append(' ');
+        RTextFormatter::appendValue(buffer,nodes[i].z);
+        buffer.append(RConstants::endl);
+    });
+}
+
+
+void RFileIO::writeBinary(RSaveFile &outFile, const std::vector<RNode> &nodes)
+{
+    unsigned int nNodes = (unsigned int)nodes.size();
+    RFileIO::writeBinary(outFile,nNodes);
+
+    RRVector coordinates(3*nNodes);
+    for (unsigned int i=0;i<nNodes;i++)
+    {
+        coordinates[3*i] = nodes[i].x;
+        coordinates[3*i+1] = nodes[i].y;
+        coordinates[3*i+2] = nodes[i].z;
+    }
+    RFileIO::writeBinaryBlock(outFile,coordinates.data(),qint64(coordinates.size())*qint64(sizeof(double)),3*sizeof(double));
+}
+
+
 /*********************************************************************
  *  RElementType                                                     *
  *********************************************************************/
@@ -2558,6 +2967,118 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RElement &element)
 }
 
 
+/*********************************************************************
+ *  std::vector<RElement>                                            *
+ *********************************************************************/
+
+
+void RFileIO::readBinary(RFile &inFile, std::vector<RElement> &elements)
+{
+    unsigned int nElements = 0;
+    RFileIO::readBinary(inFile,nElements);
+    elements.resize(nElements);
+
+    if (inFile.getVersion() < RVersion(1,1,0))
+    {
+        for (unsigned int i=0;i<nElements;i++)
+        {
+            RFileIO::readBinary(inFile,elements[i]);
+        }
+        return;
+    }
+
+    // Type table maps stored type indexes to element types.
+    unsigned int nTypes = 0;
+    RFileIO::readBinary(inFile,nTypes);
+    std::vector<RElementType> typeTable(nTypes,R_ELEMENT_NONE);
+    for (unsigned int i=0;i<nTypes;i++)
+    {
+        RFileIO::readBinary(inFile,typeTable[i]);
+    }
+
+    RUVector types(nElements);
+    RFileIO::readBinaryBlock(inFile,types.data(),qint64(nElements)*qint64(sizeof(unsigned int)),sizeof(unsigned int));
+    RUVector offsets(nElements+1);
+    RFileIO::readBinaryBlock(inFile,offsets.data(),qint64(nElements+1)*qint64(sizeof(unsigned int)),sizeof(unsigned int));
+    RUVector nodeIDs(offsets[nElements]);
+    RFileIO::readBinaryBlock(inFile,nodeIDs.data(),qint64(nodeIDs.size())*qint64(sizeof(unsigned int)),sizeof(unsigned int));
+
+    for (unsigned int i=0;i<nElements;i++)
+    {
+        if (types[i] >= nTypes || offsets[i] > offsets[i+1] || offsets[i+1] > nodeIDs.size())
+        {
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Invalid element block data.");
+        }
+        elements[i].type = typeTable[types[i]];
+        elements[i].nodeIDs.assign(nodeIDs.begin()+offsets[i],nodeIDs.begin()+offsets[i+1]);
+    }
+}
+
+
+void RFileIO::writeAscii(RSaveFile &outFile, const std::vector<RElement> &elements)
+{
+    unsigned int nElements = (unsigned int)elements.size();
+    RFileIO::writeAscii(outFile,nElements);
+
+    std::vector<QByteArray> typeIds(R_ELEMENT_N_TYPES);
+    for (unsigned int i=0;i<typeIds.size();i++)
+    {
+        QString typeId(RElement::getId(RElementType(i)));
+        typeIds[i] = typeId.isEmpty() ? QByteArray("\"\"") : typeId.toUtf8();
+    }
+
+    RTextFormatter::writeBlock(outFile,nElements,[&](qint64 i, QByteArray &buffer)
+    {
+        const RElement &rElement = elements[i];
+        buffer.append(typeIds[rElement.type]);
+        buffer.append(' ');
+        RTextFormatter::appendValue(buffer,rElement.size());
+        buffer.append(' ');
+        for (unsigned int j=0;j<rElement.nodeIDs.size();j++)
+        {
+            RTextFormatter::appendValue(buffer,rElement.nodeIDs[j]);
+            if (j+1 < rElement.nodeIDs.size())
+            {
+                buffer.append(' ');
+            }
+        }
+        buffer.append(RConstants::endl);
+    });
+}
+
+
+void RFileIO::writeBinary(RSaveFile &outFile, const std::vector<RElement> &elements)
+{
+    unsigned int nElements = (unsigned int)elements.size();
+    RFileIO::writeBinary(outFile,nElements);
+
+    unsigned int nTypes = (unsigned int)R_ELEMENT_N_TYPES;
+    RFileIO::writeBinary(outFile,nTypes);
+    for (unsigned int i=0;i<nTypes;i++)
+    {
+        RFileIO::writeBinary(outFile,RElementType(i));
+    }
+
+    RUVector types(nElements);
+    RUVector offsets(nElements+1);
+    offsets[0] = 0;
+    for (unsigned int i=0;i<nElements;i++)
+    {
+        types[i] = (unsigned int)elements[i].type;
+        offsets[i+1] = offsets[i] + (unsigned int)elements[i].nodeIDs.size();
+    }
+    RUVector nodeIDs(offsets[nElements]);
+    for (unsigned int i=0;i<nElements;i++)
+    {
+        std::copy(elements[i].nodeIDs.begin(),elements[i].nodeIDs.end(),nodeIDs.begin()+offsets[i]);
+    }
+
+    RFileIO::writeBinaryBlock(outFile,types.data(),qint64(nElements)*qint64(sizeof(unsigned int)),sizeof(unsigned int));
+    RFileIO::writeBinaryBlock(outFile,offsets.data(),qint64(nElements+1)*qint64(sizeof(unsigned int)),sizeof(unsigned int));
+    RFileIO::writeBinaryBlock(outFile,nodeIDs.data(),qint64(nodeIDs.size())*qint64(sizeof(unsigned int)),sizeof(unsigned int));
+}
+
+
 /*********************************************************************
  *  RElementGroupVariableDisplayType                                 *
  *********************************************************************/
@@ -4038,6 +4559,15 @@ void RFileIO::readAscii(RFile &inFile, RProblemSetup &problemSetup)
     {
         RFileIO::readAscii(inFile,problemSetup.meshSetup);
     }
+    if (inFile.getVersion() >= RVersion(1,4,0))
+    {
+        RFileIO::readAscii(inFile,problemSetup.warmStartMask);
+        RFileIO::readAscii(inFile,problemSetup.warmStartExtrapolationMask);
+    }
+    if (inFile.getVersion() >= RVersion(1,5,0))
+    {
+        RFileIO::readAscii(inFile,problemSetup.segregatedMask);
+    }
 }
 
 void RFileIO::readBinary(RFile &inFile, RProblemSetup &problemSetup)
@@ -4049,6 +4579,15 @@ void RFileIO::readBinary(RFile &inFile, RProblemSetup &problemSetup)
     {
         RFileIO::readBinary(inFile,problemSetup.meshSetup);
     }
+    if (inFile.getVersion() >= RVersion(1,4,0))
+    {
+        RFileIO::readBinary(inFile,problemSetup.warmStartMask);
+        RFileIO::readBinary(inFile,problemSetup.warmStartExtrapolationMask);
+    }
+    if (inFile.getVersion() >= RVersion(1,5,0))
+    {
+        RFileIO::readBinary(inFile,problemSetup.segregatedMask);
+    }
 }
 
 void RFileIO::writeAscii(RSaveFile &outFile, const RProblemSetup &problemSetup, bool addNewLine)
@@ -4069,6 +4608,21 @@ void RFileIO::writeAscii(RSaveFile &outFile, const RProblemSetup &problemSetup,
         RFileIO::writeAscii(outFile,' ',false);
     }
     RFileIO::writeAscii(outFile,problemSetup.meshSetup,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,problemSetup.warmStartMask,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,problemSetup.warmStartExtrapolationMask,addNewLine);
+    if (!addNewLine)
+    {
+        RFileIO::writeAscii(outFile,' ',false);
+    }
+    RFileIO::writeAscii(outFile,problemSetup.segregatedMask,addNewLine);
 }
 
 void RFileIO::writeBinary(RSaveFile &outFile, const RProblemSetup &problemSetup)
@@ -4077,6 +4631,9 @@ void RFileIO::writeBinary(RSaveFile &outFile, const RProblemSetup &problemSetup)
     RFileIO::writeBinary(outFile,problemSetup.radiationSetup);
     RFileIO::writeBinary(outFile,problemSetup.modalSetup);
     RFileIO::writeBinary(outFile,problemSetup.meshSetup);
+    RFileIO::writeBinary(outFile,problemSetup.warmStartMask);
+    RFileIO::writeBinary(outFile,problemSetup.warmStartExtrapolationMask);
+    RFileIO::writeBinary(outFile,problemSetup.segregatedMask);
 }
 
 
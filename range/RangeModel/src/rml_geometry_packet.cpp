@@ -0,0 +1,262 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_geometry_packet.cpp                                  *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Geometry packet classes definition                  *
+ *********************************************************************/
+
+#include <cmath>
+
+#include "rml_geometry_packet.h"
+
+RTrianglePacket::RTrianglePacket()
+{
+    this->clear();
+}
+
+void RTrianglePacket::clear(void)
+{
+    this->nTriangles = 0;
+    for (uint l=0;l<R_GEOMETRY_PACKET_SIZE;l++)
+    {
+        for (uint k=0;k<3;k++)
+        {
+            this->p[k][l] = this->e1[k][l] = this->e2[k][l] = 0.0;
+        }
+        this->a[l] = 0.0;
+    }
+}
+
+void RTrianglePacket::add(const RTriangle &triangle)
+{
+    R_ERROR_ASSERT(!this->isFull());
+
+    uint l = this->nTriangles++;
+
+    const RNode &n1 = triangle.getNode1();
+    const RNode &n2 = triangle.getNode2();
+    const RNode &n3 = triangle.getNode3();
+
+    this->p[0][l] = n1.getX();
+    this->p[1][l] = n1.getY();
+    this->p[2][l] = n1.getZ();
+
+    this->e1[0][l] = n2.getX() - n1.getX();
+    this->e1[1][l] = n2.getY() - n1.getY();
+    this->e1[2][l] = n2.getZ() - n1.getZ();
+
+    this->e2[0][l] = n3.getX() - n1.getX();
+    this->e2[1][l] = n3.getY() - n1.getY();
+    this->e2[2][l] = n3.getZ() - n1.getZ();
+
+    double nx = this->e1[1][l]*this->e2[2][l] - this->e1[2][l]*this->e2[1][l];
+    double ny = this->e1[2][l]*this->e2[0][l] - this->e1[0][l]*this->e2[2][l];
+    double nz = this->e1[0][l]*this->e2[1][l] - this->e1[1][l]*this->e2[0][l];
+
+    this->a[l] = std::sqrt(nx*nx + ny*ny + nz*nz);
+}
+
+uint RTrianglePacket::findLineIntersections(const RR3Vector &position,
+                                            const RR3Vector &direction,
+                                            double u[R_GEOMETRY_PACKET_SIZE]) const
+{
+    const double ox = position[0], oy = position[1], oz = position[2];
+    const double dx = direction[0], dy = direction[1], dz = direction[2];
+    const double tol = RConstants::eps;
+
+    int hit[R_GEOMETRY_PACKET_SIZE];
+
+    R_GEOMETRY_PACKET_SIMD
+    for (uint l=0;l<R_GEOMETRY_PACKET_SIZE;l++)
+    {
+        // pvec = d x e2
+        double px = dy*this->e2[2][l] - dz*this->e2[1][l];
+        double py = dz*this->e2[0][l] - dx*this->e2[2][l];
+        double pz = dx*this->e2[1][l] - dy*this->e2[0][l];
+
+        double det = this->e1[0][l]*px + this->e1[1][l]*py + this->e1[2][l]*pz;
+        // |det| = |n.d| * 2A, same parallel criterion as in RPlane::findLineIntersection.
+        bool parallel = (std::fabs(det) <= tol*this->a[l]);
+        double invDet = 1.0 / (parallel ? 1.0 : det);
+
+        double tx = ox - this->p[0][l];
+        double ty = oy - this->p[1][l];
+        double tz = oz - this->p[2][l];
+
+        double b1 = (tx*px + ty*py + tz*pz) * invDet;
+
+        // qvec = t x e1
+        double qx = ty*this->e1[2][l] - tz*this->e1[1][l];
+        double qy = tz*this->e1[0][l] - tx*this->e1[2][l];
+        double qz = tx*this->e1[1][l] - ty*this->e1[0][l];
+
+        double b2 = (dx*qx + dy*qy + dz*qz) * invDet;
+
+        u[l] = (this->e2[0][l]*qx + this->e2[1][l]*qy + this->e2[2][l]*qz) * invDet;
+        hit[l] = (!parallel && b1 >= -tol && b2 >= -tol && b1 + b2 <= 1.0 + tol) ? 1 : 0;
+    }
+
+    uint mask = 0;
+    for (uint l=0;l<this->nTriangles;l++)
+    {
+        mask |= uint(hit[l]) << l;
+    }
+    return mask;
+}
+
+uint RTrianglePacket::findLineIntersections(const RTriangle &triangle,
+                                            const RR3Vector &position,
+                                            const double directions[3][R_GEOMETRY_PACKET_SIZE],
+                                            uint nLines,
+                                            double u[R_GEOMETRY_PACKET_SIZE])
+{
+    const RNode &n1 = triangle.getNode1();
+    const RNode &n2 = triangle.getNode2();
+    const RNode &n3 = triangle.getNode3();
+
+    const double e1x = n2.getX() - n1.getX(), e1y = n2.getY() - n1.getY(), e1z = n2.getZ() - n1.getZ();
+    const double e2x = n3.getX() - n1.getX(), e2y = n3.getY() - n1.getY(), e2z = n3.getZ() - n1.getZ();
+
+    const double nx = e1y*e2z - e1z*e2y;
+    const double ny = e1z*e2x - e1x*e2z;
+    const double nz = e1x*e2y - e1y*e2x;
+    const double a = std::sqrt(nx*nx + ny*ny + nz*nz);
+
+    // Line start is common to all lines, so is qvec = t x e1.
+    const double tx = position[0] - n1.getX();
+    const double ty = position[1] - n1.getY();
+    const double tz = position[2] - n1.getZ();
+
+    const double qx = ty*e1z - tz*e1y;
+    const double qy = tz*e1x - tx*e1z;
+    const double qz = tx*e1y - ty*e1x;
+
+    const double uq = e2x*qx + e2y*qy + e2z*qz;
+
+    const double tol = RConstants::eps;
+
+    int hit[R_GEOMETRY_PACKET_SIZE];
+
+    R_GEOMETRY_PACKET_SIMD
+    for (uint l=0;l<R_GEOMETRY_PACKET_SIZE;l++)
+    {
+        const double dx = directions[0][l];
+        const double dy = directions[1][l];
+        const double dz = directions[2][l];
+
+        // det = e1.(d x e2) = -n.d
+        double det = -(nx*dx + ny*dy + nz*dz);
+        bool parallel = (std::fabs(det) <= tol*a);
+        double invDet = 1.0 / (parallel ? 1.0 : det);
+
+        // b1 = t.(d x e2) = d.(e2 x t)
+        double b1 = (dx*(e2y*tz - e2z*ty) + dy*(e2z*tx - e2x*tz) + dz*(e2x*ty - e2y*tx)) * invDet;
+        double b2 = (dx*qx + dy*qy + dz*qz) * invDet;
+
+        u[l] = uq * invDet;
+        hit[l] = (!parallel && b1 >= -tol && b2 >= -tol && b1 + b2 <= 1.0 + tol) ? 1 : 0;
+    }
+
+    uint mask = 0;
+    for (uint l=0;l<nLines;l++)
+    {
+        mask |= uint(hit[l]) << l;
+    }
+    return mask;
+}
+
+RTetrahedronPacket::RTetrahedronPacket()
+{
+    this->clear();
+}
+
+void RTetrahedronPacket::clear(void)
+{
+    this->nTetrahedra = 0;
+    this->validMask = 0;
+    for (uint l=0;l<R_GEOMETRY_PACKET_SIZE;l++)
+    {
+        for (uint k=0;k<3;k++)
+        {
+            this->p[k][l] = 0.0;
+        }
+        for (uint k=0;k<9;k++)
+        {
+            this->invE[k][l] = 0.0;
+        }
+    }
+}
+
+void RTetrahedronPacket::add(const RNode &node1, const RNode &node2, const RNode &node3, const RNode &node4)
+{
+    R_ERROR_ASSERT(!this->isFull());
+
+    uint l = this->nTetrahedra++;
+
+    this->p[0][l] = node1.getX();
+    this->p[1][l] = node1.getY();
+    this->p[2][l] = node1.getZ();
+
+    // Edge matrix has edges from first node as columns.
+    double E[3][3];
+    E[0][0] = node2.getX() - node1.getX(); E[0][1] = node3.getX() - node1.getX(); E[0][2] = node4.getX() - node1.getX();
+    E[1][0] = node2.getY() - node1.getY(); E[1][1] = node3.getY() - node1.getY(); E[1][2] = node4.getY() - node1.getY();
+    E[2][0] = node2.getZ() - node1.getZ(); E[2][1] = node3.getZ() - node1.getZ(); E[2][2] = node4.getZ() - node1.getZ();
+
+    double C[3][3];
+    C[0][0] = E[1][1]*E[2][2] - E[1][2]*E[2][1];
+    C[0][1] = E[0][2]*E[2][1] - E[0][1]*E[2][2];
+    C[0][2] = E[0][1]*E[1][2] - E[0][2]*E[1][1];
+    C[1][0] = E[1][2]*E[2][0] - E[1][0]*E[2][2];
+    C[1][1] = E[0][0]*E[2][2] - E[0][2]*E[2][0];
+    C[1][2] = E[0][2]*E[1][0] - E[0][0]*E[1][2];
+    C[2][0] = E[1][0]*E[2][1] - E[1][1]*E[2][0];
+    C[2][1] = E[0][1]*E[2][0] - E[0][0]*E[2][1];
+    C[2][2] = E[0][0]*E[1][1] - E[0][1]*E[1][0];
+
+    double det = E[0][0]*C[0][0] + E[0][1]*C[1][0] + E[0][2]*C[2][0];
+
+    if (det == 0.0)
+    {
+        return;
+    }
+
+    for (uint i=0;i<3;i++)
+    {
+        for (uint j=0;j<3;j++)
+        {
+            this->invE[3*i+j][l] = C[i][j] / det;
+        }
+    }
+    this->validMask |= (1u << l);
+}
+
+uint RTetrahedronPacket::findInside(const RR3Vector &point, double tolerance) const
+{
+    int inside[R_GEOMETRY_PACKET_SIZE];
+
+    R_GEOMETRY_PACKET_SIMD
+    for (uint l=0;l<R_GEOMETRY_PACKET_SIZE;l++)
+    {
+        double rx = point[0] - this->p[0][l];
+        double ry = point[1] - this->p[1][l];
+        double rz = point[2] - this->p[2][l];
+
+        double b2 = this->invE[0][l]*rx + this->invE[1][l]*ry + this->invE[2][l]*rz;
+        double b3 = this->invE[3][l]*rx + this->invE[4][l]*ry + this->invE[5][l]*rz;
+        double b4 = this->invE[6][l]*rx + this->invE[7][l]*ry + this->invE[8][l]*rz;
+        double b1 = 1.0 - b2 - b3 - b4;
+
+        inside[l] = (b1 >= -tolerance && b2 >= -tolerance && b3 >= -tolerance && b4 >= -tolerance) ? 1 : 0;
+    }
+
+    uint mask = 0;
+    for (uint l=0;l<this->nTetrahedra;l++)
+    {
+        mask |= uint(inside[l]) << l;
+    }
+    return mask & this->validMask;
+}
@@ -35,6 +35,10 @@ void RMatrixSolverConf::_init(const RMatrixSolverConf *pMatrixSolver)
         this->solverCvgValue = pMatrixSolver->solverCvgValue;
         this->outputFrequency = pMatrixSolver->outputFrequency;
         this->outputFileName = pMatrixSolver->outputFileName;
+        this->nDomains = pMatrixSolver->nDomains;
+        this->matrixFree = pMatrixSolver->matrixFree;
+        this->saddlePointPreconditioner = pMatrixSolver->saddlePointPreconditioner;
+        this->deflation = pMatrixSolver->deflation;
     }
 }
 
@@ -44,6 +48,10 @@ RMatrixSolverConf::RMatrixSolverConf(RMatrixSolverType type)
     , nOuterIterations(1000)
     , solverCvgValue(RConstants::eps)
     , outputFrequency(100)
+    , nDomains(1)
+    , matrixFree(false)
+    , saddlePointPreconditioner(true)
+    , deflation(false)
 {
     switch (this->type)
     {
@@ -138,6 +146,46 @@ void RMatrixSolverConf::setOutputFileName(const QString &outputFileName)
     this->outputFileName = outputFileName;
 }
 
+unsigned int RMatrixSolverConf::getNDomains(void) const
+{
+    return this->nDomains;
+}
+
+void RMatrixSolverConf::setNDomains(unsigned int nDomains)
+{
+    this->nDomains = nDomains;
+}
+
+bool RMatrixSolverConf::getMatrixFree(void) const
+{
+    return this->matrixFree;
+}
+
+void RMatrixSolverConf::setMatrixFree(bool matrixFree)
+{
+    this->matrixFree = matrixFree;
+}
+
+bool RMatrixSolverConf::getSaddlePointPreconditioner(void) const
+{
+    return this->saddlePointPreconditioner;
+}
+
+void RMatrixSolverConf::setSaddlePointPreconditioner(bool saddlePointPreconditioner)
+{
+    this->saddlePointPreconditioner = saddlePointPreconditioner;
+}
+
+bool RMatrixSolverConf::getDeflation(void) const
+{
+    return this->deflation;
+}
+
+void RMatrixSolverConf::setDeflation(bool deflation)
+{
+    this->deflation = deflation;
+}
+
 const QString &RMatrixSolverConf::getName(RMatrixSolverType type)
 {
     return matrixSolverDesc[type].name;
@@ -129,6 +129,12 @@ void RMeshGenerator::generate(const RMeshInput &meshInput, RModel &model)
                 throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to import mesh from TetGen format: %s", error.getMessage().toUtf8().constData());
             }
         }
+
+        // Reorder nodes and elements for better memory locality.
+        if (meshInput.getReorderType() != R_MESH_REORDER_NONE)
+        {
+            model.reorder(meshInput.getReorderType());
+        }
     }
     catch (const RError &error)
     {
@@ -161,6 +167,7 @@ std::vector<RElement> RMeshGenerator::generate(const std::vector<RNode> &nodes,
     input.setQualityMesh(false);
     input.setKeepResults(false);
     input.setOutputEdges(false);
+    input.setReorderType(R_MESH_REORDER_NONE);
 
     try
     {
@@ -205,6 +212,7 @@ std::vector<RTetrahedron> RMeshGenerator::generate(const std::vector<RTriangle>
     input.setQualityMesh(false);
     input.setKeepResults(false);
     input.setOutputEdges(false);
+    input.setReorderType(R_MESH_REORDER_NONE);
 
     try
     {
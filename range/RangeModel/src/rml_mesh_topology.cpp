@@ -0,0 +1,437 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_mesh_topology.cpp                                    *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Mesh topology class definition                      *
+ *********************************************************************/
+
+#include <algorithm>
+
+#include "rml_mesh_topology.h"
+
+typedef struct _RMeshTopologySide
+{
+    //! Sorted side node IDs (padded with RConstants::eod).
+    uint nodeIDs[R_MESH_TOPOLOGY_MAX_SIDE_NODES];
+    //! Element ID.
+    uint elementID;
+    //! Local side position in element.
+    uint localSide;
+
+    bool operator <(const _RMeshTopologySide &side) const
+    {
+        for (uint i=0;i<R_MESH_TOPOLOGY_MAX_SIDE_NODES;i++)
+        {
+            if (this->nodeIDs[i] != side.nodeIDs[i])
+            {
+                return (this->nodeIDs[i] < side.nodeIDs[i]);
+            }
+        }
+        return (this->elementID < side.elementID);
+    }
+
+    bool hasSameNodes(const _RMeshTopologySide &side) const
+    {
+        return std::equal(this->nodeIDs,this->nodeIDs+R_MESH_TOPOLOGY_MAX_SIDE_NODES,side.nodeIDs);
+    }
+} RMeshTopologySide;
+
+void RMeshTopology::_init(const RMeshTopology *pMeshTopology)
+{
+    if (pMeshTopology)
+    {
+        this->built = pMeshTopology->built;
+        this->nNodes = pMeshTopology->nNodes;
+        this->nElements = pMeshTopology->nElements;
+        this->nodeElementOffsets = pMeshTopology->nodeElementOffsets;
+        this->nodeElements = pMeshTopology->nodeElements;
+        this->elementSideOffsets = pMeshTopology->elementSideOffsets;
+        this->elementSides = pMeshTopology->elementSides;
+        this->sideElementOffsets = pMeshTopology->sideElementOffsets;
+        this->sideElements = pMeshTopology->sideElements;
+    }
+}
+
+RMeshTopology::RMeshTopology()
+    : built(false)
+    , nNodes(0)
+    , nElements(0)
+{
+    this->_init();
+}
+
+RMeshTopology::RMeshTopology(const RMeshTopology &meshTopology)
+{
+    this->_init(&meshTopology);
+}
+
+RMeshTopology::~RMeshTopology()
+{
+
+}
+
+RMeshTopology &RMeshTopology::operator =(const RMeshTopology &meshTopology)
+{
+    this->_init(&meshTopology);
+    return (*this);
+}
+
+void RMeshTopology::build(const std::vector<RElement> &elements, uint nNodes)
+{
+    this->clear();
+
+    this->nNodes = nNodes;
+    this->nElements = uint(elements.size());
+
+    // Node to element incidence.
+    this->nodeElementOffsets.resize(this->nNodes+1,0);
+    for (uint i=0;i<this->nElements;i++)
+    {
+        for (uint j=0;j<elements[i].size();j++)
+        {
+            this->nodeElementOffsets[elements[i].getNodeId(j)+1]++;
+        }
+    }
+    for (uint i=0;i<this->nNodes;i++)
+    {
+        this->nodeElementOffsets[i+1] += this->nodeElementOffsets[i];
+    }
+    this->nodeElements.resize(this->nodeElementOffsets[this->nNodes],RConstants::eod);
+
+    std::vector<uint> nodePositions(this->nodeElementOffsets.begin(),this->nodeElementOffsets.end()-1);
+    for (uint i=0;i<this->nElements;i++)
+    {
+        for (uint j=0;j<elements[i].size();j++)
+        {
+            uint nodeID = elements[i].getNodeId(j);
+            // Element may reference same node more than once (degenerated element).
+            uint position = nodePositions[nodeID];
+            if (position > this->nodeElementOffsets[nodeID] && this->nodeElements[position-1] == i)
+            {
+                continue;
+            }
+            this->nodeElements[position] = i;
+            nodePositions[nodeID]++;
+        }
+    }
+    // Compact node element arrays if degenerated elements were found.
+    uint nodeElementPosition = 0;
+    for (uint i=0;i<this->nNodes;i++)
+    {
+        uint nodeBegin = this->nodeElementOffsets[i];
+        uint nodeEnd = nodePositions[i];
+        this->nodeElementOffsets[i] = nodeElementPosition;
+        for (uint j=nodeBegin;j<nodeEnd;j++)
+        {
+            this->nodeElements[nodeElementPosition++] = this->nodeElements[j];
+        }
+    }
+    this->nodeElementOffsets[this->nNodes] = nodeElementPosition;
+    this->nodeElements.resize(nodeElementPosition);
+
+    // Element sides.
+    this->elementSideOffsets.resize(this->nElements+1,0);
+    for (uint i=0;i<this->nElements;i++)
+    {
+        this->elementSideOffsets[i+1] = this->elementSideOffsets[i] + RMeshTopology::getNSides(elements[i].getType());
+    }
+
+    std::vector<RMeshTopologySide> sides;
+    sides.reserve(this->elementSideOffsets[this->nElements]);
+
+    for (uint i=0;i<this->nElements;i++)
+    {
+        uint nElementSides = RMeshTopology::getNSides(elements[i].getType());
+        for (uint j=0;j<nElementSides;j++)
+        {
+            uint nodePositions[R_MESH_TOPOLOGY_MAX_SIDE_NODES];
+            uint nSideNodes = RMeshTopology::getSideNodePositions(elements[i].getType(),j,nodePositions);
+
+            RMeshTopologySide side;
+            side.elementID = i;
+            side.localSide = j;
+            for (uint k=0;k<R_MESH_TOPOLOGY_MAX_SIDE_NODES;k++)
+            {
+                side.nodeIDs[k] = (k < nSideNodes) ? elements[i].getNodeId(nodePositions[k]) : RConstants::eod;
+            }
+            std::sort(side.nodeIDs,side.nodeIDs+nSideNodes);
+            sides.push_back(side);
+        }
+    }
+
+    std::sort(sides.begin(),sides.end());
+
+    this->elementSides.resize(sides.size(),RConstants::eod);
+    this->sideElements.resize(sides.size(),RConstants::eod);
+    this->sideElementOffsets.push_back(0);
+
+    for (uint i=0;i<sides.size();i++)
+    {
+        if (i > 0 && !sides[i].hasSameNodes(sides[i-1]))
+        {
+            this->sideElementOffsets.push_back(i);
+        }
+        uint sideID = uint(this->sideElementOffsets.size()) - 1;
+        this->sideElements[i] = sides[i].elementID;
+        this->elementSides[this->elementSideOffsets[sides[i].elementID] + sides[i].localSide] = sideID;
+    }
+    if (!sides.empty())
+    {
+        this->sideElementOffsets.push_back(uint(sides.size()));
+    }
+
+    this->built = true;
+}
+
+void RMeshTopology::clear(void)
+{
+    this->built = false;
+    this->nNodes = 0;
+    this->nElements = 0;
+    this->nodeElementOffsets.clear();
+    this->nodeElements.clear();
+    this->elementSideOffsets.clear();
+    this->elementSides.clear();
+    this->sideElementOffsets.clear();
+    this->sideElements.clear();
+}
+
+bool RMeshTopology::isValid(uint nNodes, uint nElements) const
+{
+    return (this->built && this->nNodes == nNodes && this->nElements == nElements);
+}
+
+uint RMeshTopology::getNNodeElements(uint nodeID) const
+{
+    R_ERROR_ASSERT(nodeID < this->nNodes);
+
+    return this->nodeElementOffsets[nodeID+1] - this->nodeElementOffsets[nodeID];
+}
+
+uint RMeshTopology::getNodeElementID(uint nodeID, uint position) const
+{
+    R_ERROR_ASSERT(nodeID < this->nNodes);
+    R_ERROR_ASSERT(this->nodeElementOffsets[nodeID] + position < this->nodeElementOffsets[nodeID+1]);
+
+    return this->nodeElements[this->nodeElementOffsets[nodeID] + position];
+}
+
+uint RMeshTopology::getNSides(void) const
+{
+    return this->sideElementOffsets.empty() ? 0 : uint(this->sideElementOffsets.size()) - 1;
+}
+
+uint RMeshTopology::getNElementSides(uint elementID) const
+{
+    R_ERROR_ASSERT(elementID < this->nElements);
+
+    return this->elementSideOffsets[elementID+1] - this->elementSideOffsets[elementID];
+}
+
+uint RMeshTopology::getElementSideID(uint elementID, uint localSide) const
+{
+    R_ERROR_ASSERT(elementID < this->nElements);
+    R_ERROR_ASSERT(this->elementSideOffsets[elementID] + localSide < this->elementSideOffsets[elementID+1]);
+
+    return this->elementSides[this->elementSideOffsets[elementID] + localSide];
+}
+
+uint RMeshTopology::getNSideElements(uint sideID) const
+{
+    R_ERROR_ASSERT(sideID < this->getNSides());
+
+    return this->sideElementOffsets[sideID+1] - this->sideElementOffsets[sideID];
+}
+
+uint RMeshTopology::getSideElementID(uint sideID, uint position) const
+{
+    R_ERROR_ASSERT(sideID < this->getNSides());
+    R_ERROR_ASSERT(this->sideElementOffsets[sideID] + position < this->sideElementOffsets[sideID+1]);
+
+    return this->sideElements[this->sideElementOffsets[sideID] + position];
+}
+
+bool RMeshTopology::isBoundarySide(uint sideID) const
+{
+    return (this->getNSideElements(sideID) == 1);
+}
+
+bool RMeshTopology::isManifoldSide(uint sideID) const
+{
+    return (this->getNSideElements(sideID) <= 2);
+}
+
+bool RMeshTopology::hasBoundarySide(uint elementID) const
+{
+    for (uint i=0;i<this->getNElementSides(elementID);i++)
+    {
+        if (this->isBoundarySide(this->getElementSideID(elementID,i)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+RUVector RMeshTopology::findNeighbors(uint elementID) const
+{
+    RUVector neighbors;
+
+    for (uint i=0;i<this->getNElementSides(elementID);i++)
+    {
+        uint sideID = this->getElementSideID(elementID,i);
+        for (uint j=0;j<this->getNSideElements(sideID);j++)
+        {
+            uint neighborID = this->getSideElementID(sideID,j);
+            if (neighborID != elementID)
+            {
+                neighbors.push_back(neighborID);
+            }
+        }
+    }
+
+    std::sort(neighbors.begin(),neighbors.end());
+    neighbors.erase(std::unique(neighbors.begin(),neighbors.end()),neighbors.end());
+
+    return neighbors;
+}
+
+uint RMeshTopology::findNBoundarySides(void) const
+{
+    uint nBoundarySides = 0;
+    for (uint i=0;i<this->getNSides();i++)
+    {
+        if (this->isBoundarySide(i))
+        {
+            nBoundarySides++;
+        }
+    }
+    return nBoundarySides;
+}
+
+uint RMeshTopology::findNNonManifoldSides(void) const
+{
+    uint nNonManifoldSides = 0;
+    for (uint i=0;i<this->getNSides();i++)
+    {
+        if (!this->isManifoldSide(i))
+        {
+            nNonManifoldSides++;
+        }
+    }
+    return nNonManifoldSides;
+}
+
+bool RMeshTopology::isClosed(const RBVector &elementBook) const
+{
+    R_ERROR_ASSERT(elementBook.size() == this->nElements);
+
+    for (uint i=0;i<this->nElements;i++)
+    {
+        if (!elementBook[i])
+        {
+            continue;
+        }
+        if (this->getNElementSides(i) == 0)
+        {
+            return false;
+        }
+        for (uint j=0;j<this->getNElementSides(i);j++)
+        {
+            uint sideID = this->getElementSideID(i,j);
+            if (this->getNSideElements(sideID) < 2)
+            {
+                return false;
+            }
+            for (uint k=0;k<this->getNSideElements(sideID);k++)
+            {
+                if (!elementBook[this->getSideElementID(sideID,k)])
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+uint RMeshTopology::getNSides(RElementType elementType)
+{
+    switch (elementType)
+    {
+        case R_ELEMENT_TRI1:
+            return 3;
+        case R_ELEMENT_QUAD1:
+            return 4;
+        case R_ELEMENT_TETRA1:
+            return 4;
+        case R_ELEMENT_WEDGE1:
+            return 5;
+        case R_ELEMENT_HEXA1:
+            return 6;
+        default:
+            return 0;
+    }
+}
+
+uint RMeshTopology::getSideNodePositions(RElementType elementType, uint localSide, uint nodePositions[R_MESH_TOPOLOGY_MAX_SIDE_NODES])
+{
+    // Same side ordering as in RElement::generateEdgeElements().
+    static const uint tri1Sides[3][2] = { {0,1}, {1,2}, {2,0} };
+    static const uint quad1Sides[4][2] = { {0,1}, {1,2}, {2,3}, {3,0} };
+    static const uint tetra1Sides[4][3] = { {1,3,2}, {0,2,3}, {0,3,1}, {0,1,2} };
+    // Bottom triangle (0,1,2) and top triangle (3,4,5) followed by quadrilateral sides.
+    static const uint wedge1Sides[5][4] = { {0,2,1,0}, {3,4,5,0}, {0,1,4,3}, {1,2,5,4}, {2,0,3,5} };
+    // Bottom quadrilateral (0,1,2,3) and top quadrilateral (4,5,6,7) followed by lateral sides.
+    static const uint hexa1Sides[6][4] = { {0,3,2,1}, {4,5,6,7}, {0,1,5,4}, {1,2,6,5}, {2,3,7,6}, {3,0,4,7} };
+
+    R_ERROR_ASSERT(localSide < RMeshTopology::getNSides(elementType));
+
+    switch (elementType)
+    {
+        case R_ELEMENT_TRI1:
+        {
+            nodePositions[0] = tri1Sides[localSide][0];
+            nodePositions[1] = tri1Sides[localSide][1];
+            return 2;
+        }
+        case R_ELEMENT_QUAD1:
+        {
+            nodePositions[0] = quad1Sides[localSide][0];
+            nodePositions[1] = quad1Sides[localSide][1];
+            return 2;
+        }
+        case R_ELEMENT_TETRA1:
+        {
+            nodePositions[0] = tetra1Sides[localSide][0];
+            nodePositions[1] = tetra1Sides[localSide][1];
+            nodePositions[2] = tetra1Sides[localSide][2];
+            return 3;
+        }
+        case R_ELEMENT_WEDGE1:
+        {
+            uint nSideNodes = (localSide < 2) ? 3 : 4;
+            for (uint i=0;i<nSideNodes;i++)
+            {
+                nodePositions[i] = wedge1Sides[localSide][i];
+            }
+            return nSideNodes;
+        }
+        case R_ELEMENT_HEXA1:
+        {
+            for (uint i=0;i<4;i++)
+            {
+                nodePositions[i] = hexa1Sides[localSide][i];
+            }
+            return 4;
+        }
+        default:
+        {
+            return 0;
+        }
+    }
+}
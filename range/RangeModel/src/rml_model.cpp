@@ -15,6 +15,7 @@
 #include <QTextStream>
 #include <QSetIterator>
 
+#include <algorithm>
 #include <vector>
 #include <stack>
 #include <cmath>
@@ -23,12 +24,20 @@
 #include <rblib.h>
 
 #include "rml_model.h"
+#include "rml_edge_collapse.h"
 #include "rml_file_io.h"
 #include "rml_file_manager.h"
+#include "rml_geometry_packet.h"
+#include "rml_node_element_incidence.h"
 #include "rml_view_factor_matrix.h"
 #include "rml_polygon.h"
 #include "rml_segment.h"
 
+//! Maximum number of passes when searching for pseudo-peripheral node.
+#define R_MODEL_RCM_MAX_PERIPHERAL_PASSES 8
+
+//! Barycentric tolerance used to pre-select elements in point location.
+#define R_MODEL_POINT_LOCATION_TOLERANCE 1.0e-6
 
 static const RVersion _version = RVersion(FILE_MAJOR_VERSION,FILE_MINOR_VERSION,FILE_RELEASE_VERSION);
 
@@ -52,12 +61,15 @@ void RModel::_init (const RModel *pModel)
         this->isos = pModel->isos;
         this->surfaceNeigs = pModel->surfaceNeigs;
         this->volumeNeigs = pModel->volumeNeigs;
+        this->meshTopology = pModel->meshTopology;
         this->modelData = pModel->modelData;
+        this->binaryCompression = pModel->binaryCompression;
     }
 } /* RModel::_init */
 
 
 RModel::RModel ()
+    : binaryCompression(false)
 {
     this->_init ();
 } /* RModel::RModel */
@@ -71,6 +83,7 @@ RModel::RModel (const RModel &model) : RProblem (model)
 
 
 RModel::RModel (const RModelMsh &modelMsh)
+    : binaryCompression(false)
 {
     RNode node;
     RElement element;
@@ -201,6 +214,7 @@ RModel::RModel (const RModelMsh &modelMsh)
 
 
 RModel::RModel (const RModelStl &modelStl)
+    : binaryCompression(false)
 {
     this->_init ();
     this->setName(modelStl.getName());
@@ -228,6 +242,7 @@ RModel::RModel (const RModelStl &modelStl)
 RModel::RModel (const RModelRaw &modelRaw,
                 const QString &name,
                 const QString &description)
+    : binaryCompression(false)
 {
     this->_init ();
     this->setName(name);
@@ -332,10 +347,11 @@ void RModel::update(const RModel &rModel)
     uint nUpdateVariables = std::min(this->getNVariables(),rModel.getNVariables());
     std::vector<RVariableData> updateVariableData;
     std::vector<RVariableType> updateVariableType;
+    // Variable descriptions are accessed directly so that values are not loaded.
     for (uint i=0;i<nUpdateVariables;i++)
     {
-        updateVariableData.push_back(this->getVariable(i).getVariableData());
-        updateVariableType.push_back(this->getVariable(i).getType());
+        updateVariableData.push_back(this->RResults::variables[i].getVariableData());
+        updateVariableType.push_back(this->RResults::variables[i].getType());
     }
 
     RTimeSolver timeSolver(this->getTimeSolver());
@@ -394,9 +410,9 @@ void RModel::update(const RModel &rModel)
 
     for (uint i=0;i<nUpdateVariables;i++)
     {
-        if (this->getVariable(i).getType() == updateVariableType[i])
+        if (this->RResults::variables[i].getType() == updateVariableType[i])
         {
-            this->getVariable(i).setVariableData(updateVariableData[i]);
+            this->RResults::variables[i].setVariableData(updateVariableData[i]);
         }
     }
 
@@ -409,7 +425,44 @@ void RModel::update(const RModel &rModel)
 } /* RModel::update */
 
 
-void RModel::read(const QString &fileName)
+void RModel::read(const QString &fileName, bool lazyVariables)
+{
+    this->readRecord(fileName,lazyVariables);
+
+    if (this->timeSolver.getEnabled())
+    {
+        // Times may have been changed on restart after the record was written.
+        QString timeSolverFileName(RModel::getTimeSolverFileName(fileName));
+        if (RFileManager::fileExists(timeSolverFileName))
+        {
+            RTimeSolver recordTimeSolver;
+            RModel::readTimeSolver(timeSolverFileName,recordTimeSolver);
+            this->timeSolver.setTimes(recordTimeSolver.getTimes());
+            this->timeSolver.setInputNTimeSteps(recordTimeSolver.getInputNTimeSteps());
+            this->timeSolver.setInputStartTime(recordTimeSolver.getInputStartTime());
+            this->timeSolver.setInputTimeStepSize(recordTimeSolver.getInputTimeStepSize());
+        }
+    }
+
+    this->invalidateMeshTopology();
+
+    RModelProblemTypeMask modelProblemType = this->checkMesh();
+    if (modelProblemType != R_MODEL_PROBLEM_NONE)
+    {
+        RLogger::warning("Inconsistent mesh was loaded which needs to be repaired.\n");
+        if (modelProblemType == R_MODEL_PROBLEM_INVALID_NEIGHBORS)
+        {
+            RLogger::info("Recalculating element neighbors\n");
+            RLogger::indent();
+            this->setSurfaceNeighbors(this->findSurfaceNeighbors());
+            this->setVolumeNeighbors(this->findVolumeNeighbors());
+            RLogger::unindent();
+        }
+    }
+} /* RModel::read */
+
+
+void RModel::readRecord(const QString &fileName, bool lazyVariables)
 {
     if (fileName.isEmpty())
     {
@@ -430,7 +483,7 @@ void RModel::read(const QString &fileName)
             }
             else if (ext == RModel::getDefaultFileExtension(true))
             {
-                targetFileName = this->readBinary(targetFileName);
+                targetFileName = this->readBinary(targetFileName,lazyVariables);
             }
             else
             {
@@ -454,21 +507,7 @@ void RModel::read(const QString &fileName)
             throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "Unknown exception.");
         }
     }
-
-    RModelProblemTypeMask modelProblemType = this->checkMesh();
-    if (modelProblemType != R_MODEL_PROBLEM_NONE)
-    {
-        RLogger::warning("Inconsistent mesh was loaded which needs to be repaired.\n");
-        if (modelProblemType == R_MODEL_PROBLEM_INVALID_NEIGHBORS)
-        {
-            RLogger::info("Recalculating element neighbors\n");
-            RLogger::indent();
-            this->setSurfaceNeighbors(this->findSurfaceNeighbors());
-            this->setVolumeNeighbors(this->findVolumeNeighbors());
-            RLogger::unindent();
-        }
-    }
-} /* RModel::read */
+} /* RModel::readRecord */
 
 
 QString RModel::write(const QString &fileName, bool writeLinkFile) const
@@ -479,39 +518,85 @@ QString RModel::write(const QString &fileName, bool writeLinkFile) const
     }
 
     QString ext = RFileManager::getExtension(fileName);
-    QString targetFileName(fileName);
     QString linkFileName = RFileManager::getFileNameWithOutTimeStep(fileName);
+    QString targetFileName = this->getRecordFileName(fileName);
 
-    uint recordNumber = 0;
+    try
+    {
+        if (writeLinkFile)
+        {
+            RModel::writeLink(linkFileName,targetFileName);
+            if (this->getTimeSolver().getEnabled())
+            {
+                RModel::writeTimeSolver(RModel::getTimeSolverFileName(linkFileName),this->getTimeSolver());
+            }
+        }
 
-    if (this->getTimeSolver().getEnabled())
+        if (ext == RModel::getDefaultFileExtension(false))
+        {
+            this->writeAscii(writeLinkFile?targetFileName:linkFileName);
+        }
+        else if (ext == RModel::getDefaultFileExtension(true))
+        {
+            this->writeBinary(writeLinkFile?targetFileName:linkFileName);
+        }
+        else
+        {
+            throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF, "Unknown extension \"" + ext + "\".");
+        }
+    }
+    catch (RError &error)
     {
-        recordNumber = this->getTimeSolver().getCurrentTimeStep() + 1;
+        throw error;
     }
-    else
+    catch (std::bad_alloc&)
     {
-        if (this->getProblemTaskTree().getProblemTypeMask() & R_PROBLEM_STRESS_MODAL)
-        {
-            recordNumber = this->getProblemSetup().getModalSetup().getMode() + 1;
-        }
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "Memory allocation failed.");
+    }
+    catch (const std::exception& x)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "%s.", typeid(x).name());
+    }
+    catch (...)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF, "Unknown exception.");
+    }
+
+    return linkFileName;
+} /* RModel::write */
+
+
+QString RModel::writeResults(const QString &fileName, const QString &baseFileName) const
+{
+    if (fileName.isEmpty() || baseFileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
     }
 
-    targetFileName = RFileManager::getFileNameWithTimeStep(linkFileName,recordNumber);
+    QString ext = RFileManager::getExtension(fileName);
+    QString linkFileName = RFileManager::getFileNameWithOutTimeStep(fileName);
+    QString targetFileName = this->getRecordFileName(fileName);
+
+    if (targetFileName == baseFileName)
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"Results record can not reference itself \'%s\'.",targetFileName.toUtf8().constData());
+    }
 
     try
     {
-        if (writeLinkFile)
+        RModel::writeLink(linkFileName,targetFileName);
+        if (this->getTimeSolver().getEnabled())
         {
-            RModel::writeLink(linkFileName,targetFileName);
+            RModel::writeTimeSolver(RModel::getTimeSolverFileName(linkFileName),this->getTimeSolver());
         }
 
         if (ext == RModel::getDefaultFileExtension(false))
         {
-            this->writeAscii(writeLinkFile?targetFileName:linkFileName);
+            this->writeResultsAscii(targetFileName,baseFileName);
         }
         else if (ext == RModel::getDefaultFileExtension(true))
         {
-            this->writeBinary(writeLinkFile?targetFileName:linkFileName);
+            this->writeResultsBinary(targetFileName,baseFileName);
         }
         else
         {
@@ -536,7 +621,39 @@ QString RModel::write(const QString &fileName, bool writeLinkFile) const
     }
 
     return linkFileName;
-} /* RModel::write */
+} /* RModel::writeResults */
+
+
+QString RModel::getRecordFileName(const QString &fileName) const
+{
+    uint recordNumber = 0;
+
+    if (this->getTimeSolver().getEnabled())
+    {
+        recordNumber = this->getTimeSolver().getCurrentTimeStep() + 1;
+    }
+    else
+    {
+        if (this->getProblemTaskTree().getProblemTypeMask() & R_PROBLEM_STRESS_MODAL)
+        {
+            recordNumber = this->getProblemSetup().getModalSetup().getMode() + 1;
+        }
+    }
+
+    return RFileManager::getFileNameWithTimeStep(RFileManager::getFileNameWithOutTimeStep(fileName),recordNumber);
+} /* RModel::getRecordFileName */
+
+
+bool RModel::getBinaryCompression(void) const
+{
+    return this->binaryCompression;
+} /* RModel::getBinaryCompression */
+
+
+void RModel::setBinaryCompression(bool binaryCompression)
+{
+    this->binaryCompression = binaryCompression;
+} /* RModel::setBinaryCompression */
 
 
 void RModel::exportTo (RModelMsh &modelMsh) const
@@ -1029,6 +1146,7 @@ void RModel::setNNodes (uint nnodes)
 {
     this->nodes.resize(nnodes);
     this->RResults::setNNodes (nnodes);
+    this->invalidateMeshTopology();
 } /* RModel::setNNodes */
 
 
@@ -1128,6 +1246,7 @@ void RModel::removeNode (uint                position,
 
     this->nodes.erase (iterNode);
     this->RResults::removeNode (position);
+    this->invalidateMeshTopology();
 
     // Decrease each node ID which is greater then possitin s by one
     for (std::vector<RElement>::iterator iterElement = this->elements.begin();
@@ -1454,16 +1573,19 @@ uint RModel::purgeUnusedNodes()
     }
 
     // Remove unused nodes.
-    uint nn = this->getNNodes();
-    for (uint i=0;i<nn;i++)
+    std::vector<RNode> nodesNew;
+    nodesNew.reserve(this->getNNodes());
+    for (uint i=0;i<this->getNNodes();i++)
     {
-        uint pos = nn - i - 1;
-        if (nodeBook[pos] == RConstants::eod)
+        if (nodeBook[i] != RConstants::eod)
         {
-            this->nodes.erase(this->nodes.begin()+pos);
-            this->RResults::removeNode(pos);
+            nodesNew.push_back(this->nodes[i]);
         }
     }
+    this->nodes = nodesNew;
+    nodesNew.resize(0);
+    this->RResults::removeNodes(nodeBook);
+    this->invalidateMeshTopology();
 
     // Fix node IDs
     uint nNodes = 0;
@@ -1490,6 +1612,253 @@ uint RModel::purgeUnusedNodes()
 } /* RModel::purgeUnusedNodes */
 
 
+void RModel::renumberNodes(const std::vector<uint> &nodeBook)
+{
+    R_ERROR_ASSERT (nodeBook.size() == this->nodes.size());
+
+    std::vector<RNode> nodesNew(this->nodes.size());
+    for (uint i=0;i<this->nodes.size();i++)
+    {
+        nodesNew[nodeBook[i]] = this->nodes[i];
+    }
+    this->nodes = nodesNew;
+    nodesNew.resize(0);
+    this->RResults::renumberNodes(nodeBook);
+    this->invalidateMeshTopology();
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(this->elements.size());i++)
+    {
+        RElement &rElement = this->elements[uint(i)];
+        for (uint j=0;j<rElement.size();j++)
+        {
+            rElement.setNodeId(j,nodeBook[rElement.getNodeId(j)]);
+        }
+    }
+} /* RModel::renumberNodes */
+
+
+std::vector<uint> RModel::findNodeBookRCM(void) const
+{
+    uint nn = this->getNNodes();
+    uint ne = this->getNElements();
+
+    // Node-element incidence.
+    std::vector<uint> incidenceOffsets(nn+1,0);
+    for (uint i=0;i<ne;i++)
+    {
+        const RElement &rElement = this->getElement(i);
+        for (uint j=0;j<rElement.size();j++)
+        {
+            incidenceOffsets[rElement.getNodeId(j)+1]++;
+        }
+    }
+    for (uint i=0;i<nn;i++)
+    {
+        incidenceOffsets[i+1] += incidenceOffsets[i];
+    }
+    std::vector<uint> incidence(incidenceOffsets[nn]);
+    std::vector<uint> incidenceFill(incidenceOffsets.begin(),incidenceOffsets.end()-1);
+    for (uint i=0;i<ne;i++)
+    {
+        const RElement &rElement = this->getElement(i);
+        for (uint j=0;j<rElement.size();j++)
+        {
+            incidence[incidenceFill[rElement.getNodeId(j)]++] = i;
+        }
+    }
+    incidenceFill.clear();
+
+    // Node graph (neighbors of each node sorted by ID).
+    std::vector<uint> graphOffsets(nn+1,0);
+    std::vector<uint> graph;
+    graph.reserve(incidence.size()*3);
+    std::vector<uint> neighbors;
+    for (uint i=0;i<nn;i++)
+    {
+        neighbors.clear();
+        for (uint j=incidenceOffsets[i];j<incidenceOffsets[i+1];j++)
+        {
+            const RElement &rElement = this->getElement(incidence[j]);
+            for (uint k=0;k<rElement.size();k++)
+            {
+                if (rElement.getNodeId(k) != i)
+                {
+                    neighbors.push_back(rElement.getNodeId(k));
+                }
+            }
+        }
+        std::sort(neighbors.begin(),neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(),neighbors.end()),neighbors.end());
+        graph.insert(graph.end(),neighbors.begin(),neighbors.end());
+        graphOffsets[i+1] = uint(graph.size());
+    }
+    incidence.clear();
+    incidenceOffsets.clear();
+
+    // Nodes sorted by degree are used as candidates for starting nodes.
+    std::vector<std::pair<uint,uint> > degreeNodes(nn);
+    for (uint i=0;i<nn;i++)
+    {
+        degreeNodes[i] = std::pair<uint,uint>(graphOffsets[i+1]-graphOffsets[i],i);
+    }
+    std::sort(degreeNodes.begin(),degreeNodes.end());
+
+    std::vector<uint> order;
+    order.reserve(nn);
+    std::vector<uint> levelStamp(nn,RConstants::eod);
+    uint stamp = 0;
+    std::vector<bool> ordered(nn,false);
+    std::vector<std::pair<uint,uint> > levelNeighbors;
+
+    for (uint c=0;c<nn;c++)
+    {
+        uint startNode = degreeNodes[c].second;
+        if (ordered[startNode])
+        {
+            continue;
+        }
+
+        // Find pseudo-peripheral node (George-Liu): breadth first search is repeated from
+        // node with lowest degree in the last level as long as number of levels grows.
+        std::vector<uint> lastLevel;
+        uint nLevels = RModel::findNodeGraphLastLevel(graphOffsets,graph,startNode,stamp++,levelStamp,lastLevel);
+        for (uint pass=0;pass<R_MODEL_RCM_MAX_PERIPHERAL_PASSES;pass++)
+        {
+            uint candidateNode = lastLevel[0];
+            for (uint j=1;j<lastLevel.size();j++)
+            {
+                if (graphOffsets[lastLevel[j]+1]-graphOffsets[lastLevel[j]] < graphOffsets[candidateNode+1]-graphOffsets[candidateNode])
+                {
+                    candidateNode = lastLevel[j];
+                }
+            }
+            std::vector<uint> candidateLastLevel;
+            uint candidateNLevels = RModel::findNodeGraphLastLevel(graphOffsets,graph,candidateNode,stamp++,levelStamp,candidateLastLevel);
+            if (candidateNLevels <= nLevels)
+            {
+                break;
+            }
+            startNode = candidateNode;
+            nLevels = candidateNLevels;
+            lastLevel.swap(candidateLastLevel);
+        }
+
+        // Cuthill-McKee ordering of connected component.
+        uint componentStart = uint(order.size());
+        order.push_back(startNode);
+        ordered[startNode] = true;
+        for (uint j=componentStart;j<order.size();j++)
+        {
+            uint nodeID = order[j];
+            levelNeighbors.clear();
+            for (uint k=graphOffsets[nodeID];k<graphOffsets[nodeID+1];k++)
+            {
+                uint neighborID = graph[k];
+                if (!ordered[neighborID])
+                {
+                    ordered[neighborID] = true;
+                    levelNeighbors.push_back(std::pair<uint,uint>(graphOffsets[neighborID+1]-graphOffsets[neighborID],neighborID));
+                }
+            }
+            std::sort(levelNeighbors.begin(),levelNeighbors.end());
+            for (uint k=0;k<levelNeighbors.size();k++)
+            {
+                order.push_back(levelNeighbors[k].second);
+            }
+        }
+    }
+
+    // Reverse order.
+    std::vector<uint> nodeBook(nn);
+    for (uint i=0;i<nn;i++)
+    {
+        nodeBook[order[i]] = nn - 1 - i;
+    }
+    return nodeBook;
+} /* RModel::findNodeBookRCM */
+
+
+uint RModel::findNodeGraphLastLevel(const std::vector<uint> &graphOffsets,
+                                    const std::vector<uint> &graph,
+                                    uint startNode,
+                                    uint stamp,
+                                    std::vector<uint> &levelStamp,
+                                    std::vector<uint> &lastLevel)
+{
+    std::vector<uint> nextLevel;
+    uint nLevels = 1;
+
+    lastLevel.assign(1,startNode);
+    levelStamp[startNode] = stamp;
+
+    while (true)
+    {
+        nextLevel.clear();
+        for (uint i=0;i<lastLevel.size();i++)
+        {
+            for (uint j=graphOffsets[lastLevel[i]];j<graphOffsets[lastLevel[i]+1];j++)
+            {
+                if (levelStamp[graph[j]] != stamp)
+                {
+                    levelStamp[graph[j]] = stamp;
+                    nextLevel.push_back(graph[j]);
+                }
+            }
+        }
+        if (nextLevel.empty())
+        {
+            break;
+        }
+        lastLevel.swap(nextLevel);
+        nLevels++;
+    }
+
+    return nLevels;
+} /* RModel::findNodeGraphLastLevel */
+
+
+std::vector<uint> RModel::findNodeBookMorton(void) const
+{
+    uint nn = this->getNNodes();
+
+    double xmin,xmax,ymin,ymax,zmin,zmax;
+    this->findNodeLimits(xmin,xmax,ymin,ymax,zmin,zmax);
+
+    double scale = std::max(std::max(xmax-xmin,ymax-ymin),zmax-zmin);
+    // 21 bits per coordinate.
+    double cellScale = (scale > 0.0) ? double((1 << 21) - 1) / scale : 0.0;
+
+    std::vector<std::pair<uint64_t,uint> > codes(nn);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nn);i++)
+    {
+        const RNode &rNode = this->getNode(uint(i));
+        uint64_t cx = uint64_t((rNode.getX() - xmin) * cellScale);
+        uint64_t cy = uint64_t((rNode.getY() - ymin) * cellScale);
+        uint64_t cz = uint64_t((rNode.getZ() - zmin) * cellScale);
+
+        uint64_t code = 0;
+        for (uint b=0;b<21;b++)
+        {
+            code |= ((cx >> b) & 1) << (3*b+0);
+            code |= ((cy >> b) & 1) << (3*b+1);
+            code |= ((cz >> b) & 1) << (3*b+2);
+        }
+        codes[uint(i)] = std::pair<uint64_t,uint>(code,uint(i));
+    }
+    std::sort(codes.begin(),codes.end());
+
+    std::vector<uint> nodeBook(nn);
+    for (uint i=0;i<nn;i++)
+    {
+        nodeBook[codes[i].second] = i;
+    }
+    return nodeBook;
+} /* RModel::findNodeBookMorton */
+
+
 /*********************************************************************
  * Element interface                                                 *
  *********************************************************************/
@@ -1535,6 +1904,7 @@ void RModel::setNElements (uint nelements)
 {
     this->elements.resize(nelements);
     this->RResults::setNElements(nelements);
+    this->invalidateMeshTopology();
 
     for (uint i=0;i<this->elements.size();i++)
     {
@@ -1605,6 +1975,7 @@ void RModel::addElement (const RElement &element,
 {
     this->elements.push_back(element);
     this->RResults::addElement(0.0);
+    this->invalidateMeshTopology();
 
     if (addToGroup)
     {
@@ -1676,6 +2047,7 @@ void RModel::setElement (uint    position,
     REntityGroupType newType = RElementGroup::getGroupType (element.getType());
 
     this->elements[position] = element;
+    this->invalidateMeshTopology();
 
     if (oldType != newType)
     {
@@ -1914,6 +2286,7 @@ void RModel::removeElement (uint                position,
 
     this->elements.erase(iter);
     this->RResults::removeElement(position);
+    this->invalidateMeshTopology();
 
     // Remove node
     for (uint i=0;i<nodesToRemove.size();i++)
@@ -1995,18 +2368,69 @@ std::vector<uint> RModel::findElementPositionsByNodeId(uint nodeID) const
 } /* RModel::findElementPositionsByNodeId */
 
 
-RStatistics RModel::findLineElementSizeStatistics() const
+uint RModel::findElementContainingNode(const RNode &node, REntityGroupTypeMask entityGroup, RRVector &volumes, bool findLast) const
 {
-    RRVector elementSizes;
-    return RStatistics(elementSizes,100,true);
-} /* RModel::findLineElementSizeStatistics */
+    RR3Vector point(node.toVector());
 
+    // Linear tetrahedra are pre-selected in packets, candidates are confirmed by exact test.
+    RTetrahedronPacket tetrahedronPacket;
+    uint packetElementIDs[R_GEOMETRY_PACKET_SIZE];
 
-RStatistics RModel::findSurfaceElementSizeStatistics() const
-{
-    RRVector elementSizes;
-    return RStatistics(elementSizes,100,true);
-} /* RModel::findSurfaceElementSizeStatistics */
+    for (uint j=0;j<this->getNElements();j++)
+    {
+        // Elements are scanned backwards if last containing element is requested.
+        uint i = findLast ? this->getNElements() - 1 - j : j;
+        const RElement &rElement = this->getElement(i);
+        bool isSelected = (RElementGroup::getGroupType(rElement.getType()) & entityGroup);
+
+        if (isSelected && rElement.getType() == R_ELEMENT_TETRA1)
+        {
+            packetElementIDs[tetrahedronPacket.size()] = i;
+            tetrahedronPacket.add(this->getNode(rElement.getNodeId(0)),
+                                  this->getNode(rElement.getNodeId(1)),
+                                  this->getNode(rElement.getNodeId(2)),
+                                  this->getNode(rElement.getNodeId(3)));
+        }
+
+        // Packet has to be evaluated before any following element to keep element order.
+        bool isLast = (j+1 == this->getNElements());
+        if (tetrahedronPacket.size() > 0 && (tetrahedronPacket.isFull() || isLast || (isSelected && rElement.getType() != R_ELEMENT_TETRA1)))
+        {
+            uint insideMask = tetrahedronPacket.findInside(point,R_MODEL_POINT_LOCATION_TOLERANCE);
+            for (uint l=0;l<tetrahedronPacket.size();l++)
+            {
+                if ((insideMask & (1u << l)) && this->getElement(packetElementIDs[l]).isInside(this->getNodes(),node,volumes))
+                {
+                    return packetElementIDs[l];
+                }
+            }
+            tetrahedronPacket.clear();
+        }
+
+        if (isSelected && rElement.getType() != R_ELEMENT_TETRA1)
+        {
+            if (rElement.isInside(this->getNodes(),node,volumes))
+            {
+                return i;
+            }
+        }
+    }
+    return RConstants::eod;
+} /* RModel::findElementContainingNode */
+
+
+RStatistics RModel::findLineElementSizeStatistics() const
+{
+    RRVector elementSizes;
+    return RStatistics(elementSizes,100,true);
+} /* RModel::findLineElementSizeStatistics */
+
+
+RStatistics RModel::findSurfaceElementSizeStatistics() const
+{
+    RRVector elementSizes;
+    return RStatistics(elementSizes,100,true);
+} /* RModel::findSurfaceElementSizeStatistics */
 
 
 RStatistics RModel::findVolumeElementSizeStatistics() const
@@ -2053,6 +2477,7 @@ uint RModel::purgeUnusedElements()
     }
     this->elements = elementsNew;
     elementsNew.resize(0);
+    this->invalidateMeshTopology();
     this->RResults::removeElements(elementBook);
     RLogger::unindent();
 
@@ -2152,6 +2577,161 @@ uint RModel::purgeUnusedElements()
 } /* RModel::purgeUnusedElements */
 
 
+void RModel::renumberElements(const std::vector<uint> &elementBook)
+{
+    R_ERROR_ASSERT (elementBook.size() == this->elements.size());
+
+    uint ne = this->getNElements();
+    uint nElementGroups = this->getNElementGroups();
+
+    std::vector<RElement> elementsNew(ne);
+    for (uint i=0;i<ne;i++)
+    {
+        elementsNew[elementBook[i]] = this->elements[i];
+    }
+    this->elements = elementsNew;
+    elementsNew.resize(0);
+    this->invalidateMeshTopology();
+    this->RResults::renumberElements(elementBook);
+
+    // Fix element ID references in element groups
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nElementGroups);i++)
+    {
+        RElementGroup *pElementGroup = this->getElementGroupPtr(uint(i));
+        for (uint j=0;j<pElementGroup->size();j++)
+        {
+            pElementGroup->set(j,elementBook[pElementGroup->get(j)]);
+        }
+    }
+
+    // Update surface neighbors
+    if (this->surfaceNeigs.size() == ne)
+    {
+        std::vector<RUVector> surfaceNeigsNew(ne);
+        for (uint i=0;i<ne;i++)
+        {
+            surfaceNeigsNew[elementBook[i]] = this->surfaceNeigs[i];
+            for (uint j=0;j<surfaceNeigsNew[elementBook[i]].size();j++)
+            {
+                surfaceNeigsNew[elementBook[i]][j] = elementBook[this->surfaceNeigs[i][j]];
+            }
+        }
+        this->surfaceNeigs = surfaceNeigsNew;
+    }
+
+    // Update volume neighbors
+    if (this->volumeNeigs.size() == ne)
+    {
+        std::vector<RUVector> volumeNeigsNew(ne);
+        for (uint i=0;i<ne;i++)
+        {
+            volumeNeigsNew[elementBook[i]] = this->volumeNeigs[i];
+            for (uint j=0;j<volumeNeigsNew[elementBook[i]].size();j++)
+            {
+                volumeNeigsNew[elementBook[i]][j] = elementBook[this->volumeNeigs[i][j]];
+            }
+        }
+        this->volumeNeigs = volumeNeigsNew;
+    }
+
+    // Interpolated entities refer to element IDs.
+    for (uint i=0;i<this->cuts.size();i++)
+    {
+        this->createCut(this->cuts[i]);
+    }
+    for (uint i=0;i<this->isos.size();i++)
+    {
+        this->createIso(this->isos[i]);
+    }
+} /* RModel::renumberElements */
+
+
+std::vector<uint> RModel::findElementBookByNodes(void) const
+{
+    uint ne = this->getNElements();
+
+    std::vector<std::pair<uint,uint> > elementKeys(ne);
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(ne);i++)
+    {
+        const RElement &rElement = this->getElement(uint(i));
+        uint minNodeID = RConstants::eod;
+        for (uint j=0;j<rElement.size();j++)
+        {
+            minNodeID = std::min(minNodeID,rElement.getNodeId(j));
+        }
+        elementKeys[uint(i)] = std::pair<uint,uint>(minNodeID,uint(i));
+    }
+    std::sort(elementKeys.begin(),elementKeys.end());
+
+    std::vector<uint> elementBook(ne);
+    for (uint i=0;i<ne;i++)
+    {
+        elementBook[elementKeys[i].second] = i;
+    }
+    return elementBook;
+} /* RModel::findElementBookByNodes */
+
+
+void RModel::reorder(RMeshReorderType reorderType)
+{
+    std::vector<uint> nodeBook;
+
+    switch (reorderType)
+    {
+        case R_MESH_REORDER_RCM:
+        {
+            RLogger::info("Reordering nodes (reverse Cuthill-McKee)\n");
+            nodeBook = this->findNodeBookRCM();
+            break;
+        }
+        case R_MESH_REORDER_MORTON:
+        {
+            RLogger::info("Reordering nodes (Morton curve)\n");
+            nodeBook = this->findNodeBookMorton();
+            break;
+        }
+        default:
+        {
+            return;
+        }
+    }
+
+    RLogger::indent();
+    RLogger::info("Node bandwidth before reordering: %u\n",this->findNodeBandwidth());
+    this->renumberNodes(nodeBook);
+    RLogger::info("Node bandwidth after reordering:  %u\n",this->findNodeBandwidth());
+    RLogger::unindent();
+
+    RLogger::info("Reordering elements\n");
+    this->renumberElements(this->findElementBookByNodes());
+} /* RModel::reorder */
+
+
+uint RModel::findNodeBandwidth(void) const
+{
+    uint bandwidth = 0;
+    for (uint i=0;i<this->getNElements();i++)
+    {
+        const RElement &rElement = this->getElement(i);
+        uint minNodeID = RConstants::eod;
+        uint maxNodeID = 0;
+        for (uint j=0;j<rElement.size();j++)
+        {
+            minNodeID = std::min(minNodeID,rElement.getNodeId(j));
+            maxNodeID = std::max(maxNodeID,rElement.getNodeId(j));
+        }
+        if (rElement.size() > 0)
+        {
+            bandwidth = std::max(bandwidth,maxNodeID-minNodeID);
+        }
+    }
+    return bandwidth;
+} /* RModel::findNodeBandwidth */
+
+
 /*********************************************************************
  * Interpolated element interface                                    *
  *********************************************************************/
@@ -3399,7 +3979,7 @@ bool RModel::checkIfSurfaceIsClosed(uint surfaceID) const
 bool RModel::checkIfSurfacesAreClosed(const QList<uint> &surfaceIDs) const
 {
     // Build book of elements, which are part of the surface.
-    std::vector<bool> elementBook;
+    RBVector elementBook;
     elementBook.resize(this->getNElements(),false);
 
     for (int i=0;i<surfaceIDs.size();i++)
@@ -3411,30 +3991,7 @@ bool RModel::checkIfSurfacesAreClosed(const QList<uint> &surfaceIDs) const
         }
     }
 
-    for (uint i=0;i<elementBook.size();i++)
-    {
-        if (elementBook[i])
-        {
-            const std::vector<uint> *neighborIDs = this->getNeighborIDs(i);
-            if (!neighborIDs)
-            {
-                return false;
-            }
-            if (neighborIDs->size() < RElement::getNNeighbors(this->getElement(i).getType()))
-            {
-                return false;
-            }
-            for (uint j=0;j<neighborIDs->size();j++)
-            {
-                if (!elementBook[neighborIDs->at(j)])
-                {
-                    return false;
-                }
-            }
-        }
-    }
-
-    return true;
+    return this->getMeshTopology().isClosed(elementBook);
 } /* RModel::checkIfSurfacesAreClosed */
 
 
@@ -3496,6 +4053,10 @@ void RModel::syncSurfaceNormals()
             }
         }
     }
+    if (nSwapped > 0)
+    {
+        this->invalidateMeshTopology();
+    }
     RLogger::info("Number of swapped elements = %u\n",nSwapped);
 } /* RModel::syncSurfaceNormals */
 
@@ -4215,19 +4776,7 @@ RRVector RModel::getInterpolatedResultsValues(RVariableType variableType, const
     RRVector volumes;
 
     // Find element containing given position.
-    uint elementPos = RConstants::eod;
-    for (uint i=0;i<this->getNElements();i++)
-    {
-        const RElement &rElement = this->getElement(i);
-        if (RElementGroup::getGroupType(rElement.getType()) & entityGroup)
-        {
-            if (rElement.isInside(this->getNodes(),rNode,volumes))
-            {
-                elementPos = i;
-                break;
-            }
-        }
-    }
+    uint elementPos = this->findElementContainingNode(rNode,entityGroup,volumes);
     if (elementPos == RConstants::eod)
     {
         return RRVector();
@@ -4412,6 +4961,7 @@ RModelProblemTypeMask RModel::checkMesh(bool printOutput) const
     }
 
     // Check element neighbors.
+    const RMeshTopology &rMeshTopology = this->getMeshTopology();
 #pragma omp parallel for default(shared)
     for (int64_t i=0;i<int64_t(this->getNElements());i++)
     {
@@ -4420,13 +4970,21 @@ RModelProblemTypeMask RModel::checkMesh(bool printOutput) const
         {
             continue;
         }
+        RUVector topologyNeighbors = rMeshTopology.findNeighbors(uint(i));
         for (uint j=0;j<pNeighbors->size();j++)
         {
             if (RElementGroup::getGroupType(this->getElement(uint(i)).getType())
                 ==
                 RElementGroup::getGroupType(this->getElement(pNeighbors->at(j)).getType()))
             {
-                // TODO: Cross check for element neighbors.
+                if (!std::binary_search(topologyNeighbors.begin(),topologyNeighbors.end(),pNeighbors->at(j)))
+                {
+                    problemType |= R_MODEL_PROBLEM_INVALID_NEIGHBORS;
+                    if (printOutput)
+                    {
+                        RLogger::warning("Elements %u and %u are listed as neighbors but do not share a side\n",i,pNeighbors->at(j));
+                    }
+                }
             }
             else
             {
@@ -4449,6 +5007,22 @@ RModelProblemTypeMask RModel::checkMesh(bool printOutput) const
 } /* RModel::checkMesh */
 
 
+const RMeshTopology &RModel::getMeshTopology() const
+{
+    if (!this->meshTopology.isValid(this->getNNodes(),this->getNElements()))
+    {
+        this->meshTopology.build(this->elements,this->getNNodes());
+    }
+    return this->meshTopology;
+} /* RModel::getMeshTopology */
+
+
+void RModel::invalidateMeshTopology()
+{
+    this->meshTopology.clear();
+} /* RModel::invalidateMeshTopology */
+
+
 QVector<bool> RModel::findEdgeNodes() const
 {
     RLogger::info("Finding edge nodes\n");
@@ -4457,101 +5031,35 @@ QVector<bool> RModel::findEdgeNodes() const
 
     QVector<bool> edgeNodes;
 
-    QVector<uint> nodeCount;
     QVector<uint> nodeGroup;
+    QVector<uint> nodeCount;
 
     edgeNodes.resize(int(this->getNNodes()));
-    edgeNodes.fill(true);
+    edgeNodes.fill(false);
+    nodeGroup.resize(int(this->getNNodes()));
+    nodeGroup.fill(RConstants::eod);
     nodeCount.resize(int(this->getNNodes()));
     nodeCount.fill(0);
-    nodeGroup.resize(int(this->getNNodes()));
-    nodeGroup.fill(0);
-
-    uint nodeGroupCounter = 1;
-
-    uint nNodeGroupCounter = this->getNPoints()
-                                   + this->getNLines()
-                                   + this->getNSurfaces()
-                                   + this->getNVolumes();
-
-    for (uint i=0;i<this->getNPoints();i++)
-    {
-        RProgressPrint(nodeGroupCounter,nNodeGroupCounter);
-        const RPoint &point = this->getPoint(i);
-        for (uint j=0;j<point.size();j++)
-        {
-            const RElement &element = this->getElement(point.get(j));
-            for (uint k=0;k<element.size();k++)
-            {
-                int nodeID = int(element.getNodeId(k));
-                if (nodeGroup[nodeID] != nodeGroupCounter)
-                {
-                    nodeGroup[nodeID] = nodeGroupCounter;
-                    nodeCount[nodeID]++;
-                }
-            }
-        }
-        nodeGroupCounter++;
-    }
-
-    for (uint i=0;i<this->getNLines();i++)
-    {
-        RProgressPrint(nodeGroupCounter,nNodeGroupCounter);
-        const RLine &line = this->getLine(i);
-        for (uint j=0;j<line.size();j++)
-        {
-            const RElement &element = this->getElement(line.get(j));
-            for (uint k=0;k<element.size();k++)
-            {
-                int nodeID = int(element.getNodeId(k));
-                if (nodeGroup[nodeID] != nodeGroupCounter)
-                {
-                    nodeGroup[nodeID] = nodeGroupCounter;
-                    nodeCount[nodeID]++;
-                }
-            }
-        }
-        nodeGroupCounter++;
-    }
-
-    for (uint i=0;i<this->getNSurfaces();i++)
-    {
-        RProgressPrint(nodeGroupCounter,nNodeGroupCounter);
-        const RSurface &surface = this->getSurface(i);
-        for (uint j=0;j<surface.size();j++)
-        {
-            const RElement &element = this->getElement(surface.get(j));
-            for (uint k=0;k<element.size();k++)
-            {
-                int nodeID = int(element.getNodeId(k));
-                if (nodeGroup[nodeID] != nodeGroupCounter)
-                {
-                    nodeGroup[nodeID] = nodeGroupCounter;
-                    nodeCount[nodeID]++;
-                }
-            }
-        }
-        nodeGroupCounter++;
-    }
 
-    for (uint i=0;i<this->getNVolumes();i++)
+    // Nodes shared by more than one element group are edge nodes.
+    uint nElementGroups = this->getNElementGroups();
+    for (uint i=0;i<nElementGroups;i++)
     {
-        RProgressPrint(nodeGroupCounter,nNodeGroupCounter);
-        const RVolume &volume = this->getVolume(i);
-        for (uint j=0;j<volume.size();j++)
+        RProgressPrint(i+1,nElementGroups);
+        const RElementGroup *pElementGroup = this->getElementGroupPtr(i);
+        for (uint j=0;j<pElementGroup->size();j++)
         {
-            const RElement &element = this->getElement(volume.get(j));
-            for (uint k=0;k<element.size();k++)
+            const RElement &rElement = this->getElement(pElementGroup->get(j));
+            for (uint k=0;k<rElement.size();k++)
             {
-                int nodeID = int(element.getNodeId(k));
-                if (nodeGroup[nodeID] != nodeGroupCounter)
+                int nodeID = int(rElement.getNodeId(k));
+                if (nodeGroup[nodeID] != i)
                 {
-                    nodeGroup[nodeID] = nodeGroupCounter;
+                    nodeGroup[nodeID] = i;
                     nodeCount[nodeID]++;
                 }
             }
         }
-        nodeGroupCounter++;
     }
 
     for (uint i=0;i<this->getNNodes();i++)
@@ -4559,48 +5067,31 @@ QVector<bool> RModel::findEdgeNodes() const
         edgeNodes[int(i)] = (nodeCount[int(i)] > 1);
     }
 
-    // Add to edge nodes element nodes which neighbor count is less than expected.
-    if (this->surfaceNeigs.size() == this->getNElements())
+    // Nodes on boundary and non-manifold sides of surface and volume elements are edge nodes.
+    const RMeshTopology &rMeshTopology = this->getMeshTopology();
+    for (uint i=0;i<rMeshTopology.getNSides();i++)
     {
-        for (uint i=0;i<this->getNSurfaces();i++)
+        if (!rMeshTopology.isBoundarySide(i) && rMeshTopology.isManifoldSide(i))
         {
-            const RSurface &rSurface = this->getSurface(i);
-            for (uint j=0;j<rSurface.size();j++)
-            {
-                uint elementID = rSurface.get(j);
-                const RElement &rElement = this->getElement(elementID);
-                if (rElement.getNNeighbors(rElement.getType()) != this->surfaceNeigs[elementID].size())
-                {
-                    for (uint k=0;k<rElement.size();k++)
-                    {
-                        edgeNodes[int(rElement.getNodeId(k))] = true;
-                    }
-                }
-            }
+            continue;
         }
-    }
-    if (this->volumeNeigs.size() == this->getNElements())
-    {
-        for (uint i=0;i<this->getNVolumes();i++)
+        for (uint j=0;j<rMeshTopology.getNSideElements(i);j++)
         {
-            const RVolume &rVolume = this->getVolume(i);
-            for (uint j=0;j<rVolume.size();j++)
+            uint elementID = rMeshTopology.getSideElementID(i,j);
+            const RElement &rElement = this->getElement(elementID);
+            if (R_ELEMENT_TYPE_IS_SURFACE(rElement.getType()))
             {
-                uint elementID = rVolume.get(j);
-                const RElement &rElement = this->getElement(elementID);
-                uint nEdges = rElement.getNEdgeElements();
-                RBVector edgeBook(nEdges,false);
-                for (uint k=0;k<this->volumeNeigs[elementID].size();k++)
+                // Surface element with unexpected number of neighbors has all its nodes marked.
+                for (uint k=0;k<rElement.size();k++)
                 {
-                    uint edgePosition = rElement.findEdgePositionForNeighborElement(this->getElement(this->volumeNeigs[elementID][k]));
-                    if (edgePosition != RConstants::eod)
-                    {
-                        edgeBook[edgePosition] = true;
-                    }
+                    edgeNodes[int(rElement.getNodeId(k))] = true;
                 }
-                for (uint k=0;k<edgeBook.size();k++)
+            }
+            else if (rMeshTopology.isBoundarySide(i))
+            {
+                for (uint k=0;k<rMeshTopology.getNElementSides(elementID);k++)
                 {
-                    if (edgeBook[k])
+                    if (rMeshTopology.getElementSideID(elementID,k) != i)
                     {
                         continue;
                     }
@@ -4715,12 +5206,12 @@ QList<uint> RModel::sortLineElements(const QList<RElement> &edges, uint firstID)
 
 QList<uint> RModel::findNodeEdgeRing(uint nodeID) const
 {
-    std::vector<uint> elementPositions = this->findElementPositionsByNodeId(nodeID);
+    const RMeshTopology &rMeshTopology = this->getMeshTopology();
 
     QList<RElement> edges;
-    for (std::vector<uint>::reverse_iterator rIterEps = elementPositions.rbegin(); rIterEps != elementPositions.rend(); ++rIterEps)
+    for (uint j=rMeshTopology.getNNodeElements(nodeID);j>0;j--)
     {
-        std::vector<RElement> edgeElements = this->getElement(*rIterEps).generateEdgeElements();
+        std::vector<RElement> edgeElements = this->getElement(rMeshTopology.getNodeElementID(nodeID,j-1)).generateEdgeElements();
         for (uint i=0;i<edgeElements.size();i++)
         {
             if (edgeElements[i].hasNodeId(nodeID) || !R_ELEMENT_TYPE_IS_LINE(edgeElements[i].getType()))
@@ -5132,63 +5623,22 @@ uint RModel::fixSliverElements(double edgeRatio)
     RLogger::indent();
     RLogger::info("Edge (aspect) ratio limit = %g\n",edgeRatio);
 
-    uint nAffected = 0;
+    REdgeCollapse edgeCollapse(this->nodes,this->elements,true);
+    edgeCollapse.setEdgeRatioLimit(edgeRatio);
 
-    for (uint i=0;i<this->getNElements();i++)
+    RProgressInitialize("Fixing sliver elements",true);
+    uint nAffected = edgeCollapse.collapse();
+    RProgressFinalize();
+
+    if (nAffected > 0)
     {
-        const RElement &rElement = this->getElement(i);
-        double lMax = 0.0;
-        double lMin = 0.0;
-        bool firstTime = true;
-        uint n1 = RConstants::eod;
-        uint n2 = RConstants::eod;
-        for (uint j=0;j<rElement.size();j++)
-        {
-            for (uint k=j+1;k<rElement.size();k++)
-            {
-                double distance = this->nodes[rElement.getNodeId(j)].getDistance(this->nodes[rElement.getNodeId(k)]);
-                if (firstTime)
-                {
-                    lMax = lMin = distance;
-                    n1 = rElement.getNodeId(j);
-                    n2 = rElement.getNodeId(k);
-                    firstTime = false;
-                }
-                else
-                {
-                    lMax = std::max(lMax,distance);
-                    if (lMin > distance)
-                    {
-                        lMin = distance;
-                        n1 = rElement.getNodeId(j);
-                        n2 = rElement.getNodeId(k);
-                    }
-                }
-            }
-        }
+        this->nodes = edgeCollapse.getNodes();
+        this->elements = edgeCollapse.getElements();
+        this->invalidateMeshTopology();
+        this->purgeUnusedNodes();
+    }
 
-        if (n1 == RConstants::eod || n2 == RConstants::eod || n1 == n2)
-        {
-            continue;
-        }
-
-        if (lMin <= RConstants::eps || (lMax/lMin) >= edgeRatio)
-        {
-            try
-            {
-                this->mergeNodes(n1,n2,true,true);
-            }
-            catch (const RError &rError)
-            {
-                RLogger::unindent();
-                throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to merge nodes %u and %u. %s",n1,n2,rError.getMessage().toUtf8().constData());
-            }
-
-            nAffected++;
-        }
-    }
-
-    this->fixElementGroupRelations();
+    this->fixElementGroupRelations();
 
     RLogger::unindent();
     return nAffected;
@@ -5211,71 +5661,37 @@ uint RModel::fixElementGroupRelations()
     uint nAffected = 0;
 
     // Move elements to appropriate groups.
-    for (uint i=0;i<this->getNLines();i++)
-    {
-        RLine &rLine = this->getLine(i);
-        for (uint j=0;j<rLine.size();j++)
-        {
-            uint elementID = rLine.get(j);
-            if (R_ELEMENT_TYPE_IS_POINT(this->getElement(elementID).getType()))
-            {
-                rLine.remove(j);
-                pointGroup.add(elementID);
-                j--;
-                nAffected++;
-            }
-        }
-    }
-    for (uint i=0;i<this->getNSurfaces();i++)
+    // Each group is compacted in single pass instead of removing items one by one.
+    for (uint i=0;i<this->getNElementGroups();i++)
     {
-        RSurface &rSurface = this->getSurface(i);
-        for (uint j=0;j<rSurface.size();j++)
+        RElementGroup *pElementGroup = this->getElementGroupPtr(i);
+        REntityGroupType groupType = this->getEntityGroupType(i,true);
+        uint nKept = 0;
+        for (uint j=0;j<pElementGroup->size();j++)
         {
-            uint elementID = rSurface.get(j);
-            if (R_ELEMENT_TYPE_IS_POINT(this->getElement(elementID).getType()))
+            uint elementID = pElementGroup->get(j);
+            RElementType elementType = this->getElement(elementID).getType();
+            if (groupType != R_ENTITY_GROUP_POINT && R_ELEMENT_TYPE_IS_POINT(elementType))
             {
-                rSurface.remove(j);
                 pointGroup.add(elementID);
-                j--;
                 nAffected++;
             }
-            else if (R_ELEMENT_TYPE_IS_LINE(this->getElement(elementID).getType()))
+            else if ((groupType == R_ENTITY_GROUP_SURFACE || groupType == R_ENTITY_GROUP_VOLUME) && R_ELEMENT_TYPE_IS_LINE(elementType))
             {
-                rSurface.remove(j);
                 lineGroup.add(elementID);
-                j--;
-                nAffected++;
-            }
-        }
-    }
-    for (uint i=0;i<this->getNVolumes();i++)
-    {
-        RVolume &rVolume = this->getVolume(i);
-        for (uint j=0;j<rVolume.size();j++)
-        {
-            uint elementID = rVolume.get(j);
-            if (R_ELEMENT_TYPE_IS_POINT(this->getElement(elementID).getType()))
-            {
-                rVolume.remove(j);
-                pointGroup.add(elementID);
-                j--;
                 nAffected++;
             }
-            else if (R_ELEMENT_TYPE_IS_LINE(this->getElement(elementID).getType()))
+            else if (groupType == R_ENTITY_GROUP_VOLUME && R_ELEMENT_TYPE_IS_SURFACE(elementType))
             {
-                rVolume.remove(j);
-                lineGroup.add(elementID);
-                j--;
+                surfaceGroup.add(elementID);
                 nAffected++;
             }
-            else if (R_ELEMENT_TYPE_IS_SURFACE(this->getElement(elementID).getType()))
+            else
             {
-                rVolume.remove(j);
-                surfaceGroup.add(elementID);
-                j--;
-                nAffected++;
+                pElementGroup->set(nKept++,elementID);
             }
         }
+        pElementGroup->resize(nKept);
     }
 
     if (pointGroup.size() > 0)
@@ -5341,38 +5757,11 @@ QList<uint> RModel::findSliverElements(double edgeRatio) const
 
     for (uint i=0;i<this->getNElements();i++)
     {
-        const RElement &rElement = this->getElement(i);
-        double lMax = 0.0;
         double lMin = 0.0;
-        bool firstTime = true;
+        double lMax = 0.0;
         uint n1 = RConstants::eod;
         uint n2 = RConstants::eod;
-        for (uint j=0;j<rElement.size();j++)
-        {
-            for (uint k=j+1;k<rElement.size();k++)
-            {
-                double distance = this->nodes[rElement.getNodeId(j)].getDistance(this->nodes[rElement.getNodeId(k)]);
-                if (firstTime)
-                {
-                    lMax = lMin = distance;
-                    n1 = rElement.getNodeId(j);
-                    n2 = rElement.getNodeId(k);
-                    firstTime = false;
-                }
-                else
-                {
-                    lMax = std::max(lMax,distance);
-                    if (lMin > distance)
-                    {
-                        lMin = distance;
-                        n1 = rElement.getNodeId(j);
-                        n2 = rElement.getNodeId(k);
-                    }
-                }
-            }
-        }
-
-        if (n1 == RConstants::eod || n2 == RConstants::eod || n1 == n2)
+        if (!REdgeCollapse::findEdgeLengths(this->getElement(i),this->nodes,lMin,lMax,n1,n2))
         {
             continue;
         }
@@ -5715,6 +6104,8 @@ uint RModel::breakIntersectedElements(uint nIterations, const std::vector<uint>
         RLogger::unindent();
     }
 
+    this->invalidateMeshTopology();
+
     // Remove degenerated elements.
     RLogger::info("Removing degenerated elements\n");
     RLogger::indent();
@@ -6022,111 +6413,59 @@ bool RModel::boolUnion(uint nIterations, QList<uint> surfaceEntityIDs)
 
 uint RModel::coarsenSurfaceElements(const std::vector<uint> surfaceIDs, double edgeLength, double elementArea)
 {
-    std::vector<bool> ecBook;
+    RBVector ecBook;
     ecBook.resize(this->getNElements(),false);
-    std::vector<bool> edBook;
-    edBook.resize(this->getNElements(),false);
 
     for (uint i=0;i<surfaceIDs.size();i++)
     {
         const RSurface &rSurface = this->getSurface(surfaceIDs[i]);
         for (uint j=0;j<rSurface.size();j++)
         {
-            ecBook[rSurface.get(j)] = true;
+            if (R_ELEMENT_TYPE_IS_SURFACE(this->getElement(rSurface.get(j)).getType()))
+            {
+                ecBook[rSurface.get(j)] = true;
+            }
         }
     }
 
-    bool elementDeleted = false;
+    REdgeCollapse edgeCollapse(this->nodes,this->elements,false);
+    edgeCollapse.setCandidates(ecBook);
+    edgeCollapse.setEdgeLengthLimit(edgeLength);
+    edgeCollapse.setElementAreaLimit(elementArea);
 
     RProgressInitialize("Coarsening surface elements",true);
-    uint nDeleted = 0;
-    do
-    {
-        elementDeleted = false;
-        for (uint i=0;i<this->getNElements();i++)
-        {
-            if (!ecBook[i])
-            {
-                continue;
-            }
-            if (edBook[i])
-            {
-                continue;
-            }
-            RProgressPrint(1.0);
-
-            const RElement &rElement = this->getElement(i);
-            if (!R_ELEMENT_TYPE_IS_SURFACE(rElement.getType()))
-            {
-                continue;
-            }
-
-            double length = 0.0;
-            uint np1 = 0;
-            uint np2 = 0;
-            if (!rElement.findShortestEdge(this->nodes,length,np1,np2))
-            {
-                continue;
-            }
-            uint node1 = rElement.getNodeId(np1);
-            uint node2 = rElement.getNodeId(np2);
-
-            if (length < edgeLength)
-            {
-                if (node1 != node2)
-                {
-                    this->mergeNodes(node1,node2,true,false);
-                }
-                edBook[i] = true;
-                elementDeleted = true;
-                nDeleted++;
-                continue;
-            }
-
-            double area = 0.0;
-            if (!rElement.findArea(this->nodes,area))
-            {
-                continue;
-            }
+    edgeCollapse.collapse();
+    RProgressFinalize("Done");
 
-            if (area < elementArea)
-            {
-                if (node1 != node2)
-                {
-                    this->mergeNodes(node1,node2,true,false);
-                }
-                edBook[i] = true;
-                elementDeleted = true;
-                nDeleted++;
-            }
-        }
-    } while (elementDeleted);
+    this->nodes = edgeCollapse.getNodes();
+    this->elements = edgeCollapse.getElements();
+    this->invalidateMeshTopology();
 
     //! Delete elements with duplicate nodes.
-    for (uint i=0;i<this->getNElements();i++)
+    const RBVector &edBook = edgeCollapse.getCollapsedBook();
+    uint nDeleted = 0;
+    for (uint i=0;i<this->getNElementGroups();i++)
     {
-        const RElement &rElement = this->getElement(i);
-        if (rElement.hasDuplicateNodes())
+        RElementGroup *pElementGroup = this->getElementGroupPtr(i);
+        uint nKept = 0;
+        for (uint j=0;j<pElementGroup->size();j++)
         {
-            edBook[i] = true;
-            nDeleted++;
+            if (!edBook[pElementGroup->get(j)])
+            {
+                pElementGroup->set(nKept++,pElementGroup->get(j));
+            }
         }
+        pElementGroup->resize(nKept);
     }
-
-    QList<uint> elementIDs;
-    elementIDs.reserve(int(nDeleted));
-
     for (uint i=0;i<edBook.size();i++)
     {
         if (edBook[i])
         {
-            elementIDs.push_back(i);
+            nDeleted++;
         }
     }
-    RProgressFinalize("Done");
-
-    this->removeElements(elementIDs,false);
 
+    this->purgeUnusedElements();
     this->purgeUnusedNodes();
 
     return nDeleted;
@@ -6821,217 +7160,9 @@ void RModel::convertElementToNodeVector(const RRVector &elementValues,
                                         RRVector &nodeValues,
                                         bool onlySetValues) const
 {
-    nodeValues.resize(this->getNNodes(),0.0);
-
-    if (onlySetValues)
-    {
-        for (uint i=0;i<setValues.size();i++)
-        {
-            if (setValues[i])
-            {
-                const RElement &rElement = this->getElement(i);
-                for (uint j=0;j<rElement.size();j++)
-                {
-                    nodeValues[rElement.getNodeId(j)] = 0.0;
-                }
-            }
-        }
-    }
-    else
-    {
-        nodeValues.fill(0.0);
-    }
-
-    std::vector<double> nodeDistance;
-    nodeDistance.resize(this->getNNodes(),0.0);
-
-    if (!onlySetValues)
-    {
-        // Volume elements.
-        for (uint i=0;i<this->getNVolumes();i++)
-        {
-            const RVolume &rVolume = this->getVolume(i);
-            for (uint j=0;j<rVolume.size();j++)
-            {
-                uint elementID = rVolume.get(j);
-                const RElement &element = this->getElement(elementID);
-                if (!setValues[elementID])
-                {
-                    RR3Vector center;
-                    element.findCenter(this->nodes,center[0],center[1],center[2]);
-                    for (uint j=0;j<element.size();j++)
-                    {
-                        double d = this->nodes[element.getNodeId(j)].getDistance(RNode(center));
-                        d = (d < RConstants::eps) ? 1.0 / RConstants::eps : 1.0 / d;
-
-                        nodeValues[element.getNodeId(j)] += d*elementValues[elementID];
-                        nodeDistance[element.getNodeId(j)] += d;
-                    }
-                }
-            }
-        }
-        // Surface elements.
-        for (uint i=0;i<this->getNSurfaces();i++)
-        {
-            const RSurface &rSurface = this->getSurface(i);
-            for (uint j=0;j<rSurface.size();j++)
-            {
-                uint elementID = rSurface.get(j);
-                const RElement &element = this->getElement(elementID);
-                if (!setValues[elementID])
-                {
-                    if (rSurface.getThickness() > 0.0)
-                    {
-                        RR3Vector center;
-                        element.findCenter(this->nodes,center[0],center[1],center[2]);
-                        for (uint j=0;j<element.size();j++)
-                        {
-                            double d = this->nodes[element.getNodeId(j)].getDistance(RNode(center));
-                            d = (d < RConstants::eps) ? 1.0 / RConstants::eps : 1.0 / d;
-
-                            nodeValues[element.getNodeId(j)] += d*elementValues[elementID];
-                            nodeDistance[element.getNodeId(j)] += d;
-                        }
-                    }
-                }
-            }
-        }
-        // Line elements.
-        for (uint i=0;i<this->getNLines();i++)
-        {
-            const RLine &rLine = this->getLine(i);
-            for (uint j=0;j<rLine.size();j++)
-            {
-                uint elementID = rLine.get(j);
-                const RElement &element = this->getElement(elementID);
-                if (!setValues[elementID])
-                {
-                    if (rLine.getCrossArea() > 0.0)
-                    {
-                        RR3Vector center;
-                        element.findCenter(this->nodes,center[0],center[1],center[2]);
-                        for (uint j=0;j<element.size();j++)
-                        {
-                            double d = this->nodes[element.getNodeId(j)].getDistance(RNode(center));
-                            d = (d < RConstants::eps) ? 1.0 / RConstants::eps : 1.0 / d;
-
-                            nodeValues[element.getNodeId(j)] += d*elementValues[elementID];
-                            nodeDistance[element.getNodeId(j)] += d;
-                        }
-                    }
-                }
-            }
-        }
-        // Point elements.
-        for (uint i=0;i<this->getNPoints();i++)
-        {
-            const RPoint &rPoint = this->getPoint(i);
-            for (uint j=0;j<rPoint.size();j++)
-            {
-                uint elementID = rPoint.get(j);
-                const RElement &element = this->getElement(elementID);
-                if (!setValues[elementID])
-                {
-                    if (rPoint.getVolume() > 0.0)
-                    {
-                        for (uint j=0;j<element.size();j++)
-                        {
-                            nodeValues[element.getNodeId(j)] += elementValues[elementID] / RConstants::eps;
-                            nodeDistance[element.getNodeId(j)] += 1.0 / RConstants::eps;
-                        }
-                    }
-                }
-            }
-        }
-    }
-
-    // Volume elements.
-    for (uint i=0;i<this->getNVolumes();i++)
-    {
-        const RVolume &rVolume = this->getVolume(i);
-        for (uint j=0;j<rVolume.size();j++)
-        {
-            uint elementID = rVolume.get(j);
-            const RElement &element = this->getElement(elementID);
-            if (setValues[elementID])
-            {
-                for (uint j=0;j<element.size();j++)
-                {
-                    nodeValues[element.getNodeId(j)] = elementValues[elementID];
-                    nodeDistance[element.getNodeId(j)] = 1.0;
-                }
-            }
-        }
-    }
-    // Surface elements.
-    for (uint i=0;i<this->getNSurfaces();i++)
-    {
-        const RSurface &rSurface = this->getSurface(i);
-        for (uint j=0;j<rSurface.size();j++)
-        {
-            uint elementID = rSurface.get(j);
-            const RElement &element = this->getElement(elementID);
-            if (setValues[elementID])
-            {
-                for (uint j=0;j<element.size();j++)
-                {
-                    nodeValues[element.getNodeId(j)] = elementValues[elementID];
-                    nodeDistance[element.getNodeId(j)] = 1.0;
-                }
-            }
-        }
-    }
-    // Line elements.
-    for (uint i=0;i<this->getNLines();i++)
-    {
-        const RLine &rLine = this->getLine(i);
-        for (uint j=0;j<rLine.size();j++)
-        {
-            uint elementID = rLine.get(j);
-            const RElement &element = this->getElement(elementID);
-            if (setValues[elementID])
-            {
-                for (uint j=0;j<element.size();j++)
-                {
-                    nodeValues[element.getNodeId(j)] = elementValues[elementID];
-                    nodeDistance[element.getNodeId(j)] = 1.0;
-                }
-            }
-        }
-    }
-    // Point elements.
-    for (uint i=0;i<this->getNPoints();i++)
-    {
-        const RPoint &rPoint = this->getPoint(i);
-        for (uint j=0;j<rPoint.size();j++)
-        {
-            uint elementID = rPoint.get(j);
-            const RElement &element = this->getElement(elementID);
-            if (setValues[elementID])
-            {
-                for (uint j=0;j<element.size();j++)
-                {
-                    nodeValues[element.getNodeId(j)] = elementValues[elementID];
-                    nodeDistance[element.getNodeId(j)] = 1.0;
-                }
-            }
-        }
-    }
-
-    if (!onlySetValues)
-    {
-        for (uint i=0;i<this->getNNodes();i++)
-        {
-            if (nodeDistance[i] == 0.0)
-            {
-                nodeValues[i] = 0.0;
-            }
-            else
-            {
-                nodeValues[i] /= double(nodeDistance[i]);
-            }
-        }
-    }
+    RNodeElementIncidence nodeElementIncidence;
+    nodeElementIncidence.build(*this);
+    nodeElementIncidence.convertElementToNode(elementValues,setValues,nodeValues,onlySetValues);
 } /* RModel::convertElementToNodeVector */
 
 
@@ -7244,30 +7375,165 @@ void RModel::writeLink(const QString &linkFileName, const QString &targetFileNam
 } /* RModel::writeLink */
 
 
-QString RModel::readAscii(const QString &fileName)
+QString RModel::getTimeSolverFileName(const QString &fileName)
+{
+    return RFileManager::getFileNameWithSuffix(RFileManager::getFileNameWithOutTimeStep(fileName),"time");
+} /* RModel::getTimeSolverFileName */
+
+
+void RModel::readTimeSolver(const QString &fileName, RTimeSolver &timeSolver)
 {
     if (fileName.isEmpty())
     {
         throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
     }
 
-    RLogger::info("Reading ascii model file \'%s\'\n",fileName.toUtf8().constData());
+    QString ext = RFileManager::getExtension(fileName);
+    bool binary = true;
+    if (ext == RModel::getDefaultFileExtension(false))
+    {
+        binary = false;
+    }
+    else if (ext != RModel::getDefaultFileExtension(true))
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF, "Unknown extension \"" + ext + "\".");
+    }
 
-    RFile modelFile(fileName,RFile::ASCII);
+    RFile timeSolverFile(fileName,binary?RFile::BINARY:RFile::ASCII);
 
-    if (!modelFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    if (!timeSolverFile.open(binary?QIODevice::ReadOnly:(QIODevice::ReadOnly | QIODevice::Text)))
     {
         throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
     }
 
     RFileHeader fileHeader;
 
-    RFileIO::readAscii(modelFile,fileHeader);
-    if (fileHeader.getType() == R_FILE_TYPE_LINK)
+    if (binary)
     {
-        QString targetFileName(RFileManager::findLinkTargetFileName(fileName,fileHeader.getInformation()));
-        RLogger::info("File \'%s\' is a link file pointing to \'%s\'\n",fileName.toUtf8().constData(),targetFileName.toUtf8().constData());
-        return targetFileName;
+        RFileIO::readBinary(timeSolverFile,fileHeader);
+    }
+    else
+    {
+        RFileIO::readAscii(timeSolverFile,fileHeader);
+    }
+    if (fileHeader.getType() != R_FILE_TYPE_TIME_SOLVER)
+    {
+        throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"File type of the file \'" + fileName + "\' is not TIME SOLVER.");
+    }
+
+    timeSolverFile.setVersion(fileHeader.getVersion());
+
+    if (binary)
+    {
+        RFileIO::readBinary(timeSolverFile,timeSolver);
+    }
+    else
+    {
+        RFileIO::readAscii(timeSolverFile,timeSolver);
+    }
+
+    timeSolverFile.close();
+} /* RModel::readTimeSolver */
+
+
+void RModel::writeTimeSolver(const QString &fileName, const RTimeSolver &timeSolver)
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    QString ext = RFileManager::getExtension(fileName);
+    bool binary = true;
+    if (ext == RModel::getDefaultFileExtension(false))
+    {
+        binary = false;
+    }
+    else if (ext != RModel::getDefaultFileExtension(true))
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF, "Unknown extension \"" + ext + "\".");
+    }
+
+    RSaveFile timeSolverFile(fileName,binary?RSaveFile::BINARY:RSaveFile::ASCII);
+
+    if (!timeSolverFile.open(binary?QIODevice::WriteOnly:(QIODevice::WriteOnly | QIODevice::Text)))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    if (binary)
+    {
+        RFileIO::writeBinary(timeSolverFile,RFileHeader(R_FILE_TYPE_TIME_SOLVER,_version));
+        RFileIO::writeBinary(timeSolverFile,timeSolver);
+    }
+    else
+    {
+        RFileIO::writeAscii(timeSolverFile,RFileHeader(R_FILE_TYPE_TIME_SOLVER,_version));
+        RFileIO::writeAscii(timeSolverFile,timeSolver);
+    }
+
+    timeSolverFile.commit();
+} /* RModel::writeTimeSolver */
+
+
+QString RModel::readAscii(const QString &fileName)
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    RLogger::info("Reading ascii model file \'%s\'\n",fileName.toUtf8().constData());
+
+    RFile modelFile(fileName,RFile::ASCII);
+
+    if (!modelFile.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    RFileHeader fileHeader;
+
+    RFileIO::readAscii(modelFile,fileHeader);
+    if (fileHeader.getType() == R_FILE_TYPE_LINK)
+    {
+        QString targetFileName(RFileManager::findLinkTargetFileName(fileName,fileHeader.getInformation()));
+        RLogger::info("File \'%s\' is a link file pointing to \'%s\'\n",fileName.toUtf8().constData(),targetFileName.toUtf8().constData());
+        return targetFileName;
+    }
+    if (fileHeader.getType() == R_FILE_TYPE_MODEL_RESULTS)
+    {
+        QString baseFileName(RFileManager::findLinkTargetFileName(fileName,fileHeader.getInformation()));
+        RLogger::info("File \'%s\' contains only results, model is read from \'%s\'\n",fileName.toUtf8().constData(),baseFileName.toUtf8().constData());
+
+        // Read mesh and setup from base record and overlay results.
+        // Base record variables are replaced so their values are never loaded.
+        this->readRecord(baseFileName,true);
+
+        modelFile.setVersion(fileHeader.getVersion());
+
+        RFileIO::readAscii(modelFile,this->timeSolver);
+        RFileIO::readAscii(modelFile,this->problemSetup);
+
+        uint nResultsNodes = 0;
+        uint nResultsElements = 0;
+        RFileIO::readAscii(modelFile,nResultsNodes);
+        RFileIO::readAscii(modelFile,nResultsElements);
+        this->checkResultsSize(fileName,baseFileName,nResultsNodes,nResultsElements);
+        this->RResults::nnodes = nResultsNodes;
+        this->RResults::nelements = nResultsElements;
+        uint nVariables = 0;
+        RFileIO::readAscii(modelFile,nVariables);
+        this->clearResults();
+        this->RResults::variables.resize(nVariables);
+        for (uint i=0;i<this->RResults::variables.size();i++)
+        {
+            RFileIO::readAscii(modelFile,this->RResults::variables[i]);
+        }
+
+        modelFile.close();
+
+        return QString();
     }
     if (fileHeader.getType() != R_FILE_TYPE_MODEL)
     {
@@ -7378,6 +7644,7 @@ QString RModel::readAscii(const QString &fileName)
     RFileIO::readAscii(modelFile,this->RResults::nelements);
     uint nVariables = 0;
     RFileIO::readAscii(modelFile,nVariables);
+    this->clearResults();
     this->RResults::variables.resize(nVariables);
     for (uint i=0;i<this->RResults::variables.size();i++)
     {
@@ -7406,7 +7673,7 @@ QString RModel::readAscii(const QString &fileName)
 } /* RModel::readAscii */
 
 
-QString RModel::readBinary(const QString &fileName)
+QString RModel::readBinary(const QString &fileName, bool lazyVariables)
 {
     if (fileName.isEmpty())
     {
@@ -7431,6 +7698,39 @@ QString RModel::readBinary(const QString &fileName)
         RLogger::info("File \'%s\' is a link file pointing to \'%s\'\n",fileName.toUtf8().constData(),targetFileName.toUtf8().constData());
         return targetFileName;
     }
+    if (fileHeader.getType() == R_FILE_TYPE_MODEL_RESULTS)
+    {
+        QString baseFileName(RFileManager::findLinkTargetFileName(fileName,fileHeader.getInformation()));
+        RLogger::info("File \'%s\' contains only results, model is read from \'%s\'\n",fileName.toUtf8().constData(),baseFileName.toUtf8().constData());
+
+        // Read mesh and setup from base record and overlay results.
+        // Base record variables are replaced so their values are never loaded.
+        this->readRecord(baseFileName,true);
+
+        modelFile.setVersion(fileHeader.getVersion());
+        this->readBinaryCompression(modelFile);
+
+        std::vector<RVariableLocation> variableLocations;
+        this->readBinaryTableOfContents(modelFile,variableLocations);
+
+        RFileIO::readBinary(modelFile,this->timeSolver);
+        RFileIO::readBinary(modelFile,this->problemSetup);
+
+        uint nResultsNodes = 0;
+        uint nResultsElements = 0;
+        RFileIO::readBinary(modelFile,nResultsNodes);
+        RFileIO::readBinary(modelFile,nResultsElements);
+        this->checkResultsSize(fileName,baseFileName,nResultsNodes,nResultsElements);
+        this->RResults::nnodes = nResultsNodes;
+        this->RResults::nelements = nResultsElements;
+        uint nVariables = 0;
+        RFileIO::readBinary(modelFile,nVariables);
+        this->readBinaryVariables(modelFile,fileName,nVariables,variableLocations,lazyVariables);
+
+        modelFile.close();
+
+        return QString();
+    }
     if (fileHeader.getType() != R_FILE_TYPE_MODEL)
     {
         throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"File type of the file \'" + fileName + "\' is not MODEL.");
@@ -7438,25 +7738,17 @@ QString RModel::readBinary(const QString &fileName)
 
     // Set file version
     modelFile.setVersion(fileHeader.getVersion());
+    this->readBinaryCompression(modelFile);
+
+    std::vector<RVariableLocation> variableLocations;
+    this->readBinaryTableOfContents(modelFile,variableLocations);
 
     // Reading mesh/model values
 
     RFileIO::readBinary(modelFile,this->name);
     RFileIO::readBinary(modelFile,this->description);
-    uint nNodes = 0;
-    RFileIO::readBinary(modelFile,nNodes);
-    this->nodes.resize(nNodes);
-    for (uint i=0;i<nNodes;i++)
-    {
-        RFileIO::readBinary(modelFile,this->nodes[i]);
-    }
-    uint nElements = 0;
-    RFileIO::readBinary(modelFile,nElements);
-    this->elements.resize(nElements);
-    for (uint i=0;i<nElements;i++)
-    {
-        RFileIO::readBinary(modelFile,this->elements[i]);
-    }
+    RFileIO::readBinary(modelFile,this->nodes);
+    RFileIO::readBinary(modelFile,this->elements);
     uint nPoints = 0;
     RFileIO::readBinary(modelFile,nPoints);
     this->points.resize(nPoints);
@@ -7540,11 +7832,7 @@ QString RModel::readBinary(const QString &fileName)
     RFileIO::readBinary(modelFile,this->RResults::nelements);
     uint nVariables = 0;
     RFileIO::readBinary(modelFile,nVariables);
-    this->RResults::variables.resize(nVariables);
-    for (uint i=0;i<this->RResults::variables.size();i++)
-    {
-        RFileIO::readBinary(modelFile,this->RResults::variables[i]);
-    }
+    this->readBinaryVariables(modelFile,fileName,nVariables,variableLocations,lazyVariables);
 
     // Reading neighbor information.
     uint nSurfaceNeigs = 0;
@@ -7579,6 +7867,9 @@ void RModel::writeAscii(const QString &fileName) const
 
     RLogger::info("Writing ascii model file \'%s\'\n",fileName.toUtf8().constData());
 
+    // Variables which were not loaded yet would be lost once the file is replaced.
+    this->releaseVariableLoader(fileName);
+
     RSaveFile modelFile(fileName,RSaveFile::ASCII);
 
     if (!modelFile.open(QIODevice::WriteOnly | QIODevice::Text))
@@ -7605,20 +7896,12 @@ void RModel::writeAscii(const QString &fileName) const
 
     RFileIO::writeAscii(modelFile,"\"" + this->name + "\"");
     RFileIO::writeAscii(modelFile,"\"" + this->description + "\"");
-    RFileIO::writeAscii(modelFile,this->getNNodes());
-    for (uint i=0;i<this->getNNodes();i++)
-    {
-        RProgressPrint(cstep++,nsteps);
-        RFileIO::writeAscii(modelFile,this->nodes[i],false);
-        RFileIO::writeNewLineAscii(modelFile);
-    }
-    RFileIO::writeAscii(modelFile,this->getNElements());
-    for (uint i=0;i<this->getNElements();i++)
-    {
-        RProgressPrint(cstep++,nsteps);
-        RFileIO::writeAscii(modelFile,this->elements[i],false);
-        RFileIO::writeNewLineAscii(modelFile);
-    }
+    RFileIO::writeAscii(modelFile,this->nodes);
+    cstep += this->getNNodes();
+    RProgressPrint(cstep,nsteps);
+    RFileIO::writeAscii(modelFile,this->elements);
+    cstep += this->getNElements();
+    RProgressPrint(cstep,nsteps);
     RFileIO::writeAscii(modelFile,this->getNPoints());
     for (uint i=0;i<this->getNPoints();i++)
     {
@@ -7700,7 +7983,7 @@ void RModel::writeAscii(const QString &fileName) const
     RFileIO::writeAscii(modelFile,uint(this->RResults::variables.size()));
     for (uint i=0;i<this->RResults::variables.size();i++)
     {
-        RFileIO::writeAscii(modelFile,this->RResults::variables[i]);
+        RFileIO::writeAscii(modelFile,this->getVariable(i));
     }
 
     // Writing neighbor information.
@@ -7732,6 +8015,9 @@ void RModel::writeBinary(const QString &fileName) const
 
     RLogger::info("Writing binary model file \'%s\'\n",fileName.toUtf8().constData());
 
+    // Variables which were not loaded yet would be lost once the file is replaced.
+    this->releaseVariableLoader(fileName);
+
     RSaveFile modelFile(fileName,RSaveFile::BINARY);
 
     if (!modelFile.open(QIODevice::WriteOnly))
@@ -7753,23 +8039,23 @@ void RModel::writeBinary(const QString &fileName) const
     uint cstep = 0;
 
     RFileIO::writeBinary(modelFile,RFileHeader(R_FILE_TYPE_MODEL,_version));
+    this->writeBinaryCompression(modelFile);
+
+    // Table of contents is updated once all variables are written.
+    qint64 tocOffset = modelFile.pos();
+    std::vector<RVariableLocation> variableLocations(this->RResults::variables.size());
+    RFileIO::writeBinary(modelFile,variableLocations);
 
     // Writing mesh/model values
 
     RFileIO::writeBinary(modelFile,this->name);
     RFileIO::writeBinary(modelFile,this->description);
-    RFileIO::writeBinary(modelFile,this->getNNodes());
-    for (uint i=0;i<this->getNNodes();i++)
-    {
-        RProgressPrint(cstep++,nsteps);
-        RFileIO::writeBinary(modelFile,this->nodes[i]);
-    }
-    RFileIO::writeBinary(modelFile,this->getNElements());
-    for (uint i=0;i<this->getNElements();i++)
-    {
-        RProgressPrint(cstep++,nsteps);
-        RFileIO::writeBinary(modelFile,this->elements[i]);
-    }
+    RFileIO::writeBinary(modelFile,this->nodes);
+    cstep += this->getNNodes();
+    RProgressPrint(cstep,nsteps);
+    RFileIO::writeBinary(modelFile,this->elements);
+    cstep += this->getNElements();
+    RProgressPrint(cstep,nsteps);
     RFileIO::writeBinary(modelFile,this->getNPoints());
     for (uint i=0;i<this->getNPoints();i++)
     {
@@ -7842,7 +8128,7 @@ void RModel::writeBinary(const QString &fileName) const
     RFileIO::writeBinary(modelFile,uint(this->RResults::variables.size()));
     for (uint i=0;i<this->RResults::variables.size();i++)
     {
-        RFileIO::writeBinary(modelFile,this->RResults::variables[i]);
+        RFileIO::writeBinary(modelFile,this->getVariable(i),variableLocations[i]);
     }
 
     // Writing neighbor information.
@@ -7857,153 +8143,218 @@ void RModel::writeBinary(const QString &fileName) const
         RFileIO::writeBinary(modelFile,this->volumeNeigs[i]);
     }
 
+    this->writeBinaryTableOfContents(modelFile,tocOffset,variableLocations);
+
     modelFile.commit();
 
     RProgressFinalize("Done");
 } /* RModel::writeBinary */
 
 
-std::vector<RUVector> RModel::findSurfaceNeighbors() const
+void RModel::writeResultsAscii(const QString &fileName, const QString &baseFileName) const
 {
-    std::vector<RUVector> neigs;
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
 
-    RLogger::info("Finding surface neighbors\n");
-    RLogger::indent();
-    RProgressInitialize("Finding surface neighbors");
+    RLogger::info("Writing ascii model results file \'%s\'\n",fileName.toUtf8().constData());
 
-    neigs.resize(this->getNElements());
+    // Variables which were not loaded yet would be lost once the file is replaced.
+    this->releaseVariableLoader(fileName);
 
-    RUVector surfaceElements;
-    surfaceElements.reserve(this->getNElements());
-    for (uint i=0;i<this->getNElements();i++)
+    RSaveFile modelFile(fileName,RSaveFile::ASCII);
+
+    if (!modelFile.open(QIODevice::WriteOnly | QIODevice::Text))
     {
-        if (R_ELEMENT_TYPE_IS_SURFACE(this->getElement(i).getType()))
-        {
-            surfaceElements.push_back(i);
-            neigs[i].reserve(RElement::getNNeighbors(this->getElement(i).getType()));
-        }
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
     }
 
-    uint nProcessed = 0;
-#pragma omp parallel for default(shared)
-    for (int64_t i=0;i<int64_t(surfaceElements.size());i++)
+    // Base record is referenced relative to the results record.
+    QString relativeBaseFileName(QFileInfo(fileName).absoluteDir().relativeFilePath(baseFileName));
+
+    RFileIO::writeAscii(modelFile,RFileHeader(R_FILE_TYPE_MODEL_RESULTS,_version,"\"" + relativeBaseFileName + "\""));
+
+    RFileIO::writeAscii(modelFile,this->timeSolver);
+    RFileIO::writeAscii(modelFile,this->problemSetup);
+
+    RFileIO::writeAscii(modelFile,this->RResults::nnodes);
+    RFileIO::writeAscii(modelFile,this->RResults::nelements);
+    RFileIO::writeAscii(modelFile,uint(this->RResults::variables.size()));
+    for (uint i=0;i<this->RResults::variables.size();i++)
     {
-        uint elementID1 = surfaceElements[uint(i)];
-#pragma omp critical
-        {
-            RProgressPrint(++nProcessed,uint(surfaceElements.size()));
-        }
-        RLimitBox lb1,lb2;
-        this->getElement(elementID1).findLimitBox(this->getNodes(),lb1);
+        RFileIO::writeAscii(modelFile,this->getVariable(i));
+    }
 
-        for (uint j=uint(i+1);j<surfaceElements.size();j++)
-        {
-            uint elementID2 = surfaceElements[j];
-            this->getElement(elementID2).findLimitBox(this->getNodes(),lb2);
-            if (!RLimitBox::areIntersecting(lb1,lb2))
-            {
-                continue;
-            }
+    modelFile.commit();
+} /* RModel::writeResultsAscii */
 
-            if (this->getElement(elementID1).isNeighbor(this->getElement(elementID2)))
-            {
-#pragma omp critical
-                {
-                    neigs[elementID1].push_back(elementID2);
-                    neigs[elementID2].push_back(elementID1);
-                }
-            }
-        }
+
+void RModel::writeResultsBinary(const QString &fileName, const QString &baseFileName) const
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
     }
 
-    RProgressFinalize();
-    RLogger::unindent();
-    return neigs;
-} /* RModel::findSurfaceNeighbors */
+    RLogger::info("Writing binary model results file \'%s\'\n",fileName.toUtf8().constData());
 
-std::vector<RUVector> RModel::findVolumeNeighbors() const
+    // Variables which were not loaded yet would be lost once the file is replaced.
+    this->releaseVariableLoader(fileName);
+
+    RSaveFile modelFile(fileName,RSaveFile::BINARY);
+
+    if (!modelFile.open(QIODevice::WriteOnly))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    // Base record is referenced relative to the results record.
+    QString relativeBaseFileName(QFileInfo(fileName).absoluteDir().relativeFilePath(baseFileName));
+
+    RFileIO::writeBinary(modelFile,RFileHeader(R_FILE_TYPE_MODEL_RESULTS,_version,relativeBaseFileName));
+    this->writeBinaryCompression(modelFile);
+
+    // Table of contents is updated once all variables are written.
+    qint64 tocOffset = modelFile.pos();
+    std::vector<RVariableLocation> variableLocations(this->RResults::variables.size());
+    RFileIO::writeBinary(modelFile,variableLocations);
+
+    RFileIO::writeBinary(modelFile,this->timeSolver);
+    RFileIO::writeBinary(modelFile,this->problemSetup);
+
+    RFileIO::writeBinary(modelFile,this->RResults::nnodes);
+    RFileIO::writeBinary(modelFile,this->RResults::nelements);
+    RFileIO::writeBinary(modelFile,uint(this->RResults::variables.size()));
+    for (uint i=0;i<this->RResults::variables.size();i++)
+    {
+        RFileIO::writeBinary(modelFile,this->getVariable(i),variableLocations[i]);
+    }
+
+    this->writeBinaryTableOfContents(modelFile,tocOffset,variableLocations);
+
+    modelFile.commit();
+} /* RModel::writeResultsBinary */
+
+
+void RModel::checkResultsSize(const QString &fileName, const QString &baseFileName, uint nResultsNodes, uint nResultsElements) const
 {
-    std::vector<RUVector> neigs;
+    if (nResultsNodes != this->getNNodes() || nResultsElements != this->getNElements())
+    {
+        throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,
+                     "Results in file \'%s\' (%u nodes, %u elements) do not match mesh in base file \'%s\' (%u nodes, %u elements).",
+                     fileName.toUtf8().constData(),nResultsNodes,nResultsElements,
+                     baseFileName.toUtf8().constData(),this->getNNodes(),this->getNElements());
+    }
+} /* RModel::checkResultsSize */
 
-    RLogger::info("Finding volume neighbors\n");
-    RLogger::indent();
-    RProgressInitialize("Finding volume neighbors");
 
-    neigs.resize(this->getNElements());
+void RModel::readBinaryCompression(RFile &modelFile)
+{
+    bool compressed = false;
+    if (modelFile.getVersion() >= RVersion(1,2,0))
+    {
+        RFileIO::readBinary(modelFile,compressed);
+    }
+    modelFile.setCompressed(compressed);
+    this->binaryCompression = compressed;
+} /* RModel::readBinaryCompression */
 
-    RUVector volumeElements;
-    RUVector volumeNeighborCount;
-    volumeElements.reserve(this->getNElements());
-    volumeNeighborCount.resize(this->getNElements());
-    for (uint i=0;i<this->getNElements();i++)
+
+void RModel::writeBinaryCompression(RSaveFile &modelFile) const
+{
+    RFileIO::writeBinary(modelFile,this->binaryCompression);
+    modelFile.setCompressed(this->binaryCompression);
+} /* RModel::writeBinaryCompression */
+
+
+void RModel::readBinaryTableOfContents(RFile &modelFile, std::vector<RVariableLocation> &variableLocations)
+{
+    variableLocations.clear();
+    if (modelFile.getVersion() >= RVersion(1,3,0))
     {
-        if (R_ELEMENT_TYPE_IS_VOLUME(this->getElement(i).getType()))
-        {
-            volumeElements.push_back(i);
-            volumeNeighborCount[i] = RElement::getNNeighbors(this->getElement(i).getType());
-            neigs[i].reserve(volumeNeighborCount[i]);
-        }
+        RFileIO::readBinary(modelFile,variableLocations);
     }
+} /* RModel::readBinaryTableOfContents */
 
-    uint nProcessed = 0;
-#pragma omp parallel for default(shared)
-    for (int64_t i=0;i<int64_t(volumeElements.size());i++)
+
+void RModel::writeBinaryTableOfContents(RSaveFile &modelFile, qint64 tocOffset, const std::vector<RVariableLocation> &variableLocations) const
+{
+    if (!modelFile.seek(tocOffset))
     {
-#pragma omp critical
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to seek to table of contents.");
+    }
+    RFileIO::writeBinary(modelFile,variableLocations);
+} /* RModel::writeBinaryTableOfContents */
+
+
+void RModel::readBinaryVariables(RFile &modelFile, const QString &fileName, uint nVariables, const std::vector<RVariableLocation> &variableLocations, bool lazyVariables)
+{
+    this->clearResults();
+    this->RResults::variables.resize(nVariables);
+
+    if (lazyVariables && nVariables > 0 && variableLocations.size() == nVariables)
+    {
+        // Only variable descriptions are read, values are loaded on first access.
+        for (uint i=0;i<this->RResults::variables.size();i++)
         {
-            RProgressPrint(++nProcessed,uint(volumeElements.size()));
+            RFileIO::readBinary(modelFile,this->RResults::variables[i],variableLocations[i]);
         }
-        uint elementID1 = volumeElements[uint(i)];
-
-        if (neigs[elementID1].size() >= volumeNeighborCount[elementID1])
+        this->setVariableLoader(std::make_shared<RVariableLoader>(fileName,modelFile.getVersion(),modelFile.getCompressed(),variableLocations));
+    }
+    else
+    {
+        for (uint i=0;i<this->RResults::variables.size();i++)
         {
-            continue;
+            RFileIO::readBinary(modelFile,this->RResults::variables[i]);
         }
+    }
+} /* RModel::readBinaryVariables */
 
-        RLimitBox lb1,lb2;
-        this->getElement(elementID1).findLimitBox(this->getNodes(),lb1);
 
-        for (uint j=uint(i+1);j<volumeElements.size();j++)
-        {
-            uint elementID2 = volumeElements[j];
+std::vector<RUVector> RModel::findSurfaceNeighbors() const
+{
+    RLogger::info("Finding surface neighbors\n");
+    RLogger::indent();
 
-            if (neigs[elementID2].size() >= volumeNeighborCount[elementID2])
-            {
-                continue;
-            }
+    std::vector<RUVector> neigs = this->findNeighbors(R_ENTITY_GROUP_SURFACE);
 
-            this->getElement(elementID2).findLimitBox(this->getNodes(),lb2);
-            if (!RLimitBox::areIntersecting(lb1,lb2))
-            {
-                continue;
-            }
+    RLogger::unindent();
+    return neigs;
+} /* RModel::findSurfaceNeighbors */
 
-            bool skip = false;
-            if (this->getElement(elementID1).isNeighbor(this->getElement(elementID2)))
-            {
-#pragma omp critical
-                {
-                    neigs[elementID1].push_back(elementID2);
-                    neigs[elementID2].push_back(elementID1);
-                    if (neigs[elementID1].size() == volumeNeighborCount[elementID1])
-                    {
-                        skip = true;
-                    }
-                }
-            }
-            if (skip)
-            {
-                break;
-            }
-        }
-    }
+std::vector<RUVector> RModel::findVolumeNeighbors() const
+{
+    RLogger::info("Finding volume neighbors\n");
+    RLogger::indent();
 
-    RProgressFinalize();
-    RLogger::unindent();
+    std::vector<RUVector> neigs = this->findNeighbors(R_ENTITY_GROUP_VOLUME);
 
+    RLogger::unindent();
     return neigs;
 } /* RModel::findVolumeNeighbors */
 
+std::vector<RUVector> RModel::findNeighbors(REntityGroupType elementGroupType) const
+{
+    std::vector<RUVector> neigs;
+
+    neigs.resize(this->getNElements());
+
+    const RMeshTopology &rMeshTopology = this->getMeshTopology();
+
+#pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(this->getNElements());i++)
+    {
+        if (RElementGroup::getGroupType(this->getElement(uint(i)).getType()) != elementGroupType)
+        {
+            continue;
+        }
+        neigs[uint(i)] = rMeshTopology.findNeighbors(uint(i));
+    }
+
+    return neigs;
+} /* RModel::findNeighbors */
+
 
 void RModel::markSurfaceNeighbors(uint elementID,
                                  double angle,
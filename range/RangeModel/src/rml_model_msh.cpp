@@ -14,6 +14,7 @@
 #include "rml_file_io.h"
 #include "rml_file.h"
 #include "rml_file_manager.h"
+#include "rml_text_parser.h"
 
 
 #define FSREAD(_inFile,_data,_size,_descStr)                   \
@@ -206,12 +207,7 @@ void RModelMsh::readAscii (const QString &fileName)
     bool linesFound = false;
     bool pointsFound = false;
 
-    RFile mshFile(fileName,RFile::ASCII);
-
-    if (!mshFile.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
-    }
+    RTextParser mshParser(fileName);
 
     unsigned int nsteps = 23;
     unsigned int cstep = 0;
@@ -219,47 +215,42 @@ void RModelMsh::readAscii (const QString &fileName)
     RProgressPrint(cstep++,nsteps);
     while (true)
     {
-        mshFile.getTextStream() >> flag;
-        if (mshFile.getTextStream().status() != QTextStream::Ok)
+        if (!mshParser.readToken(flag))
         {
-            if (mshFile.getTextStream().atEnd())
-            {
-                break;
-            }
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read the file \'%s\'",fileName.toUtf8().constData());
+            break;
         }
 
         if (flag == "!VERSION:")
         {
-            RFileIO::readAscii(mshFile,fVersion);
+            mshParser.readValue(fVersion);
             RLogger::info("File version %s\n",fVersion.toUtf8().constData());
         }
         else if (flag == "TITLE:")
         {
-            RFileIO::readAscii(mshFile,this->title);
+            mshParser.readValue(this->title);
             dTitleFound = true;
         }
         else if (flag == "COMMENT:")
         {
-            RFileIO::readAscii(mshFile,this->comment);
+            mshParser.readValue(this->comment);
             dCommentFound = true;
         }
         else if (flag == "FACESNCOMPUTED:")
         {
-            RFileIO::readAscii(mshFile,this->facesNeighborsComputed);
+            mshParser.readValue(this->facesNeighborsComputed);
             dFacesNComputedFound = true;
         }
         else if (flag == "BODIESNCOMPUTED:")
         {
-            RFileIO::readAscii(mshFile,this->bodiesNeighborsComputed);
+            mshParser.readValue(this->bodiesNeighborsComputed);
             dBodiesNComputedFound = true;
         }
         else if (flag == "NODES:")
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->nodes.resize(nr,nc);
             dNodesFound = true;
         }
@@ -267,8 +258,8 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->bodiesAll.resize(nr,nc);
             this->bodiesNeighbors.resize(nr,4);
             dBodiesAllFound = true;
@@ -277,8 +268,8 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->facesAll.resize(nr,nc);
             this->facesNeighbors.resize(nr,3);
             dFacesAllFound = true;
@@ -287,8 +278,8 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->linesAll.resize(nr,nc);
             dLinesAllFound = true;
         }
@@ -296,8 +287,8 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->pointsAll.resize(nr,nc);
             dPointsAllFound = true;
         }
@@ -305,8 +296,8 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->bodies.resize(nr,nc);
             this->bodiesNames.resize(nc);
             dBodiesFound = true;
@@ -315,8 +306,8 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->faces.resize(nr,nc);
             this->facesNames.resize(nc);
             this->facesThickness.resize(nc);
@@ -326,8 +317,8 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->lines.resize(nr,nc);
             this->linesNames.resize(nc);
             this->linesCarea.resize(nc);
@@ -337,8 +328,8 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             unsigned int nr;
             unsigned int nc;
-            RFileIO::readAscii(mshFile,nr);
-            RFileIO::readAscii(mshFile,nc);
+            mshParser.readValue(nr);
+            mshParser.readValue(nc);
             this->points.resize(nr,nc);
             this->pointsNames.resize(nc);
             this->pointsVolume.resize(nc);
@@ -415,35 +406,30 @@ void RModelMsh::readAscii (const QString &fileName)
         throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF, "File is missing \'POINTS\' information.");
     }
 
-    mshFile.seek(0);
+    mshParser.setPosition(0);
 
     while (true)
     {
-        mshFile.getTextStream() >> flag;
-        if (mshFile.getTextStream().status() != QTextStream::Ok)
+        if (!mshParser.readToken(flag))
         {
-            if(mshFile.getTextStream().atEnd())
-            {
-                break;
-            }
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read the file.");
+            break;
         }
 
         if (flag == "nodes:")
         {
-            RFileIO::readAscii(mshFile,this->nodes,false);
+            mshParser.readValues(this->nodes);
             nodesFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "faces_neighbors:")
         {
-            RFileIO::readAscii(mshFile,this->facesNeighbors,false);
+            mshParser.readValues(this->facesNeighbors);
             facesNeighborsFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "bodies_neighbors:")
         {
-            RFileIO::readAscii(mshFile,this->bodiesNeighbors,false);
+            mshParser.readValues(this->bodiesNeighbors);
             bodiesNeighborsFound = true;
             RProgressPrint(cstep++,nsteps);
         }
@@ -451,7 +437,7 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             for (unsigned int i=0;i<this->bodiesNames.size();i++)
             {
-                RFileIO::readAscii(mshFile,this->bodiesNames[i]);
+                mshParser.readValue(this->bodiesNames[i]);
             }
             bodiesNamesFound = true;
             RProgressPrint(cstep++,nsteps);
@@ -460,7 +446,7 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             for (unsigned int i=0;i<this->facesNames.size();i++)
             {
-                RFileIO::readAscii(mshFile,this->facesNames[i]);
+                mshParser.readValue(this->facesNames[i]);
             }
             facesNamesFound = true;
             RProgressPrint(cstep++,nsteps);
@@ -469,7 +455,7 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             for (unsigned int i=0;i<this->linesNames.size();i++)
             {
-                RFileIO::readAscii(mshFile,this->linesNames[i]);
+                mshParser.readValue(this->linesNames[i]);
             }
             linesNamesFound = true;
             RProgressPrint(cstep++,nsteps);
@@ -478,74 +464,74 @@ void RModelMsh::readAscii (const QString &fileName)
         {
             for (unsigned int i=0;i<this->pointsNames.size();i++)
             {
-                RFileIO::readAscii(mshFile,this->pointsNames[i]);
+                mshParser.readValue(this->pointsNames[i]);
             }
             pointsNamesFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "faces_thickness:")
         {
-            RFileIO::readAscii(mshFile,this->facesThickness,false);
+            mshParser.readValues(this->facesThickness);
             facesThicknessFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "lines_carea:")
         {
-            RFileIO::readAscii(mshFile,this->linesCarea,false);
+            mshParser.readValues(this->linesCarea);
             linesCareaFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "points_volume:")
         {
-            RFileIO::readAscii(mshFile,this->pointsVolume,false);
+            mshParser.readValues(this->pointsVolume);
             pointsVolumeFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "bodies_all:")
         {
-            RFileIO::readAscii(mshFile,this->bodiesAll,false);
+            mshParser.readValues(this->bodiesAll);
             bodiesAllFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "faces_all:")
         {
-            RFileIO::readAscii(mshFile,this->facesAll,false);
+            mshParser.readValues(this->facesAll);
             facesAllFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "lines_all:")
         {
-            RFileIO::readAscii(mshFile,this->linesAll,false);
+            mshParser.readValues(this->linesAll);
             linesAllFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "points_all:")
         {
-            RFileIO::readAscii(mshFile,this->pointsAll,false);
+            mshParser.readValues(this->pointsAll);
             pointsAllFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "bodies:")
         {
-            RFileIO::readAscii(mshFile,this->bodies,false);
+            mshParser.readValues(this->bodies);
             bodiesFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "faces:")
         {
-            RFileIO::readAscii(mshFile,this->faces,false);
+            mshParser.readValues(this->faces);
             facesFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "lines:")
         {
-            RFileIO::readAscii(mshFile,this->lines,false);
+            mshParser.readValues(this->lines);
             linesFound = true;
             RProgressPrint(cstep++,nsteps);
         }
         else if (flag == "points:")
         {
-            RFileIO::readAscii(mshFile,this->points,false);
+            mshParser.readValues(this->points);
             pointsFound = true;
             RProgressPrint(cstep++,nsteps);
         }
@@ -655,7 +641,7 @@ void RModelMsh::readAscii (const QString &fileName)
     this->points.transpose();
     RProgressPrint(cstep++,nsteps);
 
-    mshFile.close();
+    mshParser.printThroughput();
 
     RProgressFinalize("Done");
 } /* RModelMsh::readAscii */
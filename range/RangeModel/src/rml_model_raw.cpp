@@ -8,6 +8,8 @@
  *  DESCRIPTION: RAW model class definition                          *
  *********************************************************************/
 
+#include <algorithm>
+
 #include <QFile>
 #include <QTextStream>
 
@@ -414,25 +416,18 @@ void RModelRaw::read(const QString &fileName,
         throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
     }
 
-    QFile file(fileName);
-
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
-    }
-
-    QTextStream in(&file);
+    RTextParser rawParser(fileName);
 
     try
     {
-        this->readTextStream(in,tolerance);
+        this->readTextParser(rawParser,tolerance);
     }
     catch (const RError &rError)
     {
         throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read the file \'%s\'. %s",fileName.toUtf8().constData(),rError.getMessage().toUtf8().constData());
     }
 
-    file.close ();
+    rawParser.printThroughput();
 
     RProgressFinalize("Done");
 } /* RModelRaw::read */
@@ -488,96 +483,153 @@ void RModelRaw::write(const QString &fileName) const
 
 void RModelRaw::readTextStream(QTextStream &textSTream, double tolerance)
 {
-    RNode node1;
-    RNode node2;
-    RNode node3;
-    RNode node4;
+    QString text = textSTream.readAll();
+    if (textSTream.status() != QTextStream::Ok)
+    {
+        throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Failed to read the text stream.");
+    }
 
-    uint lineNumber = 0;
+    RTextParser textParser(text.toUtf8());
+    this->readTextParser(textParser,tolerance);
+} /* RModelRaw::readTextStream */
 
-    while (!textSTream.atEnd())
-    {
-        QString line = textSTream.readLine();
-        lineNumber++;
 
-        int hashPos = line.indexOf('#');
-        if (hashPos >= 0)
-        {
-            line.remove(hashPos,line.size());
-        }
+void RModelRaw::readTextParser(RTextParser &textParser, double tolerance)
+{
+    // Records are parsed in parallel (line by line) and elements are added in the original order afterwards.
+    std::vector<qint64> lineOffsets;
+    textParser.findLineOffsets(lineOffsets);
+
+    qint64 nLines = qint64(lineOffsets.size()) - 1;
+    std::vector<qint64> chunks = RTextParser::findChunks(nLines);
+    int64_t nChunks = int64_t(chunks.size()) - 1;
 
-        if (!line.isEmpty())
+    // Number of coordinates for each non-empty line (0 = invalid record).
+    std::vector< std::vector<qint64> > chunkLines(nChunks);
+    std::vector< std::vector<uint> > chunkSizes(nChunks);
+    std::vector< std::vector<double> > chunkCoordinates(nChunks);
+    std::vector< std::vector<QString> > chunkMessages(nChunks);
+
+    const char *pData = textParser.getData();
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        std::vector<const char*> tokens;
+        for (qint64 j=chunks[i];j<chunks[i+1];j++)
         {
-            QRegExp rx("[,; ]");// match a comma or semicolon or a space
-            QStringList list = line.split(rx, QString::SkipEmptyParts);
+            const char *pBegin = pData + lineOffsets[j];
+            const char *pEnd = pData + lineOffsets[j+1];
+            const char *pHash = std::find(pBegin,pEnd,'#');
+            pEnd = pHash;
 
-            RRVector coordinates(list.size(),0.0);
+            tokens.clear();
+            for (const char *p=pBegin;p<pEnd;p++)
+            {
+                bool separator = (*p == ',' || *p == ';' || RTextParser::isSpace(*p));
+                if (!separator && (p == pBegin || *(p-1) == ',' || *(p-1) == ';' || RTextParser::isSpace(*(p-1))))
+                {
+                    tokens.push_back(p);
+                }
+            }
+            if (tokens.empty())
+            {
+                continue;
+            }
 
             QString invalidRecordMessage;
 
-            if (list.size() % 3 != 0)
+            size_t nCoordinates = chunkCoordinates[i].size();
+            if (tokens.size() % 3 != 0)
+            {
+                invalidRecordMessage = "Invalid number of coordinates = " + QString::number(tokens.size());
+            }
+            else if (tokens.size() > 12)
             {
-                invalidRecordMessage = "Invalid number of coordinates = " + QString::number(list.size());
+                invalidRecordMessage = "Invalid number of nodes = " + QString::number(tokens.size() / 3);
             }
             else
             {
-                for (int i=0;i<list.size();i++)
+                for (uint k=0;k<tokens.size();k++)
                 {
-                    bool isDouble = true;
-                    coordinates[i] = list[i].toDouble(&isDouble);
-                    if (!isDouble)
+                    const char *p = tokens[k];
+                    double value = 0.0;
+                    if (!RTextParser::parseDouble(p,pEnd,value) || (p < pEnd && *p != ',' && *p != ';' && !RTextParser::isSpace(*p)))
                     {
                         invalidRecordMessage = "Record can contain only numbers";
                         break;
                     }
+                    chunkCoordinates[i].push_back(value);
                 }
             }
 
+            chunkLines[i].push_back(j);
             if (invalidRecordMessage.isEmpty())
             {
-                if (coordinates.size() == 3)
-                {
-                    node1.set(coordinates[0],coordinates[1],coordinates[2]);
-                    this->addPoint(node1,true,tolerance);
-                }
-                else if (coordinates.size() == 6)
-                {
-                    node1.set(coordinates[0],coordinates[1],coordinates[2]);
-                    node2.set(coordinates[3],coordinates[4],coordinates[5]);
-                    this->addSegment(node1,node2,true,tolerance);
-                }
-                else if (coordinates.size() == 9)
-                {
-                    node1.set(coordinates[0],coordinates[1],coordinates[2]);
-                    node2.set(coordinates[3],coordinates[4],coordinates[5]);
-                    node3.set(coordinates[6],coordinates[7],coordinates[8]);
-                    this->addTriangle(node1,node2,node3,true,tolerance);
-                }
-                else if (coordinates.size() == 12)
-                {
-                    node1.set(coordinates[0],coordinates[1],coordinates[2]);
-                    node2.set(coordinates[3],coordinates[4],coordinates[5]);
-                    node3.set(coordinates[6],coordinates[7],coordinates[8]);
-                    node4.set(coordinates[9],coordinates[10],coordinates[11]);
-                    this->addQuadrilateral(node1,node2,node3,node4,true,tolerance);
-                }
-                else
-                {
-                    invalidRecordMessage = "Invalid number of nodes = " + QString::number(coordinates.size() / 3);
-                }
+                chunkSizes[i].push_back(uint(tokens.size()));
             }
-            if (!invalidRecordMessage.isEmpty())
+            else
             {
-                RLogger::warning("Invalid RAW element record @ line %u (%s). %s.\n", lineNumber, line.toUtf8().constData(), invalidRecordMessage.toUtf8().constData());
+                chunkCoordinates[i].resize(nCoordinates);
+                chunkSizes[i].push_back(0);
+                chunkMessages[i].push_back(invalidRecordMessage);
             }
         }
+    }
+
+    RNode node1;
+    RNode node2;
+    RNode node3;
+    RNode node4;
 
-        if (textSTream.status() != QTextStream::Ok && !textSTream.atEnd())
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        const double *coordinates = chunkCoordinates[i].data();
+        uint nMessages = 0;
+        for (uint j=0;j<chunkLines[i].size();j++)
         {
-            throw RError(R_ERROR_INVALID_INPUT,R_ERROR_REF,"Failed to read the text stream.");
+            uint nCoordinates = chunkSizes[i][j];
+            if (nCoordinates == 3)
+            {
+                node1.set(coordinates[0],coordinates[1],coordinates[2]);
+                this->addPoint(node1,true,tolerance);
+            }
+            else if (nCoordinates == 6)
+            {
+                node1.set(coordinates[0],coordinates[1],coordinates[2]);
+                node2.set(coordinates[3],coordinates[4],coordinates[5]);
+                this->addSegment(node1,node2,true,tolerance);
+            }
+            else if (nCoordinates == 9)
+            {
+                node1.set(coordinates[0],coordinates[1],coordinates[2]);
+                node2.set(coordinates[3],coordinates[4],coordinates[5]);
+                node3.set(coordinates[6],coordinates[7],coordinates[8]);
+                this->addTriangle(node1,node2,node3,true,tolerance);
+            }
+            else if (nCoordinates == 12)
+            {
+                node1.set(coordinates[0],coordinates[1],coordinates[2]);
+                node2.set(coordinates[3],coordinates[4],coordinates[5]);
+                node3.set(coordinates[6],coordinates[7],coordinates[8]);
+                node4.set(coordinates[9],coordinates[10],coordinates[11]);
+                this->addQuadrilateral(node1,node2,node3,node4,true,tolerance);
+            }
+            else
+            {
+                qint64 lineID = chunkLines[i][j];
+                QString line(QString::fromUtf8(pData + lineOffsets[lineID],int(lineOffsets[lineID+1] - lineOffsets[lineID])).trimmed());
+                int hashPos = line.indexOf('#');
+                if (hashPos >= 0)
+                {
+                    line.remove(hashPos,line.size());
+                }
+                RLogger::warning("Invalid RAW element record @ line %u (%s). %s.\n", uint(lineID+1), line.toUtf8().constData(), chunkMessages[i][nMessages++].toUtf8().constData());
+            }
+            coordinates += nCoordinates;
         }
     }
-} /* RModelRaw::readTextStream */
+} /* RModelRaw::readTextParser */
 
 bool RModelRaw::getNormal(unsigned int elementID, double &nx, double &ny, double &nz) const
 {
@@ -8,6 +8,8 @@
  *  DESCRIPTION: STL model class definition                          *
  *********************************************************************/
 
+#include <algorithm>
+
 #include <QFile>
 #include <QFileInfo>
 #include <QTextStream>
@@ -16,6 +18,7 @@
 
 #include "rml_model_stl.h"
 #include "rml_model_raw.h"
+#include "rml_text_parser.h"
 
 
 RModelStl::RModelStl ()
@@ -302,15 +305,6 @@ void RModelStl::writeBinary (const QString &fileName) const
 void RModelStl::readAscii (const QString &fileName,
                            double             tolerance)
 {
-    RNode node1;
-    RNode node2;
-    RNode node3;
-    double nx, ny, nz;
-    double x1, y1, z1;
-    double x2, y2, z2;
-    double x3, y3, z3;
-    QString flag;
-
     RProgressInitialize("Reading STL ASCII file");
 
     if (fileName.isEmpty())
@@ -318,18 +312,10 @@ void RModelStl::readAscii (const QString &fileName,
         throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
     }
 
-    QFile file(fileName);
-
-    if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
-    {
-        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
-    }
-
-    QTextStream in(&file);
+    RTextParser stlParser(fileName);
 
     QString line;
-    line = in.readLine();
-    if (in.status() != QTextStream::Ok)
+    if (!stlParser.readLine(line))
     {
         throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read first line (1).");
     }
@@ -346,83 +332,98 @@ void RModelStl::readAscii (const QString &fileName,
         }
     }
 
-    unsigned int nf = 0;
-    while (!in.atEnd() && in.status() == QTextStream::Ok)
+    // Keywords are located in parallel on whitespace separated tokens (any layout of
+    // tokens on lines is accepted) and vertex coordinates are parsed afterwards.
+    const char *pData = stlParser.getData();
+    qint64 begin = stlParser.getPosition();
+    qint64 end = stlParser.getSize();
+
+    std::vector<qint64> chunks = RTextParser::findTokenChunks(pData,begin,end);
+    int64_t nChunks = int64_t(chunks.size()) - 1;
+
+    std::vector< std::vector<qint64> > chunkVertexOffsets(nChunks);
+    std::vector<unsigned int> chunkFacets(nChunks,0);
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<nChunks;i++)
     {
-        in >> flag;
-        if (flag == "normal" || flag == "NORMAL")
+        const char *pEnd = pData + chunks[i+1];
+        for (qint64 j=chunks[i];j<chunks[i+1];j++)
         {
-            nf++;
+            if (RTextParser::isSpace(pData[j]) || (j > begin && !RTextParser::isSpace(pData[j-1])))
+            {
+                continue;
+            }
+            const char *p = pData + j;
+            if (RTextParser::matchToken(p,pEnd,"facet"))
+            {
+                chunkFacets[i]++;
+            }
+            else if (RTextParser::matchToken(p,pEnd,"vertex"))
+            {
+                chunkVertexOffsets[i].push_back(p - pData);
+            }
         }
     }
-    in.resetStatus();
 
-    in.seek(0);
-    if (in.status() != QTextStream::Ok)
+    unsigned int nf = 0;
+    std::vector<qint64> vertexOffsets;
+    for (int64_t i=0;i<nChunks;i++)
     {
-        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to set position.");
+        nf += chunkFacets[i];
+        vertexOffsets.insert(vertexOffsets.end(),chunkVertexOffsets[i].begin(),chunkVertexOffsets[i].end());
     }
 
-    line = in.readLine();
-    if (in.status() != QTextStream::Ok)
+    if (vertexOffsets.size() != size_t(3)*nf)
     {
-        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read first line (2).");
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read vertices (Facets: %u, Vertices: %u).",nf,uint(vertexOffsets.size()));
     }
 
-    for (unsigned int i=0;i<nf;i++)
-    {
-        RProgressPrint(i+1,nf);
+    std::vector<double> vertices(size_t(3)*vertexOffsets.size(),0.0);
+    std::vector<char> vertexFailed(vertexOffsets.size(),0);
 
-        in >> flag >> flag >> nx >> ny >> nz;
-        if (in.status() != QTextStream::Ok)
-        {
-            QString errorStr("Failed to read normal (Facet: " + QString::number(i+1) + " of " + QString::number(nf) + ").");
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF, errorStr);
-        }
-        in >> flag >> flag;
-        if (in.status() != QTextStream::Ok)
-        {
-            QString errorStr("Failed to read outer loop (Facet: " + QString::number(i+1) + " of " + QString::number(nf) + ").");
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF, errorStr);
-        }
-        in >> flag >> x1 >> y1 >> z1;
-        if (in.status() != QTextStream::Ok)
-        {
-            QString errorStr("Failed to read vertex 1 (Facet: " + QString::number(i+1) + " of " + QString::number(nf) + ").");
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF, errorStr);
-        }
-        in >> flag >> x2 >> y2 >> z2;
-        if (in.status() != QTextStream::Ok)
-        {
-            QString errorStr("Failed to read vertex 2 (Facet: " + QString::number(i+1) + " of " + QString::number(nf) + ").");
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF, errorStr);
-        }
-        in >> flag >> x3 >> y3 >> z3;
-        if (in.status() != QTextStream::Ok)
-        {
-            QString errorStr("Failed to read vertex 3 (Facet: " + QString::number(i+1) + " of " + QString::number(nf) + ").");
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF, errorStr);
-        }
-        in >> flag;
-        if (in.status() != QTextStream::Ok)
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(vertexOffsets.size());i++)
+    {
+        const char *p = pData + vertexOffsets[i];
+        const char *pEnd = pData + end;
+        for (uint k=0;k<3;k++)
         {
-            QString errorStr("Failed to read endloop (Facet: " + QString::number(i+1) + " of " + QString::number(nf) + ").");
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF, errorStr);
+            while (p < pEnd && RTextParser::isSpace(*p))
+            {
+                p++;
+            }
+            if (!RTextParser::parseDouble(p,pEnd,vertices[size_t(3)*i+k]))
+            {
+                vertexFailed[i] = 1;
+                break;
+            }
         }
-        in >> flag;
-        if (in.status() != QTextStream::Ok)
+    }
+
+    for (size_t i=0;i<vertexFailed.size();i++)
+    {
+        if (vertexFailed[i])
         {
-            QString errorStr("Failed to read endfacet (Facet: " + QString::number(i+1) + " of " + QString::number(nf) + ").");
-            throw RError(R_ERROR_READ_FILE,R_ERROR_REF, errorStr);
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read vertex (Vertex: %u).",uint(i+1));
         }
+    }
 
-        node1.set(x1,y1,z1);
-        node2.set(x2,y2,z2);
-        node3.set(x3,y3,z3);
+    RNode node1;
+    RNode node2;
+    RNode node3;
+    for (unsigned int i=0;i<nf;i++)
+    {
+        RProgressPrint(i+1,nf);
+
+        const double *v = vertices.data() + size_t(9)*i;
+        node1.set(v[0],v[1],v[2]);
+        node2.set(v[3],v[4],v[5]);
+        node3.set(v[6],v[7],v[8]);
         this->addTriangle(node1,node2,node3,false,tolerance);
     }
 
-    file.close ();
+    stlParser.printThroughput();
 
     RProgressFinalize("Done");
 
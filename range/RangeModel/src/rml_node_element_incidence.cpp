@@ -0,0 +1,334 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_node_element_incidence.cpp                           *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Node-element incidence class definition             *
+ *********************************************************************/
+
+#include "rml_node_element_incidence.h"
+#include "rml_model.h"
+
+void RNodeElementIncidence::_init(const RNodeElementIncidence *pNodeElementIncidence)
+{
+    if (pNodeElementIncidence)
+    {
+        this->nNodes = pNodeElementIncidence->nNodes;
+        this->nElements = pNodeElementIncidence->nElements;
+        this->nodeOffsets = pNodeElementIncidence->nodeOffsets;
+        this->elementIDs = pNodeElementIncidence->elementIDs;
+        this->elementWeights = pNodeElementIncidence->elementWeights;
+        this->convertibleElements = pNodeElementIncidence->convertibleElements;
+    }
+}
+
+RNodeElementIncidence::RNodeElementIncidence()
+    : nNodes(0)
+    , nElements(0)
+{
+    this->_init();
+}
+
+RNodeElementIncidence::RNodeElementIncidence(const RNodeElementIncidence &nodeElementIncidence)
+{
+    this->_init(&nodeElementIncidence);
+}
+
+RNodeElementIncidence::~RNodeElementIncidence()
+{
+
+}
+
+RNodeElementIncidence &RNodeElementIncidence::operator =(const RNodeElementIncidence &nodeElementIncidence)
+{
+    this->_init(&nodeElementIncidence);
+    return (*this);
+}
+
+void RNodeElementIncidence::build(const RModel &rModel)
+{
+    this->clear();
+
+    this->nNodes = rModel.getNNodes();
+    this->nElements = rModel.getNElements();
+
+    // Count incident elements.
+    std::vector<uint> nodeCounts(this->nNodes,0);
+    for (uint i=0;i<rModel.getNElementGroups();i++)
+    {
+        const RElementGroup *pElementGroup = rModel.getElementGroupPtr(i);
+        for (uint j=0;j<pElementGroup->size();j++)
+        {
+            const RElement &rElement = rModel.getElement(pElementGroup->get(j));
+            for (uint k=0;k<rElement.size();k++)
+            {
+                nodeCounts[rElement.getNodeId(k)]++;
+            }
+        }
+    }
+
+    this->nodeOffsets.resize(this->nNodes+1,0);
+    for (uint i=0;i<this->nNodes;i++)
+    {
+        this->nodeOffsets[i+1] = this->nodeOffsets[i] + nodeCounts[i];
+    }
+
+    this->elementIDs.resize(this->nodeOffsets[this->nNodes],RConstants::eod);
+    this->elementWeights.resize(this->nodeOffsets[this->nNodes],0.0);
+
+    std::vector<uint> nodePositions(this->nodeOffsets.begin(),this->nodeOffsets.end()-1);
+
+    // Volume elements.
+    for (uint i=0;i<rModel.getNVolumes();i++)
+    {
+        const RVolume &rVolume = rModel.getVolume(i);
+        for (uint j=0;j<rVolume.size();j++)
+        {
+            this->appendElement(rModel,rVolume.get(j),true,true,nodePositions);
+            this->convertibleElements.push_back(rVolume.get(j));
+        }
+    }
+    // Surface elements.
+    for (uint i=0;i<rModel.getNSurfaces();i++)
+    {
+        const RSurface &rSurface = rModel.getSurface(i);
+        bool weighted = (rSurface.getThickness() > 0.0);
+        for (uint j=0;j<rSurface.size();j++)
+        {
+            this->appendElement(rModel,rSurface.get(j),weighted,true,nodePositions);
+            if (weighted)
+            {
+                this->convertibleElements.push_back(rSurface.get(j));
+            }
+        }
+    }
+    // Line elements.
+    for (uint i=0;i<rModel.getNLines();i++)
+    {
+        const RLine &rLine = rModel.getLine(i);
+        bool weighted = (rLine.getCrossArea() > 0.0);
+        for (uint j=0;j<rLine.size();j++)
+        {
+            this->appendElement(rModel,rLine.get(j),weighted,true,nodePositions);
+            if (weighted)
+            {
+                this->convertibleElements.push_back(rLine.get(j));
+            }
+        }
+    }
+    // Point elements.
+    for (uint i=0;i<rModel.getNPoints();i++)
+    {
+        const RPoint &rPoint = rModel.getPoint(i);
+        bool weighted = (rPoint.getVolume() > 0.0);
+        for (uint j=0;j<rPoint.size();j++)
+        {
+            this->appendElement(rModel,rPoint.get(j),weighted,false,nodePositions);
+            if (weighted)
+            {
+                this->convertibleElements.push_back(rPoint.get(j));
+            }
+        }
+    }
+}
+
+void RNodeElementIncidence::clear(void)
+{
+    this->nNodes = 0;
+    this->nElements = 0;
+    this->nodeOffsets.clear();
+    this->elementIDs.clear();
+    this->elementWeights.clear();
+    this->convertibleElements.clear();
+}
+
+bool RNodeElementIncidence::isValid(uint nNodes, uint nElements) const
+{
+    return (this->nodeOffsets.size() == nNodes + 1 && this->nNodes == nNodes && this->nElements == nElements);
+}
+
+uint RNodeElementIncidence::getNNodes(void) const
+{
+    return this->nNodes;
+}
+
+uint RNodeElementIncidence::getNElements(void) const
+{
+    return this->nElements;
+}
+
+uint RNodeElementIncidence::getNIncidentElements(uint nodeID) const
+{
+    R_ERROR_ASSERT(nodeID < this->nNodes);
+
+    return this->nodeOffsets[nodeID+1] - this->nodeOffsets[nodeID];
+}
+
+uint RNodeElementIncidence::getIncidentElementID(uint nodeID, uint position) const
+{
+    R_ERROR_ASSERT(nodeID < this->nNodes);
+    R_ERROR_ASSERT(this->nodeOffsets[nodeID] + position < this->nodeOffsets[nodeID+1]);
+
+    return this->elementIDs[this->nodeOffsets[nodeID] + position];
+}
+
+void RNodeElementIncidence::convertElementToNode(const RRVector &elementValues,
+                                                 const RBVector &setValues,
+                                                 RRVector &nodeValues,
+                                                 bool onlySetValues) const
+{
+    std::vector<const RRVector*> elementValuesList(1,&elementValues);
+    std::vector<RRVector*> nodeValuesList(1,&nodeValues);
+
+    this->convertElementToNode(elementValuesList,setValues,nodeValuesList,onlySetValues);
+}
+
+void RNodeElementIncidence::convertElementToNode(const std::vector<const RRVector *> &elementValues,
+                                                 const RBVector &setValues,
+                                                 const std::vector<RRVector *> &nodeValues,
+                                                 bool onlySetValues) const
+{
+    R_ERROR_ASSERT(elementValues.size() == nodeValues.size());
+
+    uint nFields = uint(elementValues.size());
+
+    for (uint i=0;i<nFields;i++)
+    {
+        nodeValues[i]->resize(this->nNodes,0.0);
+    }
+
+    // Nodes are independent of each other therefore each thread writes only its own values.
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(this->nNodes);i++)
+    {
+        uint nodeID = uint(i);
+        uint nodeBegin = this->nodeOffsets[nodeID];
+        uint nodeEnd = this->nodeOffsets[nodeID+1];
+
+        // Last element with explicitly set value wins.
+        uint setElementID = RConstants::eod;
+        for (uint j=nodeEnd;j>nodeBegin;j--)
+        {
+            if (setValues[this->elementIDs[j-1]])
+            {
+                setElementID = this->elementIDs[j-1];
+                break;
+            }
+        }
+
+        if (setElementID != RConstants::eod)
+        {
+            for (uint k=0;k<nFields;k++)
+            {
+                (*nodeValues[k])[nodeID] = (*elementValues[k])[setElementID];
+            }
+            continue;
+        }
+
+        if (onlySetValues)
+        {
+            continue;
+        }
+
+        double distance = 0.0;
+        for (uint j=nodeBegin;j<nodeEnd;j++)
+        {
+            distance += this->elementWeights[j];
+        }
+
+        for (uint k=0;k<nFields;k++)
+        {
+            const RRVector &rElementValues = (*elementValues[k]);
+            double value = 0.0;
+            for (uint j=nodeBegin;j<nodeEnd;j++)
+            {
+                if (this->elementWeights[j] > 0.0)
+                {
+                    value += this->elementWeights[j] * rElementValues[this->elementIDs[j]];
+                }
+            }
+            (*nodeValues[k])[nodeID] = (distance == 0.0) ? 0.0 : value / distance;
+        }
+    }
+}
+
+void RNodeElementIncidence::convertNodeToElement(const RModel &rModel,
+                                                 const RRVector &nodeValues,
+                                                 RRVector &elementValues) const
+{
+    std::vector<const RRVector*> nodeValuesList(1,&nodeValues);
+    std::vector<RRVector*> elementValuesList(1,&elementValues);
+
+    this->convertNodeToElement(rModel,nodeValuesList,elementValuesList);
+}
+
+void RNodeElementIncidence::convertNodeToElement(const RModel &rModel,
+                                                 const std::vector<const RRVector *> &nodeValues,
+                                                 const std::vector<RRVector *> &elementValues) const
+{
+    R_ERROR_ASSERT(nodeValues.size() == elementValues.size());
+
+    uint nFields = uint(nodeValues.size());
+
+    for (uint i=0;i<nFields;i++)
+    {
+        elementValues[i]->resize(this->nElements,0.0);
+    }
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(this->convertibleElements.size());i++)
+    {
+        uint elementID = this->convertibleElements[uint(i)];
+        const RElement &rElement = rModel.getElement(elementID);
+        for (uint k=0;k<nFields;k++)
+        {
+            const RRVector &rNodeValues = (*nodeValues[k]);
+            double value = 0.0;
+            for (uint j=0;j<rElement.size();j++)
+            {
+                value += rNodeValues[rElement.getNodeId(j)];
+            }
+            (*elementValues[k])[elementID] = value / rElement.size();
+        }
+    }
+}
+
+void RNodeElementIncidence::appendElement(const RModel &rModel,
+                                          uint elementID,
+                                          bool weighted,
+                                          bool centerDistance,
+                                          std::vector<uint> &nodePositions)
+{
+    const RElement &rElement = rModel.getElement(elementID);
+
+    RR3Vector center;
+    if (weighted && centerDistance)
+    {
+        rElement.findCenter(rModel.getNodes(),center[0],center[1],center[2]);
+    }
+
+    for (uint i=0;i<rElement.size();i++)
+    {
+        uint nodeID = rElement.getNodeId(i);
+        uint position = nodePositions[nodeID]++;
+
+        double d = 0.0;
+        if (weighted)
+        {
+            if (centerDistance)
+            {
+                d = rModel.getNode(nodeID).getDistance(RNode(center));
+                d = (d < RConstants::eps) ? 1.0 / RConstants::eps : 1.0 / d;
+            }
+            else
+            {
+                d = 1.0 / RConstants::eps;
+            }
+        }
+
+        this->elementIDs[position] = elementID;
+        this->elementWeights[position] = d;
+    }
+}
@@ -8,6 +8,8 @@
  *  DESCRIPTION: Problem setup class definition                      *
  *********************************************************************/
 
+#include <rblib.h>
+
 #include "rml_problem_setup.h"
 
 void RProblemSetup::_init(const RProblemSetup *pProblemSetup)
@@ -18,11 +20,17 @@ void RProblemSetup::_init(const RProblemSetup *pProblemSetup)
         this->radiationSetup = pProblemSetup->radiationSetup;
         this->modalSetup = pProblemSetup->modalSetup;
         this->meshSetup = pProblemSetup->meshSetup;
+        this->warmStartMask = pProblemSetup->warmStartMask;
+        this->warmStartExtrapolationMask = pProblemSetup->warmStartExtrapolationMask;
+        this->segregatedMask = pProblemSetup->segregatedMask;
     }
 }
 
 RProblemSetup::RProblemSetup()
     : restart(false)
+    , warmStartMask(R_PROBLEM_NONE)
+    , warmStartExtrapolationMask(R_PROBLEM_NONE)
+    , segregatedMask(R_PROBLEM_NONE)
 {
     this->_init();
 }
@@ -97,3 +105,50 @@ void RProblemSetup::setMeshSetup(const RMeshSetup &meshSetup)
 {
     this->meshSetup = meshSetup;
 }
+
+RWarmStartType RProblemSetup::getWarmStart(RProblemType problemType) const
+{
+    if (this->warmStartExtrapolationMask & problemType)
+    {
+        return R_WARM_START_EXTRAPOLATE;
+    }
+    if (this->warmStartMask & problemType)
+    {
+        return R_WARM_START_PREVIOUS;
+    }
+    return R_WARM_START_NONE;
+}
+
+void RProblemSetup::setWarmStart(RProblemType problemType, RWarmStartType warmStartType)
+{
+    R_ERROR_ASSERT(R_WARM_START_TYPE_IS_VALID(warmStartType));
+
+    this->warmStartMask &= ~problemType;
+    this->warmStartExtrapolationMask &= ~problemType;
+
+    if (warmStartType == R_WARM_START_PREVIOUS)
+    {
+        this->warmStartMask |= problemType;
+    }
+    else if (warmStartType == R_WARM_START_EXTRAPOLATE)
+    {
+        this->warmStartExtrapolationMask |= problemType;
+    }
+}
+
+bool RProblemSetup::getSegregated(RProblemType problemType) const
+{
+    return (this->segregatedMask & problemType);
+}
+
+void RProblemSetup::setSegregated(RProblemType problemType, bool segregated)
+{
+    if (segregated)
+    {
+        this->segregatedMask |= problemType;
+    }
+    else
+    {
+        this->segregatedMask &= ~problemType;
+    }
+}
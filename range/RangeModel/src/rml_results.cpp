@@ -10,6 +10,7 @@
 
 #include <string>
 #include <vector>
+#include <mutex>
 
 #include "rml_results.h"
 
@@ -22,13 +23,22 @@ void RResults::_init (const RResults *pResults)
     if (pResults)
     {
 //        this->compTime = compTime;
-        this->setNVariables (pResults->getNVariables());
+        this->variables.clear();
+        this->variableLoader.reset();
+        this->variableLoadBook.clear();
         this->setNNodes (pResults->getNNodes());
         this->setNElements (pResults->getNElements());
-        for (unsigned int i=0;i<this->getNVariables();i++)
+
+        // Variables which were not loaded yet are copied without values
+        // and share the same loader.
+        std::unique_lock<std::mutex> lock;
+        if (pResults->variableLoader)
         {
-            this->setVariable(i, pResults->getVariable(i));
+            lock = std::unique_lock<std::mutex>(pResults->variableLoader->getMutex());
         }
+        this->variables = pResults->variables;
+        this->variableLoader = pResults->variableLoader;
+        this->variableLoadBook = pResults->variableLoadBook;
     }
 } /* RResults::_init */
 
@@ -63,6 +73,8 @@ void RResults::clearResults(void)
         this->variables[i].clearValues();
     }
     this->variables.clear();
+    this->variableLoader.reset();
+    this->variableLoadBook.clear();
 } /* RResults::clearResults */
 
 
@@ -87,12 +99,17 @@ unsigned int RResults::getNVariables (void) const
 void RResults::setNVariables (unsigned int nvariables)
 {
     this->variables.resize(nvariables);
+    if (this->variableLoader)
+    {
+        this->variableLoadBook.resize(nvariables,RConstants::eod);
+    }
 } /* RResults::set_n_variables */
 
 
 const RVariable & RResults::getVariable (unsigned int position) const
 {
     R_ERROR_ASSERT (position < this->getNVariables());
+    this->loadVariable(position);
     return this->variables[position];
 } /* RResults::getVariable */
 
@@ -100,15 +117,17 @@ const RVariable & RResults::getVariable (unsigned int position) const
 RVariable & RResults::getVariable (unsigned int position)
 {
     R_ERROR_ASSERT (position < this->getNVariables());
+    this->loadVariable(position);
     return this->variables[position];
 } /* RResults::getVariable */
 
 
 unsigned int RResults::findVariable(RVariableType variableType) const
 {
+    // Variable type is known even if values were not loaded yet.
     for (unsigned int i=0;i<this->getNVariables();i++)
     {
-        if (this->getVariable(i).getType() == variableType)
+        if (this->variables[i].getType() == variableType)
         {
             return i;
         }
@@ -141,6 +160,10 @@ unsigned int RResults::addVariable(const RVariable &variable)
     if (variablePosition == RConstants::eod)
     {
         this->variables.push_back(variable);
+        if (this->variableLoader)
+        {
+            this->variableLoadBook.push_back(RConstants::eod);
+        }
         variablePosition = uint(this->variables.size()-1);
     }
     else
@@ -156,6 +179,10 @@ void RResults::setVariable (unsigned int     position,
 {
     R_ERROR_ASSERT (position < this->getNVariables());
     this->variables[position] = variable;
+    if (this->variableLoader)
+    {
+        this->variableLoadBook[position] = RConstants::eod;
+    }
 } /* RResults::setVariable */
 
 
@@ -163,12 +190,18 @@ void RResults::removeVariable(uint position)
 {
     R_ERROR_ASSERT (position < this->getNVariables());
     this->variables.erase(this->variables.begin() + position);
+    if (this->variableLoader)
+    {
+        this->variableLoadBook.erase(this->variableLoadBook.begin() + position);
+    }
 } /* RResults::removeVariable */
 
 
 void RResults::removeAllVariables(void)
 {
     this->variables.clear();
+    this->variableLoader.reset();
+    this->variableLoadBook.clear();
 } /* RResults::removeAllVariables */
 
 
@@ -182,6 +215,8 @@ void RResults::setNNodes (unsigned int nnodes)
 {
     std::vector<RVariable>::iterator iter;
 
+    this->loadVariables();
+
     this->nnodes = nnodes;
 
     for (iter = this->variables.begin();
@@ -200,6 +235,8 @@ void RResults::addNode (double value)
 {
     std::vector<RVariable>::iterator iter;
 
+    this->loadVariables();
+
     for (iter = this->variables.begin();
          iter != this->variables.end();
          ++iter)
@@ -218,6 +255,8 @@ void RResults::removeNode (unsigned int position)
 {
     std::vector<RVariable>::iterator iter;
 
+    this->loadVariables();
+
     R_ERROR_ASSERT (position < this->getNNodes());
 
     for (iter = this->variables.begin();
@@ -234,6 +273,51 @@ void RResults::removeNode (unsigned int position)
 } /* RResults::removeNode */
 
 
+void RResults::removeNodes(const std::vector<uint> &nodeBook)
+{
+    std::vector<RVariable>::iterator iter;
+
+    this->loadVariables();
+
+    for (iter = this->variables.begin();
+         iter != this->variables.end();
+         ++iter)
+    {
+        if (iter->getApplyType() == R_VARIABLE_APPLY_NODE)
+        {
+            iter->removeValues(nodeBook);
+        }
+    }
+
+    this->nnodes = 0;
+    for (uint i=0;i<uint(nodeBook.size());i++)
+    {
+        if (nodeBook[i] != RConstants::eod)
+        {
+            this->nnodes++;
+        }
+    }
+} /* RResults::removeNodes */
+
+
+void RResults::renumberNodes(const std::vector<uint> &nodeBook)
+{
+    std::vector<RVariable>::iterator iter;
+
+    this->loadVariables();
+
+    for (iter = this->variables.begin();
+         iter != this->variables.end();
+         ++iter)
+    {
+        if (iter->getApplyType() == R_VARIABLE_APPLY_NODE)
+        {
+            iter->renumberValues(nodeBook);
+        }
+    }
+} /* RResults::renumberNodes */
+
+
 unsigned int RResults::getNElements (void) const
 {
     return this->nelements;
@@ -244,6 +328,8 @@ void RResults::setNElements (unsigned int nelements)
 {
     std::vector<RVariable>::iterator iter;
 
+    this->loadVariables();
+
     this->nelements = nelements;
 
     for (iter = this->variables.begin();
@@ -262,6 +348,8 @@ void RResults::addElement (double value)
 {
     std::vector<RVariable>::iterator iter;
 
+    this->loadVariables();
+
     for (iter = this->variables.begin();
          iter != this->variables.end();
          ++iter)
@@ -280,6 +368,8 @@ void RResults::removeElement (unsigned int position)
 {
     std::vector<RVariable>::iterator iter;
 
+    this->loadVariables();
+
     R_ERROR_ASSERT (position < this->getNElements());
 
     for (iter = this->variables.begin();
@@ -299,6 +389,8 @@ void RResults::removeElements(const std::vector<uint> &elementBook)
 {
     std::vector<RVariable>::iterator iter;
 
+    this->loadVariables();
+
     for (iter = this->variables.begin();
          iter != this->variables.end();
          ++iter)
@@ -318,3 +410,100 @@ void RResults::removeElements(const std::vector<uint> &elementBook)
         }
     }
 } /* RResults::removeElements */
+
+
+void RResults::renumberElements(const std::vector<uint> &elementBook)
+{
+    std::vector<RVariable>::iterator iter;
+
+    this->loadVariables();
+
+    for (iter = this->variables.begin();
+         iter != this->variables.end();
+         ++iter)
+    {
+        if (iter->getApplyType() == R_VARIABLE_APPLY_ELEMENT)
+        {
+            iter->renumberValues(elementBook);
+        }
+    }
+} /* RResults::renumberElements */
+
+
+void RResults::setVariableLoader(const std::shared_ptr<RVariableLoader> &variableLoader)
+{
+    R_ERROR_ASSERT (variableLoader->getNVariables() == this->getNVariables());
+
+    this->variableLoader = variableLoader;
+    this->variableLoadBook.resize(this->getNVariables());
+    for (unsigned int i=0;i<this->getNVariables();i++)
+    {
+        this->variableLoadBook[i] = i;
+    }
+} /* RResults::setVariableLoader */
+
+
+bool RResults::isVariableLoaded(unsigned int position) const
+{
+    R_ERROR_ASSERT (position < this->getNVariables());
+
+    if (!this->variableLoader)
+    {
+        return true;
+    }
+    std::lock_guard<std::mutex> lock(this->variableLoader->getMutex());
+    return (this->variableLoadBook[position] == RConstants::eod);
+} /* RResults::isVariableLoaded */
+
+
+void RResults::loadVariables(void) const
+{
+    for (unsigned int i=0;i<this->getNVariables();i++)
+    {
+        this->loadVariable(i);
+    }
+} /* RResults::loadVariables */
+
+
+void RResults::releaseVariableLoader(const QString &fileName) const
+{
+    if (!this->variableLoader || !this->variableLoader->isFile(fileName))
+    {
+        return;
+    }
+    this->loadVariables();
+    this->variableLoader.reset();
+    this->variableLoadBook.clear();
+} /* RResults::releaseVariableLoader */
+
+
+void RResults::loadVariable(unsigned int position) const
+{
+    if (!this->variableLoader)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(this->variableLoader->getMutex());
+
+    uint locationID = this->variableLoadBook[position];
+    if (locationID == RConstants::eod)
+    {
+        return;
+    }
+
+    RVariable &rVariable = this->variables[position];
+    try
+    {
+        this->variableLoader->load(locationID,rVariable);
+    }
+    catch (const RError &error)
+    {
+        // Variable stays unloaded so that invalid values are never presented as results.
+        throw RError(error.getType(),R_ERROR_REF,"Failed to load values of variable \'%s\' from file \'%s\'. %s",
+                     rVariable.getName().toUtf8().constData(),
+                     this->variableLoader->getFileName().toUtf8().constData(),
+                     error.getMessage().toUtf8().constData());
+    }
+    this->variableLoadBook[position] = RConstants::eod;
+} /* RResults::loadVariable */
@@ -17,6 +17,7 @@ void RSaveFile::_init(const RSaveFile *pFile)
         this->fileName = pFile->fileName;
         this->type = pFile->type;
         this->fileVersion = pFile->fileVersion;
+        this->compressed = pFile->compressed;
 //        this->textStream = pFile->textStream;
     }
     if (this->type == RSaveFile::ASCII)
@@ -30,6 +31,7 @@ RSaveFile::RSaveFile(const QString &fileName, RSaveFile::Type type)
     , fileName(fileName)
     , type(type)
     , fileVersion(RVersion(0,0,0))
+    , compressed(false)
 {
     this->_init();
 }
@@ -61,6 +63,16 @@ void RSaveFile::setVersion(const RVersion &fileVersion)
     this->fileVersion = fileVersion;
 }
 
+bool RSaveFile::getCompressed(void) const
+{
+    return this->compressed;
+}
+
+void RSaveFile::setCompressed(bool compressed)
+{
+    this->compressed = compressed;
+}
+
 QTextStream &RSaveFile::getTextStream(void)
 {
     return this->textStream;
@@ -68,6 +68,11 @@ double RSparseMatrix::getValue(unsigned int rowIndex, unsigned int columnPositio
     return this->data[rowIndex].getValue(columnPosition);
 }
 
+unsigned int RSparseMatrix::getColumnIndex(unsigned int rowIndex, unsigned int columnPosition) const
+{
+    return this->data[rowIndex].getIndex(columnPosition);
+}
+
 std::vector<unsigned int> RSparseMatrix::getRowIndexes(unsigned int rowIndex) const
 {
     return this->data[rowIndex].getIndexes();
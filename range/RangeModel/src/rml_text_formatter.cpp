@@ -0,0 +1,254 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_text_formatter.cpp                                   *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Text formatter class definition                     *
+ *********************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include <algorithm>
+
+#include <omp.h>
+
+#include <QString>
+
+#include "rml_text_formatter.h"
+#include "rml_text_parser.h"
+
+// Number of items formatted in memory before they are written to file.
+static const qint64 formatBatchSize = 1048576;
+
+static double scaleByPowerOfTen(double value, int power)
+{
+    // Split large powers so that intermediate results do not overflow.
+    while (power > 300)
+    {
+        value *= 1.0e300;
+        power -= 300;
+    }
+    while (power < -300)
+    {
+        value /= 1.0e300;
+        power += 300;
+    }
+    if (power >= 0)
+    {
+        return value * std::pow(10.0,power);
+    }
+    return value / std::pow(10.0,-power);
+}
+
+void RTextFormatter::appendValue(QByteArray &buffer, double value)
+{
+    if (value == 0.0 || !std::isfinite(value))
+    {
+        // Special values are formatted by Qt.
+        buffer.append(QString::number(value,'g',6).toLatin1());
+        return;
+    }
+
+    char text[32];
+    int length = 0;
+
+    if (value < 0.0)
+    {
+        text[length++] = '-';
+        value = -value;
+    }
+
+    unsigned int digits = 0;
+    int exponent = RTextFormatter::findDigits(value,digits);
+
+    char digitText[6];
+    for (int i=5;i>=0;i--)
+    {
+        digitText[i] = char('0' + digits % 10);
+        digits /= 10;
+    }
+    int nDigits = 6;
+    while (nDigits > 1 && digitText[nDigits-1] == '0')
+    {
+        nDigits--;
+    }
+
+    if (exponent < -4 || exponent >= 6)
+    {
+        text[length++] = digitText[0];
+        if (nDigits > 1)
+        {
+            text[length++] = '.';
+            for (int i=1;i<nDigits;i++)
+            {
+                text[length++] = digitText[i];
+            }
+        }
+        text[length++] = 'e';
+        text[length++] = (exponent < 0) ? '-' : '+';
+        int absExponent = std::abs(exponent);
+        if (absExponent >= 100)
+        {
+            text[length++] = char('0' + absExponent / 100);
+        }
+        text[length++] = char('0' + (absExponent / 10) % 10);
+        text[length++] = char('0' + absExponent % 10);
+    }
+    else if (exponent >= 0)
+    {
+        for (int i=0;i<=exponent;i++)
+        {
+            text[length++] = (i < nDigits) ? digitText[i] : '0';
+        }
+        if (nDigits > exponent + 1)
+        {
+            text[length++] = '.';
+            for (int i=exponent+1;i<nDigits;i++)
+            {
+                text[length++] = digitText[i];
+            }
+        }
+    }
+    else
+    {
+        text[length++] = '0';
+        text[length++] = '.';
+        for (int i=0;i<-exponent-1;i++)
+        {
+            text[length++] = '0';
+        }
+        for (int i=0;i<nDigits;i++)
+        {
+            text[length++] = digitText[i];
+        }
+    }
+
+    buffer.append(text,length);
+}
+
+void RTextFormatter::appendValue(QByteArray &buffer, int value)
+{
+    long long number = value;
+    if (number < 0)
+    {
+        buffer.append('-');
+        number = -number;
+    }
+    RTextFormatter::appendValue(buffer,(unsigned int)number);
+}
+
+void RTextFormatter::appendValue(QByteArray &buffer, unsigned int value)
+{
+    char text[16];
+    int length = 0;
+    do
+    {
+        text[length++] = char('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    std::reverse(text,text+length);
+    buffer.append(text,length);
+}
+
+void RTextFormatter::writeBlock(RSaveFile &outFile, qint64 nItems, const FormatFunction &formatItem)
+{
+    // Text stream buffer has to be written before data are written directly to the file.
+    outFile.getTextStream().flush();
+
+    for (qint64 batchBegin=0;batchBegin<nItems;batchBegin+=formatBatchSize)
+    {
+        qint64 batchEnd = std::min(nItems,batchBegin+formatBatchSize);
+
+        std::vector<qint64> chunks = RTextParser::findChunks(batchEnd - batchBegin);
+        int64_t nChunks = int64_t(chunks.size()) - 1;
+        std::vector<QByteArray> buffers(nChunks);
+
+        #pragma omp parallel for default(shared)
+        for (int64_t i=0;i<nChunks;i++)
+        {
+            for (qint64 j=chunks[i];j<chunks[i+1];j++)
+            {
+                formatItem(batchBegin + j,buffers[i]);
+            }
+        }
+
+        for (int64_t i=0;i<nChunks;i++)
+        {
+            if (outFile.write(buffers[i].constData(),buffers[i].size()) != buffers[i].size())
+            {
+                throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Failed to write formatted text block.");
+            }
+        }
+    }
+}
+
+int RTextFormatter::findDigits(double value, unsigned int &digits)
+{
+    int exponent = int(std::floor(std::log10(value)));
+
+    double scaled = scaleByPowerOfTen(value,5-exponent);
+    if (scaled < 100000.0)
+    {
+        exponent--;
+        scaled = scaleByPowerOfTen(value,5-exponent);
+    }
+    else if (scaled >= 1000000.0)
+    {
+        exponent++;
+        scaled = scaleByPowerOfTen(value,5-exponent);
+    }
+
+    double integral = std::floor(scaled);
+    if (std::fabs(scaled - integral - 0.5) > 1.0e-6)
+    {
+        digits = (unsigned int)integral;
+        if (scaled - integral > 0.5)
+        {
+            digits++;
+        }
+    }
+    else
+    {
+        // Value is too close to the rounding boundary.
+        // Exact decimal expansion is used to decide (ties are rounded up).
+        char text[1024];
+        std::snprintf(text,sizeof(text),"%.800e",value);
+        unsigned int nDigits = 0;
+        const char *p = text;
+        digits = 0;
+        char nextDigit = '0';
+        for (;*p != '\0' && *p != 'e' && *p != 'E';p++)
+        {
+            if (*p < '0' || *p > '9')
+            {
+                continue;
+            }
+            if (nDigits < 6)
+            {
+                digits = 10 * digits + (unsigned int)(*p - '0');
+            }
+            else if (nDigits == 6)
+            {
+                nextDigit = *p;
+            }
+            nDigits++;
+        }
+        exponent = (*p != '\0') ? std::atoi(p+1) : 0;
+        if (nextDigit >= '5')
+        {
+            digits++;
+        }
+    }
+
+    if (digits >= 1000000)
+    {
+        digits /= 10;
+        exponent++;
+    }
+
+    return exponent;
+}
@@ -0,0 +1,640 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_text_parser.cpp                                      *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Text parser class definition                        *
+ *********************************************************************/
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <cctype>
+#include <omp.h>
+
+#include "rml_text_parser.h"
+
+// Exactly representable powers of ten.
+static const double textParserPowersOfTen[] = { 1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                                1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                                1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+RTextParser::RTextParser(const QString &fileName)
+    : file(fileName)
+    , pMap(nullptr)
+    , pData(nullptr)
+    , size(0)
+    , position(0)
+    , startTime(std::chrono::steady_clock::now())
+{
+    if (fileName.isEmpty())
+    {
+        throw RError(R_ERROR_INVALID_FILE_NAME,R_ERROR_REF,"No file name was provided.");
+    }
+
+    if (!this->file.open(QIODevice::ReadOnly))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",fileName.toUtf8().constData());
+    }
+
+    this->size = this->file.size();
+    if (this->size > 0)
+    {
+        this->pMap = this->file.map(0,this->size);
+    }
+    if (this->pMap)
+    {
+        this->pData = reinterpret_cast<const char*>(this->pMap);
+    }
+    else
+    {
+        this->buffer = this->file.readAll();
+        if (this->file.error() != QFile::NoError)
+        {
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read the file \'%s\'.",fileName.toUtf8().constData());
+        }
+        this->pData = this->buffer.constData();
+        this->size = this->buffer.size();
+    }
+}
+
+RTextParser::RTextParser(const QByteArray &data)
+    : pMap(nullptr)
+    , buffer(data)
+    , pData(nullptr)
+    , size(0)
+    , position(0)
+    , startTime(std::chrono::steady_clock::now())
+{
+    this->pData = this->buffer.constData();
+    this->size = this->buffer.size();
+}
+
+RTextParser::~RTextParser()
+{
+    if (this->pMap)
+    {
+        this->file.unmap(this->pMap);
+    }
+    if (this->file.isOpen())
+    {
+        this->file.close();
+    }
+}
+
+const char *RTextParser::getData(void) const
+{
+    return this->pData;
+}
+
+qint64 RTextParser::getSize(void) const
+{
+    return this->size;
+}
+
+qint64 RTextParser::getPosition(void) const
+{
+    return this->position;
+}
+
+void RTextParser::setPosition(qint64 position)
+{
+    R_ERROR_ASSERT(position >= 0 && position <= this->size);
+    this->position = position;
+}
+
+bool RTextParser::atEnd(void)
+{
+    this->skipSpace();
+    return (this->position >= this->size);
+}
+
+bool RTextParser::readToken(QString &token)
+{
+    this->skipSpace();
+    if (this->position >= this->size)
+    {
+        token.clear();
+        return false;
+    }
+    qint64 begin = this->position;
+    while (this->position < this->size && !RTextParser::isSpace(this->pData[this->position]))
+    {
+        this->position++;
+    }
+    token = QString::fromUtf8(this->pData + begin,int(this->position - begin));
+    return true;
+}
+
+bool RTextParser::readLine(QString &line)
+{
+    if (this->position >= this->size)
+    {
+        line.clear();
+        return false;
+    }
+    qint64 begin = this->position;
+    while (this->position < this->size && this->pData[this->position] != '\n')
+    {
+        this->position++;
+    }
+    qint64 end = this->position;
+    if (end > begin && this->pData[end-1] == '\r')
+    {
+        end--;
+    }
+    if (this->position < this->size)
+    {
+        this->position++;
+    }
+    line = QString::fromUtf8(this->pData + begin,int(end - begin));
+    return true;
+}
+
+void RTextParser::readValue(QString &sValue)
+{
+    // Same rules as RFileIO::readAscii(RFile &, QString &).
+    this->skipSpace();
+    if (this->position >= this->size)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read string value.");
+    }
+    qint64 begin = this->position;
+    qint64 end = this->position;
+    if (this->pData[this->position] == '"')
+    {
+        begin = ++this->position;
+        while (this->position < this->size && this->pData[this->position] != '"')
+        {
+            this->position++;
+        }
+        if (this->position >= this->size)
+        {
+            throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read string value.");
+        }
+        end = this->position++;
+    }
+    else
+    {
+        while (this->position < this->size && !RTextParser::isSpace(this->pData[this->position]))
+        {
+            this->position++;
+        }
+        end = this->position;
+    }
+    sValue = QString::fromUtf8(this->pData + begin,int(end - begin));
+}
+
+void RTextParser::readValue(bool &bValue)
+{
+    this->skipSpace();
+    if (this->position >= this->size)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read bool value.");
+    }
+    // Same rules as RFileIO::readAscii(RFile &, bool &).
+    bValue = (this->pData[this->position++] == 0);
+}
+
+void RTextParser::readValue(int &iValue)
+{
+    this->skipSpace();
+    const char *p = this->pData + this->position;
+    if (!RTextParser::parseInt(p,this->pData + this->size,iValue))
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read int value.");
+    }
+    this->position = p - this->pData;
+}
+
+void RTextParser::readValue(unsigned int &uValue)
+{
+    int iValue = 0;
+    this->skipSpace();
+    const char *p = this->pData + this->position;
+    if (!RTextParser::parseInt(p,this->pData + this->size,iValue) || iValue < 0)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read unsigned int value.");
+    }
+    this->position = p - this->pData;
+    uValue = (unsigned int)iValue;
+}
+
+void RTextParser::readValue(double &dValue)
+{
+    this->skipSpace();
+    const char *p = this->pData + this->position;
+    if (!RTextParser::parseDouble(p,this->pData + this->size,dValue))
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF, "Failed to read double value.");
+    }
+    this->position = p - this->pData;
+}
+
+void RTextParser::readValues(RRVector &rVector)
+{
+    this->readValues(rVector.data(),qint64(rVector.size()));
+}
+
+void RTextParser::readValues(RRMatrix &rMatrix)
+{
+    uint nr = rMatrix.getNRows();
+    uint nc = rMatrix.getNColumns();
+
+    std::vector<double> values(size_t(nr)*size_t(nc));
+    this->readValues(values.data(),qint64(values.size()));
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nr);i++)
+    {
+        std::copy(values.begin()+i*nc,values.begin()+(i+1)*nc,rMatrix[uint(i)].begin());
+    }
+}
+
+void RTextParser::readValues(RIMatrix &iMatrix)
+{
+    uint nr = iMatrix.getNRows();
+    uint nc = iMatrix.getNColumns();
+
+    std::vector<int> values(size_t(nr)*size_t(nc));
+    this->readValues(values.data(),qint64(values.size()));
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(nr);i++)
+    {
+        std::copy(values.begin()+i*nc,values.begin()+(i+1)*nc,iMatrix[uint(i)].begin());
+    }
+}
+
+template <typename T>
+static void parseTokenBlock(const char *pData,
+                            qint64 begin,
+                            qint64 end,
+                            qint64 nValues,
+                            T *values,
+                            bool (*parseFunc)(const char *&, const char *, T &))
+{
+    std::vector<qint64> chunks = RTextParser::findTokenChunks(pData,begin,end);
+
+    int64_t nChunks = int64_t(chunks.size()) - 1;
+    std::vector<qint64> chunkTokens(nChunks+1,0);
+
+    // Count tokens in each chunk.
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        qint64 nTokens = 0;
+        bool inToken = false;
+        for (qint64 j=chunks[i];j<chunks[i+1];j++)
+        {
+            bool space = RTextParser::isSpace(pData[j]);
+            if (!space && !inToken)
+            {
+                nTokens++;
+            }
+            inToken = !space;
+        }
+        chunkTokens[i+1] = nTokens;
+    }
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        chunkTokens[i+1] += chunkTokens[i];
+    }
+    if (chunkTokens[nChunks] != nValues)
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read values (expected = %lld, found = %lld).",(long long)nValues,(long long)chunkTokens[nChunks]);
+    }
+
+    // Parse values.
+    std::vector<char> chunkFailed(nChunks,0);
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        const char *p = pData + chunks[i];
+        const char *pEnd = pData + chunks[i+1];
+        for (qint64 j=chunkTokens[i];j<chunkTokens[i+1];j++)
+        {
+            while (p < pEnd && RTextParser::isSpace(*p))
+            {
+                p++;
+            }
+            if (!parseFunc(p,pEnd,values[j]) || (p < pEnd && !RTextParser::isSpace(*p)))
+            {
+                chunkFailed[i] = 1;
+                break;
+            }
+        }
+    }
+    if (std::find(chunkFailed.begin(),chunkFailed.end(),1) != chunkFailed.end())
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read values (invalid number).");
+    }
+}
+
+void RTextParser::readValues(double *values, qint64 nValues)
+{
+    if (nValues <= 0)
+    {
+        return;
+    }
+    this->skipSpace();
+    qint64 end = this->findTokensEnd(this->position,nValues);
+    parseTokenBlock<double>(this->pData,this->position,end,nValues,values,&RTextParser::parseDouble);
+    this->position = end;
+}
+
+void RTextParser::readValues(int *values, qint64 nValues)
+{
+    if (nValues <= 0)
+    {
+        return;
+    }
+    this->skipSpace();
+    qint64 end = this->findTokensEnd(this->position,nValues);
+    parseTokenBlock<int>(this->pData,this->position,end,nValues,values,&RTextParser::parseInt);
+    this->position = end;
+}
+
+void RTextParser::findLineOffsets(std::vector<qint64> &lineOffsets) const
+{
+    std::vector<qint64> chunks = RTextParser::findChunks(this->size);
+    int64_t nChunks = int64_t(chunks.size()) - 1;
+
+    std::vector< std::vector<qint64> > chunkOffsets(nChunks);
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        for (qint64 j=chunks[i];j<chunks[i+1];j++)
+        {
+            if (this->pData[j] == '\n' && j+1 < this->size)
+            {
+                chunkOffsets[i].push_back(j+1);
+            }
+        }
+    }
+
+    lineOffsets.clear();
+    if (this->size > 0)
+    {
+        lineOffsets.push_back(0);
+    }
+    for (int64_t i=0;i<nChunks;i++)
+    {
+        lineOffsets.insert(lineOffsets.end(),chunkOffsets[i].begin(),chunkOffsets[i].end());
+    }
+    lineOffsets.push_back(this->size);
+}
+
+std::vector<qint64> RTextParser::findChunks(qint64 nItems)
+{
+    qint64 nChunks = std::max(qint64(1),std::min(nItems/qint64(4096) + 1,qint64(omp_get_max_threads())*qint64(8)));
+
+    std::vector<qint64> chunks(nChunks+1,0);
+    for (qint64 i=0;i<=nChunks;i++)
+    {
+        chunks[i] = (nItems*i)/nChunks;
+    }
+    return chunks;
+}
+
+std::vector<qint64> RTextParser::findTokenChunks(const char *pData, qint64 begin, qint64 end)
+{
+    // Chunk boundaries are moved to nearest whitespace so that no token is split.
+    std::vector<qint64> chunks = RTextParser::findChunks(end - begin);
+    for (uint i=0;i<chunks.size();i++)
+    {
+        chunks[i] += begin;
+        while (chunks[i] > begin && chunks[i] < end && !RTextParser::isSpace(pData[chunks[i]]))
+        {
+            chunks[i]++;
+        }
+    }
+    return chunks;
+}
+
+void RTextParser::printThroughput(void) const
+{
+    double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->startTime).count();
+    double megaBytes = double(this->size)/(1024.0*1024.0);
+    RLogger::info("Parsed %.2f MB in %.3f s (%.2f MB/s)\n",megaBytes,elapsedTime,elapsedTime > 0.0 ? megaBytes/elapsedTime : 0.0);
+}
+
+bool RTextParser::matchToken(const char *&pBegin, const char *pEnd, const char *token)
+{
+    const char *p = pBegin;
+    while (*token != '\0')
+    {
+        if (p >= pEnd || std::tolower(static_cast<unsigned char>(*p)) != std::tolower(static_cast<unsigned char>(*token)))
+        {
+            return false;
+        }
+        p++;
+        token++;
+    }
+    if (p < pEnd && !RTextParser::isSpace(*p))
+    {
+        return false;
+    }
+    pBegin = p;
+    return true;
+}
+
+bool RTextParser::parseDouble(const char *&pBegin, const char *pEnd, double &value)
+{
+    const char *p = pBegin;
+
+    bool negative = false;
+    if (p < pEnd && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+
+    // Fast path: mantissa fits into 53 bits and power of ten is exactly representable.
+    uint64_t mantissa = 0;
+    int nDigits = 0;
+    int exponent = 0;
+    bool anyDigit = false;
+
+    while (p < pEnd && *p >= '0' && *p <= '9')
+    {
+        if (nDigits < 19)
+        {
+            mantissa = mantissa*10 + uint64_t(*p - '0');
+            if (mantissa > 0)
+            {
+                nDigits++;
+            }
+        }
+        else
+        {
+            exponent++;
+        }
+        anyDigit = true;
+        p++;
+    }
+    if (p < pEnd && *p == '.')
+    {
+        p++;
+        while (p < pEnd && *p >= '0' && *p <= '9')
+        {
+            if (nDigits < 19)
+            {
+                mantissa = mantissa*10 + uint64_t(*p - '0');
+                if (mantissa > 0)
+                {
+                    nDigits++;
+                }
+                exponent--;
+            }
+            anyDigit = true;
+            p++;
+        }
+    }
+
+    bool fastPath = anyDigit;
+
+    if (anyDigit && p < pEnd && (*p == 'e' || *p == 'E'))
+    {
+        const char *pExponent = p + 1;
+        bool negativeExponent = false;
+        if (pExponent < pEnd && (*pExponent == '-' || *pExponent == '+'))
+        {
+            negativeExponent = (*pExponent == '-');
+            pExponent++;
+        }
+        if (pExponent < pEnd && *pExponent >= '0' && *pExponent <= '9')
+        {
+            int e = 0;
+            while (pExponent < pEnd && *pExponent >= '0' && *pExponent <= '9')
+            {
+                if (e < 100000)
+                {
+                    e = e*10 + (*pExponent - '0');
+                }
+                pExponent++;
+            }
+            exponent += negativeExponent ? -e : e;
+            p = pExponent;
+        }
+    }
+
+    if (fastPath && nDigits >= 19)
+    {
+        fastPath = false;
+    }
+    if (fastPath && (mantissa >> 53) != 0)
+    {
+        fastPath = false;
+    }
+    if (fastPath && (exponent < -22 || exponent > 22))
+    {
+        fastPath = false;
+    }
+
+    if (fastPath)
+    {
+        double v = double(mantissa);
+        if (exponent < 0)
+        {
+            v /= textParserPowersOfTen[-exponent];
+        }
+        else
+        {
+            v *= textParserPowersOfTen[exponent];
+        }
+        value = negative ? -v : v;
+        pBegin = p;
+        return true;
+    }
+
+    // Slow path: locale independent conversion of the whole token (also handles inf/nan).
+    const char *pToken = pBegin;
+    while (p < pEnd && !RTextParser::isSpace(*p))
+    {
+        p++;
+    }
+    if (p == pToken)
+    {
+        return false;
+    }
+    bool isOk = false;
+    value = QByteArray::fromRawData(pToken,int(p - pToken)).toDouble(&isOk);
+    if (!isOk)
+    {
+        return false;
+    }
+    pBegin = p;
+    return true;
+}
+
+bool RTextParser::parseInt(const char *&pBegin, const char *pEnd, int &value)
+{
+    const char *p = pBegin;
+
+    bool negative = false;
+    if (p < pEnd && (*p == '-' || *p == '+'))
+    {
+        negative = (*p == '-');
+        p++;
+    }
+    if (p >= pEnd || *p < '0' || *p > '9')
+    {
+        return false;
+    }
+    int64_t v = 0;
+    while (p < pEnd && *p >= '0' && *p <= '9')
+    {
+        v = v*10 + int64_t(*p - '0');
+        if (v > int64_t(INT32_MAX) + 1)
+        {
+            return false;
+        }
+        p++;
+    }
+    v = negative ? -v : v;
+    if (v > int64_t(INT32_MAX) || v < int64_t(INT32_MIN))
+    {
+        return false;
+    }
+    value = int(v);
+    pBegin = p;
+    return true;
+}
+
+void RTextParser::skipSpace(void)
+{
+    while (this->position < this->size && RTextParser::isSpace(this->pData[this->position]))
+    {
+        this->position++;
+    }
+}
+
+qint64 RTextParser::findTokensEnd(qint64 begin, qint64 nTokens) const
+{
+    qint64 nFound = 0;
+    qint64 i = begin;
+    while (i < this->size)
+    {
+        while (i < this->size && RTextParser::isSpace(this->pData[i]))
+        {
+            i++;
+        }
+        if (i >= this->size)
+        {
+            break;
+        }
+        while (i < this->size && !RTextParser::isSpace(this->pData[i]))
+        {
+            i++;
+        }
+        if (++nFound == nTokens)
+        {
+            return i;
+        }
+    }
+    throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"Failed to read values (expected = %lld, found = %lld).",(long long)nTokens,(long long)nFound);
+}
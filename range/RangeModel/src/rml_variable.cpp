@@ -478,6 +478,19 @@ void RVariable::removeValues(const std::vector<uint> &valueBook)
 } /* RVariable::removeValues */
 
 
+void RVariable::renumberValues(const std::vector<uint> &valueBook)
+{
+    std::vector<RValueVector>::iterator iter;
+
+    for (iter = this->values.begin();
+         iter != this->values.end();
+         ++iter)
+    {
+        iter->renumber(valueBook);
+    }
+} /* RVariable::renumberValues */
+
+
 const RVariableData &RVariable::getVariableData(void) const
 {
     return this->variableData;
@@ -0,0 +1,86 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rml_variable_loader.cpp                                  *
+ *  GROUP:  RML                                                      *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Variable loader class definition                    *
+ *********************************************************************/
+
+#include <QFileInfo>
+
+#include "rml_variable_loader.h"
+#include "rml_file_io.h"
+
+RVariableLoader::RVariableLoader(const QString &fileName,
+                                 const RVersion &fileVersion,
+                                 bool compressed,
+                                 const std::vector<RVariableLocation> &locations)
+    : fileName(fileName)
+    , fileVersion(fileVersion)
+    , compressed(compressed)
+    , locations(locations)
+{
+    QFileInfo fileInfo(this->fileName);
+    this->fileSize = fileInfo.size();
+    this->fileLastModified = fileInfo.lastModified();
+} /* RVariableLoader::RVariableLoader */
+
+
+const QString &RVariableLoader::getFileName(void) const
+{
+    return this->fileName;
+} /* RVariableLoader::getFileName */
+
+
+bool RVariableLoader::isFile(const QString &fileName) const
+{
+    return (QFileInfo(fileName).absoluteFilePath() == QFileInfo(this->fileName).absoluteFilePath());
+} /* RVariableLoader::isFile */
+
+
+bool RVariableLoader::isFileUnchanged(void) const
+{
+    QFileInfo fileInfo(this->fileName);
+    return (fileInfo.exists() && fileInfo.size() == this->fileSize && fileInfo.lastModified() == this->fileLastModified);
+} /* RVariableLoader::isFileUnchanged */
+
+
+uint RVariableLoader::getNVariables(void) const
+{
+    return uint(this->locations.size());
+} /* RVariableLoader::getNVariables */
+
+
+std::mutex &RVariableLoader::getMutex(void)
+{
+    return this->mutex;
+} /* RVariableLoader::getMutex */
+
+
+void RVariableLoader::load(uint position, RVariable &variable) const
+{
+    R_ERROR_ASSERT(position < this->locations.size());
+
+    RLogger::info("Loading variable \'%s\' from file \'%s\'\n",variable.getName().toUtf8().constData(),this->fileName.toUtf8().constData());
+
+    if (!this->isFileUnchanged())
+    {
+        throw RError(R_ERROR_READ_FILE,R_ERROR_REF,"File \'%s\' was modified after it was read.",this->fileName.toUtf8().constData());
+    }
+
+    RFile modelFile(this->fileName,RFile::BINARY);
+
+    if (!modelFile.open(QIODevice::ReadOnly))
+    {
+        throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",this->fileName.toUtf8().constData());
+    }
+
+    modelFile.setVersion(this->fileVersion);
+    modelFile.setCompressed(this->compressed);
+
+    RFileIO::readBinaryValues(modelFile,variable,this->locations[position]);
+
+    modelFile.close();
+} /* RVariableLoader::load */
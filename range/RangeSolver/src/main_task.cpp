@@ -41,6 +41,15 @@ void MainTask::run(void)
         validOptions.append(RArgumentOption("monitoring-file",RArgumentOption::Path,QVariant(),"Monitoring file name",false,false));
         validOptions.append(RArgumentOption("nthreads",RArgumentOption::Integer,QVariant(1),"Number of threads to use",false,false));
         validOptions.append(RArgumentOption("restart",RArgumentOption::Switch,QVariant(),"Restart solver",false,false));
+        validOptions.append(RArgumentOption("compress",RArgumentOption::Switch,QVariant(),"Compress binary model files",false,false));
+        validOptions.append(RArgumentOption("checkpoint-interval",RArgumentOption::Real,QVariant(0.0),"Checkpoint interval in seconds",false,false));
+        validOptions.append(RArgumentOption("warm-start",RArgumentOption::String,QVariant(),"Comma separated problem IDs for which matrix solver starts from previous solution",false,false));
+        validOptions.append(RArgumentOption("warm-start-extrapolate",RArgumentOption::String,QVariant(),"Comma separated problem IDs for which initial guess is extrapolated from two previous solutions",false,false));
+        validOptions.append(RArgumentOption("domains",RArgumentOption::Integer,QVariant(1),"Number of shared memory domains used by additive Schwarz preconditioner (replaces Jacobi)",false,false));
+        validOptions.append(RArgumentOption("matrix-free",RArgumentOption::Switch,QVariant(),"Apply volume element matrices without assembling them (acoustic and heat problems)",false,false));
+        validOptions.append(RArgumentOption("segregated",RArgumentOption::Switch,QVariant(),"Solve fluid velocity and pressure equations one after another (SIMPLE type method)",false,false));
+        validOptions.append(RArgumentOption("fluid-jacobi",RArgumentOption::Switch,QVariant(),"Precondition coupled fluid velocity and pressure equations by Jacobi instead of block triangular preconditioner",false,false));
+        validOptions.append(RArgumentOption("deflation",RArgumentOption::Switch,QVariant(),"Deflate conjugate gradient solver with vectors recycled from previous solves (symmetric positive definite problems)",false,false));
         validOptions.append(RArgumentOption("task-id",RArgumentOption::Path,QVariant(),"Task ID for inter process communication",false,false));
         validOptions.append(RArgumentOption("task-server",RArgumentOption::Path,QVariant(),"Task server for inter process communication",false,false));
 
@@ -87,6 +96,42 @@ void MainTask::run(void)
         {
             solverInput.setRestart(true);
         }
+        if (argumentsParser.isSet("compress"))
+        {
+            solverInput.setCompress(true);
+        }
+        if (argumentsParser.isSet("checkpoint-interval"))
+        {
+            solverInput.setCheckpointInterval(argumentsParser.getValue("checkpoint-interval").toDouble());
+        }
+        if (argumentsParser.isSet("warm-start"))
+        {
+            solverInput.setWarmStart(argumentsParser.getValue("warm-start").toString());
+        }
+        if (argumentsParser.isSet("warm-start-extrapolate"))
+        {
+            solverInput.setWarmStartExtrapolate(argumentsParser.getValue("warm-start-extrapolate").toString());
+        }
+        if (argumentsParser.isSet("domains"))
+        {
+            solverInput.setNDomains(argumentsParser.getValue("domains").toUInt());
+        }
+        if (argumentsParser.isSet("matrix-free"))
+        {
+            solverInput.setMatrixFree(true);
+        }
+        if (argumentsParser.isSet("segregated"))
+        {
+            solverInput.setSegregated(true);
+        }
+        if (argumentsParser.isSet("fluid-jacobi"))
+        {
+            solverInput.setFluidJacobi(true);
+        }
+        if (argumentsParser.isSet("deflation"))
+        {
+            solverInput.setDeflation(true);
+        }
 
         // Start solver.
         QThread* thread = new QThread;
@@ -17,12 +17,28 @@ void SolverInput::_init(const SolverInput *pSolverInput)
         this->modelFileName = pSolverInput->modelFileName;
         this->convergenceFileName = pSolverInput->convergenceFileName;
         this->restart = pSolverInput->restart;
+        this->compress = pSolverInput->compress;
+        this->checkpointInterval = pSolverInput->checkpointInterval;
+        this->warmStart = pSolverInput->warmStart;
+        this->warmStartExtrapolate = pSolverInput->warmStartExtrapolate;
+        this->nDomains = pSolverInput->nDomains;
+        this->matrixFree = pSolverInput->matrixFree;
+        this->segregated = pSolverInput->segregated;
+        this->fluidJacobi = pSolverInput->fluidJacobi;
+        this->deflation = pSolverInput->deflation;
     }
 }
 
 SolverInput::SolverInput(const QString &modelFileName)
     : modelFileName(modelFileName)
     , restart(false)
+    , compress(false)
+    , checkpointInterval(0.0)
+    , nDomains(1)
+    , matrixFree(false)
+    , segregated(false)
+    , fluidJacobi(false)
+    , deflation(false)
 {
     this->_init();
 }
@@ -62,3 +78,48 @@ void SolverInput::setRestart(bool restart)
 {
     this->restart = restart;
 }
+
+void SolverInput::setCompress(bool compress)
+{
+    this->compress = compress;
+}
+
+void SolverInput::setCheckpointInterval(double checkpointInterval)
+{
+    this->checkpointInterval = checkpointInterval;
+}
+
+void SolverInput::setWarmStart(const QString &warmStart)
+{
+    this->warmStart = warmStart;
+}
+
+void SolverInput::setWarmStartExtrapolate(const QString &warmStartExtrapolate)
+{
+    this->warmStartExtrapolate = warmStartExtrapolate;
+}
+
+void SolverInput::setNDomains(uint nDomains)
+{
+    this->nDomains = nDomains;
+}
+
+void SolverInput::setMatrixFree(bool matrixFree)
+{
+    this->matrixFree = matrixFree;
+}
+
+void SolverInput::setSegregated(bool segregated)
+{
+    this->segregated = segregated;
+}
+
+void SolverInput::setFluidJacobi(bool fluidJacobi)
+{
+    this->fluidJacobi = fluidJacobi;
+}
+
+void SolverInput::setDeflation(bool deflation)
+{
+    this->deflation = deflation;
+}
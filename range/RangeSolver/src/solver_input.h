@@ -30,6 +30,24 @@ class SolverInput
         uint nThreads;
         //! Force to restart solver
         bool restart;
+        //! Compress binary model files.
+        bool compress;
+        //! Checkpoint interval in seconds.
+        double checkpointInterval;
+        //! Problem IDs for which matrix solver starts from previous solution.
+        QString warmStart;
+        //! Problem IDs for which initial guess is extrapolated from two previous solutions.
+        QString warmStartExtrapolate;
+        //! Number of domains used by matrix solver preconditioner.
+        uint nDomains;
+        //! Apply volume element matrices without assembling them.
+        bool matrixFree;
+        //! Solve fluid problems by segregated method.
+        bool segregated;
+        //! Precondition coupled fluid problems by Jacobi preconditioner.
+        bool fluidJacobi;
+        //! Deflate conjugate gradient solver with vectors recycled from previous solves.
+        bool deflation;
 
     private:
 
@@ -62,6 +80,33 @@ class SolverInput
         //! Set force restart solver.
         void setRestart(bool restart);
 
+        //! Set compress binary model files.
+        void setCompress(bool compress);
+
+        //! Set checkpoint interval in seconds.
+        void setCheckpointInterval(double checkpointInterval);
+
+        //! Set comma separated problem IDs for which matrix solver starts from previous solution.
+        void setWarmStart(const QString &warmStart);
+
+        //! Set comma separated problem IDs for which initial guess is extrapolated from two previous solutions.
+        void setWarmStartExtrapolate(const QString &warmStartExtrapolate);
+
+        //! Set number of domains used by matrix solver preconditioner.
+        void setNDomains(uint nDomains);
+
+        //! Set whether volume element matrices are applied without assembling them.
+        void setMatrixFree(bool matrixFree);
+
+        //! Set whether fluid problems are solved by segregated method.
+        void setSegregated(bool segregated);
+
+        //! Set whether coupled fluid problems are preconditioned by Jacobi preconditioner.
+        void setFluidJacobi(bool fluidJacobi);
+
+        //! Set whether conjugate gradient solver is deflated with vectors recycled from previous solves.
+        void setDeflation(bool deflation);
+
         friend class SolverTask;
 
 };
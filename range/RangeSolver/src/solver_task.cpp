@@ -17,6 +17,20 @@
 
 #include "solver_task.h"
 
+static void setWarmStart(RModel &model, const QString &problemIds, RWarmStartType warmStartType)
+{
+    foreach (const QString &problemId, problemIds.split(',',QString::SkipEmptyParts))
+    {
+        RProblemType problemType = RProblem::getTypeFromId(problemId.trimmed());
+        if (problemType == R_PROBLEM_NONE)
+        {
+            RLogger::warning("Unknown problem ID \'%s\' in warm start list.\n",problemId.toUtf8().constData());
+            continue;
+        }
+        model.getProblemSetup().setWarmStart(problemType,warmStartType);
+    }
+}
+
 SolverTask::SolverTask(const SolverInput &solverInput, QCoreApplication *app, QObject *parent)
     : QObject(parent)
     , modelFileName(solverInput.modelFileName)
@@ -24,6 +38,15 @@ SolverTask::SolverTask(const SolverInput &solverInput, QCoreApplication *app, QO
     , monitoringFileName(solverInput.monitoringFileName)
     , nThreads(solverInput.nThreads)
     , restart(solverInput.restart)
+    , compress(solverInput.compress)
+    , checkpointInterval(solverInput.checkpointInterval)
+    , warmStart(solverInput.warmStart)
+    , warmStartExtrapolate(solverInput.warmStartExtrapolate)
+    , nDomains(solverInput.nDomains)
+    , matrixFree(solverInput.matrixFree)
+    , segregated(solverInput.segregated)
+    , fluidJacobi(solverInput.fluidJacobi)
+    , deflation(solverInput.deflation)
     , app(app)
 {
     this->nThreads = std::max(this->nThreads,uint(1));
@@ -54,11 +77,26 @@ void SolverTask::run(void)
 
     model.getMatrixSolverConf(RMatrixSolverConf::CG).setOutputFileName(RFileManager::getFileNameWithSuffix(this->convergenceFileName,RMatrixSolverConf::getId(RMatrixSolverConf::CG)));
     model.getMatrixSolverConf(RMatrixSolverConf::GMRES).setOutputFileName(RFileManager::getFileNameWithSuffix(this->convergenceFileName,RMatrixSolverConf::getId(RMatrixSolverConf::GMRES)));
+    model.getMatrixSolverConf(RMatrixSolverConf::CG).setNDomains(this->nDomains);
+    model.getMatrixSolverConf(RMatrixSolverConf::GMRES).setNDomains(this->nDomains);
+    model.getMatrixSolverConf(RMatrixSolverConf::CG).setMatrixFree(this->matrixFree);
+    model.getMatrixSolverConf(RMatrixSolverConf::CG).setDeflation(this->deflation);
+    model.getMatrixSolverConf(RMatrixSolverConf::GMRES).setSaddlePointPreconditioner(!this->fluidJacobi);
     model.getMonitoringPointManager().setOutputFileName(this->monitoringFileName);
     if (this->restart)
     {
         model.getProblemSetup().setRestart(true);
     }
+    if (this->compress)
+    {
+        model.setBinaryCompression(true);
+    }
+    setWarmStart(model,this->warmStart,R_WARM_START_PREVIOUS);
+    setWarmStart(model,this->warmStartExtrapolate,R_WARM_START_EXTRAPOLATE);
+    if (this->segregated)
+    {
+        model.getProblemSetup().setSegregated(R_PROBLEM_FLUID,true);
+    }
 
     // Solve model
     try
@@ -68,6 +106,7 @@ void SolverTask::run(void)
         RLogger::info("\n");
         RLogger::indent();
         RSolver solver(model,this->modelFileName,this->convergenceFileName);
+        solver.setCheckpointInterval(this->checkpointInterval);
         solver.run();
         RLogger::unindent();
         RLogger::info("\n");
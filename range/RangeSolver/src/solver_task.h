@@ -33,6 +33,24 @@ class SolverTask : public QObject
         uint nThreads;
         //! Force to restart solver
         bool restart;
+        //! Compress binary model files.
+        bool compress;
+        //! Checkpoint interval in seconds.
+        double checkpointInterval;
+        //! Problem IDs for which matrix solver starts from previous solution.
+        QString warmStart;
+        //! Problem IDs for which initial guess is extrapolated from two previous solutions.
+        QString warmStartExtrapolate;
+        //! Number of domains used by matrix solver preconditioner.
+        uint nDomains;
+        //! Apply volume element matrices without assembling them.
+        bool matrixFree;
+        //! Solve fluid problems by segregated method.
+        bool segregated;
+        //! Precondition coupled fluid problems by Jacobi preconditioner.
+        bool fluidJacobi;
+        //! Deflate conjugate gradient solver with vectors recycled from previous solves.
+        bool deflation;
         //! Pointer to application object.
         QCoreApplication *app;
 
@@ -17,16 +17,26 @@ INCLUDEPATH += include
 SOURCES += \
     src/rconvection.cpp \
     src/reigenvaluesolver.cpp \
+    src/relementlist.cpp \
+    src/relementmatrixoperator.cpp \
+    src/rgeometricfactors.cpp \
     src/rhemicube.cpp \
     src/rhemicubepixel.cpp \
     src/rhemicubesector.cpp \
     src/riterationinfo.cpp \
     src/riterationinfovalue.cpp \
     src/rlocalrotation.cpp \
+    src/rmaterialpropertycache.cpp \
+    src/rmatrixdeflation.cpp \
     src/rmatrixmanager.cpp \
+    src/rmatrixoperator.cpp \
     src/rmatrixpreconditioner.cpp \
     src/rmatrixsolver.cpp \
+    src/rmodelwriter.cpp \
+    src/rsaddlepointmatrix.cpp \
+    src/rsaddlepointpreconditioner.cpp \
     src/rscales.cpp \
+    src/rsegregatedmatrix.cpp \
     src/rsolver.cpp \
     src/rsolveracoustic.cpp \
     src/rsolverelectrostatics.cpp \
@@ -45,16 +55,27 @@ SOURCES += \
 HEADERS += \
     include/rconvection.h \
     include/reigenvaluesolver.h \
+    include/relementbatch.h \
+    include/relementlist.h \
+    include/relementmatrixoperator.h \
+    include/rgeometricfactors.h \
     include/rhemicube.h \
     include/rhemicubepixel.h \
     include/rhemicubesector.h \
     include/riterationinfo.h \
     include/riterationinfovalue.h \
     include/rlocalrotation.h \
+    include/rmaterialpropertycache.h \
+    include/rmatrixdeflation.h \
     include/rmatrixmanager.h \
+    include/rmatrixoperator.h \
     include/rmatrixpreconditioner.h \
     include/rmatrixsolver.h \
+    include/rmodelwriter.h \
+    include/rsaddlepointmatrix.h \
+    include/rsaddlepointpreconditioner.h \
     include/rscales.h \
+    include/rsegregatedmatrix.h \
     include/rsolver.h \
     include/rsolveracoustic.h \
     include/rsolverelectrostatics.h \
@@ -0,0 +1,261 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   relementbatch.h                                          *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element batch class declaration                     *
+ *********************************************************************/
+
+#ifndef RELEMENTBATCH_H
+#define RELEMENTBATCH_H
+
+#include <rblib.h>
+#include <rmlib.h>
+
+#include "rgeometricfactors.h"
+
+//! Number of elements integrated together (vector lanes).
+#define R_ELEMENT_BATCH_SIZE 8
+
+//! Vectorize loop over batch lanes.
+//! Without OpenMP 4.0 support the loop is left to the compiler (scalar fallback).
+#if defined(_OPENMP) && _OPENMP >= 201307
+#  define R_ELEMENT_BATCH_SIMD _Pragma("omp simd")
+#else
+#  define R_ELEMENT_BATCH_SIMD
+#endif
+
+//! Batch of element matrices.
+//! Values are stored lane-major, value at given row and column is followed
+//! by values of the same row and column of the other elements in the batch.
+template <unsigned int N, unsigned int M>
+class RElementBatchMatrix
+{
+
+    protected:
+
+        //! Matrix values.
+        double values[N*M*R_ELEMENT_BATCH_SIZE];
+
+    public:
+
+        //! Fill all lanes with given value.
+        inline void fill(double value)
+        {
+            for (unsigned int i=0;i<N*M*R_ELEMENT_BATCH_SIZE;i++)
+            {
+                this->values[i] = value;
+            }
+        }
+
+        //! Return pointer to lanes of given row and column.
+        inline double *operator ()(unsigned int row, unsigned int column)
+        {
+            return &this->values[(row*M+column)*R_ELEMENT_BATCH_SIZE];
+        }
+
+        //! Return const pointer to lanes of given row and column.
+        inline const double *operator ()(unsigned int row, unsigned int column) const
+        {
+            return &this->values[(row*M+column)*R_ELEMENT_BATCH_SIZE];
+        }
+
+        //! Copy matrix of given lane (matrix has to be already sized to N x M).
+        template <class TMatrix>
+        inline void getLane(unsigned int lane, TMatrix &A) const
+        {
+            for (unsigned int i=0;i<N;i++)
+            {
+                for (unsigned int j=0;j<M;j++)
+                {
+                    A[i][j] = this->values[(i*M+j)*R_ELEMENT_BATCH_SIZE+lane];
+                }
+            }
+        }
+
+};
+
+//! Batch of element vectors.
+//! Values are stored lane-major.
+template <unsigned int N>
+class RElementBatchVector
+{
+
+    protected:
+
+        //! Vector values.
+        double values[N*R_ELEMENT_BATCH_SIZE];
+
+    public:
+
+        //! Fill all lanes with given value.
+        inline void fill(double value)
+        {
+            for (unsigned int i=0;i<N*R_ELEMENT_BATCH_SIZE;i++)
+            {
+                this->values[i] = value;
+            }
+        }
+
+        //! Return pointer to lanes of given position.
+        inline double *operator ()(unsigned int n)
+        {
+            return &this->values[n*R_ELEMENT_BATCH_SIZE];
+        }
+
+        //! Return const pointer to lanes of given position.
+        inline const double *operator ()(unsigned int n) const
+        {
+            return &this->values[n*R_ELEMENT_BATCH_SIZE];
+        }
+
+        //! Copy vector of given lane (vector has to be already sized to N).
+        template <class TVector>
+        inline void getLane(unsigned int lane, TVector &v) const
+        {
+            for (unsigned int i=0;i<N;i++)
+            {
+                v[i] = this->values[i*R_ELEMENT_BATCH_SIZE+lane];
+            }
+        }
+
+};
+
+//! Batch of volume elements of the same type.
+//! Geometric factors of up to R_ELEMENT_BATCH_SIZE elements are gathered
+//! into lane-major buffers so that element matrices of all elements in the
+//! batch are integrated together by vectorized loops over lanes. Unused
+//! lanes are filled with zeros and produce zero element matrices.
+template <unsigned int nNodes, unsigned int nPoints>
+class RElementBatch
+{
+
+    protected:
+
+        //! Number of elements in the batch.
+        unsigned int nElements;
+        //! Element IDs.
+        unsigned int elementIDs[R_ELEMENT_BATCH_SIZE];
+        //! Shape function values (same for all lanes).
+        double N[nPoints][nNodes];
+        //! Jacobian determinant multiplied by integration weight.
+        double detJW[nPoints][R_ELEMENT_BATCH_SIZE];
+        //! Shape function gradients in global coordinates.
+        double B[nPoints][nNodes][3][R_ELEMENT_BATCH_SIZE];
+
+    public:
+
+        //! Constructor.
+        RElementBatch()
+            : nElements(0)
+        {
+        }
+
+        //! Return number of elements in the batch.
+        inline unsigned int size(void) const
+        {
+            return this->nElements;
+        }
+
+        //! Return true if no more elements can be added.
+        inline bool isFull(void) const
+        {
+            return (this->nElements == R_ELEMENT_BATCH_SIZE);
+        }
+
+        //! Remove all elements.
+        inline void clear(void)
+        {
+            this->nElements = 0;
+        }
+
+        //! Add element to the batch.
+        inline void add(unsigned int elementID)
+        {
+            R_ERROR_ASSERT(!this->isFull());
+            this->elementIDs[this->nElements++] = elementID;
+        }
+
+        //! Return element ID in given lane.
+        inline unsigned int getElementID(unsigned int lane) const
+        {
+            return this->elementIDs[lane];
+        }
+
+        //! Gather geometric factors of all elements in the batch.
+        //! All elements have to be of given type.
+        void gather(const RGeometricFactors &geometricFactors, RElementType elementType)
+        {
+            for (unsigned int k=0;k<nPoints;k++)
+            {
+                const RRVector &shapeN = RElement::getShapeFunction(elementType,k).getN();
+                for (unsigned int m=0;m<nNodes;m++)
+                {
+                    this->N[k][m] = shapeN[m];
+                }
+            }
+
+            for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+            {
+                if (l < this->nElements)
+                {
+                    unsigned int elementID = this->elementIDs[l];
+                    R_ERROR_ASSERT(geometricFactors.getNPoints(elementID) == nPoints);
+                    for (unsigned int k=0;k<nPoints;k++)
+                    {
+                        const double *values = geometricFactors.getGradients(elementID,k);
+                        this->detJW[k][l] = geometricFactors.getDetJW(elementID,k);
+                        for (unsigned int m=0;m<nNodes;m++)
+                        {
+                            this->B[k][m][0][l] = values[3*m+0];
+                            this->B[k][m][1][l] = values[3*m+1];
+                            this->B[k][m][2][l] = values[3*m+2];
+                        }
+                    }
+                }
+                else
+                {
+                    for (unsigned int k=0;k<nPoints;k++)
+                    {
+                        this->detJW[k][l] = 0.0;
+                        for (unsigned int m=0;m<nNodes;m++)
+                        {
+                            this->B[k][m][0][l] = this->B[k][m][1][l] = this->B[k][m][2][l] = 0.0;
+                        }
+                    }
+                }
+            }
+        }
+
+        //! Gather element values into lanes (unused lanes are set to zero).
+        inline void gather(const RRVector &elementValues, double lanes[R_ELEMENT_BATCH_SIZE]) const
+        {
+            for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+            {
+                lanes[l] = (l < this->nElements) ? elementValues[this->elementIDs[l]] : 0.0;
+            }
+        }
+
+        //! Return shape function value of given node at given integration point.
+        inline double getN(unsigned int point, unsigned int node) const
+        {
+            return this->N[point][node];
+        }
+
+        //! Return lanes of jacobian determinant multiplied by integration weight.
+        inline const double *getDetJW(unsigned int point) const
+        {
+            return this->detJW[point];
+        }
+
+        //! Return lanes of shape function gradient of given node in given direction.
+        inline const double *getB(unsigned int point, unsigned int node, unsigned int direction) const
+        {
+            return this->B[point][node][direction];
+        }
+
+};
+
+#endif // RELEMENTBATCH_H
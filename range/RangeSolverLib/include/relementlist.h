@@ -0,0 +1,81 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   relementlist.h                                           *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element list class declaration                      *
+ *********************************************************************/
+
+#ifndef RELEMENTLIST_H
+#define RELEMENTLIST_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+//! Chunk size used to dynamically schedule parallel loops over element list.
+#define R_ELEMENT_LIST_CHUNK_SIZE 64
+
+//! Flat list of elements of all entities of one kind (points, lines, surfaces or volumes).
+//! Elements are sorted by element type and for every element index of entity
+//! it belongs to is stored, so that elements of all entities can be processed
+//! by a single parallel loop.
+class RElementList
+{
+
+    protected:
+
+        //! Element IDs.
+        std::vector<unsigned int> elementIDs;
+        //! Entity IDs.
+        std::vector<unsigned int> entityIDs;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RElementList *pElementList = nullptr);
+
+    public:
+
+        //! Constructor.
+        RElementList();
+
+        //! Copy constructor.
+        RElementList(const RElementList &elementList);
+
+        //! Destructor.
+        ~RElementList();
+
+        //! Assignment operator.
+        RElementList &operator =(const RElementList &elementList);
+
+        //! Build list from elements of all entities of given type for which mask is set.
+        void build(const RModel &rModel, REntityGroupType entityType, const RBVector &elementMask);
+
+        //! Clear list.
+        void clear(void);
+
+        //! Return number of elements in the list.
+        inline unsigned int size(void) const
+        {
+            return (unsigned int)this->elementIDs.size();
+        }
+
+        //! Return element ID at given position.
+        inline unsigned int getElementID(unsigned int position) const
+        {
+            return this->elementIDs[position];
+        }
+
+        //! Return ID of entity to which element at given position belongs.
+        inline unsigned int getEntityID(unsigned int position) const
+        {
+            return this->entityIDs[position];
+        }
+
+};
+
+#endif // RELEMENTLIST_H
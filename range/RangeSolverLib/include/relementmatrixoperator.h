@@ -0,0 +1,125 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   relementmatrixoperator.h                                 *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element matrix operator class declaration           *
+ *********************************************************************/
+
+#ifndef RELEMENTMATRIXOPERATOR_H
+#define RELEMENTMATRIXOPERATOR_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+#include "rgeometricfactors.h"
+#include "rmatrixoperator.h"
+
+//! Matrix-free operator of volume elements.
+//! Volume element matrices are never stored. Their product with vector is
+//! computed element-by-element from geometric factors as
+//! Ae = s * integral(B*B') + m * integral(N*N')
+//! where s and m are element stiffness and mass coefficients.
+//! Contribution of all other elements is taken from explicitly stored sparse matrix.
+//! Elements are split into colors so that elements of the same color do not
+//! share any unknown and can be processed concurrently.
+class RElementMatrixOperator : public RMatrixOperator
+{
+
+    protected:
+
+        //! Pointer to geometric factors.
+        const RGeometricFactors *pGeometricFactors;
+        //! Operator of explicitly assembled part of the matrix.
+        RSparseMatrixOperator matrixOperator;
+        //! Number of rows.
+        unsigned int nRows;
+        //! Element IDs ordered by color.
+        std::vector<unsigned int> elementIDs;
+        //! Element types.
+        std::vector<RElementType> elementTypes;
+        //! Offsets to element arrays for each color (size = nColors + 1).
+        std::vector<unsigned int> colorOffsets;
+        //! Offsets to positions array (size = nElements + 1).
+        std::vector<unsigned int> positionOffsets;
+        //! Unknown positions of element nodes (RConstants::eod if node is not an unknown).
+        std::vector<unsigned int> positions;
+        //! Stiffness coefficients.
+        std::vector<double> stiffnessCoefficients;
+        //! Mass coefficients.
+        std::vector<double> massCoefficients;
+        //! Matrix diagonal.
+        RRVector diagonal;
+        //! Euclidean norm of matrix row sums.
+        double norm;
+        //! Estimated Frobenius norm.
+        double frobeniusNorm;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RElementMatrixOperator *pElementMatrixOperator = nullptr);
+
+    public:
+
+        //! Constructor.
+        //! Volume elements with stored geometric factors and at least one non-zero coefficient are applied matrix-free.
+        //! Coefficient vectors are indexed by element ID.
+        RElementMatrixOperator(const RModel &rModel,
+                               const RBook &nodeBook,
+                               const RGeometricFactors &geometricFactors,
+                               const RSparseMatrix &matrix,
+                               const RRVector &elementStiffnessCoefficients,
+                               const RRVector &elementMassCoefficients);
+
+        //! Copy constructor.
+        RElementMatrixOperator(const RElementMatrixOperator &elementMatrixOperator);
+
+        //! Destructor.
+        ~RElementMatrixOperator();
+
+        //! Assignment operator.
+        RElementMatrixOperator & operator =(const RElementMatrixOperator &elementMatrixOperator);
+
+        //! Return number of rows.
+        unsigned int getNRows(void) const;
+
+        //! Return number of matrix-free elements.
+        unsigned int getNElements(void) const;
+
+        //! Return number of element colors.
+        unsigned int getNColors(void) const;
+
+        //! Matrix vector multiplication - y=A*x.
+        void multiply(const RRVector &x, RRVector &y) const;
+
+        //! Return matrix diagonal.
+        void getDiagonal(RRVector &d) const;
+
+        //! Return euclidean norm of matrix row sums.
+        double findNorm(void) const;
+
+        //! Return Frobenius norm of the matrix.
+        //! Contributions of overlapping elements are summed as if they did not overlap.
+        double findFrobeniusNorm(void) const;
+
+    protected:
+
+        //! Assign colors to elements and reorder element arrays by color.
+        void colorElements(void);
+
+        //! Compute element matrix.
+        template <unsigned int nNodes, unsigned int nPoints>
+        void computeElementMatrix(unsigned int elementPosition, double *Ae) const;
+
+        //! Add product of element matrix and vector - y+=Ae*x.
+        template <unsigned int nNodes, unsigned int nPoints>
+        void multiplyElement(unsigned int elementPosition, const RRVector &x, RRVector &y) const;
+
+};
+
+#endif // RELEMENTMATRIXOPERATOR_H
@@ -0,0 +1,106 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rgeometricfactors.h                                      *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Geometric factors class declaration                 *
+ *********************************************************************/
+
+#ifndef RGEOMETRICFACTORS_H
+#define RGEOMETRICFACTORS_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+//! Geometric factors of volume elements.
+//! For every integration point of every volume element inverse jacobian,
+//! jacobian determinant multiplied by integration weight and shape function
+//! gradients in global coordinates are stored. Each factor is stored in its
+//! own contiguous array (structure of arrays). Other element types have no
+//! integration points stored.
+class RGeometricFactors
+{
+
+    protected:
+
+        //! Number of nodes for which factors were built.
+        uint nNodes;
+        //! Number of elements for which factors were built.
+        uint nElements;
+        //! Length scale for which factors were built.
+        double lengthScale;
+        //! Offsets to integration point arrays (size = nElements + 1).
+        std::vector<uint> pointOffsets;
+        //! Offsets to gradient array (size = nElements + 1).
+        std::vector<std::size_t> gradientOffsets;
+        //! Jacobian determinant multiplied by integration weight.
+        std::vector<double> detJW;
+        //! Inverse jacobian (3x3 row major).
+        std::vector<double> inverseJacobians;
+        //! Shape function gradients in global coordinates (nNodes x 3 row major).
+        std::vector<double> gradients;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RGeometricFactors *pGeometricFactors = nullptr);
+
+    public:
+
+        //! Constructor.
+        RGeometricFactors();
+
+        //! Copy constructor.
+        RGeometricFactors(const RGeometricFactors &geometricFactors);
+
+        //! Destructor.
+        ~RGeometricFactors();
+
+        //! Assignment operator.
+        RGeometricFactors &operator =(const RGeometricFactors &geometricFactors);
+
+        //! Build factors from given model.
+        void build(const RModel &rModel, double lengthScale);
+
+        //! Clear factors.
+        void clear(void);
+
+        //! Return true if factors were built for model with given number of nodes, elements and length scale.
+        bool isValid(uint nNodes, uint nElements, double lengthScale) const;
+
+        //! Return number of integration points stored for given element.
+        inline uint getNPoints(uint elementID) const
+        {
+            return this->pointOffsets[elementID+1] - this->pointOffsets[elementID];
+        }
+
+        //! Return jacobian determinant multiplied by integration weight.
+        inline double getDetJW(uint elementID, uint point) const
+        {
+            return this->detJW[this->pointOffsets[elementID]+point];
+        }
+
+        //! Return pointer to inverse jacobian (3x3 row major).
+        inline const double *getInverseJacobian(uint elementID, uint point) const
+        {
+            return &this->inverseJacobians[9*std::size_t(this->pointOffsets[elementID]+point)];
+        }
+
+        //! Return pointer to shape function gradients (nNodes x 3 row major).
+        inline const double *getGradients(uint elementID, uint point) const
+        {
+            uint nPoints = this->getNPoints(elementID);
+            std::size_t pointSize = (this->gradientOffsets[elementID+1] - this->gradientOffsets[elementID]) / nPoints;
+            return &this->gradients[this->gradientOffsets[elementID] + point*pointSize];
+        }
+
+        //! Copy shape function gradients to matrix (matrix has to be already sized to nNodes x 3).
+        void getGradients(uint elementID, uint point, RRMatrix &B) const;
+
+};
+
+#endif // RGEOMETRICFACTORS_H
@@ -0,0 +1,91 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmaterialpropertycache.h                                 *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Material property cache class declaration           *
+ *********************************************************************/
+
+#ifndef RMATERIALPROPERTYCACHE_H
+#define RMATERIALPROPERTYCACHE_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+//! Temperature difference up to which cached material property values are reused.
+//! Zero reuses values only for unchanged temperature, so values are exact.
+//! Positive tolerance returns values evaluated at slightly different temperature
+//! which may differ from table value by up to tolerance times table slope.
+#define R_MATERIAL_PROPERTY_CACHE_TEMPERATURE_TOLERANCE 0.0
+
+//! Cache of material property values of elements.
+//! Property tables of all element groups are compiled to flat arrays and
+//! evaluated in parallel. Element value is reevaluated only if material of
+//! its element group changed or if its temperature differs by more than
+//! given tolerance from temperature of the last evaluation.
+//! Values are therefore not exact, returned value may correspond to temperature
+//! of the last evaluation. Zero tolerance gives exact table values.
+class RMaterialPropertyCache
+{
+
+    protected:
+
+        //! Material property type.
+        RMaterialPropertyType type;
+        //! Material property of each element group (used to detect material changes).
+        std::vector<RMaterialProperty> groupProperties;
+        //! Element group has material property.
+        std::vector<bool> groupHasProperty;
+        //! Element group property does not depend on temperature.
+        std::vector<bool> groupConstant;
+        //! Compiled property table of each element group.
+        std::vector<RCompiledValueTable> groupTables;
+        //! Element group of each element (RConstants::eod if element group has no property).
+        std::vector<unsigned int> elementGroups;
+        //! Element temperature of the last evaluation (NaN if element value is not valid).
+        RRVector elementTemperature;
+        //! Element values.
+        RRVector elementValues;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RMaterialPropertyCache *pMaterialPropertyCache = nullptr);
+
+    public:
+
+        //! Constructor.
+        RMaterialPropertyCache(RMaterialPropertyType type = R_MATERIAL_PROPERTY_NONE);
+
+        //! Copy constructor.
+        RMaterialPropertyCache(const RMaterialPropertyCache &materialPropertyCache);
+
+        //! Destructor.
+        ~RMaterialPropertyCache();
+
+        //! Assignment operator.
+        RMaterialPropertyCache &operator =(const RMaterialPropertyCache &materialPropertyCache);
+
+        //! Return material property type.
+        RMaterialPropertyType getType(void) const;
+
+        //! Clear cache.
+        void clear(void);
+
+        //! Evaluate material property for all elements.
+        //! Values of elements which belong to element groups without given property are left unchanged.
+        void evaluate(const RModel &rModel, const RRVector &elementTemperature, double temperatureTolerance, RRVector &materialPropertyValues);
+
+    protected:
+
+        //! Update compiled tables of element groups.
+        //! Element values of groups whose property changed are invalidated.
+        void update(const RModel &rModel);
+
+};
+
+#endif // RMATERIALPROPERTYCACHE_H
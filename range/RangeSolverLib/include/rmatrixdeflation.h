@@ -0,0 +1,104 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmatrixdeflation.h                                       *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Matrix deflation class declaration                  *
+ *********************************************************************/
+
+#ifndef RMATRIXDEFLATION_H
+#define RMATRIXDEFLATION_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+#include "rmatrixoperator.h"
+
+//! Deflation space for sequence of related symmetric systems.
+//! Approximate eigenvectors belonging to the smallest eigenvalues are
+//! extracted (Rayleigh-Ritz) from search directions of one solve and used
+//! to deflate conjugate gradient iterations of the following solves.
+class RMatrixDeflation
+{
+
+    protected:
+
+        //! Maximum number of deflation vectors.
+        unsigned int nMaxVectors;
+        //! Deflation vectors.
+        std::vector<RRVector> W;
+        //! Deflation vectors multiplied by matrix (A*W).
+        std::vector<RRVector> AW;
+        //! Inverse of projected matrix (W'*A*W)^-1.
+        RRMatrix invE;
+        //! Search directions collected during current solve.
+        std::vector<RRVector> P;
+        //! Search directions multiplied by matrix (A*P).
+        std::vector<RRVector> AP;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RMatrixDeflation *pMatrixDeflation = nullptr);
+
+    public:
+
+        //! Constructor.
+        RMatrixDeflation(unsigned int nMaxVectors = 4);
+
+        //! Copy constructor.
+        RMatrixDeflation(const RMatrixDeflation &matrixDeflation);
+
+        //! Destructor.
+        ~RMatrixDeflation();
+
+        //! Assignment operator.
+        RMatrixDeflation & operator =(const RMatrixDeflation &matrixDeflation);
+
+        //! Remove all deflation vectors.
+        void clear(void);
+
+        //! Return number of deflation vectors.
+        unsigned int getNVectors(void) const;
+
+        //! Return deflation vectors.
+        const std::vector<RRVector> &getVectors(void) const;
+
+        //! Set deflation vectors.
+        //! Projected matrix is computed in next prepare.
+        void setVectors(const std::vector<RRVector> &W);
+
+        //! Prepare deflation for given matrix.
+        //! Deflation vectors are removed if their size does not match or projected matrix is singular.
+        void prepare(const RMatrixOperator &A);
+
+        //! Correct initial solution so that residual is orthogonal to deflation space.
+        //! x += W*(W'*A*W)^-1*W'*r, r -= A*W*(W'*A*W)^-1*W'*r
+        void correctSolution(RRVector &x, RRVector &r) const;
+
+        //! Remove deflation space component from search direction.
+        //! p -= W*(W'*A*W)^-1*(A*W)'*z
+        void deflateDirection(const RRVector &z, RRVector &p) const;
+
+        //! Return true if another search direction should be collected.
+        bool collectDirection(void) const;
+
+        //! Store search direction p and q=A*p.
+        void addDirection(const RRVector &p, const RRVector &q);
+
+        //! Update deflation vectors from current deflation vectors and collected search directions.
+        void update(void);
+
+    protected:
+
+        //! Compute eigenvalues and eigenvectors of symmetric matrix (Jacobi rotations).
+        //! Eigenvectors are stored in columns of matrix V.
+        static void solveSymmetricEigenValues(RRMatrix &S, RRVector &d, RRMatrix &V);
+
+};
+
+#endif // RMATRIXDEFLATION_H
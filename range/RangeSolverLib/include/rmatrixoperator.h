@@ -0,0 +1,101 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmatrixoperator.h                                        *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Matrix operator class declaration                   *
+ *********************************************************************/
+
+#ifndef RMATRIXOPERATOR_H
+#define RMATRIXOPERATOR_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+//! Linear operator applied by iterative matrix solver.
+//! Operator does not need to store matrix explicitly.
+class RMatrixOperator
+{
+
+    public:
+
+        //! Destructor.
+        virtual ~RMatrixOperator();
+
+        //! Return number of rows.
+        virtual unsigned int getNRows(void) const = 0;
+
+        //! Matrix vector multiplication - y=A*x.
+        //! Vector y has to be already sized.
+        //! Has to be called by all threads of parallel region, work is shared among them.
+        virtual void multiply(const RRVector &x, RRVector &y) const = 0;
+
+        //! Return matrix diagonal.
+        virtual void getDiagonal(RRVector &d) const = 0;
+
+        //! Return euclidean norm of matrix row sums (see RSparseMatrix::findNorm).
+        virtual double findNorm(void) const = 0;
+
+        //! Return Frobenius norm of the matrix.
+        virtual double findFrobeniusNorm(void) const = 0;
+
+};
+
+//! Operator of explicitly stored sparse matrix.
+class RSparseMatrixOperator : public RMatrixOperator
+{
+
+    protected:
+
+        //! Pointer to sparse matrix.
+        const RSparseMatrix *pMatrix;
+        //! Number of rows.
+        //! May be greater than number of matrix rows, missing rows are treated as empty.
+        unsigned int nRows;
+        //! Column indexes of each matrix row.
+        std::vector< std::vector<unsigned int> > indexes;
+        //! Frobenius norm.
+        double frobeniusNorm;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSparseMatrixOperator *pSparseMatrixOperator = nullptr);
+
+    public:
+
+        //! Constructor.
+        //! If number of rows is zero number of matrix rows is used.
+        RSparseMatrixOperator(const RSparseMatrix &matrix, unsigned int nRows = 0);
+
+        //! Copy constructor.
+        RSparseMatrixOperator(const RSparseMatrixOperator &sparseMatrixOperator);
+
+        //! Destructor.
+        ~RSparseMatrixOperator();
+
+        //! Assignment operator.
+        RSparseMatrixOperator & operator =(const RSparseMatrixOperator &sparseMatrixOperator);
+
+        //! Return number of rows.
+        unsigned int getNRows(void) const;
+
+        //! Matrix vector multiplication - y=A*x.
+        void multiply(const RRVector &x, RRVector &y) const;
+
+        //! Return matrix diagonal.
+        void getDiagonal(RRVector &d) const;
+
+        //! Return euclidean norm of matrix row sums.
+        double findNorm(void) const;
+
+        //! Return Frobenius norm of the matrix.
+        double findFrobeniusNorm(void) const;
+
+};
+
+#endif // RMATRIXOPERATOR_H
@@ -11,14 +11,19 @@
 #ifndef RMATRIXPRECONDITIONER_H
 #define RMATRIXPRECONDITIONER_H
 
+#include <vector>
+
 #include <rblib.h>
 #include <rmlib.h>
 
+#include "rmatrixoperator.h"
+
 typedef enum _RMatrixPreconditionerType
 {
     R_MATRIX_PRECONDITIONER_NONE = 0,
     R_MATRIX_PRECONDITIONER_JACOBI,
     R_MATRIX_PRECONDITIONER_BLOCK_JACOBI,
+    R_MATRIX_PRECONDITIONER_ADDITIVE_SCHWARZ,
 //    R_MATRIX_PRECONDITIONER_SSOR,
 //    R_MATRIX_PRECONDITIONER_ILU,
 //    R_MATRIX_PRECONDITIONER_DILU,
@@ -34,6 +39,14 @@ class RMatrixPreconditioner
         RMatrixPreconditionerType matrixPreconditionerType;
         //! Preconditioner values.
         RRMatrix data;
+        //! Unknowns belonging to each domain (additive Schwarz).
+        std::vector< std::vector<unsigned int> > domains;
+        //! Row offsets of domain matrix off-diagonal values (additive Schwarz).
+        std::vector<std::size_t> rowOffsets;
+        //! Column indexes of domain matrix off-diagonal values (additive Schwarz).
+        std::vector<unsigned int> columnIndexes;
+        //! Domain matrix off-diagonal values (additive Schwarz).
+        std::vector<double> values;
 
     private:
 
@@ -43,34 +56,61 @@ class RMatrixPreconditioner
     public:
 
         //! Constructor.
-        RMatrixPreconditioner(const RSparseMatrix &matrix, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE, unsigned int blockSize = 1 );
+        RMatrixPreconditioner(const RSparseMatrix &matrix, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE, unsigned int blockSize = 1, unsigned int nDomains = 1);
+
+        //! Constructor for submatrix given by global indexes of its unknowns.
+        //! Local indexes map global unknowns to their position in submatrix.
+        //! Submatrix is read from matrix in place and is not copied.
+        //! Only additive Schwarz preconditioner can be constructed for submatrix.
+        RMatrixPreconditioner(const RSparseMatrix &matrix, const std::vector<unsigned int> &indexes, const std::vector<unsigned int> &localIndexes, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_ADDITIVE_SCHWARZ, unsigned int nDomains = 1);
+
+        //! Constructor.
+        //! Only Jacobi preconditioner can be constructed from matrix operator.
+        RMatrixPreconditioner(const RMatrixOperator &matrixOperator, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_JACOBI);
 
         //! Copy constructor.
         RMatrixPreconditioner(const RMatrixPreconditioner &matrixPreconditioner);
 
         //! Destructor.
-        ~RMatrixPreconditioner();
+        virtual ~RMatrixPreconditioner();
 
         //! Assignment operator.
         RMatrixPreconditioner & operator =(const RMatrixPreconditioner &matrixPreconditioner);
 
         //! Compute preconditioner equation system.
-        void compute(const RRVector &x, RRVector &y) const;
+        //! Vector y has to be already sized.
+        //! If called by all threads of parallel region work is shared among them.
+        virtual void compute(const RRVector &x, RRVector &y) const;
 
     protected:
 
+        //! Constructor for derived preconditioners.
+        RMatrixPreconditioner();
+
         //! Construct Jacobi preconditioner.
         void constructJacobi(const RSparseMatrix &matrix);
 
         //! Construct Block Jacobi preconditioner.
         void constructBlockJacobi(const RSparseMatrix &matrix, unsigned int blockSize);
 
+        //! Construct additive Schwarz preconditioner.
+        //! Unknowns are split into connected domains and each domain is solved with symmetric Gauss-Seidel sweep.
+        //! All domains are held by single process and processed by its threads,
+        //! domains distributed over several processes (MPI) are not supported.
+        void constructAdditiveSchwarz(const RSparseMatrix &matrix, unsigned int nDomains);
+
+        //! Construct additive Schwarz preconditioner for submatrix.
+        void constructAdditiveSchwarz(const RSparseMatrix &matrix, const std::vector<unsigned int> &indexes, const std::vector<unsigned int> &localIndexes, unsigned int nDomains);
+
         //! Compute Jacobi equation system.
         void computeJacobi(const RRVector &x, RRVector &y) const;
 
         //! Construct Block Jacobi equation system.
         void computeBlockJacobi(const RRVector &x, RRVector &y) const;
 
+        //! Compute additive Schwarz equation system.
+        void computeAdditiveSchwarz(const RRVector &x, RRVector &y) const;
+
 };
 
 #endif // RMATRIXPRECONDITIONER_H
@@ -14,6 +14,8 @@
 #include <rmlib.h>
 
 #include "riterationinfo.h"
+#include "rmatrixdeflation.h"
+#include "rmatrixoperator.h"
 #include "rmatrixpreconditioner.h"
 
 class RMatrixSolver
@@ -25,6 +27,8 @@ class RMatrixSolver
         RMatrixSolverConf matrixSolverConf;
         //! Iteration ionformation.
         RIterationInfo iterationInfo;
+        //! Number of iterations performed by last solve.
+        unsigned int nIterations;
 
     private:
 
@@ -46,15 +50,31 @@ class RMatrixSolver
         RMatrixSolver & operator =(const RMatrixSolver &matrixSolver);
 
         //! Solve matrix system.
-        void solve(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE, unsigned int blockSize = 1);
+        //! If deflation is given and enabled in solver configuration it is used (and updated) by conjugate gradient solver.
+        void solve(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_NONE, unsigned int blockSize = 1, RMatrixDeflation *pDeflation = nullptr);
+
+        //! Solve matrix system with given preconditioner.
+        void solve(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+
+        //! Solve matrix system given by matrix operator.
+        //! Only conjugate gradient solver with Jacobi preconditioner is supported.
+        void solve(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType = R_MATRIX_PRECONDITIONER_JACOBI, RMatrixDeflation *pDeflation = nullptr);
+
+        //! Return number of iterations performed by last solve.
+        //! For GMRES number of inner iterations is returned.
+        unsigned int getNIterations(void) const;
 
         //! Disable convergence log file.
         void disableConvergenceLogFile(void);
 
     protected:
 
+        //! Solve matrix system with configured solver.
+        //! Sparse matrix is required by GMRES solver only.
+        void solve(const RMatrixOperator &A, const RSparseMatrix *pMatrix, const RRVector &b, RRVector &x, RMatrixPreconditioner &P, RMatrixDeflation *pDeflation);
+
         //! ConjugateGradient solver.
-        void solveCG(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
+        void solveCG(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P, RMatrixDeflation *pDeflation);
 
         //! Generalize minimal residual solver.
         void solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P);
@@ -0,0 +1,122 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmodelwriter.h                                           *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Background model writer class declaration           *
+ *********************************************************************/
+
+#ifndef RMODELWRITER_H
+#define RMODELWRITER_H
+
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <rmlib.h>
+
+typedef struct _RModelWriterItem
+{
+    //! Model snapshot (owned by writer).
+    RModel *pModel;
+    //! Model file name.
+    QString fileName;
+    //! Base record file name (empty = write full model).
+    QString baseFileName;
+    //! Estimated snapshot size in bytes.
+    qint64 size;
+} RModelWriterItem;
+
+//! Background model writer.
+//! Model snapshots are queued and written to files in a separate thread
+//! in the order in which they were submitted, so that the solver can
+//! continue with the next time step. Total size of queued snapshots is
+//! bounded by the buffer limit; submitting blocks until enough snapshots
+//! were written.
+//! Logging and progress are muted in the writer thread, write reports are
+//! printed by the submitting thread.
+class RModelWriter
+{
+
+    protected:
+
+        //! Writer thread.
+        std::thread thread;
+        //! Queue mutex.
+        std::mutex mutex;
+        //! Queue condition.
+        std::condition_variable condition;
+        //! Queued snapshots (front item is being written).
+        std::deque<RModelWriterItem> queue;
+        //! Size of queued snapshots in bytes.
+        qint64 bufferSize;
+        //! Maximum size of queued snapshots in bytes.
+        qint64 bufferLimit;
+        //! Stop request.
+        bool stopRequested;
+        //! Error message from the last failed write.
+        QString errorMessage;
+        //! Write reports waiting to be printed.
+        QStringList reports;
+        //! Total number of written bytes.
+        qint64 nWrittenBytes;
+        //! Total time spent writing in seconds.
+        double writeTime;
+
+    public:
+
+        //! Default buffer limit (1 GB).
+        static const qint64 defaultBufferLimit;
+
+    private:
+
+        //! Copy constructor (not allowed).
+        RModelWriter(const RModelWriter &modelWriter);
+
+        //! Assignment operator (not allowed).
+        RModelWriter & operator =(const RModelWriter &modelWriter);
+
+    public:
+
+        //! Constructor.
+        RModelWriter(qint64 bufferLimit = RModelWriter::defaultBufferLimit);
+
+        //! Destructor.
+        //! Waits until all queued snapshots are written.
+        ~RModelWriter();
+
+        //! Queue full model.
+        //! Return link filename to which the model will be saved.
+        QString write(const RModel &model, const QString &fileName);
+
+        //! Queue model results referencing base record.
+        //! Return link filename to which the model will be saved.
+        QString writeResults(const RModel &model, const QString &fileName, const QString &baseFileName);
+
+        //! Wait until all queued snapshots are written.
+        //! Throws error if any write has failed.
+        void wait(void);
+
+    protected:
+
+        //! Queue snapshot.
+        void enqueue(const RModelWriterItem &item);
+
+        //! Writer thread loop.
+        void process(void);
+
+        //! Throw pending error.
+        void throwError(void);
+
+        //! Print pending write reports.
+        void printReports(void);
+
+        //! Estimate size of model results in bytes.
+        static qint64 findResultsSize(const RModel &model);
+
+};
+
+#endif // RMODELWRITER_H
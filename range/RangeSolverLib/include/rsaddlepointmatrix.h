@@ -0,0 +1,127 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsaddlepointmatrix.h                                     *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Saddle point matrix class declaration               *
+ *********************************************************************/
+
+#ifndef RSADDLEPOINTMATRIX_H
+#define RSADDLEPOINTMATRIX_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+//! Two by two block split of saddle point matrix system.
+//! Unknowns are split into first (velocity) and second (pressure) set.
+//!   | A11 A12 | | x1 |   | b1 |
+//!   | A21 A22 | | x2 | = | b2 |
+//! Unknowns keep their relative order within each block.
+//! Blocks are not copied, they are applied directly from the global matrix
+//! which has to exist as long as the saddle point matrix is used.
+//! Split depends only on unknowns and can be reused while they do not change.
+class RSaddlePointMatrix
+{
+
+    protected:
+
+        //! Pointer to global matrix.
+        const RSparseMatrix *pMatrix;
+        //! Unknown belongs to second block.
+        std::vector<bool> second;
+        //! Global indexes of first block unknowns.
+        std::vector<unsigned int> indexes1;
+        //! Global indexes of second block unknowns.
+        std::vector<unsigned int> indexes2;
+        //! Position of global unknown within its block.
+        std::vector<unsigned int> localIndexes;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSaddlePointMatrix *pSaddlePointMatrix = nullptr);
+
+    public:
+
+        //! Constructor.
+        RSaddlePointMatrix();
+
+        //! Copy constructor.
+        RSaddlePointMatrix(const RSaddlePointMatrix &saddlePointMatrix);
+
+        //! Destructor.
+        ~RSaddlePointMatrix();
+
+        //! Assignment operator.
+        RSaddlePointMatrix & operator =(const RSaddlePointMatrix &saddlePointMatrix);
+
+        //! Split unknowns into blocks.
+        //! Unknowns for which second is true belong to second block.
+        void build(const std::vector<bool> &second);
+
+        //! Return true if unknowns are already split by given flags.
+        bool isBuilt(const std::vector<bool> &second) const;
+
+        //! Set global matrix.
+        void setMatrix(const RSparseMatrix &A);
+
+        //! Return global matrix.
+        const RSparseMatrix &getMatrix(void) const;
+
+        //! Return number of first block unknowns.
+        unsigned int getN1(void) const;
+
+        //! Return number of second block unknowns.
+        unsigned int getN2(void) const;
+
+        //! Return position of global unknown within its block.
+        unsigned int getLocalIndex(unsigned int globalIndex) const;
+
+        //! Return positions of global unknowns within their blocks.
+        const std::vector<unsigned int> &getLocalIndexes(void) const;
+
+        //! Return global indexes of first block unknowns.
+        const std::vector<unsigned int> &getIndexes1(void) const;
+
+        //! Return global indexes of second block unknowns.
+        const std::vector<unsigned int> &getIndexes2(void) const;
+
+        //! Find diagonal of first block.
+        void findDiagonal1(RRVector &d1) const;
+
+        //! Block matrix vector multiplications - y1=A12*x2, y2=A21*x1, y2=A22*x2.
+        //! Vector y has to be already sized.
+        //! If called by all threads of parallel region work is shared among them.
+        void multiply12(const RRVector &x2, RRVector &y1) const;
+        void multiply21(const RRVector &x1, RRVector &y2) const;
+        void multiply22(const RRVector &x2, RRVector &y2) const;
+
+        //! Split global vector into block vectors.
+        void split(const RRVector &x, RRVector &x1, RRVector &x2) const;
+
+        //! Merge block vectors into global vector.
+        void merge(const RRVector &x1, const RRVector &x2, RRVector &x) const;
+
+        //! Find diagonal of Schur complement approximation A22 - A21*diag(A11)^-1*A12.
+        void findSchurDiagonal(RRVector &d) const;
+
+        //! Find scales w for which sign*W*M*W has the same diagonal as Schur complement approximation.
+        //! Matrix M has to be symmetric positive definite and of second block size.
+        //! Unknowns for which scale cannot be found receive average scale. Sign is returned.
+        double findSchurScales(const RSparseMatrix &M, RRVector &w) const;
+
+        //! Find scales w for given diagonal of Schur complement approximation ds.
+        static double findSchurScales(const RRVector &ds, const RSparseMatrix &M, RRVector &w);
+
+    private:
+
+        //! Multiply rows given by global indexes with columns of first or second block.
+        void multiplyBlock(const std::vector<unsigned int> &rowIndexes, bool secondColumns, const RRVector &x, RRVector &y) const;
+
+};
+
+#endif // RSADDLEPOINTMATRIX_H
@@ -0,0 +1,76 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsaddlepointpreconditioner.h                             *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Saddle point preconditioner class declaration       *
+ *********************************************************************/
+
+#ifndef RSADDLEPOINTPRECONDITIONER_H
+#define RSADDLEPOINTPRECONDITIONER_H
+
+#include <rblib.h>
+#include <rmlib.h>
+
+#include "rmatrixpreconditioner.h"
+#include "rsaddlepointmatrix.h"
+
+//! Block upper triangular preconditioner of saddle point matrix system.
+//!   P = | A11 A12 |
+//!       |  0   S  |
+//! Inverse of A11 is approximated by additive Schwarz sweep and Schur
+//! complement S by matrix M (pressure mass matrix) scaled to diagonal of
+//! A22 - A21*diag(A11)^-1*A12, which is in turn approximated by additive
+//! Schwarz sweep.
+//! Blocks are read from global matrix in place, no block is copied.
+//! Saddle point matrix has to exist as long as the preconditioner is used.
+class RSaddlePointPreconditioner : public RMatrixPreconditioner
+{
+
+    protected:
+
+        //! Pointer to saddle point matrix.
+        const RSaddlePointMatrix *pSaddlePointMatrix;
+        //! First block preconditioner.
+        RMatrixPreconditioner P11;
+        //! Schur complement matrix preconditioner.
+        RMatrixPreconditioner PS;
+        //! Schur complement scales.
+        RRVector w;
+        //! Schur complement sign.
+        double sign;
+        //! Work vectors (shared by threads of parallel region).
+        mutable RRVector x1;
+        mutable RRVector x2;
+        mutable RRVector y1;
+        mutable RRVector y2;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSaddlePointPreconditioner *pSaddlePointPreconditioner = nullptr);
+
+    public:
+
+        //! Constructor.
+        //! Matrix M approximates Schur complement up to diagonal scaling.
+        RSaddlePointPreconditioner(const RSaddlePointMatrix &saddlePointMatrix, const RSparseMatrix &M, unsigned int nDomains);
+
+        //! Copy constructor.
+        RSaddlePointPreconditioner(const RSaddlePointPreconditioner &saddlePointPreconditioner);
+
+        //! Destructor.
+        ~RSaddlePointPreconditioner();
+
+        //! Assignment operator.
+        RSaddlePointPreconditioner & operator =(const RSaddlePointPreconditioner &saddlePointPreconditioner);
+
+        //! Compute preconditioner equation system.
+        //! Vector y has to be already sized.
+        //! If called by all threads of parallel region work is shared among them.
+        void compute(const RRVector &x, RRVector &y) const;
+};
+
+#endif // RSADDLEPOINTPRECONDITIONER_H
@@ -0,0 +1,108 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsegregatedmatrix.h                                      *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   header file (*.h)                                        *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Segregated matrix class declaration                 *
+ *********************************************************************/
+
+#ifndef RSEGREGATEDMATRIX_H
+#define RSEGREGATEDMATRIX_H
+
+#include <vector>
+
+#include <rblib.h>
+#include <rmlib.h>
+
+//! Matrix system assembled directly into blocks of unknowns.
+//! Each unknown belongs to one block and keeps its relative order within it.
+//! Only blocks marked as kept are stored, contributions to other blocks are dropped.
+//! Block layout depends only on unknowns and can be reused while they do not change.
+class RSegregatedMatrix
+{
+
+    protected:
+
+        //! Number of blocks.
+        unsigned int nBlocks;
+        //! Block of each unknown.
+        std::vector<unsigned int> blockIDs;
+        //! Position of unknown within its block.
+        std::vector<unsigned int> localIndexes;
+        //! Global indexes of unknowns of each block.
+        std::vector< std::vector<unsigned int> > indexes;
+        //! Stored blocks (row major, nBlocks x nBlocks).
+        std::vector<bool> keptBlocks;
+        //! Block matrices (row major, nBlocks x nBlocks).
+        std::vector<RSparseMatrix> blocks;
+
+    private:
+
+        //! Internal initialization function.
+        void _init(const RSegregatedMatrix *pSegregatedMatrix = nullptr);
+
+    public:
+
+        //! Constructor.
+        RSegregatedMatrix();
+
+        //! Copy constructor.
+        RSegregatedMatrix(const RSegregatedMatrix &segregatedMatrix);
+
+        //! Destructor.
+        ~RSegregatedMatrix();
+
+        //! Assignment operator.
+        RSegregatedMatrix & operator =(const RSegregatedMatrix &segregatedMatrix);
+
+        //! Split unknowns into blocks.
+        //! Kept blocks are given in row major order (nBlocks x nBlocks).
+        void build(const std::vector<unsigned int> &blockIDs, unsigned int nBlocks, const std::vector<bool> &keptBlocks);
+
+        //! Return true if unknowns are already split into given blocks.
+        bool isBuilt(const std::vector<unsigned int> &blockIDs, unsigned int nBlocks) const;
+
+        //! Remove all values from kept blocks.
+        void clearValues(void);
+
+        //! Return number of blocks.
+        unsigned int getNBlocks(void) const;
+
+        //! Return number of unknowns in given block.
+        unsigned int getN(unsigned int blockID) const;
+
+        //! Return block of given unknown.
+        unsigned int getBlockID(unsigned int globalIndex) const;
+
+        //! Return position of given unknown within its block.
+        unsigned int getLocalIndex(unsigned int globalIndex) const;
+
+        //! Return global indexes of unknowns of given block.
+        const std::vector<unsigned int> &getIndexes(unsigned int blockID) const;
+
+        //! Return true if given block is stored.
+        bool isBlockKept(unsigned int rowBlockID, unsigned int columnBlockID) const;
+
+        //! Return block matrix.
+        const RSparseMatrix &getBlock(unsigned int rowBlockID, unsigned int columnBlockID) const;
+
+        //! Add value at global row and column.
+        //! Value is dropped if it belongs to block which is not kept.
+        void addValue(unsigned int row, unsigned int column, double value);
+
+        //! Block matrix vector multiplication - y=Aij*x.
+        //! Vector y has to be already sized.
+        //! If called by all threads of parallel region work is shared among them.
+        void multiply(unsigned int rowBlockID, unsigned int columnBlockID, const RRVector &x, RRVector &y) const;
+
+        //! Split global vector into block vectors.
+        void split(const RRVector &x, std::vector<RRVector> &xb) const;
+
+        //! Merge block vectors into global vector.
+        void merge(const std::vector<RRVector> &xb, RRVector &x) const;
+
+};
+
+#endif // RSEGREGATEDMATRIX_H
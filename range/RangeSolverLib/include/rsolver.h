@@ -11,8 +11,12 @@
 #ifndef RSOLVER_H
 #define RSOLVER_H
 
+#include <chrono>
+#include <memory>
+
 #include <rmlib.h>
 
+#include "rmodelwriter.h"
 #include "rsolvergeneric.h"
 #include "rsolvershareddata.h"
 
@@ -33,6 +37,12 @@ class RSolver
         QMap<RProblemTypeMask,RSolverGeneric*> solvers;
         //! Map of sover type and execution count.
         QMap<RProblemType,uint> solversExecutionCount;
+        //! Background model writer (shared by copies of the solver).
+        std::shared_ptr<RModelWriter> modelWriter;
+        //! Checkpoint interval in seconds (zero = checkpoints are not written).
+        double checkpointInterval;
+        //! Time when last checkpoint was written.
+        std::chrono::steady_clock::time_point checkpointTime;
 
     private:
 
@@ -56,6 +66,15 @@ class RSolver
         //! Run solver.
         void run(void);
 
+        //! Set checkpoint interval in seconds (zero = checkpoints are not written).
+        void setCheckpointInterval(double checkpointInterval);
+
+        //! Return checkpoint file name for given model file name.
+        static QString getCheckpointFileName(const QString &modelFileName);
+
+        //! Return checkpoint model file name for given model file name.
+        static QString getCheckpointModelFileName(const QString &modelFileName);
+
     protected:
 
         //! Run single solver.
@@ -65,6 +84,16 @@ class RSolver
         //! Return task convergence status (true = converged).
         bool runProblemTask(const RProblemTaskItem &problemTaskItem, uint taskIteration);
 
+        //! Write checkpoint if checkpoint interval has elapsed.
+        void updateCheckpoint(void);
+
+        //! Write checkpoint of model and complete solver state.
+        void writeCheckpoint(void);
+
+        //! Restore model and complete solver state from checkpoint.
+        //! Return false if no usable checkpoint was found.
+        bool readCheckpoint(void);
+
 };
 
 #endif // RSOLVER_H
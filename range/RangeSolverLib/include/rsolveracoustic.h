@@ -60,6 +60,12 @@ class RSolverAcoustic : public RSolverGeneric
         //! Check if solver has converged.
         bool hasConverged(void) const;
 
+        //! Write solver state to checkpoint file.
+        void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read solver state from checkpoint file.
+        void readCheckpoint(RFile &inFile);
+
     protected:
 
         double findSoundSpeedScale(void) const;
@@ -94,8 +100,17 @@ class RSolverAcoustic : public RSolverGeneric
         //! Process statistics.
         void statistics(void);
 
+        //! Compute element matrices of volume element of any type.
+        void computeVolumeElement(unsigned int elementID, RRMatrix &Me, RRMatrix &Ke) const;
+
+        //! Compute element matrices of volume element.
+        //! Specialized for number of nodes and integration points so that no memory is allocated.
+        template <unsigned int nNodes, unsigned int nPoints>
+        void computeVolumeElement(unsigned int elementID, RFixedMatrix<nNodes,nNodes> &Me, RFixedMatrix<nNodes,nNodes> &Ke) const;
+
         //! Assembly matrix
-        void assemblyMatrix(unsigned int elementID, const RRMatrix &Me, const RRMatrix &Ce, const RRMatrix &Ke, const RRVector &fe);
+        template <class TMatrix, class TVector>
+        void assemblyMatrix(unsigned int elementID, const TMatrix &Me, const TMatrix &Ce, const TMatrix &Ke, const TVector &fe);
 
         //! Find absorbing boundary nodes.
         std::vector<bool> findAbsorbingBoundaryNodes(void) const;
@@ -57,6 +57,12 @@ class RSolverElectrostatics : public RSolverGeneric
         //! Check if solver has converged.
         bool hasConverged(void) const;
 
+        //! Write solver state to checkpoint file.
+        void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read solver state from checkpoint file.
+        void readCheckpoint(RFile &inFile);
+
     protected:
 
         //! Update scales.
@@ -80,8 +86,17 @@ class RSolverElectrostatics : public RSolverGeneric
         //! Process statistics.
         void statistics(void);
 
+        //! Compute element matrices of volume element of any type.
+        void computeVolumeElement(unsigned int elementID, double chargeDensity, RRMatrix &Ke, RRVector &fe) const;
+
+        //! Compute element matrices of volume element.
+        //! Specialized for number of nodes and integration points so that no memory is allocated.
+        template <unsigned int nNodes, unsigned int nPoints>
+        void computeVolumeElement(unsigned int elementID, double chargeDensity, RFixedMatrix<nNodes,nNodes> &Ke, RFixedVector<nNodes> &fe) const;
+
         //! Assembly matrix
-        void assemblyMatrix(unsigned int elementID, const RRMatrix &Ke, const RRVector &fe);
+        template <class TMatrix, class TVector>
+        void assemblyMatrix(unsigned int elementID, const TMatrix &Ke, const TVector &fe);
 
 };
 
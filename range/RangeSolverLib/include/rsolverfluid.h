@@ -12,6 +12,9 @@
 #define RSOLVERFLUID_H
 
 #include "rmatrixmanager.h"
+#include "rsaddlepointmatrix.h"
+#include "rsaddlepointpreconditioner.h"
+#include "rsegregatedmatrix.h"
 #include "rsolvergeneric.h"
 
 class FluidMatrixContainer;
@@ -67,6 +70,16 @@ class RSolverFluid : public RSolverGeneric
         RRVector elementGravityMagnitude;
         //! Vector of element level shape function derivatives.
         std::vector<RElementShapeDerivation *> shapeDerivations;
+        //! Pressure Laplacian used by segregated solver (assembled once per mesh).
+        RSparseMatrix pressureLaplacian;
+        //! Pressure mass matrix used by coupled solver preconditioner (assembled once per mesh).
+        RSparseMatrix pressureMass;
+        //! Nodes of pressure unknowns for which pressure matrix was assembled.
+        std::vector<unsigned int> pressureNodeIDs;
+        //! Velocity and pressure split of coupled matrix system (built once per unknowns layout).
+        RSaddlePointMatrix saddlePointMatrix;
+        //! Per component blocks of segregated matrix system (built once per unknowns layout).
+        RSegregatedMatrix segregatedMatrix;
 
         //! Stop-watches
         RStopWatch recoveryStopWatch;
@@ -96,6 +109,12 @@ class RSolverFluid : public RSolverGeneric
         //! Check if solver has converged.
         bool hasConverged(void) const;
 
+        //! Write solver state to checkpoint file.
+        void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read solver state from checkpoint file.
+        void readCheckpoint(RFile &inFile);
+
     protected:
 
         //! Update scales.
@@ -110,6 +129,35 @@ class RSolverFluid : public RSolverGeneric
         //! Run matrix solver.
         void solve(void);
 
+        //! Find block (component) of each unknown and nodes of pressure unknowns.
+        void findUnknownBlocks(std::vector<unsigned int> &blockIDs, std::vector<unsigned int> &pressureNodeIDs) const;
+
+        //! Split coupled matrix system into velocity and pressure blocks.
+        //! Split is rebuilt only if unknowns have changed.
+        void buildSaddlePointMatrix(const std::vector<unsigned int> &blockIDs);
+
+        //! Prepare per component blocks into which segregated matrix system is assembled.
+        //! Block layout is rebuilt only if unknowns have changed.
+        void buildSegregatedMatrix(const std::vector<unsigned int> &blockIDs);
+
+        //! Solve coupled matrix system by GMRES with block triangular preconditioner.
+        //! Schur complement is approximated by pressure mass matrix scaled to Schur complement diagonal.
+        //! Jacobi preconditioner is used instead if saddle point preconditioner is disabled in GMRES configuration.
+        void solveCoupled(void);
+
+        //! Solve matrix system by segregated (SIMPLE type) iterations.
+        //! Each velocity component is solved separately by GMRES and pressure correction by conjugate gradient
+        //! applied to pressure Laplacian scaled to Schur complement diagonal.
+        //! Couplings between velocity components are lagged to next nonlinear iteration.
+        void solveSegregated(void);
+
+        //! Assemble pressure Laplacian (segregated) or pressure mass matrix (coupled) and release the other one.
+        //! Matrix is assembled only if mesh or pressure unknowns have changed.
+        void updatePressureMatrix(const std::vector<unsigned int> &pressureNodeIDs, bool laplacian);
+
+        //! Assemble pressure Laplacian or pressure mass matrix for current pressure unknowns.
+        void assemblePressureMatrix(bool laplacian, RSparseMatrix &matrix) const;
+
         //! Process solver results.
         void process(void);
 
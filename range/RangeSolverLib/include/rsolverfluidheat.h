@@ -83,6 +83,12 @@ class RSolverFluidHeat : public RSolverGeneric
         //! Check if solver has converged.
         bool hasConverged(void) const;
 
+        //! Write solver state to checkpoint file.
+        void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read solver state from checkpoint file.
+        void readCheckpoint(RFile &inFile);
+
     protected:
 
         //! Find temperature scale.
@@ -78,6 +78,12 @@ class RSolverFluidParticle : public RSolverGeneric
         //! Check if solver has converged.
         bool hasConverged(void) const;
 
+        //! Write solver state to checkpoint file.
+        void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read solver state from checkpoint file.
+        void readCheckpoint(RFile &inFile);
+
     protected:
 
         //! Generate node rate input vector.
@@ -18,7 +18,13 @@
 #include <rblib.h>
 #include <rmlib.h>
 
+#include "relementbatch.h"
+#include "relementlist.h"
+#include "rgeometricfactors.h"
 #include "rlocalrotation.h"
+#include "rmaterialpropertycache.h"
+#include "rmatrixdeflation.h"
+#include "rmodelwriter.h"
 #include "rscales.h"
 #include "rsolvershareddata.h"
 
@@ -52,6 +58,10 @@ class RSolverGeneric
         RModel *pModel;
         //! Model file name.
         QString modelFileName;
+        //! Last record file which contains full model (mesh).
+        QString baseRecordFileName;
+        //! Pointer to background model writer (if null model is written synchronously).
+        RModelWriter *pModelWriter;
         //! Convergence file.
         QString convergenceFileName;
         //! Matrix M (modal analysis).
@@ -60,6 +70,10 @@ class RSolverGeneric
         RSparseMatrix A;
         //! Vector x.
         RRVector x;
+        //! Vector x from previous solve (used to extrapolate initial guess).
+        RRVector xOld;
+        //! Deflation vectors retained between matrix solves.
+        RMatrixDeflation matrixDeflation;
         //! Vector b.
         RRVector b;
         //! Node book.
@@ -82,6 +96,26 @@ class RSolverGeneric
         RBVector includableElements;
         //! Surface element inward orientation (if normal is pointing inside computable volume element).
         RBVector inwardElements;
+        //! Computable point elements.
+        RElementList pointElements;
+        //! Computable line elements.
+        RElementList lineElements;
+        //! Computable surface elements.
+        RElementList surfaceElements;
+        //! Computable volume elements.
+        RElementList volumeElements;
+        //! Computable and includable surface elements.
+        RElementList includableSurfaceElements;
+        //! Node-element incidence used to convert values between elements and nodes.
+        RNodeElementIncidence nodeElementIncidence;
+        //! Geometric factors of volume elements.
+        RGeometricFactors geometricFactors;
+        //! Stiffness coefficients of volume elements applied by matrix-free operator.
+        RRVector elementOperatorStiffness;
+        //! Mass coefficients of volume elements applied by matrix-free operator.
+        RRVector elementOperatorMass;
+        //! Material property caches (one for each material property type).
+        mutable std::vector<RMaterialPropertyCache> materialPropertyCaches;
 
     private:
 
@@ -111,9 +145,18 @@ class RSolverGeneric
         //! Set mesh changed.
         void setMeshChanged(bool meshChanged);
 
+        //! Set background model writer.
+        void setModelWriter(RModelWriter *pModelWriter);
+
         //! Check if solver has converged.
         virtual bool hasConverged(void) const = 0;
 
+        //! Write solver state to checkpoint file.
+        virtual void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read solver state from checkpoint file.
+        virtual void readCheckpoint(RFile &inFile);
+
         //! Update old records.
         static void updateOldRecords(const RTimeSolver &rTimeSolver, const QString &modelFileName);
 
@@ -165,14 +208,32 @@ class RSolverGeneric
         void writeResults(void);
 
         //! Apply displacement if possible.
-        void applyDisplacement(void);
+        //! Return true if node positions were changed.
+        bool applyDisplacement(void);
 
         //! Remove displacement if possible.
         void removeDisplacement(void);
 
+        //! Rebuild node-element incidence if mesh or node positions have changed.
+        void updateNodeElementIncidence(bool nodesMoved);
+
+        //! Build geometric factors if they are not valid for current mesh and length scale.
+        //! Has to be called before factors are used in parallel loops.
+        void updateGeometricFactors(void);
+
+        //! Return true if volume elements are applied by matrix-free operator instead of being assembled to matrix A.
+        bool getMatrixFree(void) const;
+
+        //! Reset matrix-free operator coefficients.
+        void initializeMatrixFree(void);
+
         //! Generate node book.
         void generateNodeBook(RProblemType problemType);
 
+        //! Resize vector x and fill it with initial guess for matrix solver.
+        //! Depending on problem setup previous solution is used (or extrapolated) if available.
+        void initializeSolution(uint nUnknowns);
+
         //! Generate material element vector.
         void generateMaterialVecor(RMaterialPropertyType materialPropertyType, RRVector &materialPropertyValues) const;
 
@@ -205,12 +266,22 @@ class RSolverGeneric
         //! Find inward surface elements (normal is pointing inside computable element).
         void findInwardElements();
 
+        //! Build flat lists of computable (and includable) elements.
+        //! Has to be called after computable and includable elements were found.
+        void buildElementLists(void);
+
         //! Process monitoring points.
         void processMonitoringPoints(void) const;
 
         //! Print results statistics.
         void printStats(RVariableType variableType) const;
 
+        //! Write cartesian vector to checkpoint file.
+        static void writeCheckpointVector(RSaveFile &outFile, const RSolverCartesianVector<RRVector> &vector);
+
+        //! Read cartesian vector from checkpoint file.
+        static void readCheckpointVector(RFile &inFile, RSolverCartesianVector<RRVector> &vector);
+
 };
 
 #endif // RSOLVERGENERIC_H
@@ -13,6 +13,7 @@
 
 #include <rblib.h>
 
+#include "rconvection.h"
 #include "rsolvergeneric.h"
 
 class RSolverHeat : public RSolverGeneric
@@ -59,6 +60,12 @@ class RSolverHeat : public RSolverGeneric
         //! Check if solver has converged.
         bool hasConverged(void) const;
 
+        //! Write solver state to checkpoint file.
+        void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read solver state from checkpoint file.
+        void readCheckpoint(RFile &inFile);
+
     protected:
 
         //! Find temperature scale.
@@ -85,8 +92,17 @@ class RSolverHeat : public RSolverGeneric
         //! Process statistics.
         void statistics(void);
 
+        //! Compute element matrices of volume element of any type.
+        void computeVolumeElement(unsigned int elementID, RRMatrix &Me, RRMatrix &Ke, RRVector &fe) const;
+
+        //! Compute element matrices of all volume elements in the batch.
+        //! Specialized for number of nodes and integration points so that no memory is allocated.
+        template <unsigned int nNodes, unsigned int nPoints>
+        void computeVolumeElementBatch(const RElementBatch<nNodes,nPoints> &batch, RElementBatchMatrix<nNodes,nNodes> &Me, RElementBatchMatrix<nNodes,nNodes> &Ke, RElementBatchVector<nNodes> &fe) const;
+
         //! Assembly matrix
-        void assemblyMatrix(unsigned int elementID, const RRMatrix &Me, const RRMatrix &Ke, const RRVector &fe);
+        template <class TMatrix, class TVector>
+        void assemblyMatrix(unsigned int elementID, const TMatrix &Me, const TMatrix &Ke, const TVector &fe);
 
         //! Get simple convection BC values.
         bool getSimpleConvection(const RElementGroup &elementGroup, double &htc, double &htt);
@@ -95,7 +111,11 @@ class RSolverHeat : public RSolverGeneric
         bool getForcedConvection(const RElementGroup &elementGroup, double &htc, double &htt);
 
         //! Get natural convection BC values.
-        bool getNaturalConvection(const RElementGroup &elementGroup, unsigned int elementId, double &htc, double &htt);
+        //! Convection is prepared for given element group, heat transfer coefficient depends on element temperature.
+        bool getNaturalConvection(const RElementGroup &elementGroup, RConvection &convection, double &htt);
+
+        //! Find natural convection heat transfer coefficient for given element.
+        double findNaturalConvectionHtc(const RConvection &convection, unsigned int elementId) const;
 
 };
 
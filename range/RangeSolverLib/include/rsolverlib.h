@@ -13,15 +13,26 @@
 
 #include "rconvection.h"
 #include "reigenvaluesolver.h"
+#include "relementbatch.h"
+#include "relementlist.h"
+#include "relementmatrixoperator.h"
+#include "rgeometricfactors.h"
 #include "rhemicube.h"
 #include "rhemicubepixel.h"
 #include "rhemicubesector.h"
 #include "riterationinfo.h"
 #include "riterationinfovalue.h"
 #include "rlocalrotation.h"
+#include "rmaterialpropertycache.h"
+#include "rmatrixdeflation.h"
+#include "rmatrixoperator.h"
 #include "rmatrixpreconditioner.h"
 #include "rmatrixsolver.h"
+#include "rmodelwriter.h"
+#include "rsaddlepointmatrix.h"
+#include "rsaddlepointpreconditioner.h"
 #include "rscales.h"
+#include "rsegregatedmatrix.h"
 #include "rsolver.h"
 #include "rsolverfluidparticle.h"
 #include "rsolverelectrostatics.h"
@@ -56,6 +56,12 @@ class RSolverSharedData
         //! Clear shared data.
         void clearData(void);
 
+        //! Write shared data to checkpoint file.
+        void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read shared data from checkpoint file.
+        void readCheckpoint(RFile &inFile);
+
 };
 
 #endif // RSOLVERSHAREDDATA_H
@@ -74,6 +74,12 @@ class RSolverStress : public RSolverGeneric
         //! Check if solver has converged.
         bool hasConverged(void) const;
 
+        //! Write solver state to checkpoint file.
+        void writeCheckpoint(RSaveFile &outFile) const;
+
+        //! Read solver state from checkpoint file.
+        void readCheckpoint(RFile &inFile);
+
     protected:
 
         //! Update scales.
@@ -109,14 +115,25 @@ class RSolverStress : public RSolverGeneric
         //! Generate node book.
         void generateNodeBook(void);
 
+        //! Compute element matrices of volume element.
+        void computeVolumeElement(unsigned int elementID, const RSolverCartesianVector<RRVector> &elementGravity, RRMatrix &Me, RRMatrix &Ke, RRVector &fe) const;
+
+        //! Compute element matrices of all volume elements in the batch.
+        //! Specialized for number of nodes and integration points so that no memory is allocated.
+        template <unsigned int nNodes, unsigned int nPoints>
+        void computeVolumeElementBatch(const RElementBatch<nNodes,nPoints> &batch, const RSolverCartesianVector<RRVector> &elementGravity, RElementBatchMatrix<3*nNodes,3*nNodes> &Me, RElementBatchMatrix<3*nNodes,3*nNodes> &Ke, RElementBatchVector<3*nNodes> &fe) const;
+
         //! Assembly matrix
-        void assemblyMatrix(unsigned int elementID, const RRMatrix &Me, const RRMatrix &Ke, const RRVector &fe);
+        template <class TMatrix, class TVector>
+        void assemblyMatrix(unsigned int elementID, const TMatrix &Me, const TMatrix &Ke, const TVector &fe);
 
         //! Apply local rotations to matrix.
-        void applyLocalRotations(unsigned int elementID, RRMatrix &Ae);
+        template <class TMatrix>
+        void applyLocalRotations(unsigned int elementID, TMatrix &Ae);
 
         //! Apply local rotations to vector.
-        void applyLocalRotations(unsigned int elementID, RRVector &fe);
+        template <class TVector>
+        void applyLocalRotationsToVector(unsigned int elementID, TVector &fe);
 
 };
 
@@ -0,0 +1,101 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   relementlist.cpp                                         *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element list class definition                       *
+ *********************************************************************/
+
+#include "relementlist.h"
+
+void RElementList::_init(const RElementList *pElementList)
+{
+    if (pElementList)
+    {
+        this->elementIDs = pElementList->elementIDs;
+        this->entityIDs = pElementList->entityIDs;
+    }
+}
+
+RElementList::RElementList()
+{
+    this->_init();
+}
+
+RElementList::RElementList(const RElementList &elementList)
+{
+    this->_init(&elementList);
+}
+
+RElementList::~RElementList()
+{
+
+}
+
+RElementList &RElementList::operator =(const RElementList &elementList)
+{
+    this->_init(&elementList);
+    return (*this);
+}
+
+void RElementList::build(const RModel &rModel, REntityGroupType entityType, const RBVector &elementMask)
+{
+    std::vector<const RElementGroup *> elementGroups;
+
+    switch (entityType)
+    {
+        case R_ENTITY_GROUP_POINT:
+            for (unsigned int i=0;i<rModel.getNPoints();i++)
+            {
+                elementGroups.push_back(rModel.getPointPtr(i));
+            }
+            break;
+        case R_ENTITY_GROUP_LINE:
+            for (unsigned int i=0;i<rModel.getNLines();i++)
+            {
+                elementGroups.push_back(rModel.getLinePtr(i));
+            }
+            break;
+        case R_ENTITY_GROUP_SURFACE:
+            for (unsigned int i=0;i<rModel.getNSurfaces();i++)
+            {
+                elementGroups.push_back(rModel.getSurfacePtr(i));
+            }
+            break;
+        case R_ENTITY_GROUP_VOLUME:
+            for (unsigned int i=0;i<rModel.getNVolumes();i++)
+            {
+                elementGroups.push_back(rModel.getVolumePtr(i));
+            }
+            break;
+        default:
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Invalid element group entity type \'%d\'.",entityType);
+    }
+
+    this->clear();
+
+    // Elements are sorted by type so that consecutive iterations do the same work.
+    for (unsigned int type=0;type<R_ELEMENT_N_TYPES;type++)
+    {
+        for (unsigned int i=0;i<elementGroups.size();i++)
+        {
+            for (unsigned int j=0;j<elementGroups[i]->size();j++)
+            {
+                unsigned int elementID = elementGroups[i]->get(j);
+                if (elementMask[elementID] && rModel.getElement(elementID).getType() == RElementType(type))
+                {
+                    this->elementIDs.push_back(elementID);
+                    this->entityIDs.push_back(i);
+                }
+            }
+        }
+    }
+}
+
+void RElementList::clear(void)
+{
+    this->elementIDs.clear();
+    this->entityIDs.clear();
+}
@@ -0,0 +1,415 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   relementmatrixoperator.cpp                               *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Element matrix operator class definition            *
+ *********************************************************************/
+
+#include <cmath>
+#include <cstdint>
+
+#include <omp.h>
+
+#include "relementmatrixoperator.h"
+
+void RElementMatrixOperator::_init(const RElementMatrixOperator *pElementMatrixOperator)
+{
+    if (pElementMatrixOperator)
+    {
+        this->pGeometricFactors = pElementMatrixOperator->pGeometricFactors;
+        this->matrixOperator = pElementMatrixOperator->matrixOperator;
+        this->nRows = pElementMatrixOperator->nRows;
+        this->elementIDs = pElementMatrixOperator->elementIDs;
+        this->elementTypes = pElementMatrixOperator->elementTypes;
+        this->colorOffsets = pElementMatrixOperator->colorOffsets;
+        this->positionOffsets = pElementMatrixOperator->positionOffsets;
+        this->positions = pElementMatrixOperator->positions;
+        this->stiffnessCoefficients = pElementMatrixOperator->stiffnessCoefficients;
+        this->massCoefficients = pElementMatrixOperator->massCoefficients;
+        this->diagonal = pElementMatrixOperator->diagonal;
+        this->norm = pElementMatrixOperator->norm;
+        this->frobeniusNorm = pElementMatrixOperator->frobeniusNorm;
+    }
+}
+
+RElementMatrixOperator::RElementMatrixOperator(const RModel &rModel,
+                                               const RBook &nodeBook,
+                                               const RGeometricFactors &geometricFactors,
+                                               const RSparseMatrix &matrix,
+                                               const RRVector &elementStiffnessCoefficients,
+                                               const RRVector &elementMassCoefficients)
+    : pGeometricFactors(&geometricFactors)
+    , matrixOperator(matrix,nodeBook.getNEnabled())
+    , nRows(nodeBook.getNEnabled())
+    , norm(0.0)
+    , frobeniusNorm(0.0)
+{
+    this->_init();
+
+    R_ERROR_ASSERT(elementStiffnessCoefficients.size() == rModel.getNElements());
+    R_ERROR_ASSERT(elementMassCoefficients.size() == rModel.getNElements());
+
+    this->positionOffsets.push_back(0);
+
+    for (unsigned int i=0;i<rModel.getNElements();i++)
+    {
+        const RElement &element = rModel.getElement(i);
+
+        if (!R_ELEMENT_TYPE_IS_VOLUME(element.getType()) || geometricFactors.getNPoints(i) == 0)
+        {
+            continue;
+        }
+        if (elementStiffnessCoefficients[i] == 0.0 && elementMassCoefficients[i] == 0.0)
+        {
+            continue;
+        }
+        if (element.getType() != R_ELEMENT_TETRA1)
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Matrix-free operator does not support element type \'%s\'.",
+                         RElement::getName(element.getType()).toUtf8().constData());
+        }
+
+        this->elementIDs.push_back(i);
+        this->elementTypes.push_back(element.getType());
+        this->stiffnessCoefficients.push_back(elementStiffnessCoefficients[i]);
+        this->massCoefficients.push_back(elementMassCoefficients[i]);
+        for (unsigned int j=0;j<element.size();j++)
+        {
+            unsigned int position = RConstants::eod;
+            if (!nodeBook.getValue(element.getNodeId(j),position))
+            {
+                position = RConstants::eod;
+            }
+            this->positions.push_back(position);
+        }
+        this->positionOffsets.push_back((unsigned int)this->positions.size());
+    }
+
+    this->colorElements();
+
+    // Diagonal and Frobenius norm.
+    this->matrixOperator.getDiagonal(this->diagonal);
+
+    double frobeniusNorm = std::pow(this->matrixOperator.findFrobeniusNorm(),2);
+
+    for (unsigned int c=0;c<this->getNColors();c++)
+    {
+        #pragma omp parallel for default(shared) reduction(+:frobeniusNorm)
+        for (int64_t i=int64_t(this->colorOffsets[c]);i<int64_t(this->colorOffsets[c+1]);i++)
+        {
+            double Ae[4*4];
+            unsigned int nNodes = 0;
+
+            switch (this->elementTypes[i])
+            {
+                case R_ELEMENT_TETRA1:
+                {
+                    nNodes = 4;
+                    this->computeElementMatrix<4,4>(i,Ae);
+                    break;
+                }
+                default:
+                {
+                    // Unsupported element types are rejected above.
+                    break;
+                }
+            }
+
+            const unsigned int *elementPositions = &this->positions[this->positionOffsets[i]];
+            for (unsigned int m=0;m<nNodes;m++)
+            {
+                if (elementPositions[m] == RConstants::eod)
+                {
+                    continue;
+                }
+                this->diagonal[elementPositions[m]] += Ae[m*nNodes+m];
+                for (unsigned int n=0;n<nNodes;n++)
+                {
+                    if (elementPositions[n] != RConstants::eod)
+                    {
+                        frobeniusNorm += Ae[m*nNodes+n] * Ae[m*nNodes+n];
+                    }
+                }
+            }
+        }
+    }
+
+    this->frobeniusNorm = std::sqrt(frobeniusNorm);
+
+    // Row sums norm.
+    RRVector ones(this->nRows,1.0);
+    RRVector rowSums(this->nRows,0.0);
+
+    #pragma omp parallel default(shared)
+    {
+        this->multiply(ones,rowSums);
+    }
+
+    this->norm = RRVector::norm(rowSums);
+}
+
+RElementMatrixOperator::RElementMatrixOperator(const RElementMatrixOperator &elementMatrixOperator)
+    : matrixOperator(elementMatrixOperator.matrixOperator)
+{
+    this->_init(&elementMatrixOperator);
+}
+
+RElementMatrixOperator::~RElementMatrixOperator()
+{
+}
+
+RElementMatrixOperator &RElementMatrixOperator::operator =(const RElementMatrixOperator &elementMatrixOperator)
+{
+    this->_init(&elementMatrixOperator);
+    return (*this);
+}
+
+unsigned int RElementMatrixOperator::getNRows(void) const
+{
+    return this->nRows;
+}
+
+unsigned int RElementMatrixOperator::getNElements(void) const
+{
+    return (unsigned int)this->elementIDs.size();
+}
+
+unsigned int RElementMatrixOperator::getNColors(void) const
+{
+    return (unsigned int)this->colorOffsets.size() - 1;
+}
+
+void RElementMatrixOperator::multiply(const RRVector &x, RRVector &y) const
+{
+    R_ERROR_ASSERT(y.size() == this->nRows);
+
+    // Explicitly assembled part (ends with implicit barrier).
+    this->matrixOperator.multiply(x,y);
+
+    // Elements of the same color do not share any unknown.
+    for (unsigned int c=0;c<this->getNColors();c++)
+    {
+#pragma omp for
+        for (int64_t i=int64_t(this->colorOffsets[c]);i<int64_t(this->colorOffsets[c+1]);i++)
+        {
+            switch (this->elementTypes[i])
+            {
+                case R_ELEMENT_TETRA1:
+                {
+                    this->multiplyElement<4,4>(i,x,y);
+                    break;
+                }
+                default:
+                {
+                    // Unsupported element types are rejected in constructor.
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void RElementMatrixOperator::getDiagonal(RRVector &d) const
+{
+    d = this->diagonal;
+}
+
+double RElementMatrixOperator::findNorm(void) const
+{
+    return this->norm;
+}
+
+double RElementMatrixOperator::findFrobeniusNorm(void) const
+{
+    return this->frobeniusNorm;
+}
+
+void RElementMatrixOperator::colorElements(void)
+{
+    unsigned int nElements = this->getNElements();
+
+    // Greedy coloring, 64 colors are resolved in each pass using bit masks of unknowns.
+    std::vector<unsigned int> elementColors(nElements,0);
+    std::vector<unsigned int> remaining(nElements);
+    for (unsigned int i=0;i<nElements;i++)
+    {
+        remaining[i] = i;
+    }
+
+    unsigned int nColors = 0;
+    unsigned int colorBase = 0;
+    std::vector<uint64_t> masks;
+
+    while (!remaining.empty())
+    {
+        masks.assign(this->nRows,0);
+
+        std::vector<unsigned int> postponed;
+
+        for (unsigned int i=0;i<remaining.size();i++)
+        {
+            unsigned int e = remaining[i];
+
+            uint64_t mask = 0;
+            for (unsigned int j=this->positionOffsets[e];j<this->positionOffsets[e+1];j++)
+            {
+                if (this->positions[j] != RConstants::eod)
+                {
+                    mask |= masks[this->positions[j]];
+                }
+            }
+            if (mask == ~uint64_t(0))
+            {
+                postponed.push_back(e);
+                continue;
+            }
+
+            unsigned int color = 0;
+            while (mask & (uint64_t(1) << color))
+            {
+                color++;
+            }
+            for (unsigned int j=this->positionOffsets[e];j<this->positionOffsets[e+1];j++)
+            {
+                if (this->positions[j] != RConstants::eod)
+                {
+                    masks[this->positions[j]] |= (uint64_t(1) << color);
+                }
+            }
+            elementColors[e] = colorBase + color;
+            nColors = std::max(nColors,colorBase + color + 1);
+        }
+
+        remaining.swap(postponed);
+        colorBase += 64;
+    }
+
+    // Reorder element arrays by color.
+    this->colorOffsets.assign(nColors+1,0);
+    for (unsigned int i=0;i<nElements;i++)
+    {
+        this->colorOffsets[elementColors[i]+1]++;
+    }
+    for (unsigned int c=0;c<nColors;c++)
+    {
+        this->colorOffsets[c+1] += this->colorOffsets[c];
+    }
+
+    std::vector<unsigned int> order(nElements);
+    std::vector<unsigned int> colorPositions(this->colorOffsets.begin(),this->colorOffsets.end()-1);
+    for (unsigned int i=0;i<nElements;i++)
+    {
+        order[colorPositions[elementColors[i]]++] = i;
+    }
+
+    std::vector<unsigned int> elementIDs(nElements);
+    std::vector<RElementType> elementTypes(nElements);
+    std::vector<unsigned int> positionOffsets(nElements+1,0);
+    std::vector<unsigned int> positions;
+    std::vector<double> stiffnessCoefficients(nElements);
+    std::vector<double> massCoefficients(nElements);
+
+    positions.reserve(this->positions.size());
+
+    for (unsigned int i=0;i<nElements;i++)
+    {
+        unsigned int e = order[i];
+        elementIDs[i] = this->elementIDs[e];
+        elementTypes[i] = this->elementTypes[e];
+        stiffnessCoefficients[i] = this->stiffnessCoefficients[e];
+        massCoefficients[i] = this->massCoefficients[e];
+        positions.insert(positions.end(),this->positions.begin()+this->positionOffsets[e],this->positions.begin()+this->positionOffsets[e+1]);
+        positionOffsets[i+1] = (unsigned int)positions.size();
+    }
+
+    this->elementIDs.swap(elementIDs);
+    this->elementTypes.swap(elementTypes);
+    this->positionOffsets.swap(positionOffsets);
+    this->positions.swap(positions);
+    this->stiffnessCoefficients.swap(stiffnessCoefficients);
+    this->massCoefficients.swap(massCoefficients);
+}
+
+template <unsigned int nNodes, unsigned int nPoints>
+void RElementMatrixOperator::computeElementMatrix(unsigned int elementPosition, double *Ae) const
+{
+    unsigned int elementID = this->elementIDs[elementPosition];
+    double s = this->stiffnessCoefficients[elementPosition];
+    double c = this->massCoefficients[elementPosition];
+
+    for (unsigned int i=0;i<nNodes*nNodes;i++)
+    {
+        Ae[i] = 0.0;
+    }
+
+    for (unsigned int k=0;k<nPoints;k++)
+    {
+        const RRVector &N = RElement::getShapeFunction(this->elementTypes[elementPosition],k).getN();
+        const double *B = this->pGeometricFactors->getGradients(elementID,k);
+        double detJW = this->pGeometricFactors->getDetJW(elementID,k);
+
+        for (unsigned int m=0;m<nNodes;m++)
+        {
+            for (unsigned int n=0;n<nNodes;n++)
+            {
+                Ae[m*nNodes+n] += (s * (B[3*m+0]*B[3*n+0] + B[3*m+1]*B[3*n+1] + B[3*m+2]*B[3*n+2])
+                                   + c * N[m] * N[n]) * detJW;
+            }
+        }
+    }
+}
+
+template <unsigned int nNodes, unsigned int nPoints>
+void RElementMatrixOperator::multiplyElement(unsigned int elementPosition, const RRVector &x, RRVector &y) const
+{
+    unsigned int elementID = this->elementIDs[elementPosition];
+    const unsigned int *elementPositions = &this->positions[this->positionOffsets[elementPosition]];
+    double s = this->stiffnessCoefficients[elementPosition];
+    double c = this->massCoefficients[elementPosition];
+
+    double xe[nNodes];
+    double ye[nNodes];
+
+    for (unsigned int m=0;m<nNodes;m++)
+    {
+        xe[m] = (elementPositions[m] == RConstants::eod) ? 0.0 : x[elementPositions[m]];
+        ye[m] = 0.0;
+    }
+
+    for (unsigned int k=0;k<nPoints;k++)
+    {
+        const RRVector &N = RElement::getShapeFunction(this->elementTypes[elementPosition],k).getN();
+        const double *B = this->pGeometricFactors->getGradients(elementID,k);
+        double detJW = this->pGeometricFactors->getDetJW(elementID,k);
+
+        // Gradient and value of x at integration point.
+        double gx = 0.0, gy = 0.0, gz = 0.0, v = 0.0;
+        for (unsigned int n=0;n<nNodes;n++)
+        {
+            gx += B[3*n+0] * xe[n];
+            gy += B[3*n+1] * xe[n];
+            gz += B[3*n+2] * xe[n];
+            v += N[n] * xe[n];
+        }
+        gx *= s * detJW;
+        gy *= s * detJW;
+        gz *= s * detJW;
+        v *= c * detJW;
+
+        for (unsigned int m=0;m<nNodes;m++)
+        {
+            ye[m] += B[3*m+0] * gx + B[3*m+1] * gy + B[3*m+2] * gz + N[m] * v;
+        }
+    }
+
+    for (unsigned int m=0;m<nNodes;m++)
+    {
+        if (elementPositions[m] != RConstants::eod)
+        {
+            y[elementPositions[m]] += ye[m];
+        }
+    }
+}
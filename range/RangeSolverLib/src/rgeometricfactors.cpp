@@ -0,0 +1,167 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rgeometricfactors.cpp                                    *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Geometric factors class definition                  *
+ *********************************************************************/
+
+#include <omp.h>
+
+#include "rgeometricfactors.h"
+
+void RGeometricFactors::_init(const RGeometricFactors *pGeometricFactors)
+{
+    if (pGeometricFactors)
+    {
+        this->nNodes = pGeometricFactors->nNodes;
+        this->nElements = pGeometricFactors->nElements;
+        this->lengthScale = pGeometricFactors->lengthScale;
+        this->pointOffsets = pGeometricFactors->pointOffsets;
+        this->gradientOffsets = pGeometricFactors->gradientOffsets;
+        this->detJW = pGeometricFactors->detJW;
+        this->inverseJacobians = pGeometricFactors->inverseJacobians;
+        this->gradients = pGeometricFactors->gradients;
+    }
+}
+
+RGeometricFactors::RGeometricFactors()
+    : nNodes(0)
+    , nElements(0)
+    , lengthScale(0.0)
+{
+    this->_init();
+}
+
+RGeometricFactors::RGeometricFactors(const RGeometricFactors &geometricFactors)
+{
+    this->_init(&geometricFactors);
+}
+
+RGeometricFactors::~RGeometricFactors()
+{
+
+}
+
+RGeometricFactors &RGeometricFactors::operator =(const RGeometricFactors &geometricFactors)
+{
+    this->_init(&geometricFactors);
+    return (*this);
+}
+
+void RGeometricFactors::build(const RModel &rModel, double lengthScale)
+{
+    this->nNodes = rModel.getNNodes();
+    this->nElements = rModel.getNElements();
+    this->lengthScale = lengthScale;
+
+    this->pointOffsets.assign(this->nElements+1,0);
+    this->gradientOffsets.assign(this->nElements+1,0);
+
+    for (uint i=0;i<this->nElements;i++)
+    {
+        const RElement &element = rModel.getElement(i);
+        uint nPoints = 0;
+        if (R_ELEMENT_TYPE_IS_VOLUME(element.getType()))
+        {
+            nPoints = RElement::getNIntegrationPoints(element.getType());
+        }
+        this->pointOffsets[i+1] = this->pointOffsets[i] + nPoints;
+        this->gradientOffsets[i+1] = this->gradientOffsets[i] + std::size_t(nPoints) * element.size() * 3;
+    }
+
+    this->detJW.resize(this->pointOffsets[this->nElements]);
+    this->inverseJacobians.resize(9*std::size_t(this->pointOffsets[this->nElements]));
+    this->gradients.resize(this->gradientOffsets[this->nElements]);
+
+    bool abort = false;
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(this->nElements);i++)
+    {
+        #pragma omp flush (abort)
+        if (abort)
+        {
+            continue;
+        }
+        try
+        {
+            const RElement &element = rModel.getElement(i);
+            uint nPoints = this->getNPoints(i);
+
+            RFixedMatrix<3,3> J;
+
+            for (uint k=0;k<nPoints;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRMatrix &dN = shapeFunc.getDN();
+
+                std::size_t p = this->pointOffsets[i] + k;
+
+                this->detJW[p] = element.findJacobian(rModel.getNodes(),k,J) * shapeFunc.getW();
+
+                for (uint m=0;m<3;m++)
+                {
+                    for (uint n=0;n<3;n++)
+                    {
+                        this->inverseJacobians[9*p+3*m+n] = J[m][n];
+                    }
+                }
+
+                double *B = &this->gradients[this->gradientOffsets[i] + std::size_t(k) * element.size() * 3];
+                for (uint m=0;m<element.size();m++)
+                {
+                    B[3*m+0] = (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
+                    B[3*m+1] = (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
+                    B[3*m+2] = (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
+                }
+            }
+        }
+        catch (const RError &rError)
+        {
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
+        }
+    }
+    if (abort)
+    {
+        this->clear();
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to compute geometric factors.");
+    }
+}
+
+void RGeometricFactors::clear(void)
+{
+    this->nNodes = 0;
+    this->nElements = 0;
+    this->lengthScale = 0.0;
+    this->pointOffsets.clear();
+    this->gradientOffsets.clear();
+    this->detJW.clear();
+    this->inverseJacobians.clear();
+    this->gradients.clear();
+}
+
+bool RGeometricFactors::isValid(uint nNodes, uint nElements, double lengthScale) const
+{
+    return (this->pointOffsets.size() == std::size_t(nElements) + 1 &&
+            this->nNodes == nNodes &&
+            this->nElements == nElements &&
+            this->lengthScale == lengthScale);
+}
+
+void RGeometricFactors::getGradients(uint elementID, uint point, RRMatrix &B) const
+{
+    const double *values = this->getGradients(elementID,point);
+
+    for (uint m=0;m<B.getNRows();m++)
+    {
+        B[m][0] = values[3*m+0];
+        B[m][1] = values[3*m+1];
+        B[m][2] = values[3*m+2];
+    }
+}
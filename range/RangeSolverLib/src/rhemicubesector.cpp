@@ -79,48 +79,59 @@ void RHemiCubeSector::rayTraceTriangle(const RTriangle &triangle, uint color)
     shortestDistance = std::min(shortestDistance,RSegment::findLength(RNode(this->eyePosition),triangle.getNode2()));
     shortestDistance = std::min(shortestDistance,RSegment::findLength(RNode(this->eyePosition),triangle.getNode3()));
 
-    RR3Vector rayDirection;
-    RR3Vector x;
-    double u;
+    // Rays of one row are traced in packets.
+    double rayDirections[3][R_GEOMETRY_PACKET_SIZE];
+    double u[R_GEOMETRY_PACKET_SIZE];
 
     bool iPrevFound = false;
     for (uint i=0;i<this->resolution;i++)
     {
         bool jPrevFound = false;
         bool iCurrFound = false;
+        bool rowFinished = false;
 
-        for (uint j=0;j<this->resolution;j++)
+        for (uint j0=0;j0<this->resolution && !rowFinished;j0+=R_GEOMETRY_PACKET_SIZE)
         {
-            uint pixelId = i * this->resolution + j;
-            if (this->pixels[pixelId].getColor() != RConstants::eod && this->pixels[i].getDepth() < shortestDistance)
+            uint nRays = std::min(uint(R_GEOMETRY_PACKET_SIZE),this->resolution-j0);
+
+            for (uint l=0;l<R_GEOMETRY_PACKET_SIZE;l++)
             {
-                continue;
+                const RR3Vector &pixelPosition = this->pixels[i * this->resolution + j0 + std::min(l,nRays-1)].getPosition();
+                rayDirections[0][l] = pixelPosition[0] - this->eyePosition[0];
+                rayDirections[1][l] = pixelPosition[1] - this->eyePosition[1];
+                rayDirections[2][l] = pixelPosition[2] - this->eyePosition[2];
             }
-            rayDirection[0] = this->pixels[pixelId].getPosition()[0] - this->eyePosition[0];
-            rayDirection[1] = this->pixels[pixelId].getPosition()[1] - this->eyePosition[1];
-            rayDirection[2] = this->pixels[pixelId].getPosition()[2] - this->eyePosition[2];
 
-            bool jCurrFound = false;
-            if (triangle.findLineIntersection(this->eyePosition,rayDirection,x,u))
+            uint hitMask = RTrianglePacket::findLineIntersections(triangle,this->eyePosition,rayDirections,nRays,u);
+
+            for (uint l=0;l<nRays;l++)
             {
-                if (u > 0.0)
+                uint pixelId = i * this->resolution + j0 + l;
+                if (this->pixels[pixelId].getColor() != RConstants::eod && this->pixels[i].getDepth() < shortestDistance)
+                {
+                    continue;
+                }
+
+                bool jCurrFound = false;
+                if ((hitMask & (1u << l)) && u[l] > 0.0)
                 {
                     iPrevFound = true;
                     iCurrFound = true;
                     jPrevFound = true;
                     jCurrFound = true;
-                    if (u < this->pixels[pixelId].getDepth() || this->pixels[pixelId].getColor() == RConstants::eod)
+                    if (u[l] < this->pixels[pixelId].getDepth() || this->pixels[pixelId].getColor() == RConstants::eod)
                     {
-                        this->pixels[pixelId].setDepth(u);
+                        this->pixels[pixelId].setDepth(u[l]);
                         this->pixels[pixelId].setColor(color);
                     }
                 }
-            }
 
-            if (jPrevFound && !jCurrFound)
-            {
-                // No need to continue with current row. Triangle has already ended.
-                break;
+                if (jPrevFound && !jCurrFound)
+                {
+                    // No need to continue with current row. Triangle has already ended.
+                    rowFinished = true;
+                    break;
+                }
             }
         }
 
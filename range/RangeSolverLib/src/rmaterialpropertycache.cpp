@@ -0,0 +1,172 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmaterialpropertycache.cpp                               *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Material property cache class definition            *
+ *********************************************************************/
+
+#include <cmath>
+#include <limits>
+
+#include <omp.h>
+
+#include "rmaterialpropertycache.h"
+
+void RMaterialPropertyCache::_init(const RMaterialPropertyCache *pMaterialPropertyCache)
+{
+    if (pMaterialPropertyCache)
+    {
+        this->type = pMaterialPropertyCache->type;
+        this->groupProperties = pMaterialPropertyCache->groupProperties;
+        this->groupHasProperty = pMaterialPropertyCache->groupHasProperty;
+        this->groupConstant = pMaterialPropertyCache->groupConstant;
+        this->groupTables = pMaterialPropertyCache->groupTables;
+        this->elementGroups = pMaterialPropertyCache->elementGroups;
+        this->elementTemperature = pMaterialPropertyCache->elementTemperature;
+        this->elementValues = pMaterialPropertyCache->elementValues;
+    }
+}
+
+RMaterialPropertyCache::RMaterialPropertyCache(RMaterialPropertyType type)
+    : type(type)
+{
+    this->_init();
+}
+
+RMaterialPropertyCache::RMaterialPropertyCache(const RMaterialPropertyCache &materialPropertyCache)
+{
+    this->_init(&materialPropertyCache);
+}
+
+RMaterialPropertyCache::~RMaterialPropertyCache()
+{
+
+}
+
+RMaterialPropertyCache &RMaterialPropertyCache::operator =(const RMaterialPropertyCache &materialPropertyCache)
+{
+    this->_init(&materialPropertyCache);
+    return (*this);
+}
+
+RMaterialPropertyType RMaterialPropertyCache::getType(void) const
+{
+    return this->type;
+}
+
+void RMaterialPropertyCache::clear(void)
+{
+    this->groupProperties.clear();
+    this->groupHasProperty.clear();
+    this->groupConstant.clear();
+    this->groupTables.clear();
+    this->elementGroups.clear();
+    this->elementTemperature.clear();
+    this->elementValues.clear();
+}
+
+void RMaterialPropertyCache::evaluate(const RModel &rModel, const RRVector &elementTemperature, double temperatureTolerance, RRVector &materialPropertyValues)
+{
+    unsigned int ne = rModel.getNElements();
+
+    if (this->elementGroups.size() != ne || this->groupProperties.size() != rModel.getNElementGroups())
+    {
+        this->clear();
+    }
+
+    this->update(rModel);
+
+    materialPropertyValues.resize(ne,0.0);
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(ne);i++)
+    {
+        unsigned int groupID = this->elementGroups[i];
+        if (groupID == RConstants::eod)
+        {
+            continue;
+        }
+        double temperature = elementTemperature[i];
+        if (std::isnan(this->elementTemperature[i]) || (!this->groupConstant[groupID] && std::fabs(temperature - this->elementTemperature[i]) > temperatureTolerance))
+        {
+            this->elementValues[i] = this->groupTables[groupID].get(temperature);
+            this->elementTemperature[i] = temperature;
+        }
+        materialPropertyValues[i] = this->elementValues[i];
+    }
+}
+
+void RMaterialPropertyCache::update(const RModel &rModel)
+{
+    unsigned int ne = rModel.getNElements();
+    unsigned int ng = rModel.getNElementGroups();
+
+    bool rebuildElementGroups = (this->elementGroups.size() != ne);
+
+    if (rebuildElementGroups)
+    {
+        this->groupProperties.resize(ng);
+        this->groupHasProperty.resize(ng,false);
+        this->groupConstant.resize(ng,true);
+        this->groupTables.resize(ng);
+        this->elementGroups.assign(ne,RConstants::eod);
+        this->elementTemperature.resize(ne);
+        this->elementValues.resize(ne,0.0);
+    }
+
+    for (unsigned int i=0;i<ng;i++)
+    {
+        const RElementGroup *pElementGroup = rModel.getElementGroupPtr(i);
+        if (!pElementGroup)
+        {
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Element group could not be found (%u of %u).",i,ng);
+        }
+
+        const RMaterial &material = pElementGroup->getMaterial();
+
+        unsigned int materialPropertyPosition = material.findPosition(this->type);
+        bool hasProperty = (materialPropertyPosition != material.size());
+
+        if (hasProperty != this->groupHasProperty[i] || (hasProperty && material.get(materialPropertyPosition) != this->groupProperties[i]))
+        {
+            this->groupHasProperty[i] = hasProperty;
+            if (hasProperty)
+            {
+                this->groupProperties[i] = material.get(materialPropertyPosition);
+                this->groupTables[i].compile(this->groupProperties[i]);
+                this->groupConstant[i] = this->groupTables[i].isConstant();
+            }
+            else
+            {
+                this->groupProperties[i] = RMaterialProperty();
+                this->groupTables[i] = RCompiledValueTable();
+                this->groupConstant[i] = true;
+            }
+            rebuildElementGroups = true;
+        }
+    }
+
+    if (!rebuildElementGroups)
+    {
+        return;
+    }
+
+    // Later element groups take precedence (same as when values are applied group by group).
+    this->elementGroups.assign(ne,RConstants::eod);
+    this->elementTemperature.fill(std::numeric_limits<double>::quiet_NaN());
+    for (unsigned int i=0;i<ng;i++)
+    {
+        if (!this->groupHasProperty[i])
+        {
+            continue;
+        }
+        const RElementGroup *pElementGroup = rModel.getElementGroupPtr(i);
+        for (unsigned int j=0;j<pElementGroup->size();j++)
+        {
+            this->elementGroups[pElementGroup->get(j)] = i;
+        }
+    }
+}
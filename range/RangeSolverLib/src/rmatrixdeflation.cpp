@@ -0,0 +1,372 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmatrixdeflation.cpp                                     *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Matrix deflation class definition                   *
+ *********************************************************************/
+
+#include <cmath>
+#include <algorithm>
+
+#include <omp.h>
+
+#include "rmatrixdeflation.h"
+
+void RMatrixDeflation::_init(const RMatrixDeflation *pMatrixDeflation)
+{
+    if (pMatrixDeflation)
+    {
+        this->nMaxVectors = pMatrixDeflation->nMaxVectors;
+        this->W = pMatrixDeflation->W;
+        this->AW = pMatrixDeflation->AW;
+        this->invE = pMatrixDeflation->invE;
+        this->P = pMatrixDeflation->P;
+        this->AP = pMatrixDeflation->AP;
+    }
+}
+
+RMatrixDeflation::RMatrixDeflation(unsigned int nMaxVectors)
+    : nMaxVectors(nMaxVectors)
+{
+    this->_init();
+}
+
+RMatrixDeflation::RMatrixDeflation(const RMatrixDeflation &matrixDeflation)
+{
+    this->_init(&matrixDeflation);
+}
+
+RMatrixDeflation::~RMatrixDeflation()
+{
+}
+
+RMatrixDeflation &RMatrixDeflation::operator =(const RMatrixDeflation &matrixDeflation)
+{
+    this->_init(&matrixDeflation);
+    return (*this);
+}
+
+void RMatrixDeflation::clear(void)
+{
+    this->W.clear();
+    this->AW.clear();
+    this->invE.clear();
+    this->P.clear();
+    this->AP.clear();
+}
+
+unsigned int RMatrixDeflation::getNVectors(void) const
+{
+    return (unsigned int)this->W.size();
+}
+
+const std::vector<RRVector> &RMatrixDeflation::getVectors(void) const
+{
+    return this->W;
+}
+
+void RMatrixDeflation::setVectors(const std::vector<RRVector> &W)
+{
+    this->clear();
+    this->W = W;
+}
+
+void RMatrixDeflation::prepare(const RMatrixOperator &A)
+{
+    unsigned int m = A.getNRows();
+    unsigned int k = (unsigned int)this->W.size();
+
+    this->AW.clear();
+    this->P.clear();
+    this->AP.clear();
+
+    if (k == 0)
+    {
+        return;
+    }
+    if (this->W[0].size() != m)
+    {
+        this->clear();
+        return;
+    }
+
+    // AW = A*W
+    this->AW.resize(k,RRVector(m,0.0));
+
+    #pragma omp parallel default(shared)
+    {
+        for (unsigned int l=0;l<k;l++)
+        {
+            A.multiply(this->W[l],this->AW[l]);
+        }
+    }
+
+    // E = W'*A*W
+    RRMatrix E(k,k,0.0);
+    for (unsigned int i=0;i<k;i++)
+    {
+        for (unsigned int j=i;j<k;j++)
+        {
+            E[i][j] = E[j][i] = 0.5 * (RRVector::dot(this->W[i],this->AW[j]) + RRVector::dot(this->W[j],this->AW[i]));
+        }
+        if (!(E[i][i] > 0.0))
+        {
+            // Matrix is not positive definite on deflation space.
+            this->clear();
+            return;
+        }
+    }
+
+    try
+    {
+        this->invE = E;
+        this->invE.invert();
+    }
+    catch (const RError &error)
+    {
+        RLogger::warning("Deflation vectors were discarded: %s\n",error.getMessage().toUtf8().constData());
+        this->clear();
+    }
+}
+
+void RMatrixDeflation::correctSolution(RRVector &x, RRVector &r) const
+{
+    unsigned int k = (unsigned int)this->AW.size();
+
+    if (k == 0)
+    {
+        return;
+    }
+
+    RRVector c(k,0.0);
+    for (unsigned int l=0;l<k;l++)
+    {
+        c[l] = RRVector::dot(this->W[l],r);
+    }
+
+    RRVector mu;
+    RRMatrix::mlt(this->invE,c,mu);
+
+    for (unsigned int i=0;i<x.size();i++)
+    {
+        for (unsigned int l=0;l<k;l++)
+        {
+            x[i] += this->W[l][i] * mu[l];
+            r[i] -= this->AW[l][i] * mu[l];
+        }
+    }
+}
+
+void RMatrixDeflation::deflateDirection(const RRVector &z, RRVector &p) const
+{
+    unsigned int k = (unsigned int)this->AW.size();
+
+    if (k == 0)
+    {
+        return;
+    }
+
+    RRVector c(k,0.0);
+    for (unsigned int l=0;l<k;l++)
+    {
+        c[l] = RRVector::dot(this->AW[l],z);
+    }
+
+    RRVector mu;
+    RRMatrix::mlt(this->invE,c,mu);
+
+    for (unsigned int i=0;i<p.size();i++)
+    {
+        for (unsigned int l=0;l<k;l++)
+        {
+            p[i] -= this->W[l][i] * mu[l];
+        }
+    }
+}
+
+bool RMatrixDeflation::collectDirection(void) const
+{
+    return (this->P.size() < 2 * this->nMaxVectors);
+}
+
+void RMatrixDeflation::addDirection(const RRVector &p, const RRVector &q)
+{
+    this->P.push_back(p);
+    this->AP.push_back(q);
+}
+
+void RMatrixDeflation::update(void)
+{
+    // Search space Z = [W,P] together with A*Z.
+    std::vector<RRVector> Z;
+    std::vector<RRVector> AZ;
+
+    if (this->AW.size() == this->W.size())
+    {
+        Z = this->W;
+        AZ = this->AW;
+    }
+    Z.insert(Z.end(),this->P.begin(),this->P.end());
+    AZ.insert(AZ.end(),this->AP.begin(),this->AP.end());
+
+    this->P.clear();
+    this->AP.clear();
+
+    // Orthonormalize search space (modified Gram-Schmidt, applied twice).
+    std::vector<RRVector> Q;
+    std::vector<RRVector> AQ;
+
+    for (unsigned int i=0;i<Z.size();i++)
+    {
+        double zn = RRVector::norm(Z[i]);
+        if (zn < RConstants::eps)
+        {
+            continue;
+        }
+        for (unsigned int pass=0;pass<2;pass++)
+        {
+            for (unsigned int j=0;j<Q.size();j++)
+            {
+                double c = RRVector::dot(Q[j],Z[i]);
+                for (unsigned int l=0;l<Z[i].size();l++)
+                {
+                    Z[i][l] -= c * Q[j][l];
+                    AZ[i][l] -= c * AQ[j][l];
+                }
+            }
+        }
+        double qn = RRVector::norm(Z[i]);
+        if (qn < 1.0e-8 * zn)
+        {
+            // Linearly dependent direction.
+            continue;
+        }
+        Z[i] *= 1.0/qn;
+        AZ[i] *= 1.0/qn;
+        Q.push_back(Z[i]);
+        AQ.push_back(AZ[i]);
+    }
+
+    unsigned int n = (unsigned int)Q.size();
+
+    if (n == 0)
+    {
+        this->clear();
+        return;
+    }
+
+    // Rayleigh-Ritz: H = Q'*A*Q
+    RRMatrix H(n,n,0.0);
+    for (unsigned int i=0;i<n;i++)
+    {
+        for (unsigned int j=i;j<n;j++)
+        {
+            H[i][j] = H[j][i] = 0.5 * (RRVector::dot(Q[i],AQ[j]) + RRVector::dot(Q[j],AQ[i]));
+        }
+    }
+
+    RRVector d;
+    RRMatrix V;
+    RMatrixDeflation::solveSymmetricEigenValues(H,d,V);
+
+    std::vector<unsigned int> order;
+    for (unsigned int i=0;i<n;i++)
+    {
+        if (d[i] > 0.0)
+        {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(),order.end(),[&d](unsigned int a, unsigned int b) { return d[a] < d[b]; });
+
+    unsigned int k = std::min(this->nMaxVectors,(unsigned int)order.size());
+
+    // Ritz vectors belonging to the smallest eigenvalues.
+    this->W.assign(k,RRVector(Q[0].size(),0.0));
+    for (unsigned int l=0;l<k;l++)
+    {
+        for (unsigned int j=0;j<n;j++)
+        {
+            double v = V[j][order[l]];
+            for (unsigned int i=0;i<Q[j].size();i++)
+            {
+                this->W[l][i] += v * Q[j][i];
+            }
+        }
+    }
+
+    this->AW.clear();
+    this->invE.clear();
+}
+
+void RMatrixDeflation::solveSymmetricEigenValues(RRMatrix &S, RRVector &d, RRMatrix &V)
+{
+    unsigned int n = S.getNRows();
+
+    V.setIdentity(n);
+    d.resize(n);
+
+    for (unsigned int sweep=0;sweep<50;sweep++)
+    {
+        double offNorm = 0.0;
+        double diagNorm = 0.0;
+        for (unsigned int i=0;i<n;i++)
+        {
+            diagNorm += S[i][i] * S[i][i];
+            for (unsigned int j=i+1;j<n;j++)
+            {
+                offNorm += S[i][j] * S[i][j];
+            }
+        }
+        if (offNorm <= RConstants::eps * RConstants::eps * diagNorm)
+        {
+            break;
+        }
+
+        for (unsigned int p=0;p<n;p++)
+        {
+            for (unsigned int q=p+1;q<n;q++)
+            {
+                if (S[p][q] == 0.0)
+                {
+                    continue;
+                }
+
+                double theta = (S[q][q] - S[p][p]) / (2.0 * S[p][q]);
+                double t = (theta >= 0.0 ? 1.0 : -1.0) / (std::fabs(theta) + std::sqrt(theta * theta + 1.0));
+                double c = 1.0 / std::sqrt(t * t + 1.0);
+                double s = t * c;
+
+                for (unsigned int k=0;k<n;k++)
+                {
+                    double skp = S[k][p];
+                    double skq = S[k][q];
+                    S[k][p] = c * skp - s * skq;
+                    S[k][q] = s * skp + c * skq;
+                }
+                for (unsigned int k=0;k<n;k++)
+                {
+                    double spk = S[p][k];
+                    double sqk = S[q][k];
+                    S[p][k] = c * spk - s * sqk;
+                    S[q][k] = s * spk + c * sqk;
+                }
+                for (unsigned int k=0;k<n;k++)
+                {
+                    double vkp = V[k][p];
+                    double vkq = V[k][q];
+                    V[k][p] = c * vkp - s * vkq;
+                    V[k][q] = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    for (unsigned int i=0;i<n;i++)
+    {
+        d[i] = S[i][i];
+    }
+}
@@ -0,0 +1,123 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmatrixoperator.cpp                                      *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Matrix operator class definition                    *
+ *********************************************************************/
+
+#include <cmath>
+#include <algorithm>
+
+#include <omp.h>
+
+#include "rmatrixoperator.h"
+
+RMatrixOperator::~RMatrixOperator()
+{
+}
+
+void RSparseMatrixOperator::_init(const RSparseMatrixOperator *pSparseMatrixOperator)
+{
+    if (pSparseMatrixOperator)
+    {
+        this->pMatrix = pSparseMatrixOperator->pMatrix;
+        this->nRows = pSparseMatrixOperator->nRows;
+        this->indexes = pSparseMatrixOperator->indexes;
+        this->frobeniusNorm = pSparseMatrixOperator->frobeniusNorm;
+    }
+}
+
+RSparseMatrixOperator::RSparseMatrixOperator(const RSparseMatrix &matrix, unsigned int nRows)
+    : pMatrix(&matrix)
+    , nRows(std::max(nRows,matrix.getNRows()))
+    , frobeniusNorm(0.0)
+{
+    this->_init();
+
+    unsigned int nMatrixRows = this->pMatrix->getNRows();
+
+    this->indexes.resize(nMatrixRows);
+
+    double frobeniusNorm = 0.0;
+
+    #pragma omp parallel for default(shared) reduction(+:frobeniusNorm)
+    for (int64_t i=0;i<int64_t(nMatrixRows);i++)
+    {
+        this->indexes[i] = this->pMatrix->getRowIndexes(i);
+        for (unsigned int j=0;j<this->indexes[i].size();j++)
+        {
+            frobeniusNorm += std::pow(this->pMatrix->getValue(i,j),2);
+        }
+    }
+
+    this->frobeniusNorm = std::sqrt(frobeniusNorm);
+}
+
+RSparseMatrixOperator::RSparseMatrixOperator(const RSparseMatrixOperator &sparseMatrixOperator)
+{
+    this->_init(&sparseMatrixOperator);
+}
+
+RSparseMatrixOperator::~RSparseMatrixOperator()
+{
+}
+
+RSparseMatrixOperator &RSparseMatrixOperator::operator =(const RSparseMatrixOperator &sparseMatrixOperator)
+{
+    this->_init(&sparseMatrixOperator);
+    return (*this);
+}
+
+unsigned int RSparseMatrixOperator::getNRows(void) const
+{
+    return this->nRows;
+}
+
+void RSparseMatrixOperator::multiply(const RRVector &x, RRVector &y) const
+{
+    R_ERROR_ASSERT(y.size() == this->nRows);
+
+    unsigned int nMatrixRows = (unsigned int)this->indexes.size();
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(this->nRows);i++)
+    {
+        double value = 0.0;
+        if (i < int64_t(nMatrixRows))
+        {
+            for (unsigned int j=0;j<this->indexes[i].size();j++)
+            {
+                value += this->pMatrix->getValue(i,j) * x[this->indexes[i][j]];
+            }
+        }
+        y[i] = value;
+    }
+}
+
+void RSparseMatrixOperator::getDiagonal(RRVector &d) const
+{
+    d.resize(this->nRows);
+    d.fill(0.0);
+
+    for (unsigned int i=0;i<this->pMatrix->getNRows();i++)
+    {
+        unsigned int columnPosition = 0;
+        if (this->pMatrix->findColumnPosition(i,i,columnPosition))
+        {
+            d[i] = this->pMatrix->getValue(i,columnPosition);
+        }
+    }
+}
+
+double RSparseMatrixOperator::findNorm(void) const
+{
+    return this->pMatrix->findNorm();
+}
+
+double RSparseMatrixOperator::findFrobeniusNorm(void) const
+{
+    return this->frobeniusNorm;
+}
@@ -9,6 +9,7 @@
  *********************************************************************/
 
 #include <cmath>
+#include <algorithm>
 
 #include <omp.h>
 
@@ -20,10 +21,14 @@ void RMatrixPreconditioner::_init(const RMatrixPreconditioner *pMatrixPreconditi
     {
         this->matrixPreconditionerType = pMatrixPreconditioner->matrixPreconditionerType;
         this->data = pMatrixPreconditioner->data;
+        this->domains = pMatrixPreconditioner->domains;
+        this->rowOffsets = pMatrixPreconditioner->rowOffsets;
+        this->columnIndexes = pMatrixPreconditioner->columnIndexes;
+        this->values = pMatrixPreconditioner->values;
     }
 }
 
-RMatrixPreconditioner::RMatrixPreconditioner(const RSparseMatrix &matrix, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize)
+RMatrixPreconditioner::RMatrixPreconditioner(const RSparseMatrix &matrix, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize, unsigned int nDomains)
     : matrixPreconditionerType(matrixPreconditionerType)
 {
     this->_init();
@@ -36,11 +41,58 @@ RMatrixPreconditioner::RMatrixPreconditioner(const RSparseMatrix &matrix, RMatri
         case R_MATRIX_PRECONDITIONER_BLOCK_JACOBI:
             this->constructBlockJacobi(matrix,blockSize);
             break;
+        case R_MATRIX_PRECONDITIONER_ADDITIVE_SCHWARZ:
+            this->constructAdditiveSchwarz(matrix,nDomains);
+            break;
         default:
             throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Invalid matrix preconditioner type \'%d\'",matrixPreconditionerType);
     }
 }
 
+RMatrixPreconditioner::RMatrixPreconditioner(const RSparseMatrix &matrix, const std::vector<unsigned int> &indexes, const std::vector<unsigned int> &localIndexes, RMatrixPreconditionerType matrixPreconditionerType, unsigned int nDomains)
+    : matrixPreconditionerType(matrixPreconditionerType)
+{
+    this->_init();
+
+    switch (matrixPreconditionerType)
+    {
+        case R_MATRIX_PRECONDITIONER_ADDITIVE_SCHWARZ:
+            this->constructAdditiveSchwarz(matrix,indexes,localIndexes,nDomains);
+            break;
+        default:
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Invalid submatrix preconditioner type \'%d\'",matrixPreconditionerType);
+    }
+}
+
+RMatrixPreconditioner::RMatrixPreconditioner(const RMatrixOperator &matrixOperator, RMatrixPreconditionerType matrixPreconditionerType)
+    : matrixPreconditionerType(matrixPreconditionerType)
+{
+    this->_init();
+
+    switch (matrixPreconditionerType)
+    {
+        case R_MATRIX_PRECONDITIONER_JACOBI:
+        {
+            RRVector diagonal;
+            matrixOperator.getDiagonal(diagonal);
+            this->data.resize(diagonal.size(),1);
+            for (unsigned int i=0;i<diagonal.size();i++)
+            {
+                this->data[i][0] = diagonal[i];
+            }
+            break;
+        }
+        default:
+            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Invalid matrix operator preconditioner type \'%d\'",matrixPreconditionerType);
+    }
+}
+
+RMatrixPreconditioner::RMatrixPreconditioner()
+    : matrixPreconditionerType(R_MATRIX_PRECONDITIONER_NONE)
+{
+    this->_init();
+}
+
 RMatrixPreconditioner::RMatrixPreconditioner(const RMatrixPreconditioner &matrixPreconditioner)
 {
     this->_init(&matrixPreconditioner);
@@ -66,6 +118,9 @@ void RMatrixPreconditioner::compute(const RRVector &x, RRVector &y) const
         case R_MATRIX_PRECONDITIONER_BLOCK_JACOBI:
             this->computeBlockJacobi(x,y);
             break;
+        case R_MATRIX_PRECONDITIONER_ADDITIVE_SCHWARZ:
+            this->computeAdditiveSchwarz(x,y);
+            break;
         default:
             throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Invalid matrix preconditioner type \'%d\'",matrixPreconditionerType);
     }
@@ -121,13 +176,119 @@ void RMatrixPreconditioner::constructBlockJacobi(const RSparseMatrix &matrix, un
     }
 }
 
+void RMatrixPreconditioner::constructAdditiveSchwarz(const RSparseMatrix &matrix, unsigned int nDomains)
+{
+    unsigned int nRows = matrix.getNRows();
+
+    std::vector<unsigned int> indexes(nRows);
+    for (unsigned int i=0;i<nRows;i++)
+    {
+        indexes[i] = i;
+    }
+
+    this->constructAdditiveSchwarz(matrix,indexes,indexes,nDomains);
+}
+
+void RMatrixPreconditioner::constructAdditiveSchwarz(const RSparseMatrix &matrix, const std::vector<unsigned int> &indexes, const std::vector<unsigned int> &localIndexes, unsigned int nDomains)
+{
+    unsigned int nRows = (unsigned int)indexes.size();
+
+    // Return local index of global column or nRows if column is not part of submatrix.
+    auto findLocalIndex = [&](unsigned int column) -> unsigned int
+    {
+        if (column < localIndexes.size() && localIndexes[column] < nRows && indexes[localIndexes[column]] == column)
+        {
+            return localIndexes[column];
+        }
+        return nRows;
+    };
+
+    nDomains = std::max(1U,std::min(nDomains,nRows));
+
+    // Order unknowns by breadth-first search so that consecutive unknowns form connected domains.
+    std::vector<unsigned int> order;
+    std::vector<bool> visited(nRows,false);
+    order.reserve(nRows);
+
+    for (unsigned int seed=0;seed<nRows;seed++)
+    {
+        if (visited[seed])
+        {
+            continue;
+        }
+        visited[seed] = true;
+        order.push_back(seed);
+        for (std::size_t k=order.size()-1;k<order.size();k++)
+        {
+            unsigned int row = indexes[order[k]];
+            if (row >= matrix.getNRows())
+            {
+                continue;
+            }
+            for (unsigned int j=0;j<matrix.getNColumns(row);j++)
+            {
+                unsigned int l = findLocalIndex(matrix.getColumnIndex(row,j));
+                if (l < nRows && !visited[l])
+                {
+                    visited[l] = true;
+                    order.push_back(l);
+                }
+            }
+        }
+    }
+
+    std::vector<unsigned int> domainIDs(nRows,0);
+
+    this->domains.resize(nDomains);
+    for (unsigned int i=0;i<nDomains;i++)
+    {
+        std::size_t begin = std::size_t(i) * nRows / nDomains;
+        std::size_t end = std::size_t(i+1) * nRows / nDomains;
+        this->domains[i].assign(order.begin()+begin,order.begin()+end);
+        for (std::size_t k=begin;k<end;k++)
+        {
+            domainIDs[order[k]] = i;
+        }
+    }
+
+    // Keep only couplings inside domains.
+    this->data.resize(nRows,1);
+    this->data.fill(0.0);
+    this->rowOffsets.assign(nRows+1,0);
+    this->columnIndexes.clear();
+    this->values.clear();
+
+    for (unsigned int i=0;i<nRows;i++)
+    {
+        unsigned int row = indexes[i];
+        for (unsigned int j=0;row<matrix.getNRows() && j<matrix.getNColumns(row);j++)
+        {
+            unsigned int l = findLocalIndex(matrix.getColumnIndex(row,j));
+            double value = matrix.getValue(row,j);
+            if (l == i)
+            {
+                this->data[i][0] += value;
+            }
+            else if (value != 0.0 && l < nRows && domainIDs[l] == domainIDs[i])
+            {
+                this->columnIndexes.push_back(l);
+                this->values.push_back(value);
+            }
+        }
+        this->rowOffsets[i+1] = this->values.size();
+    }
+
+    RLogger::info("Additive Schwarz preconditioner: %u domains, %u unknowns\n",nDomains,nRows);
+}
+
 void RMatrixPreconditioner::computeJacobi(const RRVector &x, RRVector &y) const
 {
     unsigned int nRows = this->data.getNRows();
 
-    y.resize(nRows);
+    R_ERROR_ASSERT(y.size() == nRows);
 
-    for (unsigned int i=0;i<nRows;i++)
+#pragma omp for
+    for (int64_t i=0;i<int64_t(nRows);i++)
     {
         y[i] = (this->data[i][0] == 0.0) ? 0.0 : x[i] / this->data[i][0];
     }
@@ -138,7 +299,7 @@ void RMatrixPreconditioner::computeBlockJacobi(const RRVector &x, RRVector &y) c
     unsigned int nRows = this->data.getNRows();
     unsigned int width = this->data.getNColumns();
 
-    y.resize(nRows);
+    R_ERROR_ASSERT(y.size() == nRows);
 
     RRMatrix As(width,width);
     RRVector xs(width);
@@ -146,7 +307,8 @@ void RMatrixPreconditioner::computeBlockJacobi(const RRVector &x, RRVector &y) c
 
     unsigned int nBlocks = nRows/width;
 
-    for (unsigned int i=0;i<nBlocks;i++)
+#pragma omp for
+    for (int64_t i=0;i<int64_t(nBlocks);i++)
     {
         for (unsigned int k=0;k<width;k++)
         {
@@ -167,3 +329,43 @@ void RMatrixPreconditioner::computeBlockJacobi(const RRVector &x, RRVector &y) c
         }
     }
 }
+
+void RMatrixPreconditioner::computeAdditiveSchwarz(const RRVector &x, RRVector &y) const
+{
+    R_ERROR_ASSERT(y.size() == this->data.getNRows());
+
+#pragma omp for
+    for (int64_t d=0;d<int64_t(this->domains.size());d++)
+    {
+        const std::vector<unsigned int> &domain = this->domains[d];
+
+        for (unsigned int k=0;k<domain.size();k++)
+        {
+            y[domain[k]] = 0.0;
+        }
+
+        // Forward sweep
+        for (unsigned int k=0;k<domain.size();k++)
+        {
+            unsigned int i = domain[k];
+            double sum = x[i];
+            for (std::size_t j=this->rowOffsets[i];j<this->rowOffsets[i+1];j++)
+            {
+                sum -= this->values[j] * y[this->columnIndexes[j]];
+            }
+            y[i] = (this->data[i][0] == 0.0) ? 0.0 : sum / this->data[i][0];
+        }
+
+        // Backward sweep
+        for (unsigned int k=domain.size();k>0;k--)
+        {
+            unsigned int i = domain[k-1];
+            double sum = x[i];
+            for (std::size_t j=this->rowOffsets[i];j<this->rowOffsets[i+1];j++)
+            {
+                sum -= this->values[j] * y[this->columnIndexes[j]];
+            }
+            y[i] = (this->data[i][0] == 0.0) ? 0.0 : sum / this->data[i][0];
+        }
+    }
+}
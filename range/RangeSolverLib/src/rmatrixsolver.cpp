@@ -26,11 +26,13 @@ void RMatrixSolver::_init(const RMatrixSolver *pMatrixSolver)
     {
         this->matrixSolverConf = pMatrixSolver->matrixSolverConf;
         this->iterationInfo = pMatrixSolver->iterationInfo;
+        this->nIterations = pMatrixSolver->nIterations;
     }
 }
 
 RMatrixSolver::RMatrixSolver(const RMatrixSolverConf &matrixSolverConf)
     : matrixSolverConf(matrixSolverConf)
+    , nIterations(0)
 {
     this->_init();
 }
@@ -50,9 +52,37 @@ RMatrixSolver & RMatrixSolver::operator =(const RMatrixSolver &matrixSolver)
     return (*this);
 }
 
-void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize)
+void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType, unsigned int blockSize, RMatrixDeflation *pDeflation)
+{
+    if (this->matrixSolverConf.getNDomains() > 1 && (matrixPreconditionerType == R_MATRIX_PRECONDITIONER_NONE ||
+                                                     matrixPreconditionerType == R_MATRIX_PRECONDITIONER_JACOBI))
+    {
+        // Only point-wise preconditioners are replaced, block preconditioners requested by caller are kept.
+        matrixPreconditionerType = R_MATRIX_PRECONDITIONER_ADDITIVE_SCHWARZ;
+    }
+
+    RMatrixPreconditioner P(A,matrixPreconditionerType,blockSize,this->matrixSolverConf.getNDomains());
+    RSparseMatrixOperator matrixOperator(A);
+
+    this->solve(matrixOperator,&A,b,x,P,pDeflation);
+}
+
+void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
+{
+    RSparseMatrixOperator matrixOperator(A);
+
+    this->solve(matrixOperator,&A,b,x,P,nullptr);
+}
+
+void RMatrixSolver::solve(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditionerType matrixPreconditionerType, RMatrixDeflation *pDeflation)
+{
+    RMatrixPreconditioner P(A,matrixPreconditionerType);
+
+    this->solve(A,nullptr,b,x,P,pDeflation);
+}
+
+void RMatrixSolver::solve(const RMatrixOperator &A, const RSparseMatrix *pMatrix, const RRVector &b, RRVector &x, RMatrixPreconditioner &P, RMatrixDeflation *pDeflation)
 {
-    RMatrixPreconditioner P(A,matrixPreconditionerType,blockSize);
     RRVector y(b);
 
     double An = A.findNorm();
@@ -68,6 +98,16 @@ void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x
     RLogger::info("||A|| = %13e\n",An);
     RLogger::info("||b|| = %13e\n",bn);
 
+    if (pDeflation && this->matrixSolverConf.getType() == RMatrixSolverConf::CG && this->matrixSolverConf.getDeflation())
+    {
+        pDeflation->prepare(A);
+        RLogger::info("Deflation vectors = %u\n",pDeflation->getNVectors());
+    }
+    else
+    {
+        pDeflation = nullptr;
+    }
+
     this->iterationInfo.printHeader(RMatrixSolverConf::getName(this->matrixSolverConf.getType()));
 
     this->iterationInfo.setEquationScale(equationScale);
@@ -77,13 +117,20 @@ void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x
     y *= equationScale;
     x *= equationScale;
 
+    this->nIterations = 0;
+
     switch (this->matrixSolverConf.getType())
     {
         case RMatrixSolverConf::CG:
-            this->solveCG(A,y,x,P);
+            this->solveCG(A,y,x,P,pDeflation);
             break;
         case RMatrixSolverConf::GMRES:
-            this->solveGMRES(A,y,x,P);
+            if (!pMatrix)
+            {
+                throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Matrix solver \'%s\' requires explicitly assembled matrix.",
+                             RMatrixSolverConf::getName(this->matrixSolverConf.getType()).toUtf8().constData());
+            }
+            this->solveGMRES(*pMatrix,y,x,P);
             break;
         default:
             throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Unknown matrix solver type \'%d\'",this->matrixSolverConf.getType());
@@ -92,6 +139,13 @@ void RMatrixSolver::solve(const RSparseMatrix &A, const RRVector &b, RRVector &x
     x *= 1.0/equationScale;
 
     this->iterationInfo.printFooter();
+
+    RLogger::info("Iterations = %u\n",this->nIterations);
+}
+
+unsigned int RMatrixSolver::getNIterations(void) const
+{
+    return this->nIterations;
 }
 
 void RMatrixSolver::disableConvergenceLogFile(void)
@@ -99,7 +153,7 @@ void RMatrixSolver::disableConvergenceLogFile(void)
     this->iterationInfo.setOutputFileName(QString());
 }
 
-void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
+void RMatrixSolver::solveCG(const RMatrixOperator &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P, RMatrixDeflation *pDeflation)
 {
     unsigned int m = A.getNRows();
 
@@ -113,40 +167,31 @@ void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector
     p.fill(0.0);
     q.fill(0.0);
 
-    double An = 0.0;
+    double An = A.findFrobeniusNorm();
     double bn = 0.0;
     double ro[] = {0.0,0.0};
     double beta = 0.0;
     double dot = 0.0;
-    std::vector< std::vector<unsigned int> > index(m);
 
 #pragma omp parallel default(shared)
     {
         // Compute initial residual.
-#pragma omp for reduction(+:An,bn)
+        A.multiply(x,q);
+#pragma omp for reduction(+:bn)
         for (int64_t i=0;i<int64_t(m);i++)
         {
-            r[i] = b[i];
+            r[i] = b[i] - q[i];
             bn = bn + (b[i]*b[i]);
-            index[i] = A.getRowIndexes(i);
-            for (unsigned int j=0;j<index[i].size();j++)
-            {
-                double value = A.getValue(i,j);
-                An = An + std::pow(value,2);
-                if (value != 0.0)
-                {
-                    if (x[index[i][j]] != 0.0)
-                    {
-                        r[i] -= value * x[index[i][j]];
-                    }
-                }
-            }
         }
-#pragma omp barrier
 #pragma omp master
         {
-            An = std::sqrt(An);
             bn = std::sqrt(bn);
+
+            if (pDeflation)
+            {
+                // Remove deflation space component from initial residual.
+                pDeflation->correctSolution(x,r);
+            }
         }
 
         // Iterate and look for the solution
@@ -156,9 +201,14 @@ void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector
 #pragma omp master
             {
                 this->iterationInfo.setIteration(it);
+                this->nIterations = it + 1;
+            }
 
-                P.compute(r,z);
+            // Preconditioning is shared among all threads.
+            P.compute(r,z);
 
+#pragma omp master
+            {
                 ro[0] = RRVector::dot(r,z);
 
                 if (it > 0)
@@ -184,20 +234,19 @@ void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector
 
             // q = A*p
 #pragma omp master
-            dot = 0.0;
+            {
+                if (pDeflation)
+                {
+                    // Keep search direction A-orthogonal to deflation space.
+                    pDeflation->deflateDirection(z,p);
+                }
+                dot = 0.0;
+            }
 #pragma omp barrier
+            A.multiply(p,q);
 #pragma omp for reduction(+:dot)
             for (int64_t i=0;i<int64_t(m);i++)
             {
-                q[i] = 0.0;
-                for (unsigned int j=0;j<index[i].size();j++)
-                {
-                    double value = A.getValue(i,j);
-                    if (value != 0.0)
-                    {
-                        q[i] += value * p[index[i][j]];
-                    }
-                }
                 dot = dot + p[i]*q[i];
             }
 
@@ -219,6 +268,11 @@ void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector
                 double alpha = ro[0] / dot;
                 ro[1] = ro[0];
 
+                if (pDeflation && pDeflation->collectDirection())
+                {
+                    pDeflation->addDirection(p,q);
+                }
+
                 // x += alpha*p
                 // r -= alpha*q
                 for (unsigned int i=0;i<m;i++)
@@ -247,6 +301,11 @@ void RMatrixSolver::solveCG(const RSparseMatrix &A, const RRVector &b, RRVector
             }
         }
     }
+
+    if (pDeflation)
+    {
+        pDeflation->update();
+    }
 }
 
 void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVector &x, RMatrixPreconditioner &P)
@@ -345,13 +404,10 @@ void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVect
             for (iti=0;iti<ninner;iti++)
             {
 #pragma omp barrier
-#pragma omp master
-                {
-                    // Preconditioning
-                    P.compute(v[iti],z[iti]);
-//                    RLogger::warning("%u v %13g\n",iti,RRVector::norm(v[iti])-1.0);
-//                    RLogger::warning("%u z %13g\n",iti,RRVector::norm(z[iti]));
-                }
+                // Preconditioning
+                P.compute(v[iti],z[iti]);
+//                RLogger::warning("%u v %13g\n",iti,RRVector::norm(v[iti])-1.0);
+//                RLogger::warning("%u z %13g\n",iti,RRVector::norm(z[iti]));
 #pragma omp barrier
                 // A multiplied by the last krylov vector at present
 #pragma omp for
@@ -428,6 +484,7 @@ void RMatrixSolver::solveGMRES(const RSparseMatrix &A, const RRVector &b, RRVect
             // Backward substitution
 #pragma omp master
             {
+                this->nIterations += iti;
                 y[iti-1] = (h[iti-1][iti-1] == 0.0) ? 0.0 : p[iti-1] / h[iti-1][iti-1];
                 for (int i=iti-2;i>=0;i--)
                 {
@@ -0,0 +1,211 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rmodelwriter.cpp                                         *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Background model writer class definition            *
+ *********************************************************************/
+
+#include <chrono>
+
+#include <QFileInfo>
+
+#include "rmodelwriter.h"
+
+const qint64 RModelWriter::defaultBufferLimit = qint64(1024)*1024*1024;
+
+RModelWriter::RModelWriter(qint64 bufferLimit)
+    : bufferSize(0)
+    , bufferLimit(bufferLimit)
+    , stopRequested(false)
+    , nWrittenBytes(0)
+    , writeTime(0.0)
+{
+    this->thread = std::thread(&RModelWriter::process,this);
+}
+
+RModelWriter::~RModelWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->stopRequested = true;
+    }
+    this->condition.notify_all();
+    this->thread.join();
+
+    this->printReports();
+
+    if (this->nWrittenBytes > 0)
+    {
+        RLogger::info("Model writer: %.2f MB written in %.3f s (%.2f MB/s)\n",
+                      double(this->nWrittenBytes)/(1024.0*1024.0),
+                      this->writeTime,
+                      this->writeTime > 0.0 ? double(this->nWrittenBytes)/(1024.0*1024.0*this->writeTime) : 0.0);
+    }
+}
+
+QString RModelWriter::write(const RModel &model, const QString &fileName)
+{
+    RModelWriterItem item;
+    item.pModel = new RModel(model);
+    item.fileName = fileName;
+    item.size = RModelWriter::findResultsSize(model)
+              + qint64(model.getNNodes())*qint64(sizeof(RNode))
+              + qint64(model.getNElements())*qint64(sizeof(RElement));
+
+    this->enqueue(item);
+
+    return RFileManager::getFileNameWithOutTimeStep(fileName);
+}
+
+QString RModelWriter::writeResults(const RModel &model, const QString &fileName, const QString &baseFileName)
+{
+    // Results record needs only problem and results data.
+    RModelWriterItem item;
+    item.pModel = new RModel;
+    static_cast<RProblem&>(*item.pModel) = static_cast<const RProblem&>(model);
+    static_cast<RResults&>(*item.pModel) = static_cast<const RResults&>(model);
+    item.pModel->setBinaryCompression(model.getBinaryCompression());
+    item.fileName = fileName;
+    item.baseFileName = baseFileName;
+    item.size = RModelWriter::findResultsSize(model);
+
+    this->enqueue(item);
+
+    return RFileManager::getFileNameWithOutTimeStep(fileName);
+}
+
+void RModelWriter::wait(void)
+{
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->condition.wait(lock,[this]{ return this->queue.empty(); });
+    }
+    this->printReports();
+    this->throwError();
+}
+
+void RModelWriter::enqueue(const RModelWriterItem &item)
+{
+    this->printReports();
+    this->throwError();
+
+    {
+        std::unique_lock<std::mutex> lock(this->mutex);
+        // At least one snapshot is always allowed regardless of its size.
+        this->condition.wait(lock,[this,&item]{ return this->queue.empty() || this->bufferSize + item.size <= this->bufferLimit; });
+        this->queue.push_back(item);
+        this->bufferSize += item.size;
+    }
+    this->condition.notify_all();
+}
+
+void RModelWriter::process(void)
+{
+    // Logger and progress state is shared with the solver thread.
+    RLogger::setThreadMuted(true);
+
+    while (true)
+    {
+        RModelWriterItem item;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->condition.wait(lock,[this]{ return this->stopRequested || !this->queue.empty(); });
+            if (this->queue.empty())
+            {
+                break;
+            }
+            item = this->queue.front();
+        }
+
+        QString recordFileName = item.pModel->getRecordFileName(item.fileName);
+        QString message;
+
+        std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+        try
+        {
+            if (item.baseFileName.isEmpty())
+            {
+                item.pModel->write(item.fileName);
+            }
+            else
+            {
+                item.pModel->writeResults(item.fileName,item.baseFileName);
+            }
+        }
+        catch (const RError &error)
+        {
+            message = error.getMessage();
+        }
+        catch (...)
+        {
+            message = "Unknown exception.";
+        }
+        double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        delete item.pModel;
+
+        qint64 nBytes = message.isEmpty() ? QFileInfo(recordFileName).size() : 0;
+
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            if (message.isEmpty())
+            {
+                this->reports.append(QString::asprintf("Model record \'%s\' written in %.3f s (%.2f MB/s)",
+                                                       recordFileName.toUtf8().constData(),
+                                                       elapsedTime,
+                                                       elapsedTime > 0.0 ? double(nBytes)/(1024.0*1024.0*elapsedTime) : 0.0));
+            }
+            this->queue.pop_front();
+            this->bufferSize -= item.size;
+            this->nWrittenBytes += nBytes;
+            this->writeTime += elapsedTime;
+            if (!message.isEmpty())
+            {
+                this->errorMessage = message;
+            }
+        }
+        this->condition.notify_all();
+    }
+}
+
+void RModelWriter::throwError(void)
+{
+    QString message;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        message = this->errorMessage;
+        this->errorMessage.clear();
+    }
+    if (!message.isEmpty())
+    {
+        throw RError(R_ERROR_WRITE_FILE,R_ERROR_REF,"Background model write has failed: %s",message.toUtf8().constData());
+    }
+}
+
+void RModelWriter::printReports(void)
+{
+    QStringList pendingReports;
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        pendingReports = this->reports;
+        this->reports.clear();
+    }
+    for (int i=0;i<pendingReports.size();i++)
+    {
+        RLogger::info("%s\n",pendingReports[i].toUtf8().constData());
+    }
+}
+
+qint64 RModelWriter::findResultsSize(const RModel &model)
+{
+    qint64 size = 0;
+    for (uint i=0;i<model.getNVariables();i++)
+    {
+        const RVariable &rVariable = model.getVariable(i);
+        size += qint64(rVariable.getNVectors())*qint64(rVariable.getNValues())*qint64(sizeof(double));
+    }
+    return size;
+}
@@ -0,0 +1,291 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsaddlepointmatrix.cpp                                   *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Saddle point matrix class definition                *
+ *********************************************************************/
+
+#include <cmath>
+
+#include <omp.h>
+
+#include "rsaddlepointmatrix.h"
+
+void RSaddlePointMatrix::_init(const RSaddlePointMatrix *pSaddlePointMatrix)
+{
+    if (pSaddlePointMatrix)
+    {
+        this->pMatrix = pSaddlePointMatrix->pMatrix;
+        this->second = pSaddlePointMatrix->second;
+        this->indexes1 = pSaddlePointMatrix->indexes1;
+        this->indexes2 = pSaddlePointMatrix->indexes2;
+        this->localIndexes = pSaddlePointMatrix->localIndexes;
+    }
+}
+
+RSaddlePointMatrix::RSaddlePointMatrix()
+    : pMatrix(nullptr)
+{
+    this->_init();
+}
+
+RSaddlePointMatrix::RSaddlePointMatrix(const RSaddlePointMatrix &saddlePointMatrix)
+{
+    this->_init(&saddlePointMatrix);
+}
+
+RSaddlePointMatrix::~RSaddlePointMatrix()
+{
+}
+
+RSaddlePointMatrix &RSaddlePointMatrix::operator =(const RSaddlePointMatrix &saddlePointMatrix)
+{
+    this->_init(&saddlePointMatrix);
+    return (*this);
+}
+
+void RSaddlePointMatrix::build(const std::vector<bool> &second)
+{
+    unsigned int n = (unsigned int)second.size();
+
+    this->second = second;
+    this->indexes1.clear();
+    this->indexes2.clear();
+    this->localIndexes.resize(n);
+
+    for (unsigned int i=0;i<n;i++)
+    {
+        if (second[i])
+        {
+            this->localIndexes[i] = (unsigned int)this->indexes2.size();
+            this->indexes2.push_back(i);
+        }
+        else
+        {
+            this->localIndexes[i] = (unsigned int)this->indexes1.size();
+            this->indexes1.push_back(i);
+        }
+    }
+}
+
+bool RSaddlePointMatrix::isBuilt(const std::vector<bool> &second) const
+{
+    return (this->second == second);
+}
+
+void RSaddlePointMatrix::setMatrix(const RSparseMatrix &A)
+{
+    R_ERROR_ASSERT(A.getNRows() <= this->second.size());
+
+    this->pMatrix = &A;
+}
+
+const RSparseMatrix &RSaddlePointMatrix::getMatrix(void) const
+{
+    R_ERROR_ASSERT(this->pMatrix);
+
+    return (*this->pMatrix);
+}
+
+unsigned int RSaddlePointMatrix::getN1(void) const
+{
+    return (unsigned int)this->indexes1.size();
+}
+
+unsigned int RSaddlePointMatrix::getN2(void) const
+{
+    return (unsigned int)this->indexes2.size();
+}
+
+unsigned int RSaddlePointMatrix::getLocalIndex(unsigned int globalIndex) const
+{
+    return this->localIndexes[globalIndex];
+}
+
+const std::vector<unsigned int> &RSaddlePointMatrix::getLocalIndexes(void) const
+{
+    return this->localIndexes;
+}
+
+const std::vector<unsigned int> &RSaddlePointMatrix::getIndexes1(void) const
+{
+    return this->indexes1;
+}
+
+const std::vector<unsigned int> &RSaddlePointMatrix::getIndexes2(void) const
+{
+    return this->indexes2;
+}
+
+void RSaddlePointMatrix::findDiagonal1(RRVector &d1) const
+{
+    R_ERROR_ASSERT(this->pMatrix);
+
+    d1.resize(this->getN1());
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(this->indexes1.size());i++)
+    {
+        unsigned int row = this->indexes1[i];
+        d1[i] = (row < this->pMatrix->getNRows()) ? this->pMatrix->findValue(row,row) : 0.0;
+    }
+}
+
+void RSaddlePointMatrix::multiply12(const RRVector &x2, RRVector &y1) const
+{
+    this->multiplyBlock(this->indexes1,true,x2,y1);
+}
+
+void RSaddlePointMatrix::multiply21(const RRVector &x1, RRVector &y2) const
+{
+    this->multiplyBlock(this->indexes2,false,x1,y2);
+}
+
+void RSaddlePointMatrix::multiply22(const RRVector &x2, RRVector &y2) const
+{
+    this->multiplyBlock(this->indexes2,true,x2,y2);
+}
+
+void RSaddlePointMatrix::split(const RRVector &x, RRVector &x1, RRVector &x2) const
+{
+    x1.resize(this->getN1());
+    x2.resize(this->getN2());
+
+    for (unsigned int i=0;i<this->indexes1.size();i++)
+    {
+        x1[i] = x[this->indexes1[i]];
+    }
+    for (unsigned int i=0;i<this->indexes2.size();i++)
+    {
+        x2[i] = x[this->indexes2[i]];
+    }
+}
+
+void RSaddlePointMatrix::merge(const RRVector &x1, const RRVector &x2, RRVector &x) const
+{
+    x.resize(this->getN1() + this->getN2());
+
+    for (unsigned int i=0;i<this->indexes1.size();i++)
+    {
+        x[this->indexes1[i]] = x1[i];
+    }
+    for (unsigned int i=0;i<this->indexes2.size();i++)
+    {
+        x[this->indexes2[i]] = x2[i];
+    }
+}
+
+void RSaddlePointMatrix::findSchurDiagonal(RRVector &d) const
+{
+    R_ERROR_ASSERT(this->pMatrix);
+
+    const RSparseMatrix &A = (*this->pMatrix);
+
+    RRVector d1;
+    this->findDiagonal1(d1);
+
+    RRVector invD1(d1.size(),0.0);
+    for (unsigned int i=0;i<d1.size();i++)
+    {
+        invD1[i] = (d1[i] == 0.0) ? 0.0 : 1.0 / d1[i];
+    }
+
+    d.resize(this->getN2());
+
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(this->indexes2.size());i++)
+    {
+        unsigned int row = this->indexes2[i];
+        if (row >= A.getNRows())
+        {
+            d[i] = 0.0;
+            continue;
+        }
+        double value = A.findValue(row,row);
+        for (unsigned int j=0;j<A.getNColumns(row);j++)
+        {
+            unsigned int k = A.getColumnIndex(row,j);
+            if (!this->second[k] && k < A.getNRows())
+            {
+                value -= A.getValue(row,j) * invD1[this->localIndexes[k]] * A.findValue(k,row);
+            }
+        }
+        d[i] = value;
+    }
+}
+
+double RSaddlePointMatrix::findSchurScales(const RSparseMatrix &M, RRVector &w) const
+{
+    RRVector ds;
+    this->findSchurDiagonal(ds);
+
+    return RSaddlePointMatrix::findSchurScales(ds,M,w);
+}
+
+double RSaddlePointMatrix::findSchurScales(const RRVector &ds, const RSparseMatrix &M, RRVector &w)
+{
+    unsigned int n2 = (unsigned int)ds.size();
+
+    double dsSum = 0.0;
+    for (unsigned int i=0;i<n2;i++)
+    {
+        dsSum += ds[i];
+    }
+    double sign = (dsSum < 0.0) ? -1.0 : 1.0;
+
+    double ratioSum = 0.0;
+    unsigned int nRatios = 0;
+    w.resize(n2);
+    w.fill(0.0);
+    for (unsigned int i=0;i<n2;i++)
+    {
+        double dm = M.findValue(i,i);
+        double ratio = (dm != 0.0) ? sign * ds[i] / dm : 0.0;
+        if (ratio > 0.0)
+        {
+            w[i] = std::sqrt(ratio);
+            ratioSum += ratio;
+            nRatios++;
+        }
+    }
+    double wAvg = (nRatios > 0) ? std::sqrt(ratioSum / double(nRatios)) : 1.0;
+    for (unsigned int i=0;i<n2;i++)
+    {
+        if (w[i] == 0.0)
+        {
+            w[i] = wAvg;
+        }
+    }
+
+    return sign;
+}
+
+void RSaddlePointMatrix::multiplyBlock(const std::vector<unsigned int> &rowIndexes, bool secondColumns, const RRVector &x, RRVector &y) const
+{
+    R_ERROR_ASSERT(this->pMatrix);
+    R_ERROR_ASSERT(y.size() == rowIndexes.size());
+
+    const RSparseMatrix &A = (*this->pMatrix);
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(rowIndexes.size());i++)
+    {
+        unsigned int row = rowIndexes[i];
+        double value = 0.0;
+        if (row < A.getNRows())
+        {
+            for (unsigned int j=0;j<A.getNColumns(row);j++)
+            {
+                unsigned int column = A.getColumnIndex(row,j);
+                if (this->second[column] == secondColumns)
+                {
+                    value += A.getValue(row,j) * x[this->localIndexes[column]];
+                }
+            }
+        }
+        y[i] = value;
+    }
+}
@@ -0,0 +1,102 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsaddlepointpreconditioner.cpp                           *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Saddle point preconditioner class definition        *
+ *********************************************************************/
+
+#include <omp.h>
+
+#include "rsaddlepointpreconditioner.h"
+
+void RSaddlePointPreconditioner::_init(const RSaddlePointPreconditioner *pSaddlePointPreconditioner)
+{
+    if (pSaddlePointPreconditioner)
+    {
+        this->pSaddlePointMatrix = pSaddlePointPreconditioner->pSaddlePointMatrix;
+        this->P11 = pSaddlePointPreconditioner->P11;
+        this->PS = pSaddlePointPreconditioner->PS;
+        this->w = pSaddlePointPreconditioner->w;
+        this->sign = pSaddlePointPreconditioner->sign;
+        this->x1 = pSaddlePointPreconditioner->x1;
+        this->x2 = pSaddlePointPreconditioner->x2;
+        this->y1 = pSaddlePointPreconditioner->y1;
+        this->y2 = pSaddlePointPreconditioner->y2;
+    }
+}
+
+RSaddlePointPreconditioner::RSaddlePointPreconditioner(const RSaddlePointMatrix &saddlePointMatrix, const RSparseMatrix &M, unsigned int nDomains)
+    : pSaddlePointMatrix(&saddlePointMatrix)
+    , P11(saddlePointMatrix.getMatrix(),saddlePointMatrix.getIndexes1(),saddlePointMatrix.getLocalIndexes(),R_MATRIX_PRECONDITIONER_ADDITIVE_SCHWARZ,nDomains)
+    , PS(M,R_MATRIX_PRECONDITIONER_ADDITIVE_SCHWARZ,1,nDomains)
+    , sign(1.0)
+{
+    this->_init();
+
+    R_ERROR_ASSERT(M.getNRows() == saddlePointMatrix.getN2());
+
+    this->sign = saddlePointMatrix.findSchurScales(M,this->w);
+
+    this->x1.resize(saddlePointMatrix.getN1(),0.0);
+    this->y1.resize(saddlePointMatrix.getN1(),0.0);
+    this->x2.resize(saddlePointMatrix.getN2(),0.0);
+    this->y2.resize(saddlePointMatrix.getN2(),0.0);
+}
+
+RSaddlePointPreconditioner::RSaddlePointPreconditioner(const RSaddlePointPreconditioner &saddlePointPreconditioner)
+    : RMatrixPreconditioner(saddlePointPreconditioner)
+    , P11(saddlePointPreconditioner.P11)
+    , PS(saddlePointPreconditioner.PS)
+{
+    this->_init(&saddlePointPreconditioner);
+}
+
+RSaddlePointPreconditioner::~RSaddlePointPreconditioner()
+{
+}
+
+RSaddlePointPreconditioner &RSaddlePointPreconditioner::operator =(const RSaddlePointPreconditioner &saddlePointPreconditioner)
+{
+    this->RMatrixPreconditioner::operator =(saddlePointPreconditioner);
+    this->_init(&saddlePointPreconditioner);
+    return (*this);
+}
+
+void RSaddlePointPreconditioner::compute(const RRVector &x, RRVector &y) const
+{
+    const std::vector<unsigned int> &indexes1 = this->pSaddlePointMatrix->getIndexes1();
+    const std::vector<unsigned int> &indexes2 = this->pSaddlePointMatrix->getIndexes2();
+
+    R_ERROR_ASSERT(y.size() == indexes1.size() + indexes2.size());
+
+    // Second block: y2 = sign*W^-1*M^-1*W^-1*x2
+#pragma omp for
+    for (int64_t i=0;i<int64_t(indexes2.size());i++)
+    {
+        this->x2[i] = this->sign * x[indexes2[i]] / this->w[i];
+    }
+    this->PS.compute(this->x2,this->y2);
+#pragma omp for
+    for (int64_t i=0;i<int64_t(indexes2.size());i++)
+    {
+        this->y2[i] /= this->w[i];
+        y[indexes2[i]] = this->y2[i];
+    }
+
+    // First block: y1 = A11^-1*(x1 - A12*y2)
+    this->pSaddlePointMatrix->multiply12(this->y2,this->x1);
+#pragma omp for
+    for (int64_t i=0;i<int64_t(indexes1.size());i++)
+    {
+        this->x1[i] = x[indexes1[i]] - this->x1[i];
+    }
+    this->P11.compute(this->x1,this->y1);
+#pragma omp for
+    for (int64_t i=0;i<int64_t(indexes1.size());i++)
+    {
+        y[indexes1[i]] = this->y1[i];
+    }
+}
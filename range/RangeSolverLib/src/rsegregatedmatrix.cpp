@@ -0,0 +1,178 @@
+/*********************************************************************
+ *  AUTHOR: Tomas Soltys                                             *
+ *  FILE:   rsegregatedmatrix.cpp                                    *
+ *  GROUP:  RSolverLib                                               *
+ *  TYPE:   source file (*.cpp)                                      *
+ *  DATE:   19-th October 2026                                       *
+ *                                                                   *
+ *  DESCRIPTION: Segregated matrix class definition                  *
+ *********************************************************************/
+
+#include <omp.h>
+
+#include "rsegregatedmatrix.h"
+
+void RSegregatedMatrix::_init(const RSegregatedMatrix *pSegregatedMatrix)
+{
+    if (pSegregatedMatrix)
+    {
+        this->nBlocks = pSegregatedMatrix->nBlocks;
+        this->blockIDs = pSegregatedMatrix->blockIDs;
+        this->localIndexes = pSegregatedMatrix->localIndexes;
+        this->indexes = pSegregatedMatrix->indexes;
+        this->keptBlocks = pSegregatedMatrix->keptBlocks;
+        this->blocks = pSegregatedMatrix->blocks;
+    }
+}
+
+RSegregatedMatrix::RSegregatedMatrix()
+    : nBlocks(0)
+{
+    this->_init();
+}
+
+RSegregatedMatrix::RSegregatedMatrix(const RSegregatedMatrix &segregatedMatrix)
+{
+    this->_init(&segregatedMatrix);
+}
+
+RSegregatedMatrix::~RSegregatedMatrix()
+{
+}
+
+RSegregatedMatrix &RSegregatedMatrix::operator =(const RSegregatedMatrix &segregatedMatrix)
+{
+    this->_init(&segregatedMatrix);
+    return (*this);
+}
+
+void RSegregatedMatrix::build(const std::vector<unsigned int> &blockIDs, unsigned int nBlocks, const std::vector<bool> &keptBlocks)
+{
+    R_ERROR_ASSERT(keptBlocks.size() == nBlocks*nBlocks);
+
+    this->nBlocks = nBlocks;
+    this->blockIDs = blockIDs;
+    this->keptBlocks = keptBlocks;
+    this->localIndexes.resize(blockIDs.size());
+    this->indexes.assign(nBlocks,std::vector<unsigned int>());
+
+    for (unsigned int i=0;i<blockIDs.size();i++)
+    {
+        R_ERROR_ASSERT(blockIDs[i] < nBlocks);
+        this->localIndexes[i] = (unsigned int)this->indexes[blockIDs[i]].size();
+        this->indexes[blockIDs[i]].push_back(i);
+    }
+
+    this->blocks.assign(nBlocks*nBlocks,RSparseMatrix());
+    this->clearValues();
+}
+
+bool RSegregatedMatrix::isBuilt(const std::vector<unsigned int> &blockIDs, unsigned int nBlocks) const
+{
+    return (this->nBlocks == nBlocks && this->blockIDs == blockIDs);
+}
+
+void RSegregatedMatrix::clearValues(void)
+{
+    for (unsigned int i=0;i<this->nBlocks;i++)
+    {
+        for (unsigned int j=0;j<this->nBlocks;j++)
+        {
+            RSparseMatrix &block = this->blocks[i*this->nBlocks+j];
+            block.clear();
+            if (this->keptBlocks[i*this->nBlocks+j])
+            {
+                block.setNRows(this->getN(i));
+            }
+        }
+    }
+}
+
+unsigned int RSegregatedMatrix::getNBlocks(void) const
+{
+    return this->nBlocks;
+}
+
+unsigned int RSegregatedMatrix::getN(unsigned int blockID) const
+{
+    return (unsigned int)this->indexes[blockID].size();
+}
+
+unsigned int RSegregatedMatrix::getBlockID(unsigned int globalIndex) const
+{
+    return this->blockIDs[globalIndex];
+}
+
+unsigned int RSegregatedMatrix::getLocalIndex(unsigned int globalIndex) const
+{
+    return this->localIndexes[globalIndex];
+}
+
+const std::vector<unsigned int> &RSegregatedMatrix::getIndexes(unsigned int blockID) const
+{
+    return this->indexes[blockID];
+}
+
+bool RSegregatedMatrix::isBlockKept(unsigned int rowBlockID, unsigned int columnBlockID) const
+{
+    return this->keptBlocks[rowBlockID*this->nBlocks+columnBlockID];
+}
+
+const RSparseMatrix &RSegregatedMatrix::getBlock(unsigned int rowBlockID, unsigned int columnBlockID) const
+{
+    R_ERROR_ASSERT(this->isBlockKept(rowBlockID,columnBlockID));
+
+    return this->blocks[rowBlockID*this->nBlocks+columnBlockID];
+}
+
+void RSegregatedMatrix::addValue(unsigned int row, unsigned int column, double value)
+{
+    unsigned int blockPosition = this->blockIDs[row]*this->nBlocks + this->blockIDs[column];
+    if (this->keptBlocks[blockPosition])
+    {
+        this->blocks[blockPosition].addValue(this->localIndexes[row],this->localIndexes[column],value);
+    }
+}
+
+void RSegregatedMatrix::multiply(unsigned int rowBlockID, unsigned int columnBlockID, const RRVector &x, RRVector &y) const
+{
+    const RSparseMatrix &block = this->getBlock(rowBlockID,columnBlockID);
+
+    R_ERROR_ASSERT(y.size() == this->getN(rowBlockID));
+
+#pragma omp for
+    for (int64_t i=0;i<int64_t(y.size());i++)
+    {
+        double value = 0.0;
+        for (unsigned int j=0;j<block.getNColumns(i);j++)
+        {
+            value += block.getValue(i,j) * x[block.getColumnIndex(i,j)];
+        }
+        y[i] = value;
+    }
+}
+
+void RSegregatedMatrix::split(const RRVector &x, std::vector<RRVector> &xb) const
+{
+    xb.resize(this->nBlocks);
+    for (unsigned int i=0;i<this->nBlocks;i++)
+    {
+        xb[i].resize(this->getN(i));
+        for (unsigned int j=0;j<this->indexes[i].size();j++)
+        {
+            xb[i][j] = x[this->indexes[i][j]];
+        }
+    }
+}
+
+void RSegregatedMatrix::merge(const std::vector<RRVector> &xb, RRVector &x) const
+{
+    x.resize(this->blockIDs.size());
+    for (unsigned int i=0;i<this->nBlocks;i++)
+    {
+        for (unsigned int j=0;j<this->indexes[i].size();j++)
+        {
+            x[this->indexes[i][j]] = xb[i][j];
+        }
+    }
+}
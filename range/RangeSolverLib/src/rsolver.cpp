@@ -21,6 +21,9 @@
 #include "rsolverstress.h"
 #include "rsolverwave.h"
 
+// Version of solver checkpoint file format.
+static const RVersion _checkpointVersion = RVersion(1,2,0);
+
 void RSolver::_init(const RSolver *pSolver)
 {
     if (pSolver)
@@ -38,6 +41,9 @@ void RSolver::_init(const RSolver *pSolver)
 //            iter.value();
 //        }
         this->solversExecutionCount = pSolver->solversExecutionCount;
+        this->modelWriter = pSolver->modelWriter;
+        this->checkpointInterval = pSolver->checkpointInterval;
+        this->checkpointTime = pSolver->checkpointTime;
     }
     else
     {
@@ -104,6 +110,13 @@ void RSolver::_init(const RSolver *pSolver)
             }
         }
 
+        // Results are written in background so that next time step can start immediately.
+        this->modelWriter = std::make_shared<RModelWriter>();
+        foreach (RSolverGeneric *solver, this->solvers)
+        {
+            solver->setModelWriter(this->modelWriter.get());
+        }
+
         // if not restarting clear results data.
         if (!this->pModel->getProblemSetup().getRestart())
         {
@@ -116,6 +129,8 @@ RSolver::RSolver(RModel &model, const QString &modelFileName, const QString &con
     : pModel(&model)
     , modelFileName(modelFileName)
     , convergenceFileName(convergenceFileName)
+    , checkpointInterval(0.0)
+    , checkpointTime(std::chrono::steady_clock::now())
 {
     this->_init();
 }
@@ -141,6 +156,11 @@ RSolver &RSolver::operator =(const RSolver &solver)
 
 void RSolver::run(void)
 {
+    if (this->pModel->getProblemSetup().getRestart())
+    {
+        this->readCheckpoint();
+    }
+
     RTimeSolver &timeSolver = this->pModel->getTimeSolver();
     timeSolver.harmonizeTimesWithInput(this->pModel->getProblemSetup().getRestart());
 
@@ -152,6 +172,8 @@ void RSolver::run(void)
         }
         RSolverGeneric::updateOldRecords(timeSolver,this->modelFileName);
 
+        this->checkpointTime = std::chrono::steady_clock::now();
+
         do {
             RLogger::info("time step: %9u of %-9u | time = % 12e [sec] | dt = % 12e [sec]\n",
                           timeSolver.getCurrentTimeStep()+1,
@@ -168,6 +190,8 @@ void RSolver::run(void)
             {
                 break;
             }
+
+            this->updateCheckpoint();
         } while (timeSolver.setNextTimeStep() != RConstants::eod);
     }
     else
@@ -177,6 +201,25 @@ void RSolver::run(void)
         timeSolver.setTimes(RTimeSolver::findTimesVector(1, 0.0, 0.0));
         this->runSingle();
     }
+
+    this->modelWriter->wait();
+}
+
+void RSolver::setCheckpointInterval(double checkpointInterval)
+{
+    this->checkpointInterval = checkpointInterval;
+}
+
+QString RSolver::getCheckpointFileName(const QString &modelFileName)
+{
+    QString fileName(RFileManager::getFileNameWithSuffix(RFileManager::getFileNameWithOutTimeStep(modelFileName),"checkpoint"));
+    return RFileManager::removeExtension(fileName) + ".rsc";
+}
+
+QString RSolver::getCheckpointModelFileName(const QString &modelFileName)
+{
+    QString fileName(RFileManager::getFileNameWithSuffix(RFileManager::getFileNameWithOutTimeStep(modelFileName),"checkpoint"));
+    return RFileManager::removeExtension(fileName) + "." + RModel::getDefaultFileExtension(true);
 }
 
 void RSolver::runSingle(void)
@@ -255,3 +298,204 @@ bool RSolver::runProblemTask(const RProblemTaskItem &problemTaskItem, uint taskI
 
     return converged;
 }
+
+void RSolver::updateCheckpoint(void)
+{
+    if (this->checkpointInterval <= 0.0 || this->modelFileName.isEmpty())
+    {
+        return;
+    }
+
+    double elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->checkpointTime).count();
+    if (elapsedTime < this->checkpointInterval)
+    {
+        return;
+    }
+
+    try
+    {
+        this->writeCheckpoint();
+    }
+    catch (const RError &error)
+    {
+        RLogger::warning("Failed to write checkpoint. ERROR: %s\n",error.getMessage().toUtf8().constData());
+    }
+
+    this->checkpointTime = std::chrono::steady_clock::now();
+}
+
+void RSolver::writeCheckpoint(void)
+{
+    QString checkpointFileName(RSolver::getCheckpointFileName(this->modelFileName));
+    QString checkpointModelFileName(RSolver::getCheckpointModelFileName(this->modelFileName));
+
+    RLogger::info("Writing checkpoint \'%s\'\n",checkpointFileName.toUtf8().constData());
+    RLogger::indent();
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+    try
+    {
+        // Records of already computed time steps must be on disk before checkpoint is written.
+        this->modelWriter->wait();
+
+        this->pModel->write(checkpointModelFileName,false);
+
+        RSaveFile checkpointFile(checkpointFileName,RSaveFile::BINARY);
+
+        if (!checkpointFile.open(QIODevice::WriteOnly))
+        {
+            throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",checkpointFileName.toUtf8().constData());
+        }
+
+        RFileIO::writeBinary(checkpointFile,RFileHeader(R_FILE_TYPE_SOLVER_CHECKPOINT,_checkpointVersion));
+        RFileIO::writeBinary(checkpointFile,this->pModel->getTimeSolver().getCurrentTimeStep());
+
+        RFileIO::writeBinary(checkpointFile,uint(this->solversExecutionCount.size()));
+        QMap<RProblemType,uint>::const_iterator countIter;
+        for (countIter = this->solversExecutionCount.constBegin(); countIter != this->solversExecutionCount.constEnd(); ++countIter)
+        {
+            RFileIO::writeBinary(checkpointFile,uint(countIter.key()));
+            RFileIO::writeBinary(checkpointFile,countIter.value());
+        }
+
+        this->sharedData.writeCheckpoint(checkpointFile);
+
+        RFileIO::writeBinary(checkpointFile,uint(this->solvers.size()));
+        QMap<RProblemTypeMask,RSolverGeneric*>::const_iterator solverIter;
+        for (solverIter = this->solvers.constBegin(); solverIter != this->solvers.constEnd(); ++solverIter)
+        {
+            RFileIO::writeBinary(checkpointFile,uint(solverIter.key()));
+            solverIter.value()->writeCheckpoint(checkpointFile);
+        }
+
+        checkpointFile.commit();
+    }
+    catch (const RError &error)
+    {
+        RLogger::unindent();
+        throw error;
+    }
+
+    RLogger::info("Checkpoint written in %.3f s\n",std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+    RLogger::unindent();
+}
+
+bool RSolver::readCheckpoint(void)
+{
+    if (this->modelFileName.isEmpty() || !this->pModel->getTimeSolver().getEnabled())
+    {
+        return false;
+    }
+
+    QString checkpointFileName(RSolver::getCheckpointFileName(this->modelFileName));
+    QString checkpointModelFileName(RSolver::getCheckpointModelFileName(this->modelFileName));
+
+    if (!RFileManager::fileExists(checkpointFileName) || !RFileManager::fileExists(checkpointModelFileName))
+    {
+        return false;
+    }
+
+    RLogger::info("Reading checkpoint \'%s\'\n",checkpointFileName.toUtf8().constData());
+    RLogger::indent();
+
+    try
+    {
+        RFile checkpointFile(checkpointFileName,RFile::BINARY);
+
+        if (!checkpointFile.open(QIODevice::ReadOnly))
+        {
+            throw RError(R_ERROR_OPEN_FILE,R_ERROR_REF,"Failed to open the file \'%s\'.",checkpointFileName.toUtf8().constData());
+        }
+
+        RFileHeader fileHeader;
+        RFileIO::readBinary(checkpointFile,fileHeader);
+        if (fileHeader.getType() != R_FILE_TYPE_SOLVER_CHECKPOINT)
+        {
+            throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"File type of the file \'" + checkpointFileName + "\' is not SOLVER CHECKPOINT.");
+        }
+        checkpointFile.setVersion(fileHeader.getVersion());
+
+        uint timeStep = 0;
+        RFileIO::readBinary(checkpointFile,timeStep);
+
+        if (timeStep < this->pModel->getTimeSolver().getCurrentTimeStep())
+        {
+            // Loaded model is more recent than the checkpoint.
+            RLogger::info("Checkpoint time step %u is older than model time step %u and will be ignored.\n",
+                          timeStep+1,
+                          this->pModel->getTimeSolver().getCurrentTimeStep()+1);
+            RLogger::unindent();
+            return false;
+        }
+
+        RModel checkpointModel;
+        checkpointModel.read(checkpointModelFileName);
+
+        if (checkpointModel.getTimeSolver().getCurrentTimeStep() != timeStep)
+        {
+            throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"Checkpoint model file \'" + checkpointModelFileName + "\' does not match the checkpoint.");
+        }
+
+        QMap<RProblemType,uint> solversExecutionCount;
+        uint nCounts = 0;
+        RFileIO::readBinary(checkpointFile,nCounts);
+        for (uint i=0;i<nCounts;i++)
+        {
+            uint problemType = 0;
+            uint executionCount = 0;
+            RFileIO::readBinary(checkpointFile,problemType);
+            RFileIO::readBinary(checkpointFile,executionCount);
+            solversExecutionCount[RProblemType(problemType)] = executionCount;
+        }
+
+        this->sharedData.readCheckpoint(checkpointFile);
+
+        uint nSolvers = 0;
+        RFileIO::readBinary(checkpointFile,nSolvers);
+        if (nSolvers != uint(this->solvers.size()))
+        {
+            throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"Number of solvers in checkpoint (%u) does not match the model (%u).",nSolvers,uint(this->solvers.size()));
+        }
+        for (uint i=0;i<nSolvers;i++)
+        {
+            uint problemType = 0;
+            RFileIO::readBinary(checkpointFile,problemType);
+            if (!this->solvers.contains(RProblemTypeMask(problemType)))
+            {
+                throw RError(R_ERROR_INVALID_FILE_FORMAT,R_ERROR_REF,"Checkpoint contains unexpected problem type (%u).",problemType);
+            }
+            this->solvers[RProblemTypeMask(problemType)]->readCheckpoint(checkpointFile);
+        }
+
+        checkpointFile.close();
+
+        // Settings which are not stored in model file and time step input which may have been changed before restart are kept.
+        checkpointModel.getMatrixSolverConf(RMatrixSolverConf::CG).setOutputFileName(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG).getOutputFileName());
+        checkpointModel.getMatrixSolverConf(RMatrixSolverConf::GMRES).setOutputFileName(this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES).getOutputFileName());
+        checkpointModel.getMatrixSolverConf(RMatrixSolverConf::CG).setNDomains(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG).getNDomains());
+        checkpointModel.getMatrixSolverConf(RMatrixSolverConf::GMRES).setNDomains(this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES).getNDomains());
+        checkpointModel.getMatrixSolverConf(RMatrixSolverConf::CG).setMatrixFree(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG).getMatrixFree());
+        checkpointModel.getMatrixSolverConf(RMatrixSolverConf::CG).setDeflation(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG).getDeflation());
+        checkpointModel.getMatrixSolverConf(RMatrixSolverConf::GMRES).setSaddlePointPreconditioner(this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES).getSaddlePointPreconditioner());
+        checkpointModel.getMonitoringPointManager() = this->pModel->getMonitoringPointManager();
+        checkpointModel.getProblemSetup().setRestart(true);
+        checkpointModel.setBinaryCompression(this->pModel->getBinaryCompression());
+        checkpointModel.getTimeSolver().setInputNTimeSteps(this->pModel->getTimeSolver().getInputNTimeSteps());
+        checkpointModel.getTimeSolver().setInputStartTime(this->pModel->getTimeSolver().getInputStartTime());
+        checkpointModel.getTimeSolver().setInputTimeStepSize(this->pModel->getTimeSolver().getInputTimeStepSize());
+
+        (*this->pModel) = checkpointModel;
+        this->solversExecutionCount = solversExecutionCount;
+    }
+    catch (const RError &error)
+    {
+        RLogger::unindent();
+        throw error;
+    }
+
+    RLogger::info("Solver state restored at time step %u\n",this->pModel->getTimeSolver().getCurrentTimeStep()+1);
+    RLogger::unindent();
+
+    return true;
+}
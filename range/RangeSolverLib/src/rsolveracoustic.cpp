@@ -9,6 +9,7 @@
  *********************************************************************/
 
 #include "rsolveracoustic.h"
+#include "relementmatrixoperator.h"
 #include "rmatrixsolver.h"
 
 void RSolverAcoustic::_init(const RSolverAcoustic *pAcousticSolver)
@@ -61,6 +62,28 @@ bool RSolverAcoustic::hasConverged(void) const
     return true;
 }
 
+void RSolverAcoustic::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RFileIO::writeBinary(outFile,this->nodeVelocityPotential,true);
+    RFileIO::writeBinary(outFile,this->nodeVelocityPotentialOld,true);
+    RFileIO::writeBinary(outFile,this->nodeVelocityPotentialVelocity,true);
+    RFileIO::writeBinary(outFile,this->nodeVelocityPotentialAcceleration,true);
+    RFileIO::writeBinary(outFile,this->nodeAcousticPressure,true);
+}
+
+void RSolverAcoustic::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RFileIO::readBinary(inFile,this->nodeVelocityPotential,true);
+    RFileIO::readBinary(inFile,this->nodeVelocityPotentialOld,true);
+    RFileIO::readBinary(inFile,this->nodeVelocityPotentialVelocity,true);
+    RFileIO::readBinary(inFile,this->nodeVelocityPotentialAcceleration,true);
+    RFileIO::readBinary(inFile,this->nodeAcousticPressure,true);
+}
+
 double RSolverAcoustic::findSoundSpeedScale(void) const
 {
     if (this->pModel->getNElements() == 0)
@@ -146,352 +169,292 @@ void RSolverAcoustic::prepare(void)
     this->generateMaterialVecor(R_MATERIAL_PROPERTY_DENSITY,this->elementDensity);
 
     this->elementDampingFactor.resize(this->pModel->getNElements(),0.0);
-    this->pModel->convertElementToNodeVector(elementVelocityPotential,velocityPotentialSetValues,this->nodeVelocityPotential,true);
+    this->nodeElementIncidence.convertElementToNode(elementVelocityPotential,velocityPotentialSetValues,this->nodeVelocityPotential,true);
     this->nodeVelocityPotentialOld = this->nodeVelocityPotential;
 
     this->b.resize(this->nodeBook.getNEnabled());
-    this->x.resize(this->nodeBook.getNEnabled());
 
     this->A.clear();
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(this->nodeBook.getNEnabled());
+    this->updateGeometricFactors();
+    this->initializeMatrixFree();
 
     // Prepare point elements.
-    for (uint i=0;i<this->pModel->getNPoints();i++)
+    bool abort = false;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->pointElements.size());j++)
     {
-        RPoint &point = this->pModel->getPoint(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(point.size());j++)
+        try
         {
-            try
+            uint elementID = this->pointElements.getElementID(j);
+            const RPoint &point = this->pModel->getPoint(this->pointElements.getEntityID(j));
+
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size(),element.size());
+            RRMatrix Ce(element.size(),element.size());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
+
+            Me.fill(0.0);
+            Ce.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
+
+            for (uint k=0;k<nInp;k++)
             {
-                uint elementID = point.get(j);
-
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ce(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-
-                Me.fill(0.0);
-                Ce.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                for (uint k=0;k<nInp;k++)
+                for (uint m=0;m<element.size();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    for (uint m=0;m<element.size();m++)
+                    for (uint n=0;n<element.size();n++)
                     {
-                        for (uint n=0;n<element.size();n++)
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled())
                         {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
-                            {
-                                Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * point.getVolume();
-                            }
+                            Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * point.getVolume();
                         }
-                        // Velocity / force
-                        fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
+                    // Velocity / force
+                    fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare line elements.
-    for (uint i=0;i<this->pModel->getNLines();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->lineElements.size());j++)
     {
-        RLine &line = this->pModel->getLine(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        try
         {
-            try
+            uint elementID = this->lineElements.getElementID(j);
+            const RLine &line = this->pModel->getLine(this->lineElements.getEntityID(j));
+
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size(),element.size());
+            RRMatrix Ce(element.size(),element.size());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
+            RRMatrix B(element.size(),1);
+
+            Me.fill(0.0);
+            Ce.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
+
+            double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
+
+            for (uint k=0;k<nInp;k++)
             {
-                uint elementID = line.get(j);
-
-                if (!this->computableElements[elementID])
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                B.fill(0.0);
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    continue;
+                    B[m][0] += dN[m][0]*J[0][0];
                 }
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ce(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),1);
-
-                Me.fill(0.0);
-                Ce.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
-
-                for (uint k=0;k<nInp;k++)
+                for (uint m=0;m<element.size();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint n=0;n<element.size();n++)
                     {
-                        B[m][0] += dN[m][0]*J[0][0];
-                    }
+                        // Stiffness
+                        Ke[m][n] += (B[m][0]*B[n][0]) * line.getCrossArea() * c * c * detJ * shapeFunc.getW();
 
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        for (uint n=0;n<element.size();n++)
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled())
                         {
-                            // Stiffness
-                            Ke[m][n] += (B[m][0]*B[n][0]) * line.getCrossArea() * c * c * detJ * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
-                            {
-                                Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * line.getCrossArea();
-                            }
+                            Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * line.getCrossArea();
                         }
-                        // Velocity / force
-                        fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
+                    // Velocity / force
+                    fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare surface elements.
-    for (uint i=0;i<this->pModel->getNSurfaces();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->surfaceElements.size());j++)
     {
-        RSurface &surface = this->pModel->getSurface(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+        try
         {
-            try
+            uint elementID = this->surfaceElements.getElementID(j);
+            const RSurface &surface = this->pModel->getSurface(this->surfaceElements.getEntityID(j));
+
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size(),element.size());
+            RRMatrix Ce(element.size(),element.size());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
+            RRMatrix B(element.size(),2);
+
+            Me.fill(0.0);
+            Ce.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
+
+            double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
+
+            for (uint k=0;k<nInp;k++)
             {
-                uint elementID = surface.get(j);
-
-                if (!this->computableElements[elementID])
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                B.fill(0.0);
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    continue;
+                    B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
+                    B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
                 }
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ce(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),2);
-
-                Me.fill(0.0);
-                Ce.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
-
-                for (uint k=0;k<nInp;k++)
+                for (uint m=0;m<element.size();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    for (uint n=0;n<element.size();n++)
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
-                    }
+                        // Stiffness
+                        Ke[m][n] += (B[m][0]*B[n][0]+B[m][1]*B[n][1]) * surface.getThickness() * c * c * detJ * shapeFunc.getW();
 
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        for (uint n=0;n<element.size();n++)
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled())
                         {
-                            // Stiffness
-                            Ke[m][n] += (B[m][0]*B[n][0]+B[m][1]*B[n][1]) * surface.getThickness() * c * c * detJ * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
-                            {
-                                Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * surface.getThickness();
-                            }
+                            Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW() * surface.getThickness();
                         }
-                        // Velocity / force
-                        fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
+                    // Velocity / force
+                    fe[m] += elementVelocityNormal[elementID] * N[m] * detJ * shapeFunc.getW();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare volume elements.
-    for (uint i=0;i<this->pModel->getNVolumes();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->volumeElements.size());j++)
     {
-        RVolume &volume = this->pModel->getVolume(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = volume.get(j);
-
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ce(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),3);
-
-                Me.fill(0.0);
-                Ce.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            continue;
+        }
+        try
+        {
+            uint elementID = this->volumeElements.getElementID(j);
 
-                double c = std::sqrt(this->elementElasticityModulus[elementID]/this->elementDensity[elementID]);
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
 
-                // Conduction
-                for (uint k=0;k<nInp;k++)
+            switch (element.getType())
+            {
+                case R_ELEMENT_TETRA1:
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
-                    }
-
-                    for (uint m=0;m<element.size();m++)
+                    RFixedMatrix<4,4> Me, Ce, Ke;
+                    RFixedVector<4> fe;
+                    Ce.fill(0.0);
+                    fe.fill(0.0);
+                    this->computeVolumeElement<4,4>(elementID,Me,Ke);
+                    #pragma omp critical
                     {
-                        for (uint n=0;n<element.size();n++)
-                        {
-                            // Stiffness
-                            Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
-                                     * c * c
-                                     * detJ
-                                     * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
-                            {
-                                Me[m][n] += (-1.0) * N[m] * N[n] * detJ * shapeFunc.getW();
-                            }
-                        }
+                        this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
                     }
+                    break;
                 }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
-                }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                default:
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    RRMatrix Me(element.size(),element.size());
+                    RRMatrix Ce(element.size(),element.size());
+                    RRMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    Ce.fill(0.0);
+                    fe.fill(0.0);
+                    this->computeVolumeElement(elementID,Me,Ke);
+                    #pragma omp critical
+                    {
+                        this->assemblyMatrix(elementID,Me,Ce,Ke,fe);
+                    }
+                    break;
                 }
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 }
 
 void RSolverAcoustic::solve(void)
@@ -500,7 +463,22 @@ void RSolverAcoustic::solve(void)
     {
         RLogger::indent();
         RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        if (this->getMatrixFree())
+        {
+            RElementMatrixOperator matrixOperator(*this->pModel,
+                                                  this->nodeBook,
+                                                  this->geometricFactors,
+                                                  this->A,
+                                                  this->elementOperatorStiffness,
+                                                  this->elementOperatorMass);
+            RLogger::info("Matrix-free elements = %u (%u colors)\n",matrixOperator.getNElements(),matrixOperator.getNColors());
+            matrixSolver.solve(matrixOperator,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI);
+        }
+        else
+        {
+            // Acoustic matrix is indefinite therefore it is never deflated.
+            matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        }
         RLogger::unindent();
     }
     catch (RError error)
@@ -633,8 +611,8 @@ void RSolverAcoustic::processAcousticPressure(void)
     this->nodeAcousticPressure.resize(this->pModel->getNNodes(),0.0);
 
     RRVector nodeDensity;
-    RBVector nodeDensitySetValues(this->pModel->getNNodes(),false);
-    this->pModel->convertElementToNodeVector(this->elementDensity,nodeDensitySetValues,nodeDensity);
+    RBVector nodeDensitySetValues(this->pModel->getNElements(),false);
+    this->nodeElementIncidence.convertElementToNode(this->elementDensity,nodeDensitySetValues,nodeDensity);
 
     //double dt = this->pModel->getTimeSolver().getCurrentTimeStepSize();
     //double ct = this->pModel->getTimeSolver().getCurrentTime();
@@ -654,249 +632,219 @@ void RSolverAcoustic::processAcousticParticleVelocity(void)
     this->elementAcousticParticleVelocity.z.resize(this->pModel->getNElements(),0.0);
 
     // Process line elements.
-    for (uint i=0;i<this->pModel->getNLines();i++)
+    bool abort = false;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->lineElements.size());j++)
     {
-        RLine &line = this->pModel->getLine(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = line.get(j);
+            continue;
+        }
+        try
+        {
+            uint elementID = this->lineElements.getElementID(j);
+            const RLine &line = this->pModel->getLine(this->lineElements.getEntityID(j));
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRVector B(element.size());
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRVector B(element.size());
+            RR3Vector ve(0.0,0.0,0.0);
 
-                RR3Vector ve(0.0,0.0,0.0);
+            if (line.getCrossArea() > 0.0)
+            {
+                double vi = 0.0;
 
-                if (line.getCrossArea() > 0.0)
+                for (uint k=0;k<nInp;k++)
                 {
-                    double vi = 0.0;
+                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                    const RRMatrix &dN = shapeFunc.getDN();
+                    RRMatrix J, Rt;
+                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                    for (uint k=0;k<nInp;k++)
+                    if (line.getCrossArea() != 0.0)
                     {
-                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                        const RRMatrix &dN = shapeFunc.getDN();
-                        RRMatrix J, Rt;
-                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                        if (line.getCrossArea() != 0.0)
+                        for (uint m=0;m<dN.getNRows();m++)
                         {
-                            for (uint m=0;m<dN.getNRows();m++)
-                            {
-                                B[m] += dN[m][0] * J[0][0] * detJ / double(nInp);
-                            }
+                            B[m] += dN[m][0] * J[0][0] * detJ / double(nInp);
                         }
                     }
-
-                    for (uint k=0;k<element.size();k++)
-                    {
-                        uint nodeID = element.getNodeId(k);
-
-                        vi -= B[k] * this->nodeVelocityPotential[nodeID];
-                    }
-
-                    RRMatrix R;
-                    RRVector t;
-                    this->pModel->getElement(elementID).findTransformationMatrix(this->pModel->getNodes(),R,t);
-
-                    ve[0] += R[0][0]*vi;
-                    ve[1] += R[1][0]*vi;
-                    ve[2] += R[2][0]*vi;
                 }
 
-                this->elementAcousticParticleVelocity.x[elementID] = ve[0];
-                this->elementAcousticParticleVelocity.y[elementID] = ve[1];
-                this->elementAcousticParticleVelocity.z[elementID] = ve[2];
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                for (uint k=0;k<element.size();k++)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    uint nodeID = element.getNodeId(k);
+
+                    vi -= B[k] * this->nodeVelocityPotential[nodeID];
                 }
+
+                RRMatrix R;
+                RRVector t;
+                this->pModel->getElement(elementID).findTransformationMatrix(this->pModel->getNodes(),R,t);
+
+                ve[0] += R[0][0]*vi;
+                ve[1] += R[1][0]*vi;
+                ve[2] += R[2][0]*vi;
             }
+
+            this->elementAcousticParticleVelocity.x[elementID] = ve[0];
+            this->elementAcousticParticleVelocity.y[elementID] = ve[1];
+            this->elementAcousticParticleVelocity.z[elementID] = ve[2];
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process acoustic particle velocity.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process acoustic particle velocity.");
+    }
 
     // Process surface elements.
-    for (uint i=0;i<this->pModel->getNSurfaces();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->surfaceElements.size());j++)
     {
-        RSurface &surface = this->pModel->getSurface(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = surface.get(j);
+            continue;
+        }
+        try
+        {
+            uint elementID = this->surfaceElements.getElementID(j);
+            const RSurface &surface = this->pModel->getSurface(this->surfaceElements.getEntityID(j));
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix B(element.size(),2);
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix B(element.size(),2);
+            RR3Vector ve(0.0,0.0,0.0);
 
-                RR3Vector ve(0.0,0.0,0.0);
+            if (surface.getThickness() > 0.0)
+            {
+                double vi = 0.0;
+                double vj = 0.0;
 
-                if (surface.getThickness() > 0.0)
+                for (uint k=0;k<nInp;k++)
                 {
-                    double vi = 0.0;
-                    double vj = 0.0;
+                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                    const RRMatrix &dN = shapeFunc.getDN();
+                    RRMatrix J, Rt;
+                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                    for (uint k=0;k<nInp;k++)
+                    if (surface.getThickness() != 0.0)
                     {
-                        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                        const RRMatrix &dN = shapeFunc.getDN();
-                        RRMatrix J, Rt;
-                        double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                        if (surface.getThickness() != 0.0)
+                        for (uint m=0;m<dN.getNRows();m++)
                         {
-                            for (uint m=0;m<dN.getNRows();m++)
-                            {
-                                B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]) * detJ / double(nInp);
-                                B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]) * detJ / double(nInp);
-                            }
+                            B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]) * detJ / double(nInp);
+                            B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]) * detJ / double(nInp);
                         }
                     }
-
-                    for (uint k=0;k<element.size();k++)
-                    {
-                        uint nodeID = element.getNodeId(k);
-
-                        vi -= B[k][0] * this->nodeVelocityPotential[nodeID];
-                        vj -= B[k][1] * this->nodeVelocityPotential[nodeID];
-                    }
-
-                    RRMatrix R;
-                    RRVector t;
-                    this->pModel->getElement(elementID).findTransformationMatrix(this->pModel->getNodes(),R,t);
-
-                    ve[0] += R[0][0]*vi + R[0][1]*vj;
-                    ve[1] += R[1][0]*vi + R[1][1]*vj;
-                    ve[2] += R[2][0]*vi + R[2][1]*vj;
                 }
 
-                this->elementAcousticParticleVelocity.x[elementID] = ve[0];
-                this->elementAcousticParticleVelocity.y[elementID] = ve[1];
-                this->elementAcousticParticleVelocity.z[elementID] = ve[2];
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                for (uint k=0;k<element.size();k++)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    uint nodeID = element.getNodeId(k);
+
+                    vi -= B[k][0] * this->nodeVelocityPotential[nodeID];
+                    vj -= B[k][1] * this->nodeVelocityPotential[nodeID];
                 }
+
+                RRMatrix R;
+                RRVector t;
+                this->pModel->getElement(elementID).findTransformationMatrix(this->pModel->getNodes(),R,t);
+
+                ve[0] += R[0][0]*vi + R[0][1]*vj;
+                ve[1] += R[1][0]*vi + R[1][1]*vj;
+                ve[2] += R[2][0]*vi + R[2][1]*vj;
             }
+
+            this->elementAcousticParticleVelocity.x[elementID] = ve[0];
+            this->elementAcousticParticleVelocity.y[elementID] = ve[1];
+            this->elementAcousticParticleVelocity.z[elementID] = ve[2];
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process acoustic particle velocity.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process acoustic particle velocity.");
+    }
 
     // Process volume elements.
-    for (uint i=0;i<this->pModel->getNVolumes();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->volumeElements.size());j++)
     {
-        RVolume &volume = this->pModel->getVolume(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = volume.get(j);
-
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix B(element.size(),3);
-                RR3Vector ve(0.0,0.0,0.0);
+            continue;
+        }
+        try
+        {
+            uint elementID = this->volumeElements.getElementID(j);
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix B(element.size(),3);
+            RR3Vector ve(0.0,0.0,0.0);
 
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]) * detJ / double(nInp);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]) * detJ / double(nInp);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]) * detJ / double(nInp);
-                    }
-                }
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                for (uint m=0;m<element.size();m++)
+                B.fill(0.0);
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    uint nodeId = element.getNodeId(m);
-                    ve[0] -= B[m][0] * this->nodeVelocityPotential[nodeId];
-                    ve[1] -= B[m][1] * this->nodeVelocityPotential[nodeId];
-                    ve[2] -= B[m][2] * this->nodeVelocityPotential[nodeId];
+                    B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]) * detJ / double(nInp);
+                    B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]) * detJ / double(nInp);
+                    B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]) * detJ / double(nInp);
                 }
-
-                this->elementAcousticParticleVelocity.x[elementID] = ve[0];
-                this->elementAcousticParticleVelocity.y[elementID] = ve[1];
-                this->elementAcousticParticleVelocity.z[elementID] = ve[2];
             }
-            catch (const RError &rError)
+
+            for (uint m=0;m<element.size();m++)
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                uint nodeId = element.getNodeId(m);
+                ve[0] -= B[m][0] * this->nodeVelocityPotential[nodeId];
+                ve[1] -= B[m][1] * this->nodeVelocityPotential[nodeId];
+                ve[2] -= B[m][2] * this->nodeVelocityPotential[nodeId];
             }
+
+            this->elementAcousticParticleVelocity.x[elementID] = ve[0];
+            this->elementAcousticParticleVelocity.y[elementID] = ve[1];
+            this->elementAcousticParticleVelocity.z[elementID] = ve[2];
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process acoustic particle velocity.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process acoustic particle velocity.");
+    }
 }
 
 void RSolverAcoustic::store(void)
@@ -1225,7 +1173,79 @@ std::vector<RR3Vector> RSolverAcoustic::findAbsorbingBoundaryNormals(const std::
     return normals;
 }
 
-void RSolverAcoustic::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMatrix &Ce, const RRMatrix &Ke, const RRVector &fe)
+void RSolverAcoustic::computeVolumeElement(unsigned int elementID, RRMatrix &Me, RRMatrix &Ke) const
+{
+    const RElement &element = this->pModel->getElement(elementID);
+    uint nInp = this->geometricFactors.getNPoints(elementID);
+
+    bool timeSolverEnabled = this->pModel->getTimeSolver().getEnabled();
+    double c2 = this->elementElasticityModulus[elementID]/this->elementDensity[elementID];
+
+    Me.fill(0.0);
+    Ke.fill(0.0);
+
+    for (uint k=0;k<nInp;k++)
+    {
+        const RRVector &N = RElement::getShapeFunction(element.getType(),k).getN();
+        const double *B = this->geometricFactors.getGradients(elementID,k);
+        double detJW = this->geometricFactors.getDetJW(elementID,k);
+
+        for (uint m=0;m<element.size();m++)
+        {
+            for (uint n=0;n<element.size();n++)
+            {
+                // Stiffness
+                Ke[m][n] += (B[3*m+0]*B[3*n+0] + B[3*m+1]*B[3*n+1] + B[3*m+2]*B[3*n+2]) * c2 * detJW;
+
+                // Mass
+                if (timeSolverEnabled)
+                {
+                    Me[m][n] += (-1.0) * N[m] * N[n] * detJW;
+                }
+            }
+        }
+    }
+}
+
+template <unsigned int nNodes, unsigned int nPoints>
+void RSolverAcoustic::computeVolumeElement(unsigned int elementID, RFixedMatrix<nNodes,nNodes> &Me, RFixedMatrix<nNodes,nNodes> &Ke) const
+{
+    const RElement &element = this->pModel->getElement(elementID);
+
+    R_ERROR_ASSERT(element.size() == nNodes);
+    R_ERROR_ASSERT(this->geometricFactors.getNPoints(elementID) == nPoints);
+
+    bool timeSolverEnabled = this->pModel->getTimeSolver().getEnabled();
+    double c2 = this->elementElasticityModulus[elementID]/this->elementDensity[elementID];
+
+    Me.fill(0.0);
+    Ke.fill(0.0);
+
+    for (unsigned int k=0;k<nPoints;k++)
+    {
+        const RRVector &N = RElement::getShapeFunction(element.getType(),k).getN();
+        const double *B = this->geometricFactors.getGradients(elementID,k);
+        double detJW = this->geometricFactors.getDetJW(elementID,k);
+
+        for (unsigned int m=0;m<nNodes;m++)
+        {
+            for (unsigned int n=0;n<nNodes;n++)
+            {
+                // Stiffness
+                Ke[m][n] += (B[3*m+0]*B[3*n+0] + B[3*m+1]*B[3*n+1] + B[3*m+2]*B[3*n+2]) * c2 * detJW;
+
+                // Mass
+                if (timeSolverEnabled)
+                {
+                    Me[m][n] += (-1.0) * N[m] * N[n] * detJW;
+                }
+            }
+        }
+    }
+}
+
+template <class TMatrix, class TVector>
+void RSolverAcoustic::assemblyMatrix(uint elementID, const TMatrix &Me, const TMatrix &Ce, const TMatrix &Ke, const TVector &fe)
 {
     double alpha = 1.0 / 2.0;
     double beta = this->pModel->getTimeSolver().getTimeMarchApproximationCoefficient() / 2.0;
@@ -1233,8 +1253,8 @@ void RSolverAcoustic::assemblyMatrix(uint elementID, const RRMatrix &Me, const R
 
     const RElement &element = this->pModel->getElement(elementID);
 
-    RRMatrix Ae(element.size(),element.size());
-    RRVector be(element.size());
+    TMatrix Ae(Ke);
+    TVector be(fe);
 
     Ae.fill(0.0);
     be.fill(0.0);
@@ -1246,6 +1266,18 @@ void RSolverAcoustic::assemblyMatrix(uint elementID, const RRMatrix &Me, const R
     double a4 = (alpha / beta) - 1.0;
     double a5 = (1.0 / 2.0) * dt * ((alpha / beta) - 2.0);
 
+    // Volume element matrix is applied by matrix-free operator.
+    bool assembleMatrix = !(this->getMatrixFree() && R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+
+    if (!assembleMatrix)
+    {
+        this->elementOperatorStiffness[elementID] = this->elementElasticityModulus[elementID] / this->elementDensity[elementID];
+        if (this->pModel->getTimeSolver().getEnabled())
+        {
+            this->elementOperatorMass[elementID] = -a0;
+        }
+    }
+
     if (this->pModel->getTimeSolver().getEnabled())
     {
         for (uint m=0;m<element.size();m++)
@@ -1295,7 +1327,7 @@ void RSolverAcoustic::assemblyMatrix(uint elementID, const RRMatrix &Me, const R
             {
                 uint np = 0;
 
-                if (this->nodeBook.getValue(element.getNodeId(n),np))
+                if (assembleMatrix && this->nodeBook.getValue(element.getNodeId(n),np))
                 {
                     this->A.addValue(mp,np,Ae[m][n]);
                 }
@@ -56,6 +56,20 @@ bool RSolverElectrostatics::hasConverged(void) const
     return true;
 }
 
+void RSolverElectrostatics::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RFileIO::writeBinary(outFile,this->nodeElectricPotential,true);
+}
+
+void RSolverElectrostatics::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RFileIO::readBinary(inFile,this->nodeElectricPotential,true);
+}
+
 void RSolverElectrostatics::updateScales(void)
 {
 
@@ -88,316 +102,257 @@ void RSolverElectrostatics::prepare(void)
     this->generateMaterialVecor(R_MATERIAL_PROPERTY_RELATIVE_PERMITTIVITY,this->elementRelativePermittivity);
     this->generateMaterialVecor(R_MATERIAL_PROPERTY_ELECTRICAL_CONDUCTIVITY,this->elementElectricConductivity);
 
-    this->pModel->convertElementToNodeVector(elementElectricPotential,electricPotentialSetValues,this->nodeElectricPotential,true);
+    this->nodeElementIncidence.convertElementToNode(elementElectricPotential,electricPotentialSetValues,this->nodeElectricPotential,true);
 
     this->b.resize(this->nodeBook.getNEnabled());
-    this->x.resize(this->nodeBook.getNEnabled());
 
     this->A.clear();
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(this->nodeBook.getNEnabled());
+    this->updateGeometricFactors();
 
     // Prepare point elements.
-    for (uint i=0;i<this->pModel->getNPoints();i++)
+    bool abort = false;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->pointElements.size());j++)
     {
-        RPoint &point = this->pModel->getPoint(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(point.size());j++)
+        try
         {
-            try
-            {
-                uint elementID = point.get(j);
+            uint elementID = this->pointElements.getElementID(j);
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
 
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
 
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                    for (unsigned m=0;m<element.size();m++)
-                    {
-                        // Force
-                        fe[m] += elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
-                    }
-                }
-                #pragma omp critical
+                for (unsigned m=0;m<element.size();m++)
                 {
-                    this->assemblyMatrix(elementID,Ke,fe);
+                    // Force
+                    fe[m] += elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare line elements.
-    for (uint i=0;i<this->pModel->getNLines();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->lineElements.size());j++)
     {
-        RLine &line = this->pModel->getLine(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        try
         {
-            try
-            {
-                uint elementID = line.get(j);
+            uint elementID = this->lineElements.getElementID(j);
+            const RLine &line = this->pModel->getLine(this->lineElements.getEntityID(j));
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+            RRMatrix B(element.size(),1);
 
-                RRMatrix B(element.size(),1);
+            Ke.fill(0.0);
+            fe.fill(0.0);
 
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                for (uint k=0;k<nInp;k++)
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += dN[m][0]*J[0][0];
-                    }
+                    B[m][0] += dN[m][0]*J[0][0];
+                }
 
-                    for (unsigned m=0;m<element.size();m++)
+                for (unsigned m=0;m<element.size();m++)
+                {
+                    for (unsigned n=0;n<element.size();n++)
                     {
-                        for (unsigned n=0;n<element.size();n++)
-                        {
-                            // Conduction
-                            Ke[m][n] += B[m][0] * B[n][0]
-                                     * this->elementRelativePermittivity[elementID]
-                                     * RSolverGeneric::e0
-                                     * detJ
-                                     * shapeFunc.getW()
-                                     * line.getCrossArea();
-                        }
-                        // Force
-                        fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
+                        // Conduction
+                        Ke[m][n] += B[m][0] * B[n][0]
+                                 * this->elementRelativePermittivity[elementID]
+                                 * RSolverGeneric::e0
+                                 * detJ
+                                 * shapeFunc.getW()
+                                 * line.getCrossArea();
                     }
-                }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Ke,fe);
+                    // Force
+                    fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare surface elements.
-    for (uint i=0;i<this->pModel->getNSurfaces();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->surfaceElements.size());j++)
     {
-        RSurface &surface = this->pModel->getSurface(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+        try
         {
-            try
-            {
-                uint elementID = surface.get(j);
+            uint elementID = this->surfaceElements.getElementID(j);
+            const RSurface &surface = this->pModel->getSurface(this->surfaceElements.getEntityID(j));
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
+            RRMatrix B(element.size(),2);
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),2);
+            Ke.fill(0.0);
+            fe.fill(0.0);
 
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                for (uint k=0;k<nInp;k++)
+                B.fill(0.0);
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
-                    }
+                    B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
+                    B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
+                }
 
-                    for (unsigned m=0;m<element.size();m++)
+                for (unsigned m=0;m<element.size();m++)
+                {
+                    for (unsigned n=0;n<element.size();n++)
                     {
-                        for (unsigned n=0;n<element.size();n++)
-                        {
-                            // Conduction
-                            Ke[m][n] += (B[m][0] * B[n][0] + B[m][1] * B[n][1])
-                                     * this->elementRelativePermittivity[elementID]
-                                     * RSolverGeneric::e0
-                                     * surface.getThickness()
-                                     * detJ
-                                     * shapeFunc.getW();
-                        }
-                        // Force
-                        fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
+                        // Conduction
+                        Ke[m][n] += (B[m][0] * B[n][0] + B[m][1] * B[n][1])
+                                 * this->elementRelativePermittivity[elementID]
+                                 * RSolverGeneric::e0
+                                 * surface.getThickness()
+                                 * detJ
+                                 * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Ke,fe);
+                    // Force
+                    fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare volume elements.
-    for (uint i=0;i<this->pModel->getNVolumes();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->volumeElements.size());j++)
     {
-        RVolume &volume = this->pModel->getVolume(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = volume.get(j);
-
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),3);
+            continue;
+        }
+        try
+        {
+            uint elementID = this->volumeElements.getElementID(j);
 
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
 
-                // Conduction
-                for (uint k=0;k<nInp;k++)
+            switch (element.getType())
+            {
+                case R_ELEMENT_TETRA1:
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
-                    }
-
-                    for (unsigned m=0;m<element.size();m++)
+                    RFixedMatrix<4,4> Ke;
+                    RFixedVector<4> fe;
+                    this->computeVolumeElement<4,4>(elementID,elementChargeDensity[elementID],Ke,fe);
+                    #pragma omp critical
                     {
-                        for (unsigned n=0;n<element.size();n++)
-                        {
-                            // Conduction
-                            Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
-                                     * this->elementRelativePermittivity[elementID]
-                                     * RSolverGeneric::e0
-                                     * detJ
-                                     * shapeFunc.getW();
-                        }
-                        // Force
-                        fe[m] -= elementChargeDensity[elementID] * N[m] * detJ * shapeFunc.getW();
+                        this->assemblyMatrix(elementID,Ke,fe);
                     }
+                    break;
                 }
-                #pragma omp critical
+                default:
                 {
-                    this->assemblyMatrix(elementID,Ke,fe);
-                }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    RRMatrix Ke(element.size(),element.size());
+                    RRVector fe(element.size());
+                    this->computeVolumeElement(elementID,elementChargeDensity[elementID],Ke,fe);
+                    #pragma omp critical
+                    {
+                        this->assemblyMatrix(elementID,Ke,fe);
+                    }
+                    break;
                 }
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 }
 
 void RSolverElectrostatics::solve(void)
@@ -406,7 +361,7 @@ void RSolverElectrostatics::solve(void)
     {
         RLogger::indent();
         RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1,&this->matrixDeflation);
         RLogger::unindent();
     }
     catch (RError error)
@@ -825,12 +780,76 @@ void RSolverElectrostatics::statistics(void)
     this->processMonitoringPoints();
 }
 
-void RSolverElectrostatics::assemblyMatrix(unsigned int elementID, const RRMatrix &Ke, const RRVector &fe)
+void RSolverElectrostatics::computeVolumeElement(unsigned int elementID, double chargeDensity, RRMatrix &Ke, RRVector &fe) const
+{
+    const RElement &element = this->pModel->getElement(elementID);
+    uint nInp = this->geometricFactors.getNPoints(elementID);
+
+    Ke.fill(0.0);
+    fe.fill(0.0);
+
+    for (uint k=0;k<nInp;k++)
+    {
+        const RRVector &N = RElement::getShapeFunction(element.getType(),k).getN();
+        const double *B = this->geometricFactors.getGradients(elementID,k);
+        double detJW = this->geometricFactors.getDetJW(elementID,k);
+
+        for (uint m=0;m<element.size();m++)
+        {
+            for (uint n=0;n<element.size();n++)
+            {
+                // Conduction
+                Ke[m][n] += (B[3*m+0]*B[3*n+0] + B[3*m+1]*B[3*n+1] + B[3*m+2]*B[3*n+2])
+                         * this->elementRelativePermittivity[elementID]
+                         * RSolverGeneric::e0
+                         * detJW;
+            }
+            // Force
+            fe[m] -= chargeDensity * N[m] * detJW;
+        }
+    }
+}
+
+template <unsigned int nNodes, unsigned int nPoints>
+void RSolverElectrostatics::computeVolumeElement(unsigned int elementID, double chargeDensity, RFixedMatrix<nNodes,nNodes> &Ke, RFixedVector<nNodes> &fe) const
+{
+    const RElement &element = this->pModel->getElement(elementID);
+
+    R_ERROR_ASSERT(element.size() == nNodes);
+    R_ERROR_ASSERT(this->geometricFactors.getNPoints(elementID) == nPoints);
+
+    Ke.fill(0.0);
+    fe.fill(0.0);
+
+    for (unsigned int k=0;k<nPoints;k++)
+    {
+        const RRVector &N = RElement::getShapeFunction(element.getType(),k).getN();
+        const double *B = this->geometricFactors.getGradients(elementID,k);
+        double detJW = this->geometricFactors.getDetJW(elementID,k);
+
+        for (unsigned int m=0;m<nNodes;m++)
+        {
+            for (unsigned int n=0;n<nNodes;n++)
+            {
+                // Conduction
+                Ke[m][n] += (B[3*m+0]*B[3*n+0] + B[3*m+1]*B[3*n+1] + B[3*m+2]*B[3*n+2])
+                         * this->elementRelativePermittivity[elementID]
+                         * RSolverGeneric::e0
+                         * detJW;
+            }
+            // Force
+            fe[m] -= chargeDensity * N[m] * detJW;
+        }
+    }
+}
+
+template <class TMatrix, class TVector>
+void RSolverElectrostatics::assemblyMatrix(unsigned int elementID, const TMatrix &Ke, const TVector &fe)
 {
     const RElement &element = this->pModel->getElement(elementID);
 
-    RRMatrix Ae(Ke);
-    RRVector be(fe);
+    TMatrix Ae(Ke);
+    TVector be(fe);
 
     // Apply explicit boundary conditions.
     for (uint m=0;m<element.size();m++)
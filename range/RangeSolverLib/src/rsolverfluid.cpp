@@ -15,6 +15,9 @@
 
 static const double inv6 = 1.0 / 6.0;
 
+//! Maximum number of segregated solver iterations per matrix solve.
+#define R_SOLVER_FLUID_SEGREGATED_MAX_ITERATIONS 10
+
 class FluidMatrixContainer
 {
     public:
@@ -187,6 +190,11 @@ void RSolverFluid::_init(const RSolverFluid *pSolver)
         this->avgU = pSolver->avgU;
         this->cvgV = pSolver->cvgV;
         this->cvgP = pSolver->cvgP;
+        this->pressureLaplacian = pSolver->pressureLaplacian;
+        this->pressureMass = pSolver->pressureMass;
+        this->pressureNodeIDs = pSolver->pressureNodeIDs;
+        this->saddlePointMatrix = pSolver->saddlePointMatrix;
+        this->segregatedMatrix = pSolver->segregatedMatrix;
     }
     else
     {
@@ -237,6 +245,38 @@ bool RSolverFluid::hasConverged(void) const
     return false;
 }
 
+void RSolverFluid::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RFileIO::writeBinary(outFile,this->nodePressure,true);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeVelocity);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeVelocityOld);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeAcceleration);
+    RFileIO::writeBinary(outFile,this->streamVelocity);
+    RFileIO::writeBinary(outFile,this->invStreamVelocity);
+    RFileIO::writeBinary(outFile,this->avgRo);
+    RFileIO::writeBinary(outFile,this->avgU);
+    RFileIO::writeBinary(outFile,this->cvgV);
+    RFileIO::writeBinary(outFile,this->cvgP);
+}
+
+void RSolverFluid::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RFileIO::readBinary(inFile,this->nodePressure,true);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeVelocity);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeVelocityOld);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeAcceleration);
+    RFileIO::readBinary(inFile,this->streamVelocity);
+    RFileIO::readBinary(inFile,this->invStreamVelocity);
+    RFileIO::readBinary(inFile,this->avgRo);
+    RFileIO::readBinary(inFile,this->avgU);
+    RFileIO::readBinary(inFile,this->cvgV);
+    RFileIO::readBinary(inFile,this->cvgP);
+}
+
 void RSolverFluid::updateScales(void)
 {
     this->nodeVelocity.x.resize(this->pModel->getNNodes(),0.0);
@@ -319,10 +359,9 @@ void RSolverFluid::prepare(void)
         this->findInputVectors();
     }
 
-    this->pModel->convertNodeToElementVector(this->nodePressure,this->elementPressure);
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.x,this->elementVelocity.x);
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.y,this->elementVelocity.y);
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.z,this->elementVelocity.z);
+    this->nodeElementIncidence.convertNodeToElement(*this->pModel,
+                                                    {&this->nodePressure,&this->nodeVelocity.x,&this->nodeVelocity.y,&this->nodeVelocity.z},
+                                                    {&this->elementPressure,&this->elementVelocity.x,&this->elementVelocity.y,&this->elementVelocity.z});
 
     if (this->meshChanged)
     {
@@ -340,14 +379,30 @@ void RSolverFluid::prepare(void)
     RBVector elementFreePressureSetValues;
     this->computeElementFreePressure(elementFreePressure,elementFreePressureSetValues);
 
+    bool segregated = this->pModel->getProblemSetup().getSegregated(this->problemType);
+
+    std::vector<uint> blockIDs;
+    std::vector<uint> pressureNodeIDs;
+    this->findUnknownBlocks(blockIDs,pressureNodeIDs);
+
     this->b.resize(this->nodeBook.getNEnabled());
-    this->x.resize(this->nodeBook.getNEnabled());
 
     this->A.clear();
-    this->A.setNRows(this->nodeBook.getNEnabled());
-    this->A.reserveNColumns(100);
+    if (segregated)
+    {
+        // Matrix system is assembled directly into blocks.
+        this->saddlePointMatrix = RSaddlePointMatrix();
+        this->buildSegregatedMatrix(blockIDs);
+    }
+    else
+    {
+        this->segregatedMatrix = RSegregatedMatrix();
+        this->A.setNRows(this->nodeBook.getNEnabled());
+        this->A.reserveNColumns(100);
+        this->buildSaddlePointMatrix(blockIDs);
+    }
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(this->nodeBook.getNEnabled());
 
     bool abort = false;
 
@@ -458,6 +513,8 @@ void RSolverFluid::prepare(void)
         throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
     }
 
+    this->updatePressureMatrix(pressureNodeIDs,segregated);
+
     RLogger::unindent();
 }
 
@@ -472,8 +529,14 @@ void RSolverFluid::solve(void)
     try
     {
         RLogger::indent();
-        RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        if (this->pModel->getProblemSetup().getSegregated(this->problemType))
+        {
+            this->solveSegregated();
+        }
+        else
+        {
+            this->solveCoupled();
+        }
         RLogger::unindent();
     }
     catch (RError error)
@@ -576,6 +639,373 @@ void RSolverFluid::solve(void)
     RLogger::unindent();
 }
 
+void RSolverFluid::findUnknownBlocks(std::vector<uint> &blockIDs, std::vector<uint> &pressureNodeIDs) const
+{
+    uint nUnknowns = this->nodeBook.getNEnabled();
+
+    // Block of each unknown is given by its component (velocity x, y, z and pressure).
+    blockIDs.assign(nUnknowns,0);
+    std::vector<uint> unknownNodeIDs(nUnknowns,RConstants::eod);
+    for (uint i=0;i<this->pModel->getNNodes();i++)
+    {
+        for (uint j=0;j<4;j++)
+        {
+            uint position = 0;
+            if (this->nodeBook.getValue(4*i+j,position))
+            {
+                blockIDs[position] = j;
+                unknownNodeIDs[position] = i;
+            }
+        }
+    }
+
+    // Pressure unknowns keep their relative order.
+    pressureNodeIDs.clear();
+    for (uint i=0;i<nUnknowns;i++)
+    {
+        if (blockIDs[i] == 3)
+        {
+            pressureNodeIDs.push_back(unknownNodeIDs[i]);
+        }
+    }
+}
+
+void RSolverFluid::buildSaddlePointMatrix(const std::vector<uint> &blockIDs)
+{
+    // Pressure unknowns form second block.
+    std::vector<bool> pressureUnknowns(blockIDs.size(),false);
+    for (uint i=0;i<blockIDs.size();i++)
+    {
+        pressureUnknowns[i] = (blockIDs[i] == 3);
+    }
+
+    if (!this->saddlePointMatrix.isBuilt(pressureUnknowns))
+    {
+        this->saddlePointMatrix.build(pressureUnknowns);
+    }
+    this->saddlePointMatrix.setMatrix(this->A);
+}
+
+void RSolverFluid::buildSegregatedMatrix(const std::vector<uint> &blockIDs)
+{
+    if (this->segregatedMatrix.isBuilt(blockIDs,4))
+    {
+        this->segregatedMatrix.clearValues();
+        return;
+    }
+
+    // Couplings between velocity components are not stored.
+    std::vector<bool> keptBlocks(16,false);
+    for (uint i=0;i<4;i++)
+    {
+        keptBlocks[4*i+i] = true;
+        keptBlocks[4*i+3] = true;
+        keptBlocks[4*3+i] = true;
+    }
+
+    this->segregatedMatrix.build(blockIDs,4,keptBlocks);
+}
+
+void RSolverFluid::solveCoupled(void)
+{
+    const RSaddlePointMatrix &saddlePointMatrix = this->saddlePointMatrix;
+
+    const RMatrixSolverConf &matrixSolverConf = this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES);
+
+    RMatrixSolver matrixSolver(matrixSolverConf);
+
+    if (!matrixSolverConf.getSaddlePointPreconditioner() || saddlePointMatrix.getN1() == 0 || saddlePointMatrix.getN2() == 0)
+    {
+        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        return;
+    }
+
+    uint nDomains = std::max(matrixSolverConf.getNDomains(),uint(omp_get_max_threads()));
+
+    RLogger::info("Block triangular preconditioner (velocity unknowns = %u, pressure unknowns = %u)\n",saddlePointMatrix.getN1(),saddlePointMatrix.getN2());
+    RSaddlePointPreconditioner P(saddlePointMatrix,this->pressureMass,nDomains);
+
+    matrixSolver.solve(this->A,this->b,this->x,P);
+}
+
+void RSolverFluid::solveSegregated(void)
+{
+    const RSegregatedMatrix &segregatedMatrix = this->segregatedMatrix;
+
+    uint nv = segregatedMatrix.getN(0) + segregatedMatrix.getN(1) + segregatedMatrix.getN(2);
+    uint np = segregatedMatrix.getN(3);
+
+    RLogger::info("Segregated solver (velocity unknowns = %u, pressure unknowns = %u)\n",nv,np);
+
+    // Velocity components x, y, z are blocks 0, 1, 2 and pressure is block 3.
+    std::vector<RRVector> xb, bb;
+    segregatedMatrix.split(this->x,xb);
+    segregatedMatrix.split(this->b,bb);
+    RRVector &p = xb[3];
+
+    std::vector<RRVector> d(3), r(4), t(3), q(3), dv(3);
+    for (uint c=0;c<3;c++)
+    {
+        uint nc = segregatedMatrix.getN(c);
+        const RSparseMatrix &K = segregatedMatrix.getBlock(c,c);
+
+        d[c].resize(nc);
+        for (uint i=0;i<nc;i++)
+        {
+            d[c][i] = K.findValue(i,i);
+        }
+        r[c].resize(nc,0.0);
+        t[c].resize(nc,0.0);
+        q[c].resize(np,0.0);
+        dv[c].resize(nc,0.0);
+    }
+    r[3].resize(np,0.0);
+
+    // Schur complement diagonal: C_ii - sum_c D_c*diag(K_c)^-1*G_c
+    RRVector ds(np,0.0);
+    const RSparseMatrix &C = segregatedMatrix.getBlock(3,3);
+    #pragma omp parallel for default(shared)
+    for (int64_t i=0;i<int64_t(np);i++)
+    {
+        double value = C.findValue(uint(i),uint(i));
+        for (uint c=0;c<3;c++)
+        {
+            const RSparseMatrix &D = segregatedMatrix.getBlock(3,c);
+            const RSparseMatrix &G = segregatedMatrix.getBlock(c,3);
+            for (uint j=0;j<D.getNColumns(uint(i));j++)
+            {
+                uint k = D.getColumnIndex(uint(i),j);
+                if (d[c][k] != 0.0)
+                {
+                    value -= D.getValue(uint(i),j) * G.findValue(k,uint(i)) / d[c][k];
+                }
+            }
+        }
+        ds[i] = value;
+    }
+
+    // Pressure Laplacian is scaled to Schur complement diagonal: S ~ sign*W*L*W
+    RRVector w;
+    double sign = RSaddlePointMatrix::findSchurScales(ds,this->pressureLaplacian,w);
+
+    RMatrixSolver velocitySolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES));
+    RMatrixSolver pressureSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
+
+    double cvgValue = this->pModel->getMatrixSolverConf(RMatrixSolverConf::GMRES).getSolverCvgValue();
+    double bn = RRVector::norm(this->b);
+
+    RRVector dp(np,0.0), y(np,0.0);
+
+    for (uint it=0;;it++)
+    {
+        // Residuals of momentum and continuity equations.
+        #pragma omp parallel default(shared)
+        {
+            for (uint c=0;c<3;c++)
+            {
+                segregatedMatrix.multiply(c,c,xb[c],r[c]);
+                segregatedMatrix.multiply(c,3,p,t[c]);
+                segregatedMatrix.multiply(3,c,xb[c],q[c]);
+            }
+            segregatedMatrix.multiply(3,3,p,r[3]);
+        }
+        double rn = 0.0;
+        for (uint c=0;c<3;c++)
+        {
+            for (uint i=0;i<r[c].size();i++)
+            {
+                r[c][i] = bb[c][i] - r[c][i] - t[c][i];
+                rn += r[c][i] * r[c][i];
+            }
+        }
+        for (uint i=0;i<np;i++)
+        {
+            r[3][i] = bb[3][i] - r[3][i] - q[0][i] - q[1][i] - q[2][i];
+            rn += r[3][i] * r[3][i];
+        }
+        rn = std::sqrt(rn);
+
+        RLogger::info("Segregated iteration %u: residual = %13e\n",it+1,(bn > 0.0) ? rn / bn : rn);
+        if (rn <= cvgValue * bn)
+        {
+            break;
+        }
+        if (it == R_SOLVER_FLUID_SEGREGATED_MAX_ITERATIONS)
+        {
+            RLogger::warning("Segregated solver did not converge in %u iterations: residual = %13e\n",
+                             uint(R_SOLVER_FLUID_SEGREGATED_MAX_ITERATIONS),(bn > 0.0) ? rn / bn : rn);
+            break;
+        }
+
+        // Momentum predictor, each velocity component is solved separately.
+        for (uint c=0;c<3;c++)
+        {
+            if (dv[c].size() == 0)
+            {
+                continue;
+            }
+            RLogger::indent();
+            dv[c].fill(0.0);
+            velocitySolver.solve(segregatedMatrix.getBlock(c,c),r[c],dv[c],R_MATRIX_PRECONDITIONER_JACOBI,1);
+            RLogger::unindent();
+            for (uint i=0;i<dv[c].size();i++)
+            {
+                xb[c][i] += dv[c][i];
+            }
+        }
+
+        if (np == 0)
+        {
+            continue;
+        }
+
+        // Pressure correction.
+        #pragma omp parallel default(shared)
+        {
+            for (uint c=0;c<3;c++)
+            {
+                segregatedMatrix.multiply(3,c,xb[c],q[c]);
+            }
+            segregatedMatrix.multiply(3,3,p,r[3]);
+        }
+        for (uint i=0;i<np;i++)
+        {
+            y[i] = (bb[3][i] - r[3][i] - q[0][i] - q[1][i] - q[2][i]) / w[i];
+        }
+        RLogger::indent();
+        dp.fill(0.0);
+        pressureSolver.solve(this->pressureLaplacian,y,dp,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        RLogger::unindent();
+        for (uint i=0;i<np;i++)
+        {
+            dp[i] *= sign / w[i];
+            p[i] += dp[i];
+        }
+
+        // Velocity correction.
+        #pragma omp parallel default(shared)
+        {
+            for (uint c=0;c<3;c++)
+            {
+                segregatedMatrix.multiply(c,3,dp,t[c]);
+            }
+        }
+        for (uint c=0;c<3;c++)
+        {
+            for (uint i=0;i<t[c].size();i++)
+            {
+                if (d[c][i] != 0.0)
+                {
+                    xb[c][i] -= t[c][i] / d[c][i];
+                }
+            }
+        }
+    }
+
+    segregatedMatrix.merge(xb,this->x);
+}
+
+void RSolverFluid::updatePressureMatrix(const std::vector<uint> &pressureNodeIDs, bool laplacian)
+{
+    RSparseMatrix &matrix = laplacian ? this->pressureLaplacian : this->pressureMass;
+
+    // Only one pressure matrix is needed at a time.
+    (laplacian ? this->pressureMass : this->pressureLaplacian).clear();
+
+    if (!this->meshChanged && this->pressureNodeIDs == pressureNodeIDs && matrix.getNRows() == pressureNodeIDs.size())
+    {
+        return;
+    }
+
+    this->pressureNodeIDs = pressureNodeIDs;
+    this->assemblePressureMatrix(laplacian,matrix);
+}
+
+void RSolverFluid::assemblePressureMatrix(bool laplacian, RSparseMatrix &matrix) const
+{
+    RLogger::info("Assembling pressure %s matrix\n",laplacian ? "Laplacian" : "mass");
+
+    uint np = uint(this->pressureNodeIDs.size());
+
+    std::vector<uint> nodeRows(this->pModel->getNNodes(),RConstants::eod);
+    for (uint i=0;i<np;i++)
+    {
+        nodeRows[this->pressureNodeIDs[i]] = i;
+    }
+
+    matrix.clear();
+    matrix.setNRows(np);
+
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t i=0;i<int64_t(this->pModel->getNElements());i++)
+    {
+        uint elementID = uint(i);
+        const RElement &element = this->pModel->getElement(elementID);
+
+        if (!R_ELEMENT_TYPE_IS_VOLUME(element.getType()) || !this->computableElements[elementID] || !this->shapeDerivations[elementID])
+        {
+            continue;
+        }
+
+        uint nen = element.size();
+        uint nInp = RElement::getNIntegrationPoints(element.getType());
+
+        RRMatrix Me(nen,nen,0.0);
+
+        for (uint intPoint=0;intPoint<nInp;intPoint++)
+        {
+            const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),intPoint);
+            const RRVector &N = shapeFunc.getN();
+            const RRMatrix &B = this->shapeDerivations[elementID]->getDerivative(intPoint);
+            double integValue = this->shapeDerivations[elementID]->getJacobian(intPoint) * shapeFunc.getW();
+
+            for (uint m=0;m<nen;m++)
+            {
+                for (uint n=0;n<nen;n++)
+                {
+                    if (laplacian)
+                    {
+                        Me[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2]) * integValue;
+                    }
+                    else
+                    {
+                        Me[m][n] += N[m] * N[n] * integValue;
+                    }
+                }
+            }
+        }
+
+        #pragma omp critical
+        {
+            for (uint m=0;m<nen;m++)
+            {
+                uint row = nodeRows[element.getNodeId(m)];
+                if (row == RConstants::eod)
+                {
+                    continue;
+                }
+                for (uint n=0;n<nen;n++)
+                {
+                    uint column = nodeRows[element.getNodeId(n)];
+                    if (column != RConstants::eod)
+                    {
+                        matrix.addValue(row,column,Me[m][n]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Pressure unknowns without volume element contribution.
+    for (uint i=0;i<np;i++)
+    {
+        if (matrix.findValue(i,i) == 0.0)
+        {
+            matrix.addValue(i,i,1.0);
+        }
+    }
+}
+
 void RSolverFluid::process(void)
 {
 
@@ -957,10 +1387,11 @@ void RSolverFluid::findInputVectors(void)
     this->generateVariableVector(R_VARIABLE_G_ACCELERATION_Y,this->elementGravity.y,elementGravitySetValues,true,true,true);
     this->generateVariableVector(R_VARIABLE_G_ACCELERATION_Z,this->elementGravity.z,elementGravitySetValues,true,true,true);
 
-    this->pModel->convertElementToNodeVector(this->elementVelocity.x,elementVelocitySetValues,this->nodeVelocity.x,true);
-    this->pModel->convertElementToNodeVector(this->elementVelocity.y,elementVelocitySetValues,this->nodeVelocity.y,true);
-    this->pModel->convertElementToNodeVector(this->elementVelocity.z,elementVelocitySetValues,this->nodeVelocity.z,true);
-    this->pModel->convertElementToNodeVector(this->elementPressure,elementPressureSetValues,this->nodePressure,true);
+    this->nodeElementIncidence.convertElementToNode({&this->elementVelocity.x,&this->elementVelocity.y,&this->elementVelocity.z},
+                                                    elementVelocitySetValues,
+                                                    {&this->nodeVelocity.x,&this->nodeVelocity.y,&this->nodeVelocity.z},
+                                                    true);
+    this->nodeElementIncidence.convertElementToNode(this->elementPressure,elementPressureSetValues,this->nodePressure,true);
 
     for (uint i=0;i<this->pModel->getNElements();i++)
     {
@@ -2377,6 +2808,8 @@ void RSolverFluid::assemblyMatrix(uint elementID, const RRMatrix &Ae, const RRVe
 {
     const RElement &rElement = this->pModel->getElement(elementID);
 
+    bool segregated = this->pModel->getProblemSetup().getSegregated(this->problemType);
+
     // Assembly final matrix system
     uint dims = 4;
     for (uint m=0;m<rElement.size();m++)
@@ -2399,7 +2832,14 @@ void RSolverFluid::assemblyMatrix(uint elementID, const RRMatrix &Ae, const RRVe
 
                             if (this->nodeBook.getValue(dims*rElement.getNodeId(n)+j,np))
                             {
-                                this->A.addValue(mp,np,Ae[dims*m+i][dims*n+j]);
+                                if (segregated)
+                                {
+                                    this->segregatedMatrix.addValue(mp,np,Ae[dims*m+i][dims*n+j]);
+                                }
+                                else
+                                {
+                                    this->A.addValue(mp,np,Ae[dims*m+i][dims*n+j]);
+                                }
                             }
                         }
                     }
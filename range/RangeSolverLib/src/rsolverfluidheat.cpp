@@ -114,6 +114,28 @@ bool RSolverFluidHeat::hasConverged(void) const
     return true;
 }
 
+void RSolverFluidHeat::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RFileIO::writeBinary(outFile,this->nodeTemperature,true);
+    RFileIO::writeBinary(outFile,this->nodeHeat,true);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeVelocity);
+    RFileIO::writeBinary(outFile,this->streamVelocity);
+    RFileIO::writeBinary(outFile,this->cvgT);
+}
+
+void RSolverFluidHeat::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RFileIO::readBinary(inFile,this->nodeTemperature,true);
+    RFileIO::readBinary(inFile,this->nodeHeat,true);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeVelocity);
+    RFileIO::readBinary(inFile,this->streamVelocity);
+    RFileIO::readBinary(inFile,this->cvgT);
+}
+
 double RSolverFluidHeat::findTemperatureScale(void) const
 {
     return 1.0;
@@ -125,7 +147,7 @@ void RSolverFluidHeat::generateNodeHeatVector(void)
     this->generateVariableVector(R_VARIABLE_HEAT,this->elementHeat,heatSetValues,true,this->firstRun,this->firstRun);
 
     this->nodeHeat.fill(0.0); // Heat on node is meant as an input - needs to be cleared
-    this->pModel->convertElementToNodeVector(this->elementHeat,heatSetValues,this->nodeHeat,true);
+    this->nodeElementIncidence.convertElementToNode(this->elementHeat,heatSetValues,this->nodeHeat,true);
 
     RRVector qv(this->pModel->getNElements(),0.0);
     RUVector qc(this->pModel->getNElements(),0);
@@ -217,22 +239,21 @@ void RSolverFluidHeat::prepare(void)
 
     this->generateNodeHeatVector();
 
-    this->pModel->convertElementToNodeVector(this->elementTemperature,temperatureSetValues,this->nodeTemperature,true);
+    this->nodeElementIncidence.convertElementToNode(this->elementTemperature,temperatureSetValues,this->nodeTemperature,true);
 
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.x,this->elementVelocity.x);
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.y,this->elementVelocity.y);
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.z,this->elementVelocity.z);
+    this->nodeElementIncidence.convertNodeToElement(*this->pModel,
+                                                    {&this->nodeVelocity.x,&this->nodeVelocity.y,&this->nodeVelocity.z},
+                                                    {&this->elementVelocity.x,&this->elementVelocity.y,&this->elementVelocity.z});
 
     this->computeShapeDerivatives();
     this->streamVelocity = RSolverFluid::computeStreamVelocity(*this->pModel,this->nodeVelocity,false);
 
     this->b.resize(this->nodeBook.getNEnabled());
-    this->x.resize(this->nodeBook.getNEnabled());
 
     this->A.clear();
     this->A.setNRows(this->nodeBook.getNEnabled());
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(this->nodeBook.getNEnabled());
 
     bool abort = false;
 
@@ -114,13 +114,35 @@ bool RSolverFluidParticle::hasConverged(void) const
     return true;
 }
 
+void RSolverFluidParticle::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RFileIO::writeBinary(outFile,this->nodeConcentration,true);
+    RFileIO::writeBinary(outFile,this->nodeRate,true);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeVelocity);
+    RFileIO::writeBinary(outFile,this->streamVelocity);
+    RFileIO::writeBinary(outFile,this->cvgC);
+}
+
+void RSolverFluidParticle::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RFileIO::readBinary(inFile,this->nodeConcentration,true);
+    RFileIO::readBinary(inFile,this->nodeRate,true);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeVelocity);
+    RFileIO::readBinary(inFile,this->streamVelocity);
+    RFileIO::readBinary(inFile,this->cvgC);
+}
+
 void RSolverFluidParticle::generateNodeRateVector(void)
 {
     RBVector rateSetValues;
     this->generateVariableVector(R_VARIABLE_PARTICLE_RATE,this->elementRate,rateSetValues,true,this->firstRun,this->firstRun);
 
     this->nodeRate.fill(0.0); // Particle rate on node is meant as an input - needs to be cleared
-    this->pModel->convertElementToNodeVector(this->elementRate,rateSetValues,this->nodeRate,true);
+    this->nodeElementIncidence.convertElementToNode(this->elementRate,rateSetValues,this->nodeRate,true);
 }
 
 void RSolverFluidParticle::updateScales(void)
@@ -169,22 +191,21 @@ void RSolverFluidParticle::prepare(void)
 
     this->generateNodeRateVector();
 
-    this->pModel->convertElementToNodeVector(this->elementConcentration,concentrationSetValues,this->nodeConcentration,true);
+    this->nodeElementIncidence.convertElementToNode(this->elementConcentration,concentrationSetValues,this->nodeConcentration,true);
 
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.x,this->elementVelocity.x);
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.y,this->elementVelocity.y);
-    this->pModel->convertNodeToElementVector(this->nodeVelocity.z,this->elementVelocity.z);
+    this->nodeElementIncidence.convertNodeToElement(*this->pModel,
+                                                    {&this->nodeVelocity.x,&this->nodeVelocity.y,&this->nodeVelocity.z},
+                                                    {&this->elementVelocity.x,&this->elementVelocity.y,&this->elementVelocity.z});
 
     this->computeShapeDerivatives();
     this->streamVelocity = RSolverFluid::computeStreamVelocity(*this->pModel,this->nodeVelocity,false);
 
     this->b.resize(this->nodeBook.getNEnabled());
-    this->x.resize(this->nodeBook.getNEnabled());
 
     this->A.clear();
     this->A.setNRows(this->nodeBook.getNEnabled());
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(this->nodeBook.getNEnabled());
 
     bool abort = false;
 
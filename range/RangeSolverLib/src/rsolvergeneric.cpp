@@ -24,9 +24,13 @@ void RSolverGeneric::_init(const RSolverGeneric *pGenericSolver)
         this->meshChanged = pGenericSolver->meshChanged;
         this->problemType = pGenericSolver->problemType;
         this->pModel = pGenericSolver->pModel;
+        this->baseRecordFileName = pGenericSolver->baseRecordFileName;
+        this->pModelWriter = pGenericSolver->pModelWriter;
         this->M = pGenericSolver->M;
         this->A = pGenericSolver->A;
         this->x = pGenericSolver->x;
+        this->xOld = pGenericSolver->xOld;
+        this->matrixDeflation = pGenericSolver->matrixDeflation;
         this->b = pGenericSolver->b;
         this->nodeBook = pGenericSolver->nodeBook;
         this->localRotations = pGenericSolver->localRotations;
@@ -35,6 +39,16 @@ void RSolverGeneric::_init(const RSolverGeneric *pGenericSolver)
         this->firstRun = pGenericSolver->firstRun;
         this->taskIteration = pGenericSolver->taskIteration;
         this->computableElements = pGenericSolver->computableElements;
+        this->pointElements = pGenericSolver->pointElements;
+        this->lineElements = pGenericSolver->lineElements;
+        this->surfaceElements = pGenericSolver->surfaceElements;
+        this->volumeElements = pGenericSolver->volumeElements;
+        this->includableSurfaceElements = pGenericSolver->includableSurfaceElements;
+        this->nodeElementIncidence = pGenericSolver->nodeElementIncidence;
+        this->geometricFactors = pGenericSolver->geometricFactors;
+        this->elementOperatorStiffness = pGenericSolver->elementOperatorStiffness;
+        this->elementOperatorMass = pGenericSolver->elementOperatorMass;
+        this->materialPropertyCaches = pGenericSolver->materialPropertyCaches;
     }
 }
 
@@ -43,6 +57,7 @@ RSolverGeneric::RSolverGeneric(RModel *pModel, const QString &modelFileName, con
     , problemType(R_PROBLEM_NONE)
     , pModel(pModel)
     , modelFileName(modelFileName)
+    , pModelWriter(nullptr)
     , convergenceFileName(convergenceFileName)
     , pSharedData(&sharedData)
     , firstRun(false)
@@ -83,6 +98,7 @@ void RSolverGeneric::run(bool firstRun, uint taskIteration)
         this->findComputableElements(this->problemType);
         this->findIncludableElements();
         this->findInwardElements();
+        this->buildElementLists();
         this->updateLocalRotations();
     }
 
@@ -93,6 +109,12 @@ void RSolverGeneric::run(bool firstRun, uint taskIteration)
         this->updateScales();
         this->scales.downscale(*this->pModel);
 
+        this->updateNodeElementIncidence(false);
+        if (this->meshChanged)
+        {
+            this->geometricFactors.clear();
+        }
+
         this->recoverSharedData();
         this->recover();
         this->prepare();
@@ -135,9 +157,10 @@ void RSolverGeneric::run(bool firstRun, uint taskIteration)
     }
     else
     {
+        bool displacementApplied = false;
         if (this->problemType != R_PROBLEM_STRESS && this->problemType != R_PROBLEM_STRESS_MODAL && this->problemType != R_PROBLEM_MESH)
         {
-            this->applyDisplacement();
+            displacementApplied = this->applyDisplacement();
         }
 
         this->updateScales();
@@ -146,6 +169,12 @@ void RSolverGeneric::run(bool firstRun, uint taskIteration)
             this->scales.downscale(*this->pModel);
         }
 
+        this->updateNodeElementIncidence(displacementApplied);
+        if (this->meshChanged || displacementApplied)
+        {
+            this->geometricFactors.clear();
+        }
+
         this->recoverSharedData();
         this->recover();
         this->prepare();
@@ -181,28 +210,56 @@ void RSolverGeneric::setMeshChanged(bool meshChanged)
     this->meshChanged = meshChanged;
 }
 
+void RSolverGeneric::setModelWriter(RModelWriter *pModelWriter)
+{
+    this->pModelWriter = pModelWriter;
+}
+
+void RSolverGeneric::writeCheckpoint(RSaveFile &outFile) const
+{
+    // Solution vector is used as initial guess by the matrix solver.
+    RFileIO::writeBinary(outFile,this->x,true);
+    RFileIO::writeBinary(outFile,this->elementTemperature,true);
+    RFileIO::writeBinary(outFile,this->xOld,true);
+    // Deflation vectors affect following matrix solves.
+    const std::vector<RRVector> &deflationVectors = this->matrixDeflation.getVectors();
+    RFileIO::writeBinary(outFile,uint(deflationVectors.size()));
+    for (uint i=0;i<deflationVectors.size();i++)
+    {
+        RFileIO::writeBinary(outFile,deflationVectors[i],true);
+    }
+}
+
+void RSolverGeneric::readCheckpoint(RFile &inFile)
+{
+    RFileIO::readBinary(inFile,this->x,true);
+    RFileIO::readBinary(inFile,this->elementTemperature,true);
+    if (inFile.getVersion() >= RVersion(1,1,0))
+    {
+        RFileIO::readBinary(inFile,this->xOld,true);
+    }
+    if (inFile.getVersion() >= RVersion(1,2,0))
+    {
+        uint nDeflationVectors = 0;
+        RFileIO::readBinary(inFile,nDeflationVectors);
+        std::vector<RRVector> deflationVectors(nDeflationVectors);
+        for (uint i=0;i<nDeflationVectors;i++)
+        {
+            RFileIO::readBinary(inFile,deflationVectors[i],true);
+        }
+        this->matrixDeflation.setVectors(deflationVectors);
+    }
+}
+
 void RSolverGeneric::updateOldRecords(const RTimeSolver &rTimeSolver, const QString &modelFileName)
 {
     if (rTimeSolver.getEnabled())
     {
-        // Update previous records.
-        for (unsigned int i=0;i<=rTimeSolver.getCurrentTimeStep();i++)
-        {
-            QString fileName = RFileManager::getFileNameWithTimeStep(modelFileName,i);
+        // Update time solver file shared by previous records.
+        QString timeSolverFileName(RModel::getTimeSolverFileName(modelFileName));
+        RLogger::info("Updating time solver file \'%s\'\n",timeSolverFileName.toUtf8().constData());
+        RModel::writeTimeSolver(timeSolverFileName,rTimeSolver);
 
-            if (RFileManager::fileExists(fileName))
-            {
-                RLogger::info("Updating model file \'%s\'\n",fileName.toUtf8().constData());
-
-                RModel model;
-                model.read(fileName);
-                model.getTimeSolver().setTimes(rTimeSolver.getTimes());
-                model.getTimeSolver().setInputNTimeSteps(rTimeSolver.getInputNTimeSteps());
-                model.getTimeSolver().setInputStartTime(rTimeSolver.getInputStartTime());
-                model.getTimeSolver().setInputTimeStepSize(rTimeSolver.getInputTimeStepSize());
-                model.write(fileName);
-            }
-        }
         // Delete records which will be computed again.
         for (unsigned int i=rTimeSolver.getCurrentTimeStep();i<rTimeSolver.getNTimeSteps();i++)
         {
@@ -483,16 +540,44 @@ void RSolverGeneric::writeResults(void)
 
     if (canWrite)
     {
-        this->modelFileName = this->pModel->write(this->modelFileName);
+        QString recordFileName = this->pModel->getRecordFileName(this->modelFileName);
+
+        // Full model is written only if mesh has changed, otherwise results are written and mesh is referenced from base record.
+        if (this->meshChanged
+            || this->problemType == R_PROBLEM_MESH
+            || this->baseRecordFileName.isEmpty()
+            || this->baseRecordFileName == recordFileName)
+        {
+            if (this->pModelWriter)
+            {
+                this->modelFileName = this->pModelWriter->write(*this->pModel,this->modelFileName);
+            }
+            else
+            {
+                this->modelFileName = this->pModel->write(this->modelFileName);
+            }
+            this->baseRecordFileName = recordFileName;
+        }
+        else
+        {
+            if (this->pModelWriter)
+            {
+                this->modelFileName = this->pModelWriter->writeResults(*this->pModel,this->modelFileName,this->baseRecordFileName);
+            }
+            else
+            {
+                this->modelFileName = this->pModel->writeResults(this->modelFileName,this->baseRecordFileName);
+            }
+        }
     }
 }
 
-void RSolverGeneric::applyDisplacement(void)
+bool RSolverGeneric::applyDisplacement(void)
 {
     uint variablePosition = this->pModel->findVariable(R_VARIABLE_DISPLACEMENT);
     if (variablePosition == RConstants::eod)
     {
-        return;
+        return false;
     }
 
     const RVariable &rVariable = this->pModel->getVariable(variablePosition);
@@ -505,6 +590,8 @@ void RSolverGeneric::applyDisplacement(void)
         RRVector u = rVariable.getValueVector(i);
         this->pModel->getNode(i).move(RR3Vector(u[0],u[1],u[2]));
     }
+
+    return true;
 }
 
 void RSolverGeneric::removeDisplacement(void)
@@ -528,6 +615,44 @@ void RSolverGeneric::removeDisplacement(void)
     }
 }
 
+void RSolverGeneric::updateNodeElementIncidence(bool nodesMoved)
+{
+    if (this->meshChanged || nodesMoved || !this->nodeElementIncidence.isValid(this->pModel->getNNodes(),this->pModel->getNElements()))
+    {
+        this->nodeElementIncidence.build(*this->pModel);
+    }
+}
+
+void RSolverGeneric::updateGeometricFactors(void)
+{
+    if (!this->geometricFactors.isValid(this->pModel->getNNodes(),this->pModel->getNElements(),this->scales.getMetre()))
+    {
+        RLogger::info("Computing geometric factors\n");
+        this->geometricFactors.build(*this->pModel,this->scales.getMetre());
+    }
+}
+
+bool RSolverGeneric::getMatrixFree(void) const
+{
+    return this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG).getMatrixFree();
+}
+
+void RSolverGeneric::initializeMatrixFree(void)
+{
+    if (this->getMatrixFree())
+    {
+        this->elementOperatorStiffness.resize(this->pModel->getNElements());
+        this->elementOperatorStiffness.fill(0.0);
+        this->elementOperatorMass.resize(this->pModel->getNElements());
+        this->elementOperatorMass.fill(0.0);
+    }
+    else
+    {
+        this->elementOperatorStiffness.clear();
+        this->elementOperatorMass.clear();
+    }
+}
+
 void RSolverGeneric::generateNodeBook(RProblemType problemType)
 {
     if (problemType == R_PROBLEM_FLUID)
@@ -592,41 +717,63 @@ void RSolverGeneric::generateNodeBook(RProblemType problemType)
     }
 }
 
-void RSolverGeneric::generateMaterialVecor(RMaterialPropertyType materialPropertyType, RRVector &materialPropertyValues) const
+void RSolverGeneric::initializeSolution(uint nUnknowns)
 {
-    unsigned int ne = this->pModel->getNElements();
+    RWarmStartType warmStartType = this->pModel->getProblemSetup().getWarmStart(this->problemType);
 
-    materialPropertyValues.resize(ne,0.0);
+    if (this->meshChanged || this->x.size() != nUnknowns)
+    {
+        // Deflation vectors are no longer related to new system.
+        this->matrixDeflation.clear();
+    }
 
-    for (unsigned int i=0;i<this->pModel->getNElementGroups();i++)
+    // Previous solution can be used only if unknowns have not changed.
+    if (warmStartType == R_WARM_START_NONE || this->meshChanged || this->x.size() != nUnknowns)
     {
-        const RElementGroup *pElementGroup = this->pModel->getElementGroupPtr(i);
-        if (!pElementGroup)
-        {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Element group could not be found (%u of %u).",i,this->pModel->getNElementGroups());
-        }
+        this->x.resize(nUnknowns);
+        this->x.fill(0.0);
+        this->xOld.clear();
+        return;
+    }
 
-        const RMaterial &material = pElementGroup->getMaterial();
+    RRVector xLast(this->x);
 
-        // Get material property
-        unsigned int materialPropertyPosition = material.findPosition(materialPropertyType);
-        if (materialPropertyPosition == material.size())
+    if (warmStartType == R_WARM_START_EXTRAPOLATE && this->xOld.size() == nUnknowns)
+    {
+        RLogger::info("Initial guess is extrapolated from two previous solutions\n");
+        #pragma omp parallel for default(shared)
+        for (int64_t i=0;i<int64_t(nUnknowns);i++)
         {
-//            RLogger::warning("Could not find material property \'%s\' in element group \'%s\'\n",
-//                             RMaterialProperty::getName(materialPropertyType).toUtf8().constData(),
-//                             pElementGroup->getName().toUtf8().constData());
-            continue;
+            this->x[i] = 2.0 * xLast[i] - this->xOld[i];
         }
-        const RMaterialProperty &materialProperty = material.get(materialPropertyPosition);
+    }
+    else
+    {
+        RLogger::info("Initial guess is taken from previous solution\n");
+    }
 
-        // Apply values to element vectors.
-        for (unsigned int j=0;j<pElementGroup->size();j++)
+    this->xOld = xLast;
+}
+
+void RSolverGeneric::generateMaterialVecor(RMaterialPropertyType materialPropertyType, RRVector &materialPropertyValues) const
+{
+    if (this->materialPropertyCaches.size() != R_MATERIAL_PROPERTY_N_TYPES)
+    {
+        this->materialPropertyCaches.clear();
+        for (RMaterialPropertyType type=R_MATERIAL_PROPERTY_NONE;type<R_MATERIAL_PROPERTY_N_TYPES;type++)
         {
-            unsigned int elementID = pElementGroup->get(j);
-            double temperature = this->elementTemperature[elementID];
-            materialPropertyValues[elementID] = materialProperty.get(temperature);
+            this->materialPropertyCaches.push_back(RMaterialPropertyCache(type));
         }
     }
+
+    RMaterialPropertyCache &materialPropertyCache = this->materialPropertyCaches[materialPropertyType];
+
+    if (this->meshChanged)
+    {
+        materialPropertyCache.clear();
+    }
+
+    materialPropertyCache.evaluate(*this->pModel,this->elementTemperature,R_MATERIAL_PROPERTY_CACHE_TEMPERATURE_TOLERANCE,materialPropertyValues);
 }
 
 void RSolverGeneric::generateVariableVector(RVariableType variableType,
@@ -846,6 +993,24 @@ void RSolverGeneric::findIncludableElements(void)
 
 }
 
+void RSolverGeneric::buildElementLists(void)
+{
+    this->pointElements.build(*this->pModel,R_ENTITY_GROUP_POINT,this->computableElements);
+    this->lineElements.build(*this->pModel,R_ENTITY_GROUP_LINE,this->computableElements);
+    this->surfaceElements.build(*this->pModel,R_ENTITY_GROUP_SURFACE,this->computableElements);
+    this->volumeElements.build(*this->pModel,R_ENTITY_GROUP_VOLUME,this->computableElements);
+
+    RBVector surfaceElementMask(this->computableElements);
+    for (uint i=0;i<this->includableElements.size();i++)
+    {
+        if (this->includableElements[i])
+        {
+            surfaceElementMask[i] = true;
+        }
+    }
+    this->includableSurfaceElements.build(*this->pModel,R_ENTITY_GROUP_SURFACE,surfaceElementMask);
+}
+
 void RSolverGeneric::findInwardElements(void)
 {
     this->inwardElements.resize(this->pModel->getNElements());
@@ -951,14 +1116,9 @@ void RSolverGeneric::processMonitoringPoints(void) const
 
         RNode iNode(rMonitorinPoint.getPosition());
 
-        unsigned int elementID = RConstants::eod;
-        for (unsigned int j=0;j<this->pModel->getNElements();j++)
-        {
-            if (this->pModel->getElement(j).isInside(this->pModel->getNodes(),iNode))
-            {
-                elementID = j;
-            }
-        }
+        // Last containing element is used so that points on shared faces keep their monitored values.
+        RRVector volumes;
+        unsigned int elementID = this->pModel->findElementContainingNode(iNode,R_ENTITY_GROUP_ELEMENT,volumes,true);
         if (elementID == RConstants::eod)
         {
             RLogger::warning("Monitoring point [%g %g %g] is outside of the model\n",
@@ -968,7 +1128,7 @@ void RSolverGeneric::processMonitoringPoints(void) const
             continue;
         }
 
-        RElement &rElement = this->pModel->getElement(elementID);
+        const RElement &rElement = this->pModel->getElement(elementID);
 
         RValueVector valueVector;
         valueVector.resize(rVariable.getNVectors());
@@ -1027,3 +1187,17 @@ void RSolverGeneric::printStats(RVariableType variableType) const
     stat.print();
     RLogger::unindent();
 }
+
+void RSolverGeneric::writeCheckpointVector(RSaveFile &outFile, const RSolverCartesianVector<RRVector> &vector)
+{
+    RFileIO::writeBinary(outFile,vector.x,true);
+    RFileIO::writeBinary(outFile,vector.y,true);
+    RFileIO::writeBinary(outFile,vector.z,true);
+}
+
+void RSolverGeneric::readCheckpointVector(RFile &inFile, RSolverCartesianVector<RRVector> &vector)
+{
+    RFileIO::readBinary(inFile,vector.x,true);
+    RFileIO::readBinary(inFile,vector.y,true);
+    RFileIO::readBinary(inFile,vector.z,true);
+}
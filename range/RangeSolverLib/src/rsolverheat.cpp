@@ -8,10 +8,13 @@
  *  DESCRIPTION: Heat-transfer solver class definition               *
  *********************************************************************/
 
+#include <algorithm>
+
 #include <rblib.h>
 
 #include "rsolverheat.h"
 #include "rconvection.h"
+#include "relementmatrixoperator.h"
 #include "rmatrixsolver.h"
 
 void RSolverHeat::_init(const RSolverHeat *pHeatSolver)
@@ -58,6 +61,20 @@ bool RSolverHeat::hasConverged(void) const
     return true;
 }
 
+void RSolverHeat::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RFileIO::writeBinary(outFile,this->nodeTemperature,true);
+}
+
+void RSolverHeat::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RFileIO::readBinary(inFile,this->nodeTemperature,true);
+}
+
 double RSolverHeat::findTemperatureScale(void) const
 {
     return 1.0;
@@ -112,382 +129,354 @@ void RSolverHeat::prepare(void)
     this->generateMaterialVecor(R_MATERIAL_PROPERTY_HEAT_CAPACITY,this->elementCapacity);
     this->generateMaterialVecor(R_MATERIAL_PROPERTY_DENSITY,this->elementDensity);
 
-    this->pModel->convertElementToNodeVector(this->elementTemperature,temperatureSetValues,this->nodeTemperature,true);
+    this->nodeElementIncidence.convertElementToNode(this->elementTemperature,temperatureSetValues,this->nodeTemperature,true);
 
     this->b.resize(this->nodeBook.getNEnabled());
-    this->x.resize(this->nodeBook.getNEnabled());
 
     this->A.clear();
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(this->nodeBook.getNEnabled());
+    this->updateGeometricFactors();
+    this->initializeMatrixFree();
 
     // Prepare point elements.
-    for (uint i=0;i<this->pModel->getNPoints();i++)
+    bool abort = false;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->pointElements.size());j++)
     {
-        RPoint &point = this->pModel->getPoint(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(point.size());j++)
+        try
         {
-            try
-            {
-                uint elementID = point.get(j);
+            uint elementID = this->pointElements.getElementID(j);
+            const RPoint &point = this->pModel->getPoint(this->pointElements.getEntityID(j));
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size(),element.size());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+            Me.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                for (uint k=0;k<nInp;k++)
+                for (unsigned m=0;m<element.size();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    for (unsigned m=0;m<element.size();m++)
+                    for (unsigned n=0;n<element.size();n++)
                     {
-                        for (unsigned n=0;n<element.size();n++)
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled())
                         {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
-                            {
-                                Me[m][n] += N[m] * N[n]
-                                         * this->elementDensity[elementID]
-                                         * this->elementCapacity[elementID]
-                                         * detJ
-                                         * shapeFunc.getW()
-                                         * point.getVolume();
-                            }
+                            Me[m][n] += N[m] * N[n]
+                                     * this->elementDensity[elementID]
+                                     * this->elementCapacity[elementID]
+                                     * detJ
+                                     * shapeFunc.getW()
+                                     * point.getVolume();
                         }
-                        // Force
-                        fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ke,fe);
+                    // Force
+                    fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Me,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare line elements.
-    for (uint i=0;i<this->pModel->getNLines();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->lineElements.size());j++)
     {
-        RLine &line = this->pModel->getLine(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        try
         {
-            try
-            {
-                uint elementID = line.get(j);
+            uint elementID = this->lineElements.getElementID(j);
+            const RLine &line = this->pModel->getLine(this->lineElements.getEntityID(j));
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size(),element.size());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
+            RRMatrix B(element.size(),1);
 
-                RRMatrix B(element.size(),1);
+            Me.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
 
-                for (uint k=0;k<nInp;k++)
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    B[m][0] += dN[m][0]*J[0][0];
+                }
 
-                    for (uint m=0;m<dN.getNRows();m++)
+                for (unsigned m=0;m<element.size();m++)
+                {
+                    for (unsigned n=0;n<element.size();n++)
                     {
-                        B[m][0] += dN[m][0]*J[0][0];
-                    }
+                        // Conduction
+                        double kcnd = (B[m][0]*B[n][0]) * line.getCrossArea() * this->elementConduction[elementID];
 
-                    for (unsigned m=0;m<element.size();m++)
-                    {
-                        for (unsigned n=0;n<element.size();n++)
+                        Ke[m][n] += kcnd * detJ * shapeFunc.getW();
+
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled())
                         {
-                            // Conduction
-                            double kcnd = (B[m][0]*B[n][0]) * line.getCrossArea() * this->elementConduction[elementID];
-
-                            Ke[m][n] += kcnd * detJ * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
-                            {
-                                Me[m][n] += N[m] * N[n]
-                                         * this->elementDensity[elementID]
-                                         * this->elementCapacity[elementID]
-                                         * detJ
-                                         * shapeFunc.getW()
-                                         * line.getCrossArea();
-                            }
+                            Me[m][n] += N[m] * N[n]
+                                     * this->elementDensity[elementID]
+                                     * this->elementCapacity[elementID]
+                                     * detJ
+                                     * shapeFunc.getW()
+                                     * line.getCrossArea();
                         }
-                        // Force
-                        fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                     }
-                }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ke,fe);
+                    // Force
+                    fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Me,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
-    // Prepare surface elements.
+    // Convection coefficients of each surface.
+    RRVector surfaceHtc(this->pModel->getNSurfaces(),0.0);
+    RRVector surfaceHtt(this->pModel->getNSurfaces(),0.0);
+    std::vector<RConvection> surfaceNaturalConvection(this->pModel->getNSurfaces());
+    RBVector surfaceHasNaturalConvection(this->pModel->getNSurfaces(),false);
     for (uint i=0;i<this->pModel->getNSurfaces();i++)
     {
-        RSurface &surface = this->pModel->getSurface(i);
-
-        double htc = 0.0;
-        double htt = 0.0;
-
-        this->getSimpleConvection(surface,htc,htt);
-        this->getForcedConvection(surface,htc,htt);
+        this->getSimpleConvection(this->pModel->getSurface(i),surfaceHtc[i],surfaceHtt[i]);
+        this->getForcedConvection(this->pModel->getSurface(i),surfaceHtc[i],surfaceHtt[i]);
+        surfaceHasNaturalConvection[i] = this->getNaturalConvection(this->pModel->getSurface(i),surfaceNaturalConvection[i],surfaceHtt[i]);
+    }
 
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+    // Prepare surface elements.
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->surfaceElements.size());j++)
+    {
+        try
         {
-            try
-            {
-                uint elementID = surface.get(j);
+            uint elementID = this->surfaceElements.getElementID(j);
+            uint surfaceID = this->surfaceElements.getEntityID(j);
+            const RSurface &surface = this->pModel->getSurface(surfaceID);
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            double htc = surfaceHtc[surfaceID];
+            double htt = surfaceHtt[surfaceID];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),2);
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size(),element.size());
+            RRMatrix Ke(element.size(),element.size());
+            RRVector fe(element.size());
+            RRMatrix B(element.size(),2);
 
-                this->getNaturalConvection(surface,elementID,htc,htt);
+            if (surfaceHasNaturalConvection[surfaceID])
+            {
+                htc = this->findNaturalConvectionHtc(surfaceNaturalConvection[surfaceID],elementID);
+            }
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            Me.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
 
-                for (uint k=0;k<nInp;k++)
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                B.fill(0.0);
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
+                    B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
+                    B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
+                }
 
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                for (unsigned m=0;m<element.size();m++)
+                {
+                    for (unsigned n=0;n<element.size();n++)
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
-                    }
+                        // Conduction
+                        double kcnd = (B[m][0]*B[n][0]+B[m][1]*B[n][1]) * surface.getThickness() * this->elementConduction[elementID];
+                        // Convection
+                        double kcnv = N[m] * N[n] * htc;
 
-                    for (unsigned m=0;m<element.size();m++)
-                    {
-                        for (unsigned n=0;n<element.size();n++)
+                        Ke[m][n] += (kcnd + kcnv) * detJ * shapeFunc.getW();
+
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled())
                         {
-                            // Conduction
-                            double kcnd = (B[m][0]*B[n][0]+B[m][1]*B[n][1]) * surface.getThickness() * this->elementConduction[elementID];
-                            // Convection
-                            double kcnv = N[m] * N[n] * htc;
-
-                            Ke[m][n] += (kcnd + kcnv) * detJ * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
-                            {
-                                Me[m][n] += N[m] * N[n]
-                                         * this->elementDensity[elementID]
-                                         * this->elementCapacity[elementID]
-                                         * detJ
-                                         * shapeFunc.getW()
-                                         * surface.getThickness();
-                            }
+                            Me[m][n] += N[m] * N[n]
+                                     * this->elementDensity[elementID]
+                                     * this->elementCapacity[elementID]
+                                     * detJ
+                                     * shapeFunc.getW()
+                                     * surface.getThickness();
                         }
-                        // Force
-                        fe[m] += (this->elementHeat[elementID] + this->elementRadiativeHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                     }
+                    // Force
+                    fe[m] += (this->elementHeat[elementID] + this->elementRadiativeHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
                 }
+            }
 
-                // Convection force
-                double elementArea = 0.0;
-                if (element.findArea(this->pModel->getNodes(),elementArea))
-                {
-                    for (unsigned m=0;m<element.size();m++)
-                    {
-                        fe[m] += htc * htt * elementArea / element.size();
-                    }
-                }
-                #pragma omp critical
+            // Convection force
+            double elementArea = 0.0;
+            if (element.findArea(this->pModel->getNodes(),elementArea))
+            {
+                for (unsigned m=0;m<element.size();m++)
                 {
-                    this->assemblyMatrix(elementID,Me,Ke,fe);
+                    fe[m] += htc * htt * elementArea / element.size();
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Me,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare volume elements.
-    for (uint i=0;i<this->pModel->getNVolumes();i++)
+    // Elements are sorted by type, consecutive elements of the same type are integrated in batches.
+    int64_t nVolumeBatches = (int64_t(this->volumeElements.size()) + R_ELEMENT_BATCH_SIZE - 1) / R_ELEMENT_BATCH_SIZE;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE/R_ELEMENT_BATCH_SIZE)
+    for (int64_t jb=0;jb<nVolumeBatches;jb++)
     {
-        RVolume &volume = this->pModel->getVolume(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = volume.get(j);
+            continue;
+        }
+        try
+        {
+            uint jStart = uint(jb * R_ELEMENT_BATCH_SIZE);
+            uint jEnd = std::min(jStart + R_ELEMENT_BATCH_SIZE,this->volumeElements.size());
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            RElementBatch<4,4> tetra1Batch;
+
+            for (uint j=jStart;j<jEnd;j++)
+            {
+                uint elementID = this->volumeElements.getElementID(j);
 
                 const RElement &element = this->pModel->getElement(elementID);
                 R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size(),element.size());
-                RRMatrix Ke(element.size(),element.size());
-                RRVector fe(element.size());
-                RRMatrix B(element.size(),3);
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                // Conduction
-                for (uint k=0;k<nInp;k++)
+                switch (element.getType())
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    case R_ELEMENT_TETRA1:
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
+                        tetra1Batch.add(elementID);
+                        break;
                     }
-
-                    for (unsigned m=0;m<element.size();m++)
+                    default:
                     {
-                        for (unsigned n=0;n<element.size();n++)
+                        RRMatrix Me(element.size(),element.size());
+                        RRMatrix Ke(element.size(),element.size());
+                        RRVector fe(element.size());
+                        this->computeVolumeElement(elementID,Me,Ke,fe);
+                        #pragma omp critical
                         {
-                            // Conduction
-                            Ke[m][n] += (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2])
-                                     * this->elementConduction[elementID]
-                                     * detJ
-                                     * shapeFunc.getW();
-
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled())
-                            {
-                                Me[m][n] += N[m] * N[n]
-                                         * this->elementDensity[elementID]
-                                         * this->elementCapacity[elementID]
-                                         * detJ
-                                         * shapeFunc.getW();
-                            }
+                            this->assemblyMatrix(elementID,Me,Ke,fe);
                         }
-                        // Force
-                        fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJ * shapeFunc.getW();
+                        break;
                     }
                 }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ke,fe);
-                }
             }
-            catch (const RError &rError)
+
+            if (tetra1Batch.size() > 0)
             {
+                tetra1Batch.gather(this->geometricFactors,R_ELEMENT_TETRA1);
+
+                RElementBatchMatrix<4,4> Mb, Kb;
+                RElementBatchVector<4> fb;
+                this->computeVolumeElementBatch<4,4>(tetra1Batch,Mb,Kb,fb);
+
                 #pragma omp critical
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    RFixedMatrix<4,4> Me, Ke;
+                    RFixedVector<4> fe;
+                    for (uint l=0;l<tetra1Batch.size();l++)
+                    {
+                        Mb.getLane(l,Me);
+                        Kb.getLane(l,Ke);
+                        fb.getLane(l,fe);
+                        this->assemblyMatrix(tetra1Batch.getElementID(l),Me,Ke,fe);
+                    }
                 }
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 }
 
 void RSolverHeat::solve(void)
@@ -496,7 +485,21 @@ void RSolverHeat::solve(void)
     {
         RLogger::indent();
         RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        if (this->getMatrixFree())
+        {
+            RElementMatrixOperator matrixOperator(*this->pModel,
+                                                  this->nodeBook,
+                                                  this->geometricFactors,
+                                                  this->A,
+                                                  this->elementOperatorStiffness,
+                                                  this->elementOperatorMass);
+            RLogger::info("Matrix-free elements = %u (%u colors)\n",matrixOperator.getNElements(),matrixOperator.getNColors());
+            matrixSolver.solve(matrixOperator,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,&this->matrixDeflation);
+        }
+        else
+        {
+            matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1,&this->matrixDeflation);
+        }
         RLogger::unindent();
     }
     catch (RError error)
@@ -514,7 +517,7 @@ void RSolverHeat::solve(void)
         }
     }
 
-    this->pModel->convertNodeToElementVector(this->nodeTemperature,this->elementTemperature);
+    this->nodeElementIncidence.convertNodeToElement(*this->pModel,this->nodeTemperature,this->elementTemperature);
 }
 
 void RSolverHeat::process(void)
@@ -598,8 +601,11 @@ void RSolverHeat::process(void)
         double htc = 0.0;
         double htt = 0.0;
 
+        RConvection naturalConvection;
+
         this->getSimpleConvection(surface,htc,htt);
         this->getForcedConvection(surface,htc,htt);
+        bool hasNaturalConvection = this->getNaturalConvection(surface,naturalConvection,htt);
 
         for (uint j=0;j<surface.size();j++)
         {
@@ -614,7 +620,10 @@ void RSolverHeat::process(void)
             uint nInp = RElement::getNIntegrationPoints(element.getType());
             RRMatrix B(element.size(),2);
 
-            this->getNaturalConvection(surface,elementID,htc,htt);
+            if (hasNaturalConvection)
+            {
+                htc = this->findNaturalConvectionHtc(naturalConvection,elementID);
+            }
 
             Qx = Qy = Qz = 0.0;
 
@@ -787,18 +796,143 @@ void RSolverHeat::statistics(void)
     this->processMonitoringPoints();
 }
 
-void RSolverHeat::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMatrix &Ke, const RRVector &fe)
+void RSolverHeat::computeVolumeElement(unsigned int elementID, RRMatrix &Me, RRMatrix &Ke, RRVector &fe) const
+{
+    const RElement &element = this->pModel->getElement(elementID);
+    uint nInp = this->geometricFactors.getNPoints(elementID);
+
+    bool timeSolverEnabled = this->pModel->getTimeSolver().getEnabled();
+
+    Me.fill(0.0);
+    Ke.fill(0.0);
+    fe.fill(0.0);
+
+    for (uint k=0;k<nInp;k++)
+    {
+        const RRVector &N = RElement::getShapeFunction(element.getType(),k).getN();
+        const double *B = this->geometricFactors.getGradients(elementID,k);
+        double detJW = this->geometricFactors.getDetJW(elementID,k);
+
+        for (uint m=0;m<element.size();m++)
+        {
+            for (uint n=0;n<element.size();n++)
+            {
+                // Conduction
+                Ke[m][n] += (B[3*m+0]*B[3*n+0] + B[3*m+1]*B[3*n+1] + B[3*m+2]*B[3*n+2])
+                         * this->elementConduction[elementID]
+                         * detJW;
+
+                // Mass
+                if (timeSolverEnabled)
+                {
+                    Me[m][n] += N[m] * N[n]
+                             * this->elementDensity[elementID]
+                             * this->elementCapacity[elementID]
+                             * detJW;
+                }
+            }
+            // Force
+            fe[m] += (this->elementHeat[elementID] + this->elementJouleHeat[elementID]) * N[m] * detJW;
+        }
+    }
+}
+
+template <unsigned int nNodes, unsigned int nPoints>
+void RSolverHeat::computeVolumeElementBatch(const RElementBatch<nNodes,nPoints> &batch, RElementBatchMatrix<nNodes,nNodes> &Me, RElementBatchMatrix<nNodes,nNodes> &Ke, RElementBatchVector<nNodes> &fe) const
+{
+    bool timeSolverEnabled = this->pModel->getTimeSolver().getEnabled();
+
+    double conduction[R_ELEMENT_BATCH_SIZE];
+    double density[R_ELEMENT_BATCH_SIZE];
+    double capacity[R_ELEMENT_BATCH_SIZE];
+    double heat[R_ELEMENT_BATCH_SIZE];
+    double jouleHeat[R_ELEMENT_BATCH_SIZE];
+
+    batch.gather(this->elementConduction,conduction);
+    batch.gather(this->elementDensity,density);
+    batch.gather(this->elementCapacity,capacity);
+    batch.gather(this->elementHeat,heat);
+    batch.gather(this->elementJouleHeat,jouleHeat);
+
+    Me.fill(0.0);
+    Ke.fill(0.0);
+    fe.fill(0.0);
+
+    for (unsigned int k=0;k<nPoints;k++)
+    {
+        const double *detJW = batch.getDetJW(k);
+
+        for (unsigned int m=0;m<nNodes;m++)
+        {
+            const double *Bm0 = batch.getB(k,m,0);
+            const double *Bm1 = batch.getB(k,m,1);
+            const double *Bm2 = batch.getB(k,m,2);
+            double Nm = batch.getN(k,m);
+
+            for (unsigned int n=0;n<nNodes;n++)
+            {
+                const double *Bn0 = batch.getB(k,n,0);
+                const double *Bn1 = batch.getB(k,n,1);
+                const double *Bn2 = batch.getB(k,n,2);
+                double NmNn = Nm * batch.getN(k,n);
+
+                // Conduction
+                double *ke = Ke(m,n);
+                R_ELEMENT_BATCH_SIMD
+                for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+                {
+                    ke[l] += (Bm0[l]*Bn0[l] + Bm1[l]*Bn1[l] + Bm2[l]*Bn2[l]) * conduction[l] * detJW[l];
+                }
+
+                // Mass
+                if (timeSolverEnabled)
+                {
+                    double *me = Me(m,n);
+                    R_ELEMENT_BATCH_SIMD
+                    for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+                    {
+                        me[l] += NmNn * density[l] * capacity[l] * detJW[l];
+                    }
+                }
+            }
+
+            // Force
+            double *f = fe(m);
+            R_ELEMENT_BATCH_SIMD
+            for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+            {
+                f[l] += (heat[l] + jouleHeat[l]) * Nm * detJW[l];
+            }
+        }
+    }
+}
+
+template <class TMatrix, class TVector>
+void RSolverHeat::assemblyMatrix(uint elementID, const TMatrix &Me, const TMatrix &Ke, const TVector &fe)
 {
     double alpha = this->pModel->getTimeSolver().getTimeMarchApproximationCoefficient();
     double dt = this->pModel->getTimeSolver().getCurrentTimeStepSize();
 
     const RElement &element = this->pModel->getElement(elementID);
 
-    RRMatrix Ae(element.size(),element.size());
-    RRVector be(element.size());
+    TMatrix Ae(Ke);
+    TVector be(fe);
 
-    Ae.fill(0.0);
-    be.fill(0.0);
+    // Volume element matrix is applied by matrix-free operator.
+    bool assembleMatrix = !(this->getMatrixFree() && R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+
+    if (!assembleMatrix)
+    {
+        if (this->pModel->getTimeSolver().getEnabled())
+        {
+            this->elementOperatorStiffness[elementID] = alpha * dt * this->elementConduction[elementID];
+            this->elementOperatorMass[elementID] = this->elementDensity[elementID] * this->elementCapacity[elementID];
+        }
+        else
+        {
+            this->elementOperatorStiffness[elementID] = this->elementConduction[elementID];
+        }
+    }
 
     if (this->pModel->getTimeSolver().getEnabled())
     {
@@ -845,7 +979,7 @@ void RSolverHeat::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMat
             {
                 uint np = 0;
 
-                if (this->nodeBook.getValue(element.getNodeId(n),np))
+                if (assembleMatrix && this->nodeBook.getValue(element.getNodeId(n),np))
                 {
                     this->A.addValue(mp,np,Ae[m][n]);
                 }
@@ -861,7 +995,7 @@ bool RSolverHeat::getSimpleConvection(const RElementGroup &elementGroup, double
         return false;
     }
 
-    RBoundaryCondition bc = elementGroup.getBoundaryCondition(R_BOUNDARY_CONDITION_CONVECTION_SIMPLE);
+    const RBoundaryCondition &bc = elementGroup.getBoundaryCondition(R_BOUNDARY_CONDITION_CONVECTION_SIMPLE);
     uint cPos = 0;
 
     cPos = bc.findComponentPosition(R_VARIABLE_CONVECTION_COEFFICIENT);
@@ -894,7 +1028,7 @@ bool RSolverHeat::getForcedConvection(const RElementGroup &elementGroup, double
         return false;
     }
 
-    RBoundaryCondition bc = elementGroup.getBoundaryCondition(R_BOUNDARY_CONDITION_CONVECTION_FORCED);
+    const RBoundaryCondition &bc = elementGroup.getBoundaryCondition(R_BOUNDARY_CONDITION_CONVECTION_FORCED);
     uint cPos = 0;
 
     // Fluid temperature
@@ -987,14 +1121,14 @@ bool RSolverHeat::getForcedConvection(const RElementGroup &elementGroup, double
     return true;
 }
 
-bool RSolverHeat::getNaturalConvection(const RElementGroup &elementGroup, uint elementId, double &htc, double &htt)
+bool RSolverHeat::getNaturalConvection(const RElementGroup &elementGroup, RConvection &convection, double &htt)
 {
     if (!elementGroup.hasBoundaryCondition(R_BOUNDARY_CONDITION_CONVECTION_NATURAL))
     {
         return false;
     }
 
-    RBoundaryCondition bc = elementGroup.getBoundaryCondition(R_BOUNDARY_CONDITION_CONVECTION_NATURAL);
+    const RBoundaryCondition &bc = elementGroup.getBoundaryCondition(R_BOUNDARY_CONDITION_CONVECTION_NATURAL);
     uint cPos = 0;
 
     // Density
@@ -1074,15 +1208,17 @@ bool RSolverHeat::getNaturalConvection(const RElementGroup &elementGroup, uint e
     }
     double b = bc.getComponent(cPos).get(this->pModel->getTimeSolver().getCurrentTime());
 
-    RConvection convection;
-
     convection.setType(R_CONVECTION_NATURAL_EXTERNAL_HORIZONTAL_PLATES);
     convection.setMaterial("Custom material",mu,ro,k,c,b);
     convection.setDiameter(d);
-    convection.setSurfTemp(this->elementTemperature[elementId]);
     convection.setFluidTemp(htt);
 
-    htc = convection.calculateHtc();
-
     return true;
 }
+
+double RSolverHeat::findNaturalConvectionHtc(const RConvection &convection, uint elementId) const
+{
+    RConvection elementConvection(convection);
+    elementConvection.setSurfTemp(this->elementTemperature[elementId]);
+    return elementConvection.calculateHtc();
+}
@@ -50,6 +50,22 @@ bool RSolverMagnetostatics::hasConverged(void) const
     return true;
 }
 
+void RSolverMagnetostatics::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeCurrentDensity);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeMagneticField);
+}
+
+void RSolverMagnetostatics::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeCurrentDensity);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeMagneticField);
+}
+
 void RSolverMagnetostatics::updateScales(void)
 {
 
@@ -65,9 +81,10 @@ void RSolverMagnetostatics::recover(void)
     this->recoverVariable(R_VARIABLE_CURRENT_DENSITY,R_VARIABLE_APPLY_ELEMENT,this->pModel->getNElements(),1,elementCurrentDensityY,0.0);
     this->recoverVariable(R_VARIABLE_CURRENT_DENSITY,R_VARIABLE_APPLY_ELEMENT,this->pModel->getNElements(),2,elementCurrentDensityZ,0.0);
 
-    this->pModel->convertElementToNodeVector(elementCurrentDensityX,RBVector(this->pModel->getNElements(),true),this->nodeCurrentDensity.x,false);
-    this->pModel->convertElementToNodeVector(elementCurrentDensityY,RBVector(this->pModel->getNElements(),true),this->nodeCurrentDensity.y,false);
-    this->pModel->convertElementToNodeVector(elementCurrentDensityZ,RBVector(this->pModel->getNElements(),true),this->nodeCurrentDensity.z,false);
+    this->nodeElementIncidence.convertElementToNode({&elementCurrentDensityX,&elementCurrentDensityY,&elementCurrentDensityZ},
+                                                    RBVector(this->pModel->getNElements(),true),
+                                                    {&this->nodeCurrentDensity.x,&this->nodeCurrentDensity.y,&this->nodeCurrentDensity.z},
+                                                    false);
 }
 
 void RSolverMagnetostatics::prepare(void)
@@ -75,102 +92,83 @@ void RSolverMagnetostatics::prepare(void)
     this->generateNodeBook(R_PROBLEM_MAGNETOSTATICS);
 
     this->b.resize(3*this->nodeBook.getNEnabled());
-    this->x.resize(3*this->nodeBook.getNEnabled());
 
     this->A.clear();
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(3*this->nodeBook.getNEnabled());
+    this->updateGeometricFactors();
 
     // Prepare volume elements.
-    for (uint i=0;i<this->pModel->getNVolumes();i++)
+    bool abort = false;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->volumeElements.size());j++)
     {
-        RVolume &volume = this->pModel->getVolume(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = volume.get(j);
+            continue;
+        }
+        try
+        {
+            uint elementID = this->volumeElements.getElementID(j);
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Ke(element.size()*3,element.size()*3);
+            RRVector fe(element.size()*3);
+            RRMatrix B(element.size(),3);
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Ke(element.size()*3,element.size()*3);
-                RRVector fe(element.size()*3);
-                RRMatrix B(element.size(),3);
+            Ke.fill(0.0);
+            fe.fill(0.0);
 
-                Ke.fill(0.0);
-                fe.fill(0.0);
+            // Conduction
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                double detJW = this->geometricFactors.getDetJW(elementID,k);
+                this->geometricFactors.getGradients(elementID,k,B);
 
-                // Conduction
-                for (uint k=0;k<nInp;k++)
+                for (unsigned m=0;m<element.size();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = this->pModel->getElement(elementID).findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
+                    uint nodeID = element.getNodeId(m);
+                    for (unsigned n=0;n<element.size();n++)
                     {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
+                        double KeValue = (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2]) * detJW;
+                        Ke[3*m+0][3*n+0] -= KeValue;
+                        Ke[3*m+1][3*n+1] -= KeValue;
+                        Ke[3*m+2][3*n+2] -= KeValue;
                     }
+                    double feValue = N[m] * detJW * RSolverGeneric::e0;
 
-                    for (unsigned m=0;m<element.size();m++)
-                    {
-                        uint nodeID = element.getNodeId(m);
-                        for (unsigned n=0;n<element.size();n++)
-                        {
-                            double KeValue = (B[m][0]*B[n][0] + B[m][1]*B[n][1] + B[m][2]*B[n][2]) * detJ * shapeFunc.getW();
-                            Ke[3*m+0][3*n+0] -= KeValue;
-                            Ke[3*m+1][3*n+1] -= KeValue;
-                            Ke[3*m+2][3*n+2] -= KeValue;
-                        }
-                        double feValue = N[m] * detJ * shapeFunc.getW() * RSolverGeneric::e0;
-
-                        double jsx = - B[m][2] * this->nodeCurrentDensity.y[nodeID] + B[m][1] * this->nodeCurrentDensity.z[nodeID];
-                        double jsy =   B[m][2] * this->nodeCurrentDensity.x[nodeID] - B[m][0] * this->nodeCurrentDensity.z[nodeID];
-                        double jsz = - B[m][1] * this->nodeCurrentDensity.x[nodeID] + B[m][0] * this->nodeCurrentDensity.y[nodeID];
-
-                        fe[3*m+0] += feValue * jsx;
-                        fe[3*m+1] += feValue * jsy;
-                        fe[3*m+2] += feValue * jsz;
-                    }
-                }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Ke,fe);
+                    double jsx = - B[m][2] * this->nodeCurrentDensity.y[nodeID] + B[m][1] * this->nodeCurrentDensity.z[nodeID];
+                    double jsy =   B[m][2] * this->nodeCurrentDensity.x[nodeID] - B[m][0] * this->nodeCurrentDensity.z[nodeID];
+                    double jsz = - B[m][1] * this->nodeCurrentDensity.x[nodeID] + B[m][0] * this->nodeCurrentDensity.y[nodeID];
+
+                    fe[3*m+0] += feValue * jsx;
+                    fe[3*m+1] += feValue * jsy;
+                    fe[3*m+2] += feValue * jsz;
                 }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
+                this->assemblyMatrix(elementID,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 }
 
 void RSolverMagnetostatics::solve(void)
@@ -179,7 +177,7 @@ void RSolverMagnetostatics::solve(void)
     {
         RLogger::indent();
         RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1);
+        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,1,&this->matrixDeflation);
         RLogger::unindent();
     }
     catch (RError error)
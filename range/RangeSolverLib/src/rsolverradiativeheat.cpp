@@ -65,6 +65,28 @@ bool RSolverRadiativeHeat::hasConverged(void) const
     return (convergenceRate < RConstants::eps);
 }
 
+void RSolverRadiativeHeat::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RFileIO::writeBinary(outFile,this->elementTemperature,true);
+    RFileIO::writeBinary(outFile,this->elementRadiativeHeat,true);
+    RFileIO::writeBinary(outFile,this->patchHeat,true);
+    RFileIO::writeBinary(outFile,this->patchHeatNorm);
+    RFileIO::writeBinary(outFile,this->oldPatchHeatNorm);
+}
+
+void RSolverRadiativeHeat::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RFileIO::readBinary(inFile,this->elementTemperature,true);
+    RFileIO::readBinary(inFile,this->elementRadiativeHeat,true);
+    RFileIO::readBinary(inFile,this->patchHeat,true);
+    RFileIO::readBinary(inFile,this->patchHeatNorm);
+    RFileIO::readBinary(inFile,this->oldPatchHeatNorm);
+}
+
 double RSolverRadiativeHeat::findTemperatureScale(void) const
 {
     return 1.0;
@@ -190,11 +212,10 @@ void RSolverRadiativeHeat::prepare(void)
 
     // Resize computatioal arrays.
     this->b.resize(rPatchBook.getNPatches());
-    this->x.resize(rPatchBook.getNPatches());
 
     this->A.clear();
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(rPatchBook.getNPatches());
 
     RRVector patchEmissivity(rPatchBook.getNPatches(),0.0);
     RRVector patchTemperature(rPatchBook.getNPatches(),0.0);
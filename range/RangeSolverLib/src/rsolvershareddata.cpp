@@ -63,3 +63,29 @@ void RSolverSharedData::clearData(void)
     this->data.clear();
 }
 
+void RSolverSharedData::writeCheckpoint(RSaveFile &outFile) const
+{
+    RFileIO::writeBinary(outFile,uint(this->data.size()));
+    QMap<QString,RRVector>::const_iterator iter;
+    for (iter = this->data.constBegin(); iter != this->data.constEnd(); ++iter)
+    {
+        RFileIO::writeBinary(outFile,iter.key());
+        RFileIO::writeBinary(outFile,iter.value(),true);
+    }
+}
+
+void RSolverSharedData::readCheckpoint(RFile &inFile)
+{
+    this->data.clear();
+
+    uint nData = 0;
+    RFileIO::readBinary(inFile,nData);
+    for (uint i=0;i<nData;i++)
+    {
+        QString name;
+        RRVector values;
+        RFileIO::readBinary(inFile,name);
+        RFileIO::readBinary(inFile,values,true);
+        this->data[name] = values;
+    }
+}
@@ -9,6 +9,7 @@
  *********************************************************************/
 
 #include <cmath>
+#include <algorithm>
 
 #include "rsolverstress.h"
 #include "rmatrixsolver.h"
@@ -64,6 +65,28 @@ bool RSolverStress::hasConverged(void) const
     return true;
 }
 
+void RSolverStress::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeDisplacement);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeInitialDisplacement);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeForce);
+    RSolverGeneric::writeCheckpointVector(outFile,this->nodeAcceleration);
+    RFileIO::writeBinary(outFile,this->nodePressure,true);
+}
+
+void RSolverStress::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeDisplacement);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeInitialDisplacement);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeForce);
+    RSolverGeneric::readCheckpointVector(inFile,this->nodeAcceleration);
+    RFileIO::readBinary(inFile,this->nodePressure,true);
+}
+
 void RSolverStress::updateScales(void)
 {
     this->scales.setMetre(this->findMeshScale());
@@ -157,23 +180,23 @@ void RSolverStress::prepare(void)
     this->generateVariableVector(R_VARIABLE_TEMPERATURE,this->elementEnvironmentTemperature,temperatureSetValues,false,false,true);
 
     this->b.resize(this->nodeBook.getNEnabled());
-    this->x.resize(this->nodeBook.getNEnabled());
 
     this->M.clear();
     this->A.clear();
     this->b.fill(0.0);
-    this->x.fill(0.0);
-
-    this->pModel->convertElementToNodeVector(elementDisplacement.x,displacementSetValues.x,this->nodeDisplacement.x,true);
-    this->pModel->convertElementToNodeVector(elementDisplacement.y,displacementSetValues.y,this->nodeDisplacement.y,true);
-    this->pModel->convertElementToNodeVector(elementDisplacement.z,displacementSetValues.z,this->nodeDisplacement.z,true);
-    this->pModel->convertElementToNodeVector(elementForce.x,forceSetValues.x,this->nodeForce.x,true);
-    this->pModel->convertElementToNodeVector(elementForce.y,forceSetValues.y,this->nodeForce.y,true);
-    this->pModel->convertElementToNodeVector(elementForce.z,forceSetValues.z,this->nodeForce.z,true);
-    this->pModel->convertElementToNodeVector(elementAcceleration.x,accelerationSetValues.x,this->nodeAcceleration.x,true);
-    this->pModel->convertElementToNodeVector(elementAcceleration.y,accelerationSetValues.y,this->nodeAcceleration.y,true);
-    this->pModel->convertElementToNodeVector(elementAcceleration.z,accelerationSetValues.z,this->nodeAcceleration.z,true);
-    this->pModel->convertElementToNodeVector(elementPressure,pressureSetValues,this->nodePressure,true);
+    this->initializeSolution(this->nodeBook.getNEnabled());
+    this->updateGeometricFactors();
+
+    this->nodeElementIncidence.convertElementToNode(elementDisplacement.x,displacementSetValues.x,this->nodeDisplacement.x,true);
+    this->nodeElementIncidence.convertElementToNode(elementDisplacement.y,displacementSetValues.y,this->nodeDisplacement.y,true);
+    this->nodeElementIncidence.convertElementToNode(elementDisplacement.z,displacementSetValues.z,this->nodeDisplacement.z,true);
+    this->nodeElementIncidence.convertElementToNode(elementForce.x,forceSetValues.x,this->nodeForce.x,true);
+    this->nodeElementIncidence.convertElementToNode(elementForce.y,forceSetValues.y,this->nodeForce.y,true);
+    this->nodeElementIncidence.convertElementToNode(elementForce.z,forceSetValues.z,this->nodeForce.z,true);
+    this->nodeElementIncidence.convertElementToNode(elementAcceleration.x,accelerationSetValues.x,this->nodeAcceleration.x,true);
+    this->nodeElementIncidence.convertElementToNode(elementAcceleration.y,accelerationSetValues.y,this->nodeAcceleration.y,true);
+    this->nodeElementIncidence.convertElementToNode(elementAcceleration.z,accelerationSetValues.z,this->nodeAcceleration.z,true);
+    this->nodeElementIncidence.convertElementToNode(elementPressure,pressureSetValues,this->nodePressure,true);
 
     // Convert node pressure to element pressure
     for (uint i=0;i<elementPressure.size();i++)
@@ -209,549 +232,464 @@ void RSolverStress::prepare(void)
     }
 
     // Prepare point elements.
-    for (uint i=0;i<this->pModel->getNPoints();i++)
+    bool abort = false;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->pointElements.size());j++)
     {
-        RPoint &point = this->pModel->getPoint(i);
-        double pointVolume = point.getVolume();
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(point.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
+            continue;
+        }
+        try
+        {
+            uint elementID = this->pointElements.getElementID(j);
+            const RPoint &point = this->pModel->getPoint(this->pointElements.getEntityID(j));
+            double pointVolume = point.getVolume();
+
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
+            RRMatrix Me(3,3);
+            RRMatrix Ke(3,3);
+            RRVector fe(3);
+
+            Me.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
+
+            // Force
+            fe[0] += elementForce.x[elementID];
+            fe[1] += elementForce.y[elementID];
+            fe[2] += elementForce.z[elementID];
+            // Weight
+            fe[0] += elementWeight[elementID] * elementGravity.x[elementID];
+            fe[1] += elementWeight[elementID] * elementGravity.y[elementID];
+            fe[2] += elementWeight[elementID] * elementGravity.z[elementID];
+            // Own weight
+            if (pointVolume > 0.0)
             {
-                continue;
+                fe[0] += elementGravity.x[elementID] * this->elementDensity[elementID] * pointVolume;
+                fe[1] += elementGravity.y[elementID] * this->elementDensity[elementID] * pointVolume;
+                fe[2] += elementGravity.z[elementID] * this->elementDensity[elementID] * pointVolume;
             }
-            try
-            {
-                uint elementID = point.get(uint(j));
-
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_POINT(element.getType()));
-                RRMatrix Me(3,3);
-                RRMatrix Ke(3,3);
-                RRVector fe(3);
-
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                // Force
-                fe[0] += elementForce.x[elementID];
-                fe[1] += elementForce.y[elementID];
-                fe[2] += elementForce.z[elementID];
-                // Weight
-                fe[0] += elementWeight[elementID] * elementGravity.x[elementID];
-                fe[1] += elementWeight[elementID] * elementGravity.y[elementID];
-                fe[2] += elementWeight[elementID] * elementGravity.z[elementID];
-                // Own weight
-                if (pointVolume > 0.0)
-                {
-                    fe[0] += elementGravity.x[elementID] * this->elementDensity[elementID] * pointVolume;
-                    fe[1] += elementGravity.y[elementID] * this->elementDensity[elementID] * pointVolume;
-                    fe[2] += elementGravity.z[elementID] * this->elementDensity[elementID] * pointVolume;
-                }
-
-                // Mass
-                if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
-                {
-                    Me.setIdentity(3);
-                    Me *= this->elementDensity[elementID] * pointVolume;
-                }
 
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ke,fe);
-                }
+            // Mass
+            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+            {
+                Me.setIdentity(3);
+                Me *= this->elementDensity[elementID] * pointVolume;
             }
-            catch (const RError &rError)
+
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
-                #pragma omp flush (abort)
+                this->assemblyMatrix(elementID,Me,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
+            #pragma omp flush (abort)
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare line elements.
-    for (uint i=0;i<this->pModel->getNLines();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->lineElements.size());j++)
     {
-        RLine &line = this->pModel->getLine(i);
-        double lineCrossArea = line.getCrossArea();
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = line.get(uint(j));
-
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            continue;
+        }
+        try
+        {
+            uint elementID = this->lineElements.getElementID(j);
+            const RLine &line = this->pModel->getLine(this->lineElements.getEntityID(j));
+            double lineCrossArea = line.getCrossArea();
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size()*3,element.size()*3,0.0);
-                RRMatrix Ke(element.size()*3,element.size()*3,0.0);
-                RRVector fe(element.size()*3,0.0);
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size()*3,element.size()*3,0.0);
+            RRMatrix Ke(element.size()*3,element.size()*3,0.0);
+            RRVector fe(element.size()*3,0.0);
 
-                RRMatrix Be(3*element.size(),1);
-                RRMatrix BeT(1,3*element.size());
+            RRMatrix Be(3*element.size(),1);
+            RRMatrix BeT(1,3*element.size());
 
-                double lineLength = 0.0;
-                element.findLength(this->pModel->getNodes(),lineLength);
+            double lineLength = 0.0;
+            element.findLength(this->pModel->getNodes(),lineLength);
 
-                double E = this->elementElasticityModulus[elementID];
-                double De = E * lineCrossArea;
+            double E = this->elementElasticityModulus[elementID];
+            double De = E * lineCrossArea;
 
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+            double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
 
-                for (uint k=0;k<nInp;k++)
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
+                if (lineCrossArea > 0.0)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-                    if (lineCrossArea > 0.0)
+                    Be.fill(0.0);
+                    for (uint m=0;m<dN.getNRows();m++)
                     {
-                        Be.fill(0.0);
-                        for (uint m=0;m<dN.getNRows();m++)
-                        {
-                            Be[3*m+0][0] += Rt[3*m+0][0]*dN[m][0]*J[0][0];
-                            Be[3*m+1][0] += Rt[3*m+1][0]*dN[m][0]*J[0][0];
-                            Be[3*m+2][0] += Rt[3*m+2][0]*dN[m][0]*J[0][0];
-                        }
-                        BeT.transpose(Be);
-                        Be *= De;
-                        RRMatrix::mlt(Be,BeT,Ke);
+                        Be[3*m+0][0] += Rt[3*m+0][0]*dN[m][0]*J[0][0];
+                        Be[3*m+1][0] += Rt[3*m+1][0]*dN[m][0]*J[0][0];
+                        Be[3*m+2][0] += Rt[3*m+2][0]*dN[m][0]*J[0][0];
                     }
+                    BeT.transpose(Be);
+                    Be *= De;
+                    RRMatrix::mlt(Be,BeT,Ke);
+                }
 
-                    for (uint m=0;m<element.size();m++)
+                for (uint m=0;m<element.size();m++)
+                {
+                    if (lineCrossArea > 0.0)
                     {
-                        if (lineCrossArea > 0.0)
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
                         {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                            for (uint n=0;n<element.size();n++)
                             {
-                                for (uint n=0;n<element.size();n++)
-                                {
-                                    double value = N[m] * N[n]
-                                                 * this->elementDensity[elementID]
-                                                 * detJ
-                                                 * shapeFunc.getW()
-                                                 * lineCrossArea;
-                                    Me[3*m+0][3*n+0] += std::pow(Rt[0][0],2.0)*value;
-                                    Me[3*m+1][3*n+1] += std::pow(Rt[1][0],2.0)*value;
-                                    Me[3*m+2][3*n+2] += std::pow(Rt[2][0],2.0)*value;
-                                }
+                                double value = N[m] * N[n]
+                                             * this->elementDensity[elementID]
+                                             * detJ
+                                             * shapeFunc.getW()
+                                             * lineCrossArea;
+                                Me[3*m+0][3*n+0] += std::pow(Rt[0][0],2.0)*value;
+                                Me[3*m+1][3*n+1] += std::pow(Rt[1][0],2.0)*value;
+                                Me[3*m+2][3*n+2] += std::pow(Rt[2][0],2.0)*value;
                             }
                         }
+                    }
 
-                        double integValue = N[m] * detJ * shapeFunc.getW();
-
-                        // Force
-                        fe[3*m+0] += (elementForce.x[elementID] / lineLength) * integValue;
-                        fe[3*m+1] += (elementForce.y[elementID] / lineLength) * integValue;
-                        fe[3*m+2] += (elementForce.z[elementID] / lineLength) * integValue;
-                        // Weight
-                        fe[3*m+0] += (elementWeight[elementID] * elementGravity.x[elementID] / lineLength) * integValue;
-                        fe[3*m+1] += (elementWeight[elementID] * elementGravity.y[elementID] / lineLength) * integValue;
-                        fe[3*m+2] += (elementWeight[elementID] * elementGravity.z[elementID] / lineLength) * integValue;
-                        // Own weight
-                        if (lineCrossArea > 0.0)
-                        {
-                            fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
-                            fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
-                            fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
-                        }
+                    double integValue = N[m] * detJ * shapeFunc.getW();
+
+                    // Force
+                    fe[3*m+0] += (elementForce.x[elementID] / lineLength) * integValue;
+                    fe[3*m+1] += (elementForce.y[elementID] / lineLength) * integValue;
+                    fe[3*m+2] += (elementForce.z[elementID] / lineLength) * integValue;
+                    // Weight
+                    fe[3*m+0] += (elementWeight[elementID] * elementGravity.x[elementID] / lineLength) * integValue;
+                    fe[3*m+1] += (elementWeight[elementID] * elementGravity.y[elementID] / lineLength) * integValue;
+                    fe[3*m+2] += (elementWeight[elementID] * elementGravity.z[elementID] / lineLength) * integValue;
+                    // Own weight
+                    if (lineCrossArea > 0.0)
+                    {
+                        fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
+                        fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
+                        fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * lineCrossArea * integValue;
+                    }
 
-                        // Thermal expansion
-                        if (lineCrossArea > 0.0)
-                        {
-                            double fet = this->elementThermalExpansion[elementID] * dT * De * Be[m][0] * lineCrossArea * detJ * shapeFunc.getW();
+                    // Thermal expansion
+                    if (lineCrossArea > 0.0)
+                    {
+                        double fet = this->elementThermalExpansion[elementID] * dT * De * Be[m][0] * lineCrossArea * detJ * shapeFunc.getW();
 
-                            fe[3*m+0] += Rt[3*m+0][0]*fet;
-                            fe[3*m+1] += Rt[3*m+1][0]*fet;
-                            fe[3*m+2] += Rt[3*m+2][0]*fet;
-                        }
+                        fe[3*m+0] += Rt[3*m+0][0]*fet;
+                        fe[3*m+1] += Rt[3*m+1][0]*fet;
+                        fe[3*m+2] += Rt[3*m+2][0]*fet;
                     }
                 }
-                #pragma omp critical
-                {
-                    this->assemblyMatrix(elementID,Me,Ke,fe);
-                }
             }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
-                {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
-                }
-                #pragma omp flush (abort)
+                this->assemblyMatrix(elementID,Me,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
+            #pragma omp flush (abort)
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
-    // Prepare surface elements.
+    // Area of each surface.
+    RRVector surfaceAreas(this->pModel->getNSurfaces(),0.0);
     for (uint i=0;i<this->pModel->getNSurfaces();i++)
     {
-        RSurface &surface = this->pModel->getSurface(i);
-        double surfaceArea = surface.findArea(this->pModel->getNodes(),this->pModel->getElements());
-        double surfaceThickness = surface.getThickness();
+        surfaceAreas[i] = this->pModel->getSurface(i).findArea(this->pModel->getNodes(),this->pModel->getElements());
+    }
 
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+    // Prepare surface elements.
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->includableSurfaceElements.size());j++)
+    {
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
-            {
-                uint elementID = surface.get(uint(j));
-
-                if (!this->computableElements[elementID] && !this->includableElements[elementID])
-                {
-                    continue;
-                }
-
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size()*3,element.size()*3);
-                RRMatrix Ke(element.size()*3,element.size()*3);
-                RRVector fe(element.size()*3);
-
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                RRMatrix B(element.size(),3);
-                RRMatrix Be(element.size()*2,3);
-                RRMatrix BeT(3,element.size()*2);
-                RRMatrix BeD(element.size()*2,3);
-                RRMatrix Met(element.size()*2,element.size()*2);
-                RRMatrix MeRt(element.size()*3,element.size()*2);
-                RRMatrix Ket(element.size()*2,element.size()*2);
-                RRMatrix KeRt(element.size()*3,element.size()*2);
-                RRVector fet(element.size()*2);
-
-                RRMatrix De(3,3,0.0);
-
-                double E = this->elementElasticityModulus[elementID];
-                double v = this->elementPoissonRatio[elementID];
-
-                De[0][0] = 1-v;   De[0][1] = v;
-                De[1][0] = v;     De[1][1] = 1-v;
-                De[2][2] = (1-2*v)/2;
-                De *= E/((1+v)*(1-2*v));
-
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
-
-                RR3Vector normal;
-                element.findNormal(this->pModel->getNodes(),normal[0],normal[1],normal[2]);
+            continue;
+        }
+        try
+        {
+            uint elementID = this->includableSurfaceElements.getElementID(j);
+            uint surfaceID = this->includableSurfaceElements.getEntityID(j);
+            const RSurface &surface = this->pModel->getSurface(surfaceID);
+            double surfaceArea = surfaceAreas[surfaceID];
+            double surfaceThickness = surface.getThickness();
 
-                for (uint k=0;k<nInp;k++)
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size()*3,element.size()*3);
+            RRMatrix Ke(element.size()*3,element.size()*3);
+            RRVector fe(element.size()*3);
+
+            Me.fill(0.0);
+            Ke.fill(0.0);
+            fe.fill(0.0);
+
+            RRMatrix B(element.size(),3);
+            RRMatrix Be(element.size()*2,3);
+            RRMatrix BeT(3,element.size()*2);
+            RRMatrix BeD(element.size()*2,3);
+            RRMatrix Met(element.size()*2,element.size()*2);
+            RRMatrix MeRt(element.size()*3,element.size()*2);
+            RRMatrix Ket(element.size()*2,element.size()*2);
+            RRMatrix KeRt(element.size()*3,element.size()*2);
+            RRVector fet(element.size()*2);
+
+            RRMatrix De(3,3,0.0);
+
+            double E = this->elementElasticityModulus[elementID];
+            double v = this->elementPoissonRatio[elementID];
+
+            De[0][0] = 1-v;   De[0][1] = v;
+            De[1][0] = v;     De[1][1] = 1-v;
+            De[2][2] = (1-2*v)/2;
+            De *= E/((1+v)*(1-2*v));
+
+            double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+
+            RR3Vector normal;
+            element.findNormal(this->pModel->getNodes(),normal[0],normal[1],normal[2]);
+
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt, RtT;
+                double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
+                RtT.transpose(Rt);
+
+                if (surfaceThickness > 0.0)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt, RtT;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-                    RtT.transpose(Rt);
-
-                    if (surfaceThickness > 0.0)
+                    B.fill(0.0);
+                    for (uint m=0;m<dN.getNRows();m++)
                     {
-                        B.fill(0.0);
-                        for (uint m=0;m<dN.getNRows();m++)
-                        {
-                            B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                            B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
-                        }
-
-                        for (uint m=0;m<element.size();m++)
-                        {
-                            Be[2*m][0] = B[m][0];   Be[2*m+1][0] = 0.0;
-                            Be[2*m][1] = 0.0;       Be[2*m+1][1] = B[m][1];
-                            Be[2*m][2] = B[m][1];   Be[2*m+1][2] = B[m][0];
-                        }
-                        BeT.transpose(Be);
-
-                        RRMatrix::mlt(Be,De,BeD);
-                        RRMatrix::mlt(BeD,BeT,Ket);
-                        RRMatrix::mlt(Rt,Ket,KeRt);
-                        RRMatrix::mlt(KeRt,RtT,Ke);
-                        Ke *= detJ * shapeFunc.getW();
+                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
+                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
                     }
 
                     for (uint m=0;m<element.size();m++)
                     {
-                        if (surfaceThickness > 0.0)
-                        {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
-                            {
-                                for (uint n=0;n<element.size();n++)
-                                {
-                                    double value = N[m] * N[n]
-                                                 * this->elementDensity[elementID]
-                                                 * detJ
-                                                 * shapeFunc.getW()
-                                                 * surfaceThickness;
-                                    Met[2*m+0][2*n+0] += value;
-                                    Met[2*m+1][2*n+1] += value;
-                                }
-                            }
-                        }
+                        Be[2*m][0] = B[m][0];   Be[2*m+1][0] = 0.0;
+                        Be[2*m][1] = 0.0;       Be[2*m+1][1] = B[m][1];
+                        Be[2*m][2] = B[m][1];   Be[2*m+1][2] = B[m][0];
+                    }
+                    BeT.transpose(Be);
 
-                        double integValue = N[m] * detJ * shapeFunc.getW();
-
-                        // Pressure vector
-                        fe[3*m+0] += elementPressure[elementID] * normal[0] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
-                        fe[3*m+1] += elementPressure[elementID] * normal[1] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
-                        fe[3*m+2] += elementPressure[elementID] * normal[2] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
-                        // Force per unit area
-                        fe[3*m+0] += elementForceUnitArea.x[elementID] * integValue;
-                        fe[3*m+1] += elementForceUnitArea.y[elementID] * integValue;
-                        fe[3*m+2] += elementForceUnitArea.z[elementID] * integValue;
-                        // Force
-                        fe[3*m+0] += (elementForce.x[elementID] / surfaceArea) * integValue;
-                        fe[3*m+1] += (elementForce.y[elementID] / surfaceArea) * integValue;
-                        fe[3*m+2] += (elementForce.z[elementID] / surfaceArea) * integValue;
-                        // Weight
-                        fe[3*m+0] += (elementWeight[elementID] * elementGravity.x[elementID] / surfaceArea) * integValue;
-                        fe[3*m+1] += (elementWeight[elementID] * elementGravity.y[elementID] / surfaceArea) * integValue;
-                        fe[3*m+2] += (elementWeight[elementID] * elementGravity.z[elementID] / surfaceArea) * integValue;
-                        // Own weight
-                        if (surfaceThickness > 0.0)
-                        {
-                            fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
-                            fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
-                            fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
-                        }
+                    RRMatrix::mlt(Be,De,BeD);
+                    RRMatrix::mlt(BeD,BeT,Ket);
+                    RRMatrix::mlt(Rt,Ket,KeRt);
+                    RRMatrix::mlt(KeRt,RtT,Ke);
+                    Ke *= detJ * shapeFunc.getW();
+                }
 
-                        // Thermal expansion
-                        if (surfaceThickness > 0.0)
+                for (uint m=0;m<element.size();m++)
+                {
+                    if (surfaceThickness > 0.0)
+                    {
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
                         {
-                            fet.fill(0.0);
-                            for (uint n=0;n<3;n++)
+                            for (uint n=0;n<element.size();n++)
                             {
-                                fet[2*m+0] += this->elementThermalExpansion[elementID] * dT * BeD[2*m+0][n] * surfaceThickness * detJ * shapeFunc.getW();
-                                fet[2*m+1] += this->elementThermalExpansion[elementID] * dT * BeD[2*m+1][n] * surfaceThickness * detJ * shapeFunc.getW();
+                                double value = N[m] * N[n]
+                                             * this->elementDensity[elementID]
+                                             * detJ
+                                             * shapeFunc.getW()
+                                             * surfaceThickness;
+                                Met[2*m+0][2*n+0] += value;
+                                Met[2*m+1][2*n+1] += value;
                             }
-
-                            fe[3*m+0] += Rt[3*m+0][0]*fet[2*m+0] + Rt[3*m+0][1]*fet[2*m+1];
-                            fe[3*m+1] += Rt[3*m+1][0]*fet[2*m+0] + Rt[3*m+1][1]*fet[2*m+1];
-                            fe[3*m+2] += Rt[3*m+2][0]*fet[2*m+0] + Rt[3*m+2][1]*fet[2*m+1];
                         }
                     }
 
-                    // Mass
-                    if (surfaceThickness > 0.0 && (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL))
+                    double integValue = N[m] * detJ * shapeFunc.getW();
+
+                    // Pressure vector
+                    fe[3*m+0] += elementPressure[elementID] * normal[0] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
+                    fe[3*m+1] += elementPressure[elementID] * normal[1] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
+                    fe[3*m+2] += elementPressure[elementID] * normal[2] * integValue * (this->inwardElements[elementID] ? 1.0 : -1.0);
+                    // Force per unit area
+                    fe[3*m+0] += elementForceUnitArea.x[elementID] * integValue;
+                    fe[3*m+1] += elementForceUnitArea.y[elementID] * integValue;
+                    fe[3*m+2] += elementForceUnitArea.z[elementID] * integValue;
+                    // Force
+                    fe[3*m+0] += (elementForce.x[elementID] / surfaceArea) * integValue;
+                    fe[3*m+1] += (elementForce.y[elementID] / surfaceArea) * integValue;
+                    fe[3*m+2] += (elementForce.z[elementID] / surfaceArea) * integValue;
+                    // Weight
+                    fe[3*m+0] += (elementWeight[elementID] * elementGravity.x[elementID] / surfaceArea) * integValue;
+                    fe[3*m+1] += (elementWeight[elementID] * elementGravity.y[elementID] / surfaceArea) * integValue;
+                    fe[3*m+2] += (elementWeight[elementID] * elementGravity.z[elementID] / surfaceArea) * integValue;
+                    // Own weight
+                    if (surfaceThickness > 0.0)
                     {
-                        RRMatrix::mlt(Rt,Met,MeRt);
-                        RRMatrix::mlt(MeRt,RtT,Me,true);
+                        fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
+                        fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
+                        fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * surfaceThickness * integValue;
                     }
-                    if (!this->computableElements[elementID])
+
+                    // Thermal expansion
+                    if (surfaceThickness > 0.0)
                     {
-                        Me.fill(0.0);
-                        Ke.fill(0.0);
+                        fet.fill(0.0);
+                        for (uint n=0;n<3;n++)
+                        {
+                            fet[2*m+0] += this->elementThermalExpansion[elementID] * dT * BeD[2*m+0][n] * surfaceThickness * detJ * shapeFunc.getW();
+                            fet[2*m+1] += this->elementThermalExpansion[elementID] * dT * BeD[2*m+1][n] * surfaceThickness * detJ * shapeFunc.getW();
+                        }
+
+                        fe[3*m+0] += Rt[3*m+0][0]*fet[2*m+0] + Rt[3*m+0][1]*fet[2*m+1];
+                        fe[3*m+1] += Rt[3*m+1][0]*fet[2*m+0] + Rt[3*m+1][1]*fet[2*m+1];
+                        fe[3*m+2] += Rt[3*m+2][0]*fet[2*m+0] + Rt[3*m+2][1]*fet[2*m+1];
                     }
                 }
-                #pragma omp critical
+
+                // Mass
+                if (surfaceThickness > 0.0 && (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL))
                 {
-                    this->assemblyMatrix(elementID,Me,Ke,fe);
+                    RRMatrix::mlt(Rt,Met,MeRt);
+                    RRMatrix::mlt(MeRt,RtT,Me,true);
                 }
-            }
-            catch (const RError &rError)
-            {
-                #pragma omp critical
+                if (!this->computableElements[elementID])
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    Me.fill(0.0);
+                    Ke.fill(0.0);
                 }
-                #pragma omp flush (abort)
+            }
+            #pragma omp critical
+            {
+                this->assemblyMatrix(elementID,Me,Ke,fe);
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
+            #pragma omp flush (abort)
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
 
     // Prepare volume elements.
-    for (uint i=0;i<this->pModel->getNVolumes();i++)
+    // Elements are sorted by type, consecutive elements of the same type are integrated in batches.
+    int64_t nVolumeBatches = (int64_t(this->volumeElements.size()) + R_ELEMENT_BATCH_SIZE - 1) / R_ELEMENT_BATCH_SIZE;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE/R_ELEMENT_BATCH_SIZE)
+    for (int64_t jb=0;jb<nVolumeBatches;jb++)
     {
-        RVolume &volume = this->pModel->getVolume(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
-            {
-                continue;
-            }
-            try
+            continue;
+        }
+        try
+        {
+            uint jStart = uint(jb * R_ELEMENT_BATCH_SIZE);
+            uint jEnd = std::min(jStart + R_ELEMENT_BATCH_SIZE,this->volumeElements.size());
+
+            RElementBatch<4,4> tetra1Batch;
+
+            for (uint j=jStart;j<jEnd;j++)
             {
-                uint elementID = volume.get(uint(j));
+                uint elementID = this->volumeElements.getElementID(j);
 
-                if (!this->computableElements[elementID])
+                const RElement &element = this->pModel->getElement(elementID);
+                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+
+                if (element.getType() == R_ELEMENT_TETRA1)
                 {
+                    tetra1Batch.add(elementID);
                     continue;
                 }
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
                 RRMatrix Me(element.size()*3,element.size()*3);
                 RRMatrix Ke(element.size()*3,element.size()*3);
                 RRVector fe(element.size()*3);
 
-                Me.fill(0.0);
-                Ke.fill(0.0);
-                fe.fill(0.0);
-
-                RRMatrix B(element.size(),3);
-                RRMatrix Be(element.size()*3,6);
-                RRMatrix BeT(6,element.size()*3);
-                RRMatrix BeD(element.size()*3,6);
-                RRMatrix Ket(element.size()*3,element.size()*3);
+                this->computeVolumeElement(elementID,elementGravity,Me,Ke,fe);
 
-                RRMatrix De(6,6);
-                De.fill(0.0);
-
-                double E = this->elementElasticityModulus[elementID];
-                double v = this->elementPoissonRatio[elementID];
-
-                De[0][0] = 1.0-v; De[0][1] = v;     De[0][2] = v;
-                De[1][0] = v;     De[1][1] = 1.0-v; De[1][2] = v;
-                De[2][0] = v;     De[2][1] = v;     De[2][2] = 1.0-v;
-                De[3][3] = De[4][4] = De[5][5] = (1.0-2.0*v)/2.0;
-                De *= E/((1.0+v)*(1.0-2.0*v));
-
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
-
-                for (uint k=0;k<nInp;k++)
-                {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
-                    }
-
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        Be[3*m+0][0] = B[m][0];   Be[3*m+1][0] = 0.0;       Be[3*m+2][0] = 0.0;
-                        Be[3*m+0][1] = 0.0;       Be[3*m+1][1] = B[m][1];   Be[3*m+2][1] = 0.0;
-                        Be[3*m+0][2] = 0.0;       Be[3*m+1][2] = 0.0;       Be[3*m+2][2] = B[m][2];
-                        Be[3*m+0][3] = 0.0;       Be[3*m+1][3] = B[m][2];   Be[3*m+2][3] = B[m][1];
-                        Be[3*m+0][4] = B[m][2];   Be[3*m+1][4] = 0.0;       Be[3*m+2][4] = B[m][0];
-                        Be[3*m+0][5] = B[m][1];   Be[3*m+1][5] = B[m][0];   Be[3*m+2][5] = 0.0;
-                    }
-                    BeT.transpose(Be);
-
-                    RRMatrix::mlt(Be,De,BeD);
-                    RRMatrix::mlt(BeD,BeT,Ket);
-                    for (uint m=0;m<3*element.size();m++)
-                    {
-                        for (uint n=0;n<3*element.size();n++)
-                        {
-                            // Stiffness matrix
-                            Ke[m][n] += Ket[m][n] * detJ * shapeFunc.getW();
-                        }
-                    }
-
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        for (uint n=0;n<element.size();n++)
-                        {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
-                            {
-                                double value = N[m] * N[n]
-                                             * this->elementDensity[elementID]
-                                             * detJ
-                                             * shapeFunc.getW();
-                                Me[3*m+0][3*n+0] += value;
-                                Me[3*m+1][3*n+1] += value;
-                                Me[3*m+2][3*n+2] += value;
-                            }
-                        }
-
-                        // Own weight
-                        fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
-                        fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
-                        fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * N[m] * detJ * shapeFunc.getW();
-
-                        // Thermal expansion
-                        for (uint n=0;n<3;n++)
-                        {
-                            fe[3*m+0] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+0][n] * detJ * shapeFunc.getW();
-                            fe[3*m+1] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+1][n] * detJ * shapeFunc.getW();
-                            fe[3*m+2] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+2][n] * detJ * shapeFunc.getW();
-                        }
-                    }
-                }
                 #pragma omp critical
                 {
                     this->assemblyMatrix(elementID,Me,Ke,fe);
                 }
             }
-            catch (const RError &rError)
+
+            if (tetra1Batch.size() > 0)
             {
+                tetra1Batch.gather(this->geometricFactors,R_ELEMENT_TETRA1);
+
+                RElementBatchMatrix<12,12> Mb, Kb;
+                RElementBatchVector<12> fb;
+                this->computeVolumeElementBatch<4,4>(tetra1Batch,elementGravity,Mb,Kb,fb);
+
                 #pragma omp critical
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    RFixedMatrix<12,12> Me, Ke;
+                    RFixedVector<12> fe;
+                    for (uint l=0;l<tetra1Batch.size();l++)
+                    {
+                        Mb.getLane(l,Me);
+                        Kb.getLane(l,Ke);
+                        fb.getLane(l,fe);
+                        this->assemblyMatrix(tetra1Batch.getElementID(l),Me,Ke,fe);
+                    }
                 }
-                #pragma omp flush (abort)
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
+            #pragma omp flush (abort)
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to prepare matrix system.");
+    }
     if (this->problemType == R_PROBLEM_STRESS_MODAL)
     {
         RLogger::info("Restoring prestressed nodes\n");
@@ -789,7 +727,7 @@ void RSolverStress::solveStressStrain(void)
     {
         RLogger::indent();
         RMatrixSolver matrixSolver(this->pModel->getMatrixSolverConf(RMatrixSolverConf::CG));
-        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,3);
+        matrixSolver.solve(this->A,this->b,this->x,R_MATRIX_PRECONDITIONER_JACOBI,3,&this->matrixDeflation);
         RLogger::unindent();
     }
     catch (const RError &error)
@@ -906,549 +844,519 @@ void RSolverStress::process(void)
     this->elementVonMisses.resize(this->pModel->getNElements(),0.0);
 
     // Process line elements.
-    for (uint i=0;i<this->pModel->getNLines();i++)
+    bool abort = false;
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->lineElements.size());j++)
     {
-        RLine &line = this->pModel->getLine(i);
-        double lineCrossArea = line.getCrossArea();
-
-        if (lineCrossArea == 0.0)
+        #pragma omp flush (abort)
+        if (abort)
         {
             continue;
         }
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(line.size());j++)
+        try
         {
-            #pragma omp flush (abort)
-            if (abort)
+            uint elementID = this->lineElements.getElementID(j);
+            const RLine &line = this->pModel->getLine(this->lineElements.getEntityID(j));
+            double lineCrossArea = line.getCrossArea();
+
+            if (lineCrossArea == 0.0)
             {
                 continue;
             }
-            try
+
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size()*3,element.size()*3,0.0);
+            RRMatrix Ke(element.size()*3,element.size()*3,0.0);
+            RRVector fe(element.size()*3,0.0);
+            RRVector ae(element.size()*3,0.0);
+            RRVector xe(element.size()*3,0.0);
+            double QeN = 0.0;
+
+            RRMatrix Be(3*element.size(),1);
+            RRMatrix BeT(1,3*element.size());
+
+            double E = this->elementElasticityModulus[elementID];
+            double De = E * lineCrossArea;
+
+            RRMatrix Rl;
+            RRVector tl;
+            element.findTransformationMatrix(this->pModel->getNodes(),Rl,tl);
+            Rl.invert();
+
+            RRVector lxe(element.size(),0.0);
+            for (uint k=0;k<element.size();k++)
             {
-                uint elementID = line.get(uint(j));
+                RR3Vector xg(this->nodeDisplacement.x[element.getNodeId(k)],
+                             this->nodeDisplacement.y[element.getNodeId(k)],
+                             this->nodeDisplacement.z[element.getNodeId(k)]);
+                RR3Vector xl;
+                RRMatrix::mlt(Rl,xg,xl);
+                lxe[k] = xl[0];
+            }
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+            for (uint k=0;k<element.size();k++)
+            {
+                ae[3*k+0] = this->nodeAcceleration.x[element.getNodeId(k)];
+                ae[3*k+1] = this->nodeAcceleration.y[element.getNodeId(k)];
+                ae[3*k+2] = this->nodeAcceleration.z[element.getNodeId(k)];
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_LINE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size()*3,element.size()*3,0.0);
-                RRMatrix Ke(element.size()*3,element.size()*3,0.0);
-                RRVector fe(element.size()*3,0.0);
-                RRVector ae(element.size()*3,0.0);
-                RRVector xe(element.size()*3,0.0);
-                double QeN = 0.0;
-
-                RRMatrix Be(3*element.size(),1);
-                RRMatrix BeT(1,3*element.size());
-
-                double E = this->elementElasticityModulus[elementID];
-                double De = E * lineCrossArea;
-
-                RRMatrix Rl;
-                RRVector tl;
-                element.findTransformationMatrix(this->pModel->getNodes(),Rl,tl);
-                Rl.invert();
-
-                RRVector lxe(element.size(),0.0);
-                for (uint k=0;k<element.size();k++)
-                {
-                    RR3Vector xg(this->nodeDisplacement.x[element.getNodeId(k)],
-                                 this->nodeDisplacement.y[element.getNodeId(k)],
-                                 this->nodeDisplacement.z[element.getNodeId(k)]);
-                    RR3Vector xl;
-                    RRMatrix::mlt(Rl,xg,xl);
-                    lxe[k] = xl[0];
-                }
+                xe[3*k+0] = this->nodeDisplacement.x[element.getNodeId(k)];
+                xe[3*k+1] = this->nodeDisplacement.y[element.getNodeId(k)];
+                xe[3*k+2] = this->nodeDisplacement.z[element.getNodeId(k)];
+            }
 
-                for (uint k=0;k<element.size();k++)
-                {
-                    ae[3*k+0] = this->nodeAcceleration.x[element.getNodeId(k)];
-                    ae[3*k+1] = this->nodeAcceleration.y[element.getNodeId(k)];
-                    ae[3*k+2] = this->nodeAcceleration.z[element.getNodeId(k)];
+            double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
 
-                    xe[3*k+0] = this->nodeDisplacement.x[element.getNodeId(k)];
-                    xe[3*k+1] = this->nodeDisplacement.y[element.getNodeId(k)];
-                    xe[3*k+2] = this->nodeDisplacement.z[element.getNodeId(k)];
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt, RtT;
+                double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
+                RtT.transpose(Rt);
+
+                Be.fill(0.0);
+                for (uint m=0;m<dN.getNRows();m++)
+                {
+                    Be[3*m+0][0] += Rt[0][0]*dN[m][0]*J[0][0];
+                    Be[3*m+1][0] += Rt[1][0]*dN[m][0]*J[0][0];
+                    Be[3*m+2][0] += Rt[2][0]*dN[m][0]*J[0][0];
                 }
+                BeT.transpose(Be);
 
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+                Be *= De;
+                RRMatrix::mlt(Be,BeT,Ke);
+                Ke *= detJ * shapeFunc.getW();
 
-                for (uint k=0;k<nInp;k++)
+                for (uint m=0;m<element.size();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt, RtT;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-                    RtT.transpose(Rt);
-
-                    Be.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        Be[3*m+0][0] += Rt[0][0]*dN[m][0]*J[0][0];
-                        Be[3*m+1][0] += Rt[1][0]*dN[m][0]*J[0][0];
-                        Be[3*m+2][0] += Rt[2][0]*dN[m][0]*J[0][0];
-                    }
-                    BeT.transpose(Be);
-
-                    Be *= De;
-                    RRMatrix::mlt(Be,BeT,Ke);
-                    Ke *= detJ * shapeFunc.getW();
-
-                    for (uint m=0;m<element.size();m++)
+                    if (lineCrossArea > 0.0)
                     {
-                        if (lineCrossArea > 0.0)
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
                         {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                            for (uint n=0;n<element.size();n++)
                             {
-                                for (uint n=0;n<element.size();n++)
-                                {
-                                    double value = N[m] * N[n]
-                                                 * this->elementDensity[elementID]
-                                                 * detJ
-                                                 * shapeFunc.getW()
-                                                 * lineCrossArea;
-                                    Me[3*m+0][3*n+0] += std::pow(Rt[0][0],2.0)*value;
-                                    Me[3*m+1][3*n+1] += std::pow(Rt[1][0],2.0)*value;
-                                    Me[3*m+2][3*n+2] += std::pow(Rt[2][0],2.0)*value;
-                                }
+                                double value = N[m] * N[n]
+                                             * this->elementDensity[elementID]
+                                             * detJ
+                                             * shapeFunc.getW()
+                                             * lineCrossArea;
+                                Me[3*m+0][3*n+0] += std::pow(Rt[0][0],2.0)*value;
+                                Me[3*m+1][3*n+1] += std::pow(Rt[1][0],2.0)*value;
+                                Me[3*m+2][3*n+2] += std::pow(Rt[2][0],2.0)*value;
                             }
                         }
                     }
-
-                    double integValue = 1.0/double(nInp);
-
-                    // Element level stress.
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        QeN += dN[m][0]*J[0][0] * De * lxe[m] * integValue;
-                        QeN -= dN[m][0]*J[0][0] * De * this->elementThermalExpansion[elementID] * dT * lineCrossArea * integValue;
-                    }
                 }
 
-                RRVector fae, fxe;
-                RRMatrix::mlt(Me,ae,fae);
-                RRMatrix::mlt(Ke,xe,fxe);
-                RRVector::add(fae,fxe,fe);
+                double integValue = 1.0/double(nInp);
 
-                #pragma omp critical
+                // Element level stress.
+                for (uint m=0;m<element.size();m++)
                 {
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        this->nodeForce.x[element.getNodeId(m)] += fe[3*m+0];
-                        this->nodeForce.y[element.getNodeId(m)] += fe[3*m+1];
-                        this->nodeForce.z[element.getNodeId(m)] += fe[3*m+2];
-                    }
-
-                    this->elementNormalStress[elementID] = QeN;
-                    this->elementShearStress[elementID] = 0.0;
-                    this->elementVonMisses[elementID] = QeN;
+                    QeN += dN[m][0]*J[0][0] * De * lxe[m] * integValue;
+                    QeN -= dN[m][0]*J[0][0] * De * this->elementThermalExpansion[elementID] * dT * lineCrossArea * integValue;
                 }
             }
-            catch (const RError &rError)
+
+            RRVector fae, fxe;
+            RRMatrix::mlt(Me,ae,fae);
+            RRMatrix::mlt(Ke,xe,fxe);
+            RRVector::add(fae,fxe,fe);
+
+            #pragma omp critical
             {
-                #pragma omp critical
+                for (uint m=0;m<element.size();m++)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    this->nodeForce.x[element.getNodeId(m)] += fe[3*m+0];
+                    this->nodeForce.y[element.getNodeId(m)] += fe[3*m+1];
+                    this->nodeForce.z[element.getNodeId(m)] += fe[3*m+2];
                 }
-                #pragma omp flush (abort)
+
+                this->elementNormalStress[elementID] = QeN;
+                this->elementShearStress[elementID] = 0.0;
+                this->elementVonMisses[elementID] = QeN;
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process results.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
+            #pragma omp flush (abort)
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process results.");
+    }
 
     // Process surface elements.
-    for (uint i=0;i<this->pModel->getNSurfaces();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->surfaceElements.size());j++)
     {
-        RSurface &surface = this->pModel->getSurface(i);
-        double surfaceThickness = surface.getThickness();
-
-        if (surfaceThickness == 0.0)
+        #pragma omp flush (abort)
+        if (abort)
         {
             continue;
         }
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(surface.size());j++)
+        try
         {
-            #pragma omp flush (abort)
-            if (abort)
+            uint elementID = this->surfaceElements.getElementID(j);
+            const RSurface &surface = this->pModel->getSurface(this->surfaceElements.getEntityID(j));
+            double surfaceThickness = surface.getThickness();
+
+            if (surfaceThickness == 0.0)
             {
                 continue;
             }
-            try
+
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size()*3,element.size()*3,0.0);
+            RRMatrix Ke(element.size()*2,element.size()*2,0.0);
+            RRVector fe(element.size()*3,0.0);
+            RRVector ae(element.size()*3,0.0);
+            RRVector xe(element.size()*3,0.0);
+            RRVector Qe(3,0.0);
+            double QeN = 0.0;
+            double QeS = 0.0;
+            double QeVM = 0.0;
+
+            RRMatrix B(element.size(),3);
+            RRMatrix Be(element.size()*2,3);
+            RRMatrix BeT(3,element.size()*2);
+            RRMatrix BeD(element.size()*2,3);
+            RRMatrix Met(element.size()*2,element.size()*2);
+            RRMatrix MeRt(element.size()*2,element.size()*2);
+            RRMatrix Ket(element.size()*2,element.size()*2);
+            RRMatrix KeRt(element.size()*2,element.size()*2);
+            RRVector fet(element.size()*2);
+
+            RRMatrix De(3,3,0.0);
+
+            double E = this->elementElasticityModulus[elementID];
+            double v = this->elementPoissonRatio[elementID];
+
+            De[0][0] = 1-v;   De[0][1] = v;
+            De[1][0] = v;     De[1][1] = 1-v;
+            De[2][2] = (1-2*v)/2;
+            De *= E/((1+v)*(1-2*v));
+
+            RRMatrix Rl;
+            RRVector tl;
+            element.findTransformationMatrix(this->pModel->getNodes(),Rl,tl);
+            Rl.invert();
+
+            RRVector lxe(element.size()*2);
+            for (uint k=0;k<element.size();k++)
+            {
+                RR3Vector xg(this->nodeDisplacement.x[element.getNodeId(k)],
+                             this->nodeDisplacement.y[element.getNodeId(k)],
+                             this->nodeDisplacement.z[element.getNodeId(k)]);
+                RR3Vector xl;
+                RRMatrix::mlt(Rl,xg,xl);
+                lxe[2*k+0] = xl[0];
+                lxe[2*k+1] = xl[1];
+            }
+
+            for (uint k=0;k<element.size();k++)
             {
-                uint elementID = surface.get(uint(j));
+                ae[3*k+0] = this->nodeAcceleration.x[element.getNodeId(k)];
+                ae[3*k+1] = this->nodeAcceleration.y[element.getNodeId(k)];
+                ae[3*k+2] = this->nodeAcceleration.z[element.getNodeId(k)];
 
-                if (!this->computableElements[elementID])
-                {
-                    continue;
-                }
+                xe[3*k+0] = this->nodeDisplacement.x[element.getNodeId(k)];
+                xe[3*k+1] = this->nodeDisplacement.y[element.getNodeId(k)];
+                xe[3*k+2] = this->nodeDisplacement.z[element.getNodeId(k)];
+            }
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_SURFACE(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size()*3,element.size()*3,0.0);
-                RRMatrix Ke(element.size()*2,element.size()*2,0.0);
-                RRVector fe(element.size()*3,0.0);
-                RRVector ae(element.size()*3,0.0);
-                RRVector xe(element.size()*3,0.0);
-                RRVector Qe(3,0.0);
-                double QeN = 0.0;
-                double QeS = 0.0;
-                double QeVM = 0.0;
-
-                RRMatrix B(element.size(),3);
-                RRMatrix Be(element.size()*2,3);
-                RRMatrix BeT(3,element.size()*2);
-                RRMatrix BeD(element.size()*2,3);
-                RRMatrix Met(element.size()*2,element.size()*2);
-                RRMatrix MeRt(element.size()*2,element.size()*2);
-                RRMatrix Ket(element.size()*2,element.size()*2);
-                RRMatrix KeRt(element.size()*2,element.size()*2);
-                RRVector fet(element.size()*2);
-
-                RRMatrix De(3,3,0.0);
-
-                double E = this->elementElasticityModulus[elementID];
-                double v = this->elementPoissonRatio[elementID];
-
-                De[0][0] = 1-v;   De[0][1] = v;
-                De[1][0] = v;     De[1][1] = 1-v;
-                De[2][2] = (1-2*v)/2;
-                De *= E/((1+v)*(1-2*v));
-
-                RRMatrix Rl;
-                RRVector tl;
-                element.findTransformationMatrix(this->pModel->getNodes(),Rl,tl);
-                Rl.invert();
-
-                RRVector lxe(element.size()*2);
-                for (uint k=0;k<element.size();k++)
+            double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt, RtT;
+                double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
+                RtT.transpose(Rt);
+
+                B.fill(0.0);
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    RR3Vector xg(this->nodeDisplacement.x[element.getNodeId(k)],
-                                 this->nodeDisplacement.y[element.getNodeId(k)],
-                                 this->nodeDisplacement.z[element.getNodeId(k)]);
-                    RR3Vector xl;
-                    RRMatrix::mlt(Rl,xg,xl);
-                    lxe[2*k+0] = xl[0];
-                    lxe[2*k+1] = xl[1];
+                    B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
+                    B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
                 }
 
-                for (uint k=0;k<element.size();k++)
+                for (uint m=0;m<element.size();m++)
                 {
-                    ae[3*k+0] = this->nodeAcceleration.x[element.getNodeId(k)];
-                    ae[3*k+1] = this->nodeAcceleration.y[element.getNodeId(k)];
-                    ae[3*k+2] = this->nodeAcceleration.z[element.getNodeId(k)];
-
-                    xe[3*k+0] = this->nodeDisplacement.x[element.getNodeId(k)];
-                    xe[3*k+1] = this->nodeDisplacement.y[element.getNodeId(k)];
-                    xe[3*k+2] = this->nodeDisplacement.z[element.getNodeId(k)];
+                    Be[2*m][0] = B[m][0];   Be[2*m+1][0] = 0.0;
+                    Be[2*m][1] = 0.0;       Be[2*m+1][1] = B[m][1];
+                    Be[2*m][2] = B[m][1];   Be[2*m+1][2] = B[m][0];
                 }
+                BeT.transpose(Be);
 
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+                RRMatrix::mlt(Be,De,BeD);
+                RRMatrix::mlt(BeD,BeT,Ket);
+                RRMatrix::mlt(Rt,Ket,KeRt);
+                RRMatrix::mlt(KeRt,RtT,Ke);
+                Ke *= detJ * shapeFunc.getW();
 
-                for (uint k=0;k<nInp;k++)
+                for (uint m=0;m<element.size();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt, RtT;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-                    RtT.transpose(Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1]);
-                    }
-
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        Be[2*m][0] = B[m][0];   Be[2*m+1][0] = 0.0;
-                        Be[2*m][1] = 0.0;       Be[2*m+1][1] = B[m][1];
-                        Be[2*m][2] = B[m][1];   Be[2*m+1][2] = B[m][0];
-                    }
-                    BeT.transpose(Be);
-
-                    RRMatrix::mlt(Be,De,BeD);
-                    RRMatrix::mlt(BeD,BeT,Ket);
-                    RRMatrix::mlt(Rt,Ket,KeRt);
-                    RRMatrix::mlt(KeRt,RtT,Ke);
-                    Ke *= detJ * shapeFunc.getW();
-
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        // Mass
-                        if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
-                        {
-                            for (uint n=0;n<element.size();n++)
-                            {
-                                double value = N[m] * N[n]
-                                             * this->elementDensity[elementID]
-                                             * detJ
-                                             * shapeFunc.getW()
-                                             * surfaceThickness;
-                                Met[2*m+0][2*n+0] += value;
-                                Met[2*m+1][2*n+1] += value;
-                            }
-                        }
-                    }
-
                     // Mass
                     if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
                     {
-                        RRMatrix::mlt(Rt,Met,MeRt);
-                        RRMatrix::mlt(MeRt,RtT,Me,true);
-                    }
-
-                    double integValue = 1.0/double(nInp);
-
-                    // Element level stress.
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        for (uint n=0;n<3;n++)
-                        {
-                            Qe[n] += BeD[2*m+0][n] * lxe[2*m+0] * integValue
-                                  +  BeD[2*m+1][n] * lxe[2*m+1] * integValue;
-                        }
-                        for (uint n=0;n<2;n++)
+                        for (uint n=0;n<element.size();n++)
                         {
-                            Qe[0] -= BeD[2*m+0][n] * this->elementThermalExpansion[elementID] * dT * surfaceThickness * integValue;
-                            Qe[1] -= BeD[2*m+1][n] * this->elementThermalExpansion[elementID] * dT * surfaceThickness * integValue;
+                            double value = N[m] * N[n]
+                                         * this->elementDensity[elementID]
+                                         * detJ
+                                         * shapeFunc.getW()
+                                         * surfaceThickness;
+                            Met[2*m+0][2*n+0] += value;
+                            Met[2*m+1][2*n+1] += value;
                         }
                     }
                 }
 
-                RRVector fae, fxe;
-                RRMatrix::mlt(Me,ae,fae);
-                RRMatrix::mlt(Ke,xe,fxe);
-                RRVector::add(fae,fxe,fe);
+                // Mass
+                if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                {
+                    RRMatrix::mlt(Rt,Met,MeRt);
+                    RRMatrix::mlt(MeRt,RtT,Me,true);
+                }
 
-                QeN = std::sqrt(Qe[0] * Qe[0] + Qe[1] * Qe[1] - Qe[0] * Qe[1]);
-                QeS = std::sqrt(3.0) * Qe[2];
-                QeVM = QeN + QeS;
+                double integValue = 1.0/double(nInp);
 
-                #pragma omp critical
+                // Element level stress.
+                for (uint m=0;m<element.size();m++)
                 {
-                    for (uint m=0;m<element.size();m++)
+                    for (uint n=0;n<3;n++)
                     {
-                        this->nodeForce.x[element.getNodeId(m)] += fe[3*m+0];
-                        this->nodeForce.y[element.getNodeId(m)] += fe[3*m+1];
-                        this->nodeForce.z[element.getNodeId(m)] += fe[3*m+2];
+                        Qe[n] += BeD[2*m+0][n] * lxe[2*m+0] * integValue
+                              +  BeD[2*m+1][n] * lxe[2*m+1] * integValue;
+                    }
+                    for (uint n=0;n<2;n++)
+                    {
+                        Qe[0] -= BeD[2*m+0][n] * this->elementThermalExpansion[elementID] * dT * surfaceThickness * integValue;
+                        Qe[1] -= BeD[2*m+1][n] * this->elementThermalExpansion[elementID] * dT * surfaceThickness * integValue;
                     }
-
-                    this->elementNormalStress[elementID] = QeN;
-                    this->elementShearStress[elementID] = QeS;
-                    this->elementVonMisses[elementID] = QeVM;
                 }
             }
-            catch (const RError &rError)
+
+            RRVector fae, fxe;
+            RRMatrix::mlt(Me,ae,fae);
+            RRMatrix::mlt(Ke,xe,fxe);
+            RRVector::add(fae,fxe,fe);
+
+            QeN = std::sqrt(Qe[0] * Qe[0] + Qe[1] * Qe[1] - Qe[0] * Qe[1]);
+            QeS = std::sqrt(3.0) * Qe[2];
+            QeVM = QeN + QeS;
+
+            #pragma omp critical
             {
-                #pragma omp critical
+                for (uint m=0;m<element.size();m++)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    this->nodeForce.x[element.getNodeId(m)] += fe[3*m+0];
+                    this->nodeForce.y[element.getNodeId(m)] += fe[3*m+1];
+                    this->nodeForce.z[element.getNodeId(m)] += fe[3*m+2];
                 }
-                #pragma omp flush (abort)
+
+                this->elementNormalStress[elementID] = QeN;
+                this->elementShearStress[elementID] = QeS;
+                this->elementVonMisses[elementID] = QeVM;
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process results.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
+            #pragma omp flush (abort)
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process results.");
+    }
 
     // Process volume elements.
-    for (uint i=0;i<this->pModel->getNVolumes();i++)
+    #pragma omp parallel for default(shared) schedule(dynamic,R_ELEMENT_LIST_CHUNK_SIZE)
+    for (int64_t j=0;j<int64_t(this->volumeElements.size());j++)
     {
-        RVolume &volume = this->pModel->getVolume(i);
-
-        bool abort = false;
-        #pragma omp parallel for default(shared)
-        for (int64_t j=0;j<int64_t(volume.size());j++)
+        #pragma omp flush (abort)
+        if (abort)
         {
-            #pragma omp flush (abort)
-            if (abort)
+            continue;
+        }
+        try
+        {
+            uint elementID = this->volumeElements.getElementID(j);
+
+            const RElement &element = this->pModel->getElement(elementID);
+            R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
+            uint nInp = RElement::getNIntegrationPoints(element.getType());
+            RRMatrix Me(element.size()*3,element.size()*3,0.0);
+            RRMatrix Ke(element.size()*3,element.size()*3,0.0);
+            RRVector fe(element.size()*3,0.0);
+            RRVector ae(element.size()*3,0.0);
+            RRVector xe(element.size()*3,0.0);
+            RRVector Qe(6,0.0);
+
+            RRMatrix B(element.size(),3);
+            RRMatrix Be(element.size()*3,6);
+            RRMatrix BeT(6,element.size()*3);
+            RRMatrix BeD(element.size()*3,6);
+            RRMatrix Ket(element.size()*3,element.size()*3);
+
+            RRMatrix De(6,6,0.0);
+
+            double E = this->elementElasticityModulus[elementID];
+            double v = this->elementPoissonRatio[elementID];
+
+            De[0][0] = 1-v;   De[0][1] = v;     De[0][2] = v;
+            De[1][0] = v;     De[1][1] = 1-v;   De[1][2] = v;
+            De[2][0] = v;     De[2][1] = v;     De[2][2] = 1-v;
+            De[3][3] = De[4][4] = De[5][5] = (1-2*v)/2;
+            De *= E/((1+v)*(1-2*v));
+
+            double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+
+            for (uint k=0;k<element.size();k++)
             {
-                continue;
+                ae[3*k+0] = this->nodeAcceleration.x[element.getNodeId(k)];
+                ae[3*k+1] = this->nodeAcceleration.y[element.getNodeId(k)];
+                ae[3*k+2] = this->nodeAcceleration.z[element.getNodeId(k)];
+
+                xe[3*k+0] = this->nodeDisplacement.x[element.getNodeId(k)];
+                xe[3*k+1] = this->nodeDisplacement.y[element.getNodeId(k)];
+                xe[3*k+2] = this->nodeDisplacement.z[element.getNodeId(k)];
             }
-            try
-            {
-                uint elementID = volume.get(uint(j));
 
-                if (!this->computableElements[elementID])
+            for (uint k=0;k<nInp;k++)
+            {
+                const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+                const RRVector &N = shapeFunc.getN();
+                const RRMatrix &dN = shapeFunc.getDN();
+                RRMatrix J, Rt;
+                double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
+
+                B.fill(0.0);
+                for (uint m=0;m<dN.getNRows();m++)
                 {
-                    continue;
+                    B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
+                    B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
+                    B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
                 }
 
-                const RElement &element = this->pModel->getElement(elementID);
-                R_ERROR_ASSERT(R_ELEMENT_TYPE_IS_VOLUME(element.getType()));
-                uint nInp = RElement::getNIntegrationPoints(element.getType());
-                RRMatrix Me(element.size()*3,element.size()*3,0.0);
-                RRMatrix Ke(element.size()*3,element.size()*3,0.0);
-                RRVector fe(element.size()*3,0.0);
-                RRVector ae(element.size()*3,0.0);
-                RRVector xe(element.size()*3,0.0);
-                RRVector Qe(6,0.0);
-
-                RRMatrix B(element.size(),3);
-                RRMatrix Be(element.size()*3,6);
-                RRMatrix BeT(6,element.size()*3);
-                RRMatrix BeD(element.size()*3,6);
-                RRMatrix Ket(element.size()*3,element.size()*3);
-
-                RRMatrix De(6,6,0.0);
-
-                double E = this->elementElasticityModulus[elementID];
-                double v = this->elementPoissonRatio[elementID];
-
-                De[0][0] = 1-v;   De[0][1] = v;     De[0][2] = v;
-                De[1][0] = v;     De[1][1] = 1-v;   De[1][2] = v;
-                De[2][0] = v;     De[2][1] = v;     De[2][2] = 1-v;
-                De[3][3] = De[4][4] = De[5][5] = (1-2*v)/2;
-                De *= E/((1+v)*(1-2*v));
-
-                double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
-
-                for (uint k=0;k<element.size();k++)
+                for (uint m=0;m<element.size();m++)
                 {
-                    ae[3*k+0] = this->nodeAcceleration.x[element.getNodeId(k)];
-                    ae[3*k+1] = this->nodeAcceleration.y[element.getNodeId(k)];
-                    ae[3*k+2] = this->nodeAcceleration.z[element.getNodeId(k)];
-
-                    xe[3*k+0] = this->nodeDisplacement.x[element.getNodeId(k)];
-                    xe[3*k+1] = this->nodeDisplacement.y[element.getNodeId(k)];
-                    xe[3*k+2] = this->nodeDisplacement.z[element.getNodeId(k)];
+                    Be[3*m+0][0] = B[m][0];   Be[3*m+1][0] = 0.0;       Be[3*m+2][0] = 0.0;
+                    Be[3*m+0][1] = 0.0;       Be[3*m+1][1] = B[m][1];   Be[3*m+2][1] = 0.0;
+                    Be[3*m+0][2] = 0.0;       Be[3*m+1][2] = 0.0;       Be[3*m+2][2] = B[m][2];
+                    Be[3*m+0][3] = 0.0;       Be[3*m+1][3] = B[m][2];   Be[3*m+2][3] = B[m][1];
+                    Be[3*m+0][4] = B[m][2];   Be[3*m+1][4] = 0.0;       Be[3*m+2][4] = B[m][0];
+                    Be[3*m+0][5] = B[m][1];   Be[3*m+1][5] = B[m][0];   Be[3*m+2][5] = 0.0;
                 }
+                BeT.transpose(Be);
 
-                for (uint k=0;k<nInp;k++)
+                RRMatrix::mlt(Be,De,BeD);
+                RRMatrix::mlt(BeD,BeT,Ket);
+                for (uint m=0;m<3*element.size();m++)
                 {
-                    const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
-                    const RRVector &N = shapeFunc.getN();
-                    const RRMatrix &dN = shapeFunc.getDN();
-                    RRMatrix J, Rt;
-                    double detJ = element.findJacobian(this->pModel->getNodes(),k,J,Rt);
-
-                    B.fill(0.0);
-                    for (uint m=0;m<dN.getNRows();m++)
-                    {
-                        B[m][0] += (dN[m][0]*J[0][0] + dN[m][1]*J[0][1] + dN[m][2]*J[0][2]);
-                        B[m][1] += (dN[m][0]*J[1][0] + dN[m][1]*J[1][1] + dN[m][2]*J[1][2]);
-                        B[m][2] += (dN[m][0]*J[2][0] + dN[m][1]*J[2][1] + dN[m][2]*J[2][2]);
-                    }
-
-                    for (uint m=0;m<element.size();m++)
+                    for (uint n=0;n<3*element.size();n++)
                     {
-                        Be[3*m+0][0] = B[m][0];   Be[3*m+1][0] = 0.0;       Be[3*m+2][0] = 0.0;
-                        Be[3*m+0][1] = 0.0;       Be[3*m+1][1] = B[m][1];   Be[3*m+2][1] = 0.0;
-                        Be[3*m+0][2] = 0.0;       Be[3*m+1][2] = 0.0;       Be[3*m+2][2] = B[m][2];
-                        Be[3*m+0][3] = 0.0;       Be[3*m+1][3] = B[m][2];   Be[3*m+2][3] = B[m][1];
-                        Be[3*m+0][4] = B[m][2];   Be[3*m+1][4] = 0.0;       Be[3*m+2][4] = B[m][0];
-                        Be[3*m+0][5] = B[m][1];   Be[3*m+1][5] = B[m][0];   Be[3*m+2][5] = 0.0;
+                        // Stiffness matrix
+                        Ke[m][n] += Ket[m][n] * detJ * shapeFunc.getW();
                     }
-                    BeT.transpose(Be);
+                }
 
-                    RRMatrix::mlt(Be,De,BeD);
-                    RRMatrix::mlt(BeD,BeT,Ket);
-                    for (uint m=0;m<3*element.size();m++)
+                for (uint m=0;m<element.size();m++)
+                {
+                    for (uint n=0;n<element.size();n++)
                     {
-                        for (uint n=0;n<3*element.size();n++)
+                        // Mass
+                        if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
                         {
-                            // Stiffness matrix
-                            Ke[m][n] += Ket[m][n] * detJ * shapeFunc.getW();
+                            double value = N[m] * N[n]
+                                         * this->elementDensity[elementID]
+                                         * detJ
+                                         * shapeFunc.getW();
+                            Me[3*m+0][3*n+0] += value;
+                            Me[3*m+1][3*n+1] += value;
+                            Me[3*m+2][3*n+2] += value;
                         }
                     }
+                }
 
-                    for (uint m=0;m<element.size();m++)
+                double integValue = 1.0/double(nInp);
+
+                // Element level stress.
+                for (uint m=0;m<element.size();m++)
+                {
+                    for (uint n=0;n<6;n++)
                     {
-                        for (uint n=0;n<element.size();n++)
-                        {
-                            // Mass
-                            if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
-                            {
-                                double value = N[m] * N[n]
-                                             * this->elementDensity[elementID]
-                                             * detJ
-                                             * shapeFunc.getW();
-                                Me[3*m+0][3*n+0] += value;
-                                Me[3*m+1][3*n+1] += value;
-                                Me[3*m+2][3*n+2] += value;
-                            }
-                        }
+                        Qe[n] += BeD[3*m+0][n] * this->nodeDisplacement.x[element.getNodeId(m)] * integValue
+                              +  BeD[3*m+1][n] * this->nodeDisplacement.y[element.getNodeId(m)] * integValue
+                              +  BeD[3*m+2][n] * this->nodeDisplacement.z[element.getNodeId(m)] * integValue;
                     }
-
-                    double integValue = 1.0/double(nInp);
-
-                    // Element level stress.
-                    for (uint m=0;m<element.size();m++)
+                    for (uint n=0;n<3;n++)
                     {
-                        for (uint n=0;n<6;n++)
-                        {
-                            Qe[n] += BeD[3*m+0][n] * this->nodeDisplacement.x[element.getNodeId(m)] * integValue
-                                  +  BeD[3*m+1][n] * this->nodeDisplacement.y[element.getNodeId(m)] * integValue
-                                  +  BeD[3*m+2][n] * this->nodeDisplacement.z[element.getNodeId(m)] * integValue;
-                        }
-                        for (uint n=0;n<3;n++)
-                        {
-                            Qe[0] -= BeD[3*m+0][n] * this->elementThermalExpansion[elementID] * dT * integValue;
-                            Qe[1] -= BeD[3*m+1][n] * this->elementThermalExpansion[elementID] * dT * integValue;
-                            Qe[2] -= BeD[3*m+2][n] * this->elementThermalExpansion[elementID] * dT * integValue;
-                        }
+                        Qe[0] -= BeD[3*m+0][n] * this->elementThermalExpansion[elementID] * dT * integValue;
+                        Qe[1] -= BeD[3*m+1][n] * this->elementThermalExpansion[elementID] * dT * integValue;
+                        Qe[2] -= BeD[3*m+2][n] * this->elementThermalExpansion[elementID] * dT * integValue;
                     }
                 }
+            }
 
-                RRVector fae, fxe;
-                RRMatrix::mlt(Me,ae,fae);
-                RRMatrix::mlt(Ke,xe,fxe);
-                RRVector::add(fae,fxe,fe);
-
-                double QeN = std::sqrt(Qe[0]*Qe[0] + Qe[1]*Qe[1] + Qe[2]*Qe[2] - (Qe[0]*Qe[1] + Qe[1]*Qe[2] + Qe[2]*Qe[0]));
-                double QeS = std::sqrt(3.0 * (Qe[3]*Qe[3] + Qe[4]*Qe[4] + Qe[5]*Qe[5]));
-                double QeVM = QeN + QeS;
+            RRVector fae, fxe;
+            RRMatrix::mlt(Me,ae,fae);
+            RRMatrix::mlt(Ke,xe,fxe);
+            RRVector::add(fae,fxe,fe);
 
-                #pragma omp critical
-                {
-                    for (uint m=0;m<element.size();m++)
-                    {
-                        this->nodeForce.x[element.getNodeId(m)] += fe[3*m+0];
-                        this->nodeForce.y[element.getNodeId(m)] += fe[3*m+1];
-                        this->nodeForce.z[element.getNodeId(m)] += fe[3*m+2];
-                    }
+            double QeN = std::sqrt(Qe[0]*Qe[0] + Qe[1]*Qe[1] + Qe[2]*Qe[2] - (Qe[0]*Qe[1] + Qe[1]*Qe[2] + Qe[2]*Qe[0]));
+            double QeS = std::sqrt(3.0 * (Qe[3]*Qe[3] + Qe[4]*Qe[4] + Qe[5]*Qe[5]));
+            double QeVM = QeN + QeS;
 
-                    this->elementNormalStress[elementID] = QeN;
-                    this->elementShearStress[elementID] = QeS;
-                    this->elementVonMisses[elementID] = QeVM;
-                }
-            }
-            catch (const RError &rError)
+            #pragma omp critical
             {
-                #pragma omp critical
+                for (uint m=0;m<element.size();m++)
                 {
-                    RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
-                    abort = true;
+                    this->nodeForce.x[element.getNodeId(m)] += fe[3*m+0];
+                    this->nodeForce.y[element.getNodeId(m)] += fe[3*m+1];
+                    this->nodeForce.z[element.getNodeId(m)] += fe[3*m+2];
                 }
-                #pragma omp flush (abort)
+
+                this->elementNormalStress[elementID] = QeN;
+                this->elementShearStress[elementID] = QeS;
+                this->elementVonMisses[elementID] = QeVM;
             }
         }
-        if (abort)
+        catch (const RError &rError)
         {
-            throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process results.");
+            #pragma omp critical
+            {
+                RLogger::error("%s\n",rError.getMessage().toUtf8().constData());
+                abort = true;
+            }
+            #pragma omp flush (abort)
         }
     }
+    if (abort)
+    {
+        throw RError(R_ERROR_APPLICATION,R_ERROR_REF,"Failed to process results.");
+    }
 }
 
 void RSolverStress::store(void)
@@ -1688,16 +1596,230 @@ void RSolverStress::generateNodeBook(void)
     }
 }
 
-void RSolverStress::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRMatrix &Ke, const RRVector &fe)
+void RSolverStress::computeVolumeElement(uint elementID, const RSolverCartesianVector<RRVector> &elementGravity, RRMatrix &Me, RRMatrix &Ke, RRVector &fe) const
+{
+    const RElement &element = this->pModel->getElement(elementID);
+    uint nInp = RElement::getNIntegrationPoints(element.getType());
+
+    Me.fill(0.0);
+    Ke.fill(0.0);
+    fe.fill(0.0);
+
+    RRMatrix B(element.size(),3);
+    RRMatrix Be(element.size()*3,6);
+    RRMatrix BeT(6,element.size()*3);
+    RRMatrix BeD(element.size()*3,6);
+    RRMatrix Ket(element.size()*3,element.size()*3);
+
+    RRMatrix De(6,6);
+    De.fill(0.0);
+
+    double E = this->elementElasticityModulus[elementID];
+    double v = this->elementPoissonRatio[elementID];
+
+    De[0][0] = 1.0-v; De[0][1] = v;     De[0][2] = v;
+    De[1][0] = v;     De[1][1] = 1.0-v; De[1][2] = v;
+    De[2][0] = v;     De[2][1] = v;     De[2][2] = 1.0-v;
+    De[3][3] = De[4][4] = De[5][5] = (1.0-2.0*v)/2.0;
+    De *= E/((1.0+v)*(1.0-2.0*v));
+
+    double dT = this->elementTemperature[elementID] - this->elementEnvironmentTemperature[elementID];
+
+    for (uint k=0;k<nInp;k++)
+    {
+        const RElementShapeFunction &shapeFunc = RElement::getShapeFunction(element.getType(),k);
+        const RRVector &N = shapeFunc.getN();
+        double detJW = this->geometricFactors.getDetJW(elementID,k);
+        this->geometricFactors.getGradients(elementID,k,B);
+
+        for (uint m=0;m<element.size();m++)
+        {
+            Be[3*m+0][0] = B[m][0];   Be[3*m+1][0] = 0.0;       Be[3*m+2][0] = 0.0;
+            Be[3*m+0][1] = 0.0;       Be[3*m+1][1] = B[m][1];   Be[3*m+2][1] = 0.0;
+            Be[3*m+0][2] = 0.0;       Be[3*m+1][2] = 0.0;       Be[3*m+2][2] = B[m][2];
+            Be[3*m+0][3] = 0.0;       Be[3*m+1][3] = B[m][2];   Be[3*m+2][3] = B[m][1];
+            Be[3*m+0][4] = B[m][2];   Be[3*m+1][4] = 0.0;       Be[3*m+2][4] = B[m][0];
+            Be[3*m+0][5] = B[m][1];   Be[3*m+1][5] = B[m][0];   Be[3*m+2][5] = 0.0;
+        }
+        BeT.transpose(Be);
+
+        RRMatrix::mlt(Be,De,BeD);
+        RRMatrix::mlt(BeD,BeT,Ket);
+        for (uint m=0;m<3*element.size();m++)
+        {
+            for (uint n=0;n<3*element.size();n++)
+            {
+                // Stiffness matrix
+                Ke[m][n] += Ket[m][n] * detJW;
+            }
+        }
+
+        for (uint m=0;m<element.size();m++)
+        {
+            for (uint n=0;n<element.size();n++)
+            {
+                // Mass
+                if (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL)
+                {
+                    double value = N[m] * N[n]
+                                 * this->elementDensity[elementID]
+                                 * detJW;
+                    Me[3*m+0][3*n+0] += value;
+                    Me[3*m+1][3*n+1] += value;
+                    Me[3*m+2][3*n+2] += value;
+                }
+            }
+
+            // Own weight
+            fe[3*m+0] += elementGravity.x[elementID] * this->elementDensity[elementID] * N[m] * detJW;
+            fe[3*m+1] += elementGravity.y[elementID] * this->elementDensity[elementID] * N[m] * detJW;
+            fe[3*m+2] += elementGravity.z[elementID] * this->elementDensity[elementID] * N[m] * detJW;
+
+            // Thermal expansion
+            for (uint n=0;n<3;n++)
+            {
+                fe[3*m+0] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+0][n] * detJW;
+                fe[3*m+1] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+1][n] * detJW;
+                fe[3*m+2] += this->elementThermalExpansion[elementID] * dT * BeD[3*m+2][n] * detJW;
+            }
+        }
+    }
+}
+
+template <unsigned int nNodes, unsigned int nPoints>
+void RSolverStress::computeVolumeElementBatch(const RElementBatch<nNodes,nPoints> &batch, const RSolverCartesianVector<RRVector> &elementGravity, RElementBatchMatrix<3*nNodes,3*nNodes> &Me, RElementBatchMatrix<3*nNodes,3*nNodes> &Ke, RElementBatchVector<3*nNodes> &fe) const
+{
+    bool computeMass = (this->pModel->getTimeSolver().getEnabled() || this->problemType == R_PROBLEM_STRESS_MODAL);
+
+    double E[R_ELEMENT_BATCH_SIZE];
+    double v[R_ELEMENT_BATCH_SIZE];
+    double density[R_ELEMENT_BATCH_SIZE];
+    double thermalExpansion[R_ELEMENT_BATCH_SIZE];
+    double temperature[R_ELEMENT_BATCH_SIZE];
+    double environmentTemperature[R_ELEMENT_BATCH_SIZE];
+    double g[3][R_ELEMENT_BATCH_SIZE];
+
+    batch.gather(this->elementElasticityModulus,E);
+    batch.gather(this->elementPoissonRatio,v);
+    batch.gather(this->elementDensity,density);
+    batch.gather(this->elementThermalExpansion,thermalExpansion);
+    batch.gather(this->elementTemperature,temperature);
+    batch.gather(this->elementEnvironmentTemperature,environmentTemperature);
+    batch.gather(elementGravity.x,g[0]);
+    batch.gather(elementGravity.y,g[1]);
+    batch.gather(elementGravity.z,g[2]);
+
+    // Isotropic material written with Lame coefficients:
+    // Be*De*BeT block of nodes m,n = lambda*Bm*Bn' + mu*Bn*Bm' + mu*(Bm.Bn)*I
+    double lambda[R_ELEMENT_BATCH_SIZE];
+    double mu[R_ELEMENT_BATCH_SIZE];
+    double thermalStress[R_ELEMENT_BATCH_SIZE];
+
+    R_ELEMENT_BATCH_SIMD
+    for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+    {
+        // Unused lanes have zero modulus and zero gradients.
+        double c = (l < batch.size()) ? E[l]/((1.0+v[l])*(1.0-2.0*v[l])) : 0.0;
+        lambda[l] = c * v[l];
+        mu[l] = c * (1.0-2.0*v[l])/2.0;
+        thermalStress[l] = thermalExpansion[l] * (temperature[l] - environmentTemperature[l]) * (3.0*lambda[l] + 2.0*mu[l]);
+    }
+
+    Me.fill(0.0);
+    Ke.fill(0.0);
+    fe.fill(0.0);
+
+    for (unsigned int k=0;k<nPoints;k++)
+    {
+        const double *detJW = batch.getDetJW(k);
+
+        for (unsigned int m=0;m<nNodes;m++)
+        {
+            double Nm = batch.getN(k,m);
+
+            for (unsigned int n=0;n<nNodes;n++)
+            {
+                double NmNn = Nm * batch.getN(k,n);
+
+                // Stiffness matrix
+                for (unsigned int a=0;a<3;a++)
+                {
+                    const double *Bma = batch.getB(k,m,a);
+                    const double *Bna = batch.getB(k,n,a);
+                    for (unsigned int b=0;b<3;b++)
+                    {
+                        const double *Bmb = batch.getB(k,m,b);
+                        const double *Bnb = batch.getB(k,n,b);
+                        double *ke = Ke(3*m+a,3*n+b);
+                        R_ELEMENT_BATCH_SIMD
+                        for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+                        {
+                            ke[l] += (lambda[l]*Bma[l]*Bnb[l] + mu[l]*Bmb[l]*Bna[l]) * detJW[l];
+                        }
+                    }
+                }
+                const double *Bm0 = batch.getB(k,m,0);
+                const double *Bm1 = batch.getB(k,m,1);
+                const double *Bm2 = batch.getB(k,m,2);
+                const double *Bn0 = batch.getB(k,n,0);
+                const double *Bn1 = batch.getB(k,n,1);
+                const double *Bn2 = batch.getB(k,n,2);
+                double *ke0 = Ke(3*m+0,3*n+0);
+                double *ke1 = Ke(3*m+1,3*n+1);
+                double *ke2 = Ke(3*m+2,3*n+2);
+                R_ELEMENT_BATCH_SIMD
+                for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+                {
+                    double value = mu[l] * (Bm0[l]*Bn0[l] + Bm1[l]*Bn1[l] + Bm2[l]*Bn2[l]) * detJW[l];
+                    ke0[l] += value;
+                    ke1[l] += value;
+                    ke2[l] += value;
+                }
+
+                // Mass
+                if (computeMass)
+                {
+                    double *me0 = Me(3*m+0,3*n+0);
+                    double *me1 = Me(3*m+1,3*n+1);
+                    double *me2 = Me(3*m+2,3*n+2);
+                    R_ELEMENT_BATCH_SIMD
+                    for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+                    {
+                        double value = NmNn * density[l] * detJW[l];
+                        me0[l] += value;
+                        me1[l] += value;
+                        me2[l] += value;
+                    }
+                }
+            }
+
+            for (unsigned int a=0;a<3;a++)
+            {
+                const double *Bma = batch.getB(k,m,a);
+                const double *ga = g[a];
+                double *f = fe(3*m+a);
+                R_ELEMENT_BATCH_SIMD
+                for (unsigned int l=0;l<R_ELEMENT_BATCH_SIZE;l++)
+                {
+                    // Own weight and thermal expansion
+                    f[l] += (ga[l] * density[l] * Nm + thermalStress[l] * Bma[l]) * detJW[l];
+                }
+            }
+        }
+    }
+}
+
+template <class TMatrix, class TVector>
+void RSolverStress::assemblyMatrix(uint elementID, const TMatrix &Me, const TMatrix &Ke, const TVector &fe)
 {
     double alpha = this->pModel->getTimeSolver().getTimeMarchApproximationCoefficient();
     double dt = this->pModel->getTimeSolver().getCurrentTimeStepSize();
 
     const RElement &rElement = this->pModel->getElement(elementID);
 
-    RRMatrix Ae(3*rElement.size(),3*rElement.size());
-    RRMatrix Be(3*rElement.size(),3*rElement.size());
-    RRVector be(3*rElement.size());
+    TMatrix Ae(Ke);
+    TMatrix Be(Me);
+    TVector be(fe);
 
     Ae.fill(0.0);
     Be.fill(0.0);
@@ -1751,7 +1873,7 @@ void RSolverStress::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRM
     }
     this->applyLocalRotations(elementID,Ae);
     this->applyLocalRotations(elementID,Be);
-    this->applyLocalRotations(elementID,be);
+    this->applyLocalRotationsToVector(elementID,be);
 
     // Apply explicit boundary conditions.
     for (uint m=0;m<rElement.size();m++)
@@ -1808,63 +1930,66 @@ void RSolverStress::assemblyMatrix(uint elementID, const RRMatrix &Me, const RRM
     }
 }
 
-void RSolverStress::applyLocalRotations(unsigned int elementID, RRMatrix &Ae)
+template <class TMatrix>
+void RSolverStress::applyLocalRotations(unsigned int elementID, TMatrix &Ae)
 {
     const RElement &rElement = this->pModel->getElement(elementID);
-    RRMatrix T;
-
-    bool first = true;
+    uint nValues = 3*rElement.size();
 
+    // Ae = Tt*Ae*T, where T is block diagonal with node rotations, applied block by block in place.
     for (uint i=0;i<rElement.size();i++)
     {
         uint nodeId = rElement.getNodeId(i);
-        if (this->localRotations[nodeId].isActive())
+        if (!this->localRotations[nodeId].isActive())
+        {
+            continue;
+        }
+        const RRMatrix &R = this->localRotations[nodeId].getR();
+
+        for (uint n=0;n<nValues;n++)
         {
-            if (first)
+            double a0 = Ae[3*i+0][n];
+            double a1 = Ae[3*i+1][n];
+            double a2 = Ae[3*i+2][n];
+            for (uint k=0;k<3;k++)
             {
-                T.setIdentity(Ae.getNRows());
-                first = false;
+                Ae[3*i+k][n] = R[0][k]*a0 + R[1][k]*a1 + R[2][k]*a2;
+            }
+        }
+        for (uint m=0;m<nValues;m++)
+        {
+            double a0 = Ae[m][3*i+0];
+            double a1 = Ae[m][3*i+1];
+            double a2 = Ae[m][3*i+2];
+            for (uint k=0;k<3;k++)
+            {
+                Ae[m][3*i+k] = a0*R[0][k] + a1*R[1][k] + a2*R[2][k];
             }
-            T.setBlock(this->localRotations[nodeId].getR(),3*i,3*i);
         }
-    }
-    if (!first)
-    {
-        RRMatrix Tt(T);
-        Tt.transpose();
-
-        RRMatrix Aetmp;
-
-        RRMatrix::mlt(Tt,Ae,Aetmp);
-        RRMatrix::mlt(Aetmp,T,Ae);
     }
 }
 
-void RSolverStress::applyLocalRotations(unsigned int elementID, RRVector &fe)
+template <class TVector>
+void RSolverStress::applyLocalRotationsToVector(unsigned int elementID, TVector &fe)
 {
     const RElement &rElement = this->pModel->getElement(elementID);
-    RRMatrix T;
-
-    bool first = true;
 
+    // fe = T*fe, where T is block diagonal with node rotations.
     for (uint i=0;i<rElement.size();i++)
     {
         uint nodeId = rElement.getNodeId(i);
-        if (this->localRotations[nodeId].isActive())
+        if (!this->localRotations[nodeId].isActive())
         {
-            if (first)
-            {
-                T.setIdentity(fe.getNRows());
-                first = false;
-            }
-            T.setBlock(this->localRotations[nodeId].getR(),3*i,3*i);
+            continue;
         }
-    }
-    if (!first)
-    {
-        RRVector fetmp;
+        const RRMatrix &R = this->localRotations[nodeId].getR();
 
-        RRMatrix::mlt(T,fe,fetmp);
-        fe = fetmp;
+        double f0 = fe[3*i+0];
+        double f1 = fe[3*i+1];
+        double f2 = fe[3*i+2];
+        for (uint k=0;k<3;k++)
+        {
+            fe[3*i+k] = R[k][0]*f0 + R[k][1]*f1 + R[k][2]*f2;
+        }
     }
 }
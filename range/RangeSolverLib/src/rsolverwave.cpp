@@ -50,6 +50,20 @@ bool RSolverWave::hasConverged(void) const
     return true;
 }
 
+void RSolverWave::writeCheckpoint(RSaveFile &outFile) const
+{
+    RSolverGeneric::writeCheckpoint(outFile);
+
+    RFileIO::writeBinary(outFile,this->nodeWaveDisplacement,true);
+}
+
+void RSolverWave::readCheckpoint(RFile &inFile)
+{
+    RSolverGeneric::readCheckpoint(inFile);
+
+    RFileIO::readBinary(inFile,this->nodeWaveDisplacement,true);
+}
+
 void RSolverWave::updateScales(void)
 {
 
@@ -71,11 +85,10 @@ void RSolverWave::prepare(void)
 //    this->generateVariableVector(R_VARIABLE_W,this->elementWaveDisplacement,waveDisplacementExplicitFlags,true,firstTime,firstTime);
 
     this->b.resize(this->nodeBook.getNEnabled());
-    this->x.resize(this->nodeBook.getNEnabled());
 
     this->A.clear();
     this->b.fill(0.0);
-    this->x.fill(0.0);
+    this->initializeSolution(this->nodeBook.getNEnabled());
 }
 
 void RSolverWave::solve(void)